@@ -0,0 +1,587 @@
+#ifndef GRAPHCSR_HPP_
+#define GRAPHCSR_HPP_
+
+#include <cassert>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "../core/shapes.hpp"
+#include "../core/graphItem.h"
+
+namespace geometry
+{
+
+using namespace std;
+
+class graphCSR;
+
+/*! Light reference to one row of a graphCSR. It has the same methods of graphItem with the same semantics (e.g. add
+    and remove leave the row sorted exactly as graphItem does), so the code that edits the connectivity through a
+    graphItem pointer works unchanged on a row of a graphCSR. The operator "->" returns the row itself, so a graphRow
+    can be used in place of a graphItem pointer. */
+
+class graphRow
+{
+      //
+      // Class variables
+      //
+      public:
+		/*! Pointer to the graph */
+		graphCSR  *  graph;
+
+		/*! Row in the graph */
+		UInt	       row;
+      //
+      // Constructors and operators
+      //
+      public:
+		/*! Constructor
+		    \param _graph pointer to the graph
+		    \param _row row */
+		inline graphRow(graphCSR * _graph, UInt _row);
+
+		/*! Copy constructor, the copy refers to the same row */
+		graphRow(const graphRow & G) = default;
+
+		/*! Operator to use the row as a pointer to a graphItem */
+		inline graphRow * operator->();
+
+		/*! Operator to use the row as a pointer to a graphItem */
+		inline const graphRow * operator->() const;
+
+		/*! Copy of the content of a graphItem in the row
+		    \param G graphItem */
+		graphRow & operator=(const graphItem & G);
+
+		/*! Copy of the content of another row, also of the same graph
+		    \param G row */
+		graphRow & operator=(const graphRow & G);
+
+		/*! Conversion to a graphItem */
+		operator graphItem() const;
+      //
+      // Get methods
+      //
+      public:
+		/*! Number of connected ids */
+		inline UInt getNumConnected() const;
+
+		/*! Id of the i-th connected
+		    \param i position */
+		inline UInt getConnectedId(const UInt & i) const;
+
+		/*! Pointer to the first connected id, it is valid until the next change of the graph */
+		inline const UInt * begin() const;
+
+		/*! Pointer after the last connected id, it is valid until the next change of the graph */
+		inline const UInt * end() const;
+      //
+      // Set methods
+      //
+      public:
+		/*! Method that cleans the row */
+		inline void clear();
+
+		/*! Set the id of the i-th connected */
+		inline void setConnectedId(const UInt & i, const UInt & value);
+
+		/*! Set all the connected ids */
+		void setConnectedId(vector<UInt> * ids);
+
+		/*! Adds a connected id */
+		inline void connectedPushBack(const UInt & value);
+
+		/*! Resize of the number of connected ids, the new ones are 0 */
+		void connectedResize(const UInt & dim);
+      //
+      // Methods to add, remove and change
+      //
+      public:
+		/*! Adds a value if it is not present, the row is sorted as in graphItem::add */
+		void add(UInt value);
+
+		/*! Adds the values which are not present, the row is sorted as in graphItem::add */
+		void add(vector<UInt> & value);
+
+		/*! Removes the first occurrence of a value, the row is sorted as in graphItem::remove */
+		void remove(UInt value);
+
+		/*! Changes all the occurrences of a value */
+		void change(UInt oldValue, UInt newValue);
+      //
+      // Methods to find the common ids
+      //
+      public:
+		/*! Fills the vector with the ids in common, in the order of this row */
+		void common(const graphItem & E, vector<UInt> * com) const;
+
+		/*! Fills the vector with the ids in common, in the order of this row */
+		void common(const graphRow & E, vector<UInt> * com) const;
+      //
+      // Print
+      //
+      public:
+		/*! Print to screen */
+		void print() const;
+      //
+      // Internal methods
+      //
+      protected:
+		/*! Fills the vector with the ids in common with the sorted vector ext */
+		void common(vector<UInt> & ext, vector<UInt> * com) const;
+};
+
+/*! Compressed sparse row storage of a list of graphs, alternative to vector<graphItem>. All the connected ids are
+    stored in a single vector: every row has an offset, a number of used ids and a capacity with some slack, so that
+    the small changes of the collapses are done in place. When a row needs more space it is moved at the end of the
+    storage and its old place becomes a hole; the holes are removed by compact() which is called automatically when
+    they become half of the storage.
+
+    The class has the methods of vector<graphItem> used on the connectivity (size, at, operator[], push_back, resize,
+    clear) and returns a graphRow for each row. */
+
+class graphCSR
+{
+      //
+      // Class variables
+      //
+      public:
+		/*! Position of the first id of every row */
+		vector<UInt>	offset;
+
+		/*! Number of ids of every row */
+		vector<UInt>	 count;
+
+		/*! Number of places reserved for every row */
+		vector<UInt>  capacity;
+
+		/*! All the ids */
+		vector<UInt>	   ids;
+
+		/*! Extra places given to a row when it is created or moved */
+		UInt		 slack;
+
+		/*! Number of places lost by the rows that have been moved */
+		UInt	      numHoles;
+      //
+      // Constructor and methods of vector<graphItem>
+      //
+      public:
+		/*! Constructor
+		    \param _slack extra places for each row */
+		graphCSR(UInt _slack=2);
+
+		/*! Number of rows */
+		inline UInt size() const;
+
+		/*! Method that checks if there are no rows */
+		inline bool empty() const;
+
+		/*! Method that cleans the storage */
+		void clear();
+
+		/*! Method that reserves the memory
+		    \param numRows number of rows
+		    \param numIds total number of ids */
+		void reserve(UInt numRows, UInt numIds=0);
+
+		/*! Method that changes the number of rows, the new ones are empty
+		    \param numRows number of rows */
+		void resize(UInt numRows);
+
+		/*! Method that adds a row at the end
+		    \param G content of the row */
+		void push_back(const graphItem & G);
+
+		/*! Row i
+		    \param i row */
+		inline graphRow at(UInt i);
+
+		/*! Row i
+		    \param i row */
+		inline graphRow operator[](UInt i);
+      //
+      // Methods to manage the storage
+      //
+      public:
+		/*! Method that changes the slack
+		    \param _slack extra places for each row */
+		void setSlack(UInt _slack);
+
+		/*! Method that fills the storage starting from a vector of graphItem
+		    \param lista vector of graphItem */
+		void assign(const vector<graphItem> & lista);
+
+		/*! Method that makes sure that the row has at least n places, the row can be moved
+		    \param i row
+		    \param n number of places */
+		void reserveRow(UInt i, UInt n);
+
+		/*! Method that removes the holes, every row keeps slack free places */
+		void compact();
+
+		/*! Memory used by the storage in bytes */
+		UInt getMemory() const;
+};
+
+//-------------------------------------------------------------------------------------------------------
+// Reference to a row for the two storages of the connectivity
+//-------------------------------------------------------------------------------------------------------
+
+/*! Reference to the row i of a vector<graphItem> */
+inline graphItem * graphReference(vector<graphItem> & lista, UInt i)
+{
+    return(&lista[i]);
+}
+
+/*! Reference to the row i of a graphCSR */
+inline graphRow graphReference(graphCSR & lista, UInt i)
+{
+    return(lista.at(i));
+}
+
+//-------------------------------------------------------------------------------------------------------
+// IMPLEMENTATION graphRow
+//-------------------------------------------------------------------------------------------------------
+
+//
+// Constructors and operators
+//
+inline graphRow::graphRow(graphCSR * _graph, UInt _row) : graph(_graph), row(_row)
+{
+}
+
+inline graphRow * graphRow::operator->()
+{
+    return(this);
+}
+
+inline const graphRow * graphRow::operator->() const
+{
+    return(this);
+}
+
+inline graphRow & graphRow::operator=(const graphItem & G)
+{
+    graph->reserveRow(row, G.getNumConnected());
+    std::copy(G.connected.begin(), G.connected.end(), graph->ids.begin()+graph->offset[row]);
+    graph->count[row] = G.getNumConnected();
+    return(*this);
+}
+
+inline graphRow & graphRow::operator=(const graphRow & G)
+{
+    // the two rows can be in the same storage which can move
+    graphItem tmp = G;
+    return(*this = tmp);
+}
+
+inline graphRow::operator graphItem() const
+{
+    graphItem tmp;
+    tmp.connected.assign(begin(), end());
+    return(tmp);
+}
+
+//
+// Get methods
+//
+inline UInt graphRow::getNumConnected() const
+{
+    return(graph->count[row]);
+}
+
+inline UInt graphRow::getConnectedId(const UInt & i) const
+{
+    assert(i<graph->count[row]);
+    return(graph->ids[graph->offset[row]+i]);
+}
+
+inline const UInt * graphRow::begin() const
+{
+    return(graph->ids.data()+graph->offset[row]);
+}
+
+inline const UInt * graphRow::end() const
+{
+    return(graph->ids.data()+graph->offset[row]+graph->count[row]);
+}
+
+//
+// Set methods
+//
+inline void graphRow::clear()
+{
+    graph->count[row] = 0;
+}
+
+inline void graphRow::setConnectedId(const UInt & i, const UInt & value)
+{
+    assert(i<graph->count[row]);
+    graph->ids[graph->offset[row]+i] = value;
+}
+
+inline void graphRow::setConnectedId(vector<UInt> * ids)
+{
+    graph->reserveRow(row, ids->size());
+    std::copy(ids->begin(), ids->end(), graph->ids.begin()+graph->offset[row]);
+    graph->count[row] = ids->size();
+}
+
+inline void graphRow::connectedPushBack(const UInt & value)
+{
+    graph->reserveRow(row, graph->count[row]+1);
+    graph->ids[graph->offset[row]+graph->count[row]] = value;
+    ++graph->count[row];
+}
+
+inline void graphRow::connectedResize(const UInt & dim)
+{
+    graph->reserveRow(row, dim);
+    for(UInt i=graph->count[row]; i<dim; ++i)	graph->ids[graph->offset[row]+i] = 0;
+    graph->count[row] = dim;
+}
+
+//
+// Methods to add, remove and change
+//
+inline void graphRow::add(UInt value)
+{
+    // same operations of graphItem::add: push, sort and unique
+    connectedPushBack(value);
+
+    UInt * first = graph->ids.data()+graph->offset[row];
+    std::sort(first, first+graph->count[row]);
+    graph->count[row] = std::unique(first, first+graph->count[row])-first;
+}
+
+inline void graphRow::add(vector<UInt> & value)
+{
+    // same operations of graphItem::add: push, sort and unique
+    graph->reserveRow(row, graph->count[row]+value.size());
+
+    UInt * first = graph->ids.data()+graph->offset[row];
+    std::copy(value.begin(), value.end(), first+graph->count[row]);
+    std::sort(first, first+graph->count[row]+value.size());
+    graph->count[row] = std::unique(first, first+graph->count[row]+value.size())-first;
+}
+
+inline void graphRow::remove(UInt value)
+{
+    // same operations of graphItem::remove: sort and erase of the first occurrence
+    UInt * first = graph->ids.data()+graph->offset[row];
+    UInt * last  = first+graph->count[row];
+
+    std::sort(first, last);
+    UInt * it = std::find(first, last, value);
+
+    if(it!=last)
+    {
+	std::copy(it+1, last, it);
+	--graph->count[row];
+    }
+}
+
+inline void graphRow::change(UInt oldValue, UInt newValue)
+{
+    UInt * first = graph->ids.data()+graph->offset[row];
+    std::replace(first, first+graph->count[row], oldValue, newValue);
+}
+
+//
+// Methods to find the common ids
+//
+inline void graphRow::common(vector<UInt> & ext, vector<UInt> * com) const
+{
+    // clean
+    com->clear();
+
+    // the ids of this row which are in ext
+    for(const UInt * it=begin(); it!=end(); ++it)
+	if(std::binary_search(ext.begin(), ext.end(), *it))	com->push_back(*it);
+}
+
+inline void graphRow::common(const graphItem & E, vector<UInt> * com) const
+{
+    vector<UInt> ext(E.connected);
+    std::sort(ext.begin(), ext.end());
+    common(ext, com);
+}
+
+inline void graphRow::common(const graphRow & E, vector<UInt> * com) const
+{
+    vector<UInt> ext(E.begin(), E.end());
+    std::sort(ext.begin(), ext.end());
+    common(ext, com);
+}
+
+//
+// Print
+//
+inline void graphRow::print() const
+{
+    cout << "Numero di connessi: " << getNumConnected() << endl;
+    for(const UInt * it=begin(); it!=end(); ++it)	cout << *it << " ";
+    cout << endl;
+}
+
+//-------------------------------------------------------------------------------------------------------
+// IMPLEMENTATION graphCSR
+//-------------------------------------------------------------------------------------------------------
+
+//
+// Constructor and methods of vector<graphItem>
+//
+inline graphCSR::graphCSR(UInt _slack) : slack(_slack), numHoles(0)
+{
+}
+
+inline UInt graphCSR::size() const
+{
+    return(offset.size());
+}
+
+inline bool graphCSR::empty() const
+{
+    return(offset.empty());
+}
+
+inline void graphCSR::clear()
+{
+    offset.clear();
+    count.clear();
+    capacity.clear();
+    ids.clear();
+    numHoles = 0;
+}
+
+inline void graphCSR::reserve(UInt numRows, UInt numIds)
+{
+    offset.reserve(numRows);
+    count.reserve(numRows);
+    capacity.reserve(numRows);
+    ids.reserve(numIds);
+}
+
+inline void graphCSR::resize(UInt numRows)
+{
+    // the rows removed become holes
+    for(UInt i=numRows; i<offset.size(); ++i)	numHoles += capacity[i];
+
+    // the new rows are empty and take their places at the first push
+    offset.resize(numRows, ids.size());
+    count.resize(numRows, 0);
+    capacity.resize(numRows, 0);
+}
+
+inline void graphCSR::push_back(const graphItem & G)
+{
+    offset.push_back(ids.size());
+    count.push_back(0);
+    capacity.push_back(0);
+
+    at(offset.size()-1) = G;
+}
+
+inline graphRow graphCSR::at(UInt i)
+{
+    assert(i<offset.size());
+    return(graphRow(this, i));
+}
+
+inline graphRow graphCSR::operator[](UInt i)
+{
+    return(graphRow(this, i));
+}
+
+//
+// Methods to manage the storage
+//
+inline void graphCSR::setSlack(UInt _slack)
+{
+    slack = _slack;
+}
+
+inline void graphCSR::assign(const vector<graphItem> & lista)
+{
+    // variables
+    UInt tot=0;
+
+    // count the ids
+    for(UInt i=0; i<lista.size(); ++i)	tot += lista[i].getNumConnected()+slack;
+
+    // fill the rows one after the other
+    clear();
+    reserve(lista.size(), tot);
+    for(UInt i=0; i<lista.size(); ++i)
+    {
+	offset.push_back(ids.size());
+	count.push_back(lista[i].getNumConnected());
+	capacity.push_back(lista[i].getNumConnected()+slack);
+
+	ids.insert(ids.end(), lista[i].connected.begin(), lista[i].connected.end());
+	ids.resize(ids.size()+slack, 0);
+    }
+}
+
+inline void graphCSR::reserveRow(UInt i, UInt n)
+{
+    // there is enough space
+    if(n<=capacity[i])	return;
+
+    // the last row of the storage grows in place
+    if(offset[i]+capacity[i]==ids.size())
+    {
+	capacity[i] = n+slack;
+	ids.resize(offset[i]+capacity[i], 0);
+	return;
+    }
+
+    // too many holes: compact before moving the row
+    if(numHoles>ids.size()/2 && numHoles>1024)	compact();
+    if(n<=capacity[i])	return;
+
+    // move the row at the end
+    UInt newOffset = ids.size();
+    ids.resize(newOffset+n+slack, 0);
+    std::copy(ids.begin()+offset[i], ids.begin()+offset[i]+count[i], ids.begin()+newOffset);
+
+    numHoles   += capacity[i];
+    offset[i]   = newOffset;
+    capacity[i] = n+slack;
+}
+
+inline void graphCSR::compact()
+{
+    // variables
+    UInt	     pos=0;
+    vector<UInt>	tmp;
+
+    // count the places
+    for(UInt i=0; i<offset.size(); ++i)	pos += count[i]+slack;
+    tmp.reserve(pos);
+
+    // copy the rows one after the other
+    for(UInt i=0; i<offset.size(); ++i)
+    {
+	UInt newOffset = tmp.size();
+	tmp.insert(tmp.end(), ids.begin()+offset[i], ids.begin()+offset[i]+count[i]);
+	tmp.resize(tmp.size()+slack, 0);
+
+	offset[i]   = newOffset;
+	capacity[i] = count[i]+slack;
+    }
+
+    ids.swap(tmp);
+    numHoles = 0;
+}
+
+inline UInt graphCSR::getMemory() const
+{
+    return((offset.capacity()+count.capacity()+capacity.capacity()+ids.capacity())*sizeof(UInt));
+}
+
+}
+
+#endif
@@ -584,7 +584,7 @@ bool doctor2d<Triangle>::controlColl(vector<UInt> * edge, point pNew)
       set<UInt>::iterator                             it1;
       vector<UInt>                            common,elem;
       UInt                      		  id1,id2;
-      point                  oldId1,oldId2,nPrima,nDopo,p;
+      point                               nPrima,nDopo;
       bool         			     inv,nullArea;
       
       // controllo che pNew non sia degenere 
@@ -620,16 +620,6 @@ bool doctor2d<Triangle>::controlColl(vector<UInt> * edge, point pNew)
       // bound*   = controlla che collassando non ci siano tre punti che stanno sul bordo 
       // ang      = controllo sull'angolo minimo che si formerà a seguito del collasso 
       
-      // inserisco le coordinate di id1 e id2 in questi due punti
-      // id1 ...
-      oldId1.setX(meshPointer->getNode(id1).getX());
-      oldId1.setY(meshPointer->getNode(id1).getY());
-      oldId1.setZ(meshPointer->getNode(id1).getZ());
-      // ... e id2
-      oldId2.setX(meshPointer->getNode(id2).getX());
-      oldId2.setY(meshPointer->getNode(id2).getY());
-      oldId2.setZ(meshPointer->getNode(id2).getZ());
-      
       // setto queste due variabili vere e poi nel ciclo le aggiorno
       inv  = true;
       
@@ -638,39 +628,19 @@ bool doctor2d<Triangle>::controlColl(vector<UInt> * edge, point pNew)
 	    // calcolo la normale prima del collasso 
 	    nPrima = getTriangleNormal(*it1);
 	    
-	    // sostituisco il punto
-	    // per sicurezza sostituisco sia a id1 ...
-	    meshPointer->getNodePointer(id1)->setX(pNew.getX());
-	    meshPointer->getNodePointer(id1)->setY(pNew.getY());
-	    meshPointer->getNodePointer(id1)->setZ(pNew.getZ());
-	    // ...che a id2, lo so che è sovrabbondante come cosa ma non costa nulla
-	    meshPointer->getNodePointer(id2)->setX(pNew.getX());
-	    meshPointer->getNodePointer(id2)->setY(pNew.getY());
-	    meshPointer->getNodePointer(id2)->setZ(pNew.getZ());
-	    
-	    // calcolo la normale dopo il collasso 
-	    nDopo = getTriangleNormal(*it1);
+	    // calcolo la normale dopo il collasso senza spostare i nodi 
+	    nDopo = getTriangleNormal(*it1, id1, id2, pNew);
 	    
 	    // vedo i due controlli
 	    // 	    inv  = ((nPrima*nDopo)>(sqrt(3.)/2.));
 	    inv  = ((nPrima*nDopo)>0.9);
 	    
 	    // calcolo l'area
-	    area = getTriangleArea(*it1);
+	    area = getTriangleArea(*it1, id1, id2, pNew);
 	    
 	    // controllo l'area 
 	    nullArea = (area<toll);   
 	    
-	    // ripristino le vecchie coordinate
-	    // per sicurezza sostituisco sia a id1 ...
-	    meshPointer->getNodePointer(id1)->setX(oldId1.getX());
-	    meshPointer->getNodePointer(id1)->setY(oldId1.getY());
-	    meshPointer->getNodePointer(id1)->setZ(oldId1.getZ());
-	    // ...che a id2, lo so che è sovrabbondante come cosa ma non costa nulla
-	    meshPointer->getNodePointer(id2)->setX(oldId2.getX());
-	    meshPointer->getNodePointer(id2)->setY(oldId2.getY());
-	    meshPointer->getNodePointer(id2)->setZ(oldId2.getZ());
-	    
 	    // controllo preventivo sull'inversione
 	    if((!inv) || nullArea)		return(false);
       }
@@ -924,6 +894,12 @@ bool doctor2d<Triangle>::controlCollForMetricAda(vector<UInt> * edge, point pNew
 }
 
 void doctor2d<Triangle>::collEdge(vector<UInt> * edge)
+{
+      // collasso sull'ultimo nodo 
+      collEdge(edge, meshPointer->getNumNodes()-1);
+}
+
+void doctor2d<Triangle>::collEdge(vector<UInt> * edge, UInt newId)
 {
       // variabili utilizzate
       bool				bound1,bound2;
@@ -933,16 +909,13 @@ void doctor2d<Triangle>::collEdge(vector<UInt> * edge)
       set<UInt>                                 coinvolti;
       set<UInt>::iterator                          it,it2;
       vector<UInt>            common,elem,newEdge,oldEdge;
-      UInt                              tmp,id1,id2,newId;
+      UInt                                    tmp,id1,id2;
       graphItem				 newNodeToElement;
       
       // setto le variabili per comodità
       id1 = edge->at(0);
       id2 = edge->at(1);
       
-      // setto il nodo
-      newId = meshPointer->getNumNodes()-1;
-      
       // trovo i triangoli adiacenti al lato
       elementOnEdge(id1, id2, &elem);
       
@@ -984,26 +957,25 @@ void doctor2d<Triangle>::collEdge(vector<UInt> * edge)
       for(it=coinvolti.begin(); it!=coinvolti.end(); ++it)	    newNodeToElement.connectedPushBack(*it);
 		
       // creo le connessioni nodo-elemento del nuovo punto
-      conn.getNodeToElementPointer()->push_back(newNodeToElement);
+      if(conn.getNodeToElementPointer()->size()>newId)	conn.getNodeToElementPointer()->at(newId) = newNodeToElement;
+      else						conn.getNodeToElementPointer()->push_back(newNodeToElement);
 		    
-      // sistemo le connessioni di nodi dei triangoli coinvolti
-      for(UInt s=0; s<2; ++s)
+      // sistemo le connessioni di nodi dei triangoli coinvolti, i triangoli eliminati sono già degeneri e 
+      // si scorrono solo i coinvolti perché newId può anche essere uno dei due estremi
+      for(it=coinvolti.begin(); it!=coinvolti.end(); ++it)
       {
-	    for(UInt j=0; j<conn.getNodeToElementPointer(edge->at(s))->getNumConnected(); ++j)
-	    {
-		// prendo in esame un triangolo della stellata dell'estremo
-		tmp = conn.getNodeToElementPointer(edge->at(s))->getConnectedId(j);
+	    // prendo in esame un triangolo della stellata degli estremi
+	    tmp = *it;
 				      
-		// metto il nuovo id agli elementi coinvolti
-		for(UInt t=0; t<3; ++t)
-		      for(UInt k=0; k<elem.size(); ++k)
+	    // tolgo gli elementi eliminati dai nodi del triangolo
+	    for(UInt t=0; t<3; ++t)
+		  for(UInt k=0; k<elem.size(); ++k)
 			conn.getNodeToElementPointer(meshPointer->getElement(tmp).getConnectedId(t))->remove(elem[k]);
-	    }
       }
 		    
-      // setto a null le coordinate dei nodi appartenenti al segmento collassato
-      setNodeDegenerate(id1);		
-      setNodeDegenerate(id2); 
+      // setto a null le coordinate dei nodi appartenenti al segmento collassato tranne quello riusato 
+      if(id1!=newId)	setNodeDegenerate(id1);		
+      if(id2!=newId)	setNodeDegenerate(id2); 
       
       // se è di bordo devo fare delle modifiche 
       if(bound1>0 || bound2>0)
@@ -1055,6 +1027,21 @@ void doctor2d<Triangle>::collEdge(vector<UInt> * edge)
       }      
 }
 
+void doctor2d<Triangle>::collEdgeInPlace(vector<UInt> * edge, UInt keepId, point pNew)
+{
+      // controllo che keepId sia un estremo 
+      assert(keepId==edge->at(0) || keepId==edge->at(1));
+      
+      // sposto il nodo riusato mantenendo il suo id
+      meshPointer->getNodePointer(keepId)->setX(pNew.getX());
+      meshPointer->getNodePointer(keepId)->setY(pNew.getY());
+      meshPointer->getNodePointer(keepId)->setZ(pNew.getZ());
+      meshPointer->getNodePointer(keepId)->setBoundary(pNew.getBoundary());
+      
+      // collasso sul nodo riusato
+      collEdge(edge, keepId);
+}
+
 bool doctor2d<Triangle>::removeNode(UInt nodeId)
 {
     // Questo metodo permette di eliminare un nodo dalla triangolazione. Viene fatto attraverso il collasso di un edge connesso 
@@ -23,6 +23,14 @@ namespace geometry
 
 using namespace std;
 
+/*! Gestione della memoria durante i processi di collasso:
+    <ol>
+    <li> APPENDNODE ogni collasso aggiunge il nuovo nodo in fondo alla mesh e tutto viene compattato dal refresh finale;
+    <li> REUSENODE ogni collasso riusa il posto di uno degli estremi (collEdgeInPlace) e la mesh viene compattata 
+	 periodicamente quando i nodi morti superano quelli vivi, così la memoria resta proporzionale alla mesh viva.
+    </ol> */
+enum collapseMemory {APPENDNODE=0, REUSENODE=1};
+
 /*! Classe che permette di utilizzare le principali operazioni di modifica della mesh*/
 
 template<typename GEOSHAPE> class doctor2d : public tricky2d<GEOSHAPE>
@@ -135,6 +143,22 @@ template<> class doctor2d<Triangle> : public tricky2d<Triangle>
 		     N.B. per comodità le connettività vengono messe a posto con il nodo in fondo alla lista dei nodi della mesh*/
 		void collEdge(vector<UInt> * edge);
 		
+		/*! Metodo che effettua il collasso di un edge su un nodo già inserito nella mesh 
+		     \param edge puntatore a un vettore che contiene le informazioni dell'edge 
+		     \param newId identificatore del nodo in cui si collassa l'edge 
+		     N.B. se la connettività nodo-elemento ha già il posto per newId viene sovrascritta, altrimenti viene 
+			  aggiunta in fondo. Collassi di edge con stellate disgiunte e non di bordo possono essere fatti in 
+			  parallelo se i nodi e i loro posti nella connettività sono stati creati prima */
+		void collEdge(vector<UInt> * edge, UInt newId);
+		
+		/*! Metodo che effettua il collasso di un edge riusando il posto di uno dei due estremi, senza aggiungere 
+		    nodi alla mesh e senza allungare la connettività nodo-elemento
+		     \param edge puntatore a un vettore che contiene le informazioni dell'edge 
+		     \param keepId estremo dell'edge che viene riusato 
+		     \param pNew coordinate del nuovo punto 
+		     N.B. il nodo keepId prende le coordinate e la flag di bordo di pNew, l'altro estremo diventa degenere */
+		void collEdgeInPlace(vector<UInt> * edge, UInt keepId, point pNew);
+		
 		/*! Metodo che serve per eliminare un punto della griglia. 
 		    \param nodeId identificatore del nodo */
 		bool removeNode(UInt nodeId);
@@ -0,0 +1,118 @@
+#include "binaryMesh.h"
+
+using namespace geometry;
+
+const char binaryMesh::magic[8] = {'M', 'E', 'S', 'H', 'B', 'I', 'N', '\0'};
+const uint32_t binaryMesh::versione;
+
+//
+// Costruttori
+//
+binaryMesh::binaryMesh()
+{
+      memset(&intestazione, 0, sizeof(intestazione));
+      posNodi = posConn = posGeo = posProp = 0;
+}
+
+bool binaryMesh::open(string s)
+{
+      // variabili in uso
+      size_t	pos[5];
+
+      close();
+
+      if(!mappa.open(s))
+      {
+	    cout << "ERRORE: file " << s << " non trovato" << endl;
+	    return(false);
+      }
+
+      // intestazione
+      if(mappa.size()<sizeof(binaryMeshHeader))
+      {
+	    cout << "ERRORE: il file " << s << " non è una mesh binaria" << endl;
+	    close();
+	    return(false);
+      }
+      memcpy(&intestazione, mappa.begin(), sizeof(binaryMeshHeader));
+
+      if(memcmp(intestazione.magic, magic, sizeof(magic))!=0 || intestazione.versione!=versione)
+      {
+	    cout << "ERRORE: il file " << s << " non è una mesh binaria" << endl;
+	    close();
+	    return(false);
+      }
+
+      if(intestazione.ordine!=0x01020304)
+      {
+	    cout << "ERRORE: il file " << s << " è stato scritto con un ordine dei byte diverso" << endl;
+	    close();
+	    return(false);
+      }
+
+      // i numeri dell'intestazione devono stare in UInt e i blocchi nel file, così le somme di layout non vanno in 
+      // overflow: le proprietà sono controllate con una divisione perché numProp*numNode può superare 64 bit
+      if(intestazione.numNode>numeric_limits<UInt>::max() || intestazione.numElem>numeric_limits<UInt>::max() ||
+	 intestazione.numVertex<1 || intestazione.numVertex>4 ||
+	 intestazione.numProp>mappa.size()/(sizeof(double)*max(intestazione.numNode, static_cast<uint64_t>(1))))
+      {
+	    cout << "ERRORE: l'intestazione del file " << s << " non è valida" << endl;
+	    close();
+	    return(false);
+      }
+      
+      // dimensione
+      layout(intestazione, pos);
+      if(mappa.size()!=pos[4])
+      {
+	    cout << "ERRORE: la dimensione del file " << s << " non corrisponde all'intestazione" << endl;
+	    close();
+	    return(false);
+      }
+
+      posNodi = pos[0];
+      posConn = pos[1];
+      posGeo  = pos[2];
+      posProp = pos[3];
+
+      return(true);
+}
+
+void binaryMesh::close()
+{
+      mappa.close();
+      memset(&intestazione, 0, sizeof(intestazione));
+      posNodi = posConn = posGeo = posProp = 0;
+}
+
+//
+// Formato
+//
+binaryMeshHeader binaryMesh::createHeader(UInt numVertex, UInt numProp, UInt numNode, UInt numElem)
+{
+      // variabili in uso
+      binaryMeshHeader	h;
+
+      memset(&h, 0, sizeof(h));
+      memcpy(h.magic, magic, sizeof(magic));
+      h.versione  = versione;
+      h.ordine    = 0x01020304;
+      h.numVertex = numVertex;
+      h.numProp   = numProp;
+      h.numNode   = numNode;
+      h.numElem   = numElem;
+
+      return(h);
+}
+
+void binaryMesh::layout(const binaryMeshHeader & h, size_t * pos)
+{
+      pos[0] = sizeof(binaryMeshHeader);
+      pos[1] = pos[0] + 3*sizeof(double)*h.numNode;
+      pos[2] = pos[1] + sizeof(uint32_t)*h.numVertex*h.numElem;
+      pos[3] = pos[2] + sizeof(uint32_t)*h.numElem;
+
+      // le proprietà partono da un multiplo di 8 byte
+      pos[3] = (pos[3]+7) & ~static_cast<size_t>(7);
+      pos[4] = pos[3] + sizeof(double)*h.numProp*h.numNode;
+}
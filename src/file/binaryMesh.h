@@ -0,0 +1,144 @@
+#ifndef BINARYMESH_H_
+#define BINARYMESH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../core/shapes.hpp"
+
+#include "../file/mappedFile.h"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Intestazione del formato binario delle mesh. Il file è fatto da:
+    <ol>
+    <li> l'intestazione;
+    <li> le coordinate dei nodi, 3 double per nodo;
+    <li> la connettività, numVertex interi a 32 bit per elemento partendo da 0;
+    <li> i geoId, un intero a 32 bit per elemento;
+    <li> numProp proprietà dei nodi, un double per nodo, che partono da un multiplo di 8 byte.
+    </ol>
+    I numeri sono scritti nell'ordine dei byte della macchina, il campo ordine serve a riconoscere un file scritto
+    con l'ordine opposto. */
+struct binaryMeshHeader
+{
+      /*! Identificatore del formato */
+      char				magic[8];
+
+      /*! Versione del formato */
+      uint32_t				versione;
+
+      /*! Vale 0x01020304 nell'ordine dei byte di chi ha scritto il file */
+      uint32_t				  ordine;
+
+      /*! Numero di nodi per elemento */
+      uint32_t			       numVertex;
+
+      /*! Numero di proprietà dei nodi */
+      uint32_t				 numProp;
+
+      /*! Numero di nodi */
+      uint64_t				 numNode;
+
+      /*! Numero di elementi */
+      uint64_t				 numElem;
+};
+
+/*! Classe che apre un file binario di mesh mappandolo in memoria e ne espone i blocchi senza leggerli: i puntatori
+    restituiti puntano direttamente ai byte del file e restano validi fino a close. */
+
+class binaryMesh
+{
+      //
+      // Variabili di classe
+      //
+      public:
+		  /*! File mappato */
+		  mappedFile				mappa;
+
+		  /*! Intestazione */
+		  binaryMeshHeader		  intestazione;
+
+		  /*! Posizione dei blocchi nel file */
+		  size_t		  posNodi,posConn,posGeo,posProp;
+
+		  /*! Identificatore del formato */
+		  static const char			magic[8];
+
+		  /*! Versione del formato */
+		  static const uint32_t		      versione = 1;
+      //
+      // Costruttori
+      //
+      public:
+		  /*! Costruttore */
+		  binaryMesh();
+
+		  /*! Metodo che apre il file e controlla l'intestazione e la dimensione. Il numero di nodi e di elementi deve
+		      stare in un UInt, gli elementi devono avere da 1 a 4 nodi e le proprietà devono stare nel file
+		      \param s nome del file
+		      \return falso se il file non si apre o non è valido */
+		  bool open(string s);
+
+		  /*! Metodo che chiude il file */
+		  void close();
+      //
+      // Informazioni e blocchi
+      //
+      public:
+		  /*! Numero di nodi */
+		  inline UInt getNumNodes() const		{return(intestazione.numNode);};
+
+		  /*! Numero di elementi */
+		  inline UInt getNumElements() const		{return(intestazione.numElem);};
+
+		  /*! Numero di nodi per elemento */
+		  inline UInt getNumVertices() const		{return(intestazione.numVertex);};
+
+		  /*! Numero di proprietà dei nodi */
+		  inline UInt getNumProperties() const		{return(intestazione.numProp);};
+
+		  /*! Coordinate dei nodi, x y z per ogni nodo */
+		  inline const double * getNodes() const
+		  {return(reinterpret_cast<const double *>(mappa.begin()+posNodi));};
+
+		  /*! Connettività, getNumVertices() identificatori per ogni elemento */
+		  inline const uint32_t * getConnectivity() const
+		  {return(reinterpret_cast<const uint32_t *>(mappa.begin()+posConn));};
+
+		  /*! geoId degli elementi */
+		  inline const uint32_t * getGeoIds() const
+		  {return(reinterpret_cast<const uint32_t *>(mappa.begin()+posGeo));};
+
+		  /*! Proprietà dei nodi
+		      \param k indice della proprietà */
+		  inline const double * getProperty(UInt k) const
+		  {return(reinterpret_cast<const double *>(mappa.begin()+posProp)+static_cast<size_t>(k)*getNumNodes());};
+      //
+      // Formato
+      //
+      public:
+		  /*! Metodo che crea l'intestazione
+		      \param numVertex numero di nodi per elemento
+		      \param numProp numero di proprietà dei nodi
+		      \param numNode numero di nodi
+		      \param numElem numero di elementi */
+		  static binaryMeshHeader createHeader(UInt numVertex, UInt numProp, UInt numNode, UInt numElem);
+
+		  /*! Metodo che calcola la posizione dei blocchi
+		      \param h intestazione
+		      \param pos vettore con le posizioni di nodi, connettività, geoId, proprietà e la fine del file */
+		  static void layout(const binaryMeshHeader & h, size_t * pos);
+};
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "bufferedWriter.h"
+
+using namespace geometry;
+
+//
+// Costruttori
+//
+bufferedWriter::bufferedWriter(size_t _capacita)
+{
+      capacita   = _capacita;
+      numThreads = 0;
+      buffer.reserve(capacita + (1<<16));
+}
+
+bufferedWriter::~bufferedWriter()
+{
+      close();
+}
+
+bool bufferedWriter::open(string s)
+{
+      close();
+      file.open(s.c_str(), ios::binary);
+
+      return(file.is_open());
+}
+
+void bufferedWriter::flush()
+{
+      if(file.is_open() && !buffer.empty())	file.write(buffer.data(), buffer.size());
+      buffer.clear();
+}
+
+void bufferedWriter::close()
+{
+      flush();
+      if(file.is_open())	file.close();
+}
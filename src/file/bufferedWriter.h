@@ -0,0 +1,204 @@
+#ifndef BUFFEREDWRITER_H_
+#define BUFFEREDWRITER_H_
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "../core/shapes.hpp"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Classe che scrive un file di testo passando da un buffer grande: i numeri sono formattati a mano nel buffer, che
+    viene scritto sul file solo quando è pieno o alla chiusura (non ci sono flush a ogni riga come con endl).
+
+    I reali sono scritti con il formato più corto fra %.15g, %.16g e %.17g che, riletto, dà lo stesso double, quindi
+    un file scritto e riletto restituisce esattamente gli stessi numeri. I blocchi di record (nodi, elementi,
+    proprietà) possono essere formattati in parallelo con writeBlock: ogni thread scrive dei pezzi consecutivi in
+    buffer suoi che sono poi copiati in ordine, quindi il file non dipende dal numero di thread. */
+
+class bufferedWriter
+{
+      //
+      // Variabili di classe
+      //
+      public:
+		  /*! File */
+		  ofstream					file;
+
+		  /*! Buffer */
+		  string				      buffer;
+
+		  /*! Dimensione oltre la quale il buffer viene scritto */
+		  size_t				   capacita;
+
+		  /*! Numero di thread, se è 0 si usa quello di default di OpenMP */
+		  UInt					 numThreads;
+      //
+      // Costruttori
+      //
+      public:
+		  /*! Costruttore
+		      \param _capacita dimensione del buffer */
+		  bufferedWriter(size_t _capacita = static_cast<size_t>(1)<<22);
+
+		  /*! Distruttore, scrive quello che resta e chiude il file */
+		  ~bufferedWriter();
+
+		  /*! Metodo che apre il file
+		      \param s nome del file
+		      \return falso se il file non si apre */
+		  bool open(string s);
+
+		  /*! Metodo che scrive il buffer sul file */
+		  void flush();
+
+		  /*! Metodo che scrive il buffer e chiude il file */
+		  void close();
+
+		  /*! set e get del numero di thread
+		      \param _numThreads numero di thread, se è 0 si usa quello di default di OpenMP */
+		  inline void setNumThreads(UInt _numThreads)	{numThreads = _numThreads;};
+		  inline UInt getNumThreads()			{return(numThreads);};
+      //
+      // Scrittura
+      //
+      public:
+		  /*! Metodo che aggiunge una stringa
+		      \param s stringa */
+		  inline void write(const string & s)		{buffer += s;	check();};
+
+		  /*! Metodo che aggiunge un intero
+		      \param v intero */
+		  inline void writeUInt(UInt v)			{appendUInt(buffer, v);	check();};
+
+		  /*! Metodo che aggiunge un reale
+		      \param v reale */
+		  inline void writeReal(Real v)			{appendReal(buffer, v);	check();};
+
+		  /*! Metodo che scrive n record formattati da f, eventualmente in parallelo
+		      \param n numero di record
+		      \param f funzione f(i, buf) che aggiunge a buf il record i, deve poter essere chiamata da più thread */
+		  template<typename FUNC> void writeBlock(UInt n, FUNC f);
+
+		  /*! Metodo che aggiunge un intero in fondo a una stringa
+		      \param buf stringa
+		      \param v intero */
+		  static inline void appendUInt(string & buf, UInt v);
+
+		  /*! Metodo che aggiunge un reale in fondo a una stringa con il formato più corto che si rilegge esatto
+		      \param buf stringa
+		      \param v reale */
+		  static inline void appendReal(string & buf, Real v);
+      //
+      // Metodi interni
+      //
+      protected:
+		  /*! Metodo che scrive il buffer se ha superato la capacità */
+		  inline void check()				{if(buffer.size()>=capacita)	flush();};
+};
+
+//
+// Scrittura
+//
+inline void bufferedWriter::appendUInt(string & buf, UInt v)
+{
+      // variabili in uso
+      char	cifre[16];
+      int	    n=0;
+
+      do
+      {
+	    cifre[n++] = '0' + v%10;
+	    v /= 10;
+      }
+      while(v>0);
+
+      while(n>0)	buf += cifre[--n];
+}
+
+inline void bufferedWriter::appendReal(string & buf, Real v)
+{
+      // variabili in uso
+      char	tmp[32];
+      int	      n=0;
+
+      // gli interi che stanno in un UInt si scrivono come interi, è quello che fa anche %g
+      if(v==floor(v) && fabs(v)<4294967296.0 && !(v==0.0 && signbit(v)))
+      {
+	    if(v<0.0)	buf += '-';
+	    appendUInt(buf, static_cast<UInt>(fabs(v)));
+	    return;
+      }
+
+      for(int p=15; p<=17; ++p)
+      {
+	    n = snprintf(tmp, sizeof(tmp), "%.*g", p, v);
+	    if(p==17 || strtod(tmp, NULL)==v)	break;
+      }
+
+      buf.append(tmp, n);
+}
+
+template<typename FUNC>
+void bufferedWriter::writeBlock(UInt n, FUNC f)
+{
+      // variabili in uso
+      UInt					numChunk;
+      UInt			 perChunk = 1<<14;
+      vector<string>				   parti;
+
+#ifdef _OPENMP
+      int numTh = (numThreads>0) ? numThreads : omp_get_max_threads();
+#else
+      int numTh = 1;
+#endif
+
+      // su un thread si scrive direttamente nel buffer
+      if(numTh<=1 || n<=perChunk)
+      {
+	    for(UInt i=0; i<n; ++i)
+	    {
+		  f(i, buffer);
+		  check();
+	    }
+	    return;
+      }
+
+      // a turni di 4 pezzi per thread, così la memoria usata resta limitata
+      numChunk = 4*numTh;
+      parti.resize(numChunk);
+      for(UInt a=0; a<n; a+=numChunk*perChunk)
+      {
+	    #pragma omp parallel for num_threads(numTh) schedule(dynamic,1)
+	    for(UInt k=0; k<numChunk; ++k)
+	    {
+		  UInt inizio = a + k*perChunk;
+		  UInt fine   = min(n, inizio+perChunk);
+
+		  parti[k].clear();
+		  for(UInt i=inizio; i<fine; ++i)	f(i, parti[k]);
+	    }
+
+	    for(UInt k=0; k<numChunk; ++k)
+	    {
+		  buffer += parti[k];
+		  check();
+	    }
+      }
+}
+
+}
+
+#endif
@@ -8,7 +8,8 @@ using namespace geometry;
 
 createFile::createFile()
 {
-      toll = 1e-07;
+      toll       = 1e-07;
+      numThreads = 0;
 }
 
 //
@@ -24,6 +25,91 @@ void createFile::setToll(Real _toll)
 {
       toll = _toll;
 }
+
+//
+// get e set del numero di thread
+//
+
+UInt createFile::getNumThreads()
+{
+      return(numThreads);
+}
+
+void createFile::setNumThreads(UInt _numThreads)
+{
+      numThreads = _numThreads;
+}
+
+//
+// Metodi che scrivono i blocchi dei file per Paraview
+//
+
+template<typename MESH>
+void createFile::writeParaviewMesh(bufferedWriter & out, MESH * mesh, string tipo, string sep, UInt numNodeProp, 
+				   UInt numElemProp)
+{
+	// variabili in uso
+	typedef decltype(mesh->getElement(0))			ELEMENT;
+	UInt				      numVertex = ELEMENT::numVertex;
+	
+	// intestazione
+	out.writeUInt(mesh->getNumNodes());	out.write(" ");
+	out.writeUInt(mesh->getNumElements());	out.write(" ");
+	out.writeUInt(numNodeProp);		out.write(" ");
+	out.writeUInt(numElemProp);		out.write(" 0\n");
+	
+	// nodi 
+	out.writeBlock(mesh->getNumNodes(), [&](UInt i, string & buf)
+	{
+		const point * p = mesh->getNodePointer(i);
+		
+		bufferedWriter::appendUInt(buf, i+1);	buf += ' ';
+		bufferedWriter::appendReal(buf, p->getX());	buf += ' ';
+		bufferedWriter::appendReal(buf, p->getY());	buf += ' ';
+		bufferedWriter::appendReal(buf, p->getZ());	buf += '\n';
+	});
+	
+	// elementi 
+	out.writeBlock(mesh->getNumElements(), [&](UInt i, string & buf)
+	{
+		const ELEMENT * e = mesh->getElementPointer(i);
+		
+		bufferedWriter::appendUInt(buf, i+1);		buf += ' ';
+		bufferedWriter::appendUInt(buf, e->getGeoId());	buf += sep;
+		buf += tipo;
+		for(UInt j=0; j<numVertex; ++j)
+		{
+			buf += (j==0) ? " " : sep;
+			bufferedWriter::appendUInt(buf, e->getConnectedId(j)+1);
+		}
+		buf += '\n';
+	});
+}
+
+void createFile::writeParaviewProperty(bufferedWriter & out, vector<Real> * prop, string nome)
+{
+	out.write("1 1\n" + nome + "\n");
+	out.writeBlock(prop->size(), [&](UInt i, string & buf)
+	{
+		bufferedWriter::appendUInt(buf, i+1);	buf += "  ";
+		bufferedWriter::appendReal(buf, prop->at(i));	buf += '\n';
+	});
+}
+
+void createFile::writeParaviewProperty(bufferedWriter & out, vector<point> * prop, string nome)
+{
+	out.write("1 3\n" + nome + "\n");
+	out.writeBlock(prop->size(), [&](UInt i, string & buf)
+	{
+		bufferedWriter::appendUInt(buf, i+1);
+		for(UInt j=0; j<3; ++j)
+		{
+			buf += "  ";
+			bufferedWriter::appendReal(buf, prop->at(i).getI(j));
+		}
+		buf += '\n';
+	});
+}
 	  
 //
 // Metodi per creare i file per Paraview
@@ -69,114 +155,37 @@ void createFile::fileForParaview(string s, mesh0d<simplePoint> * mesh)
 // ------------------------------
 void createFile::fileForParaview(string s, mesh1d<Line> * mesh)
 {
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 0 0 0" << endl;
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}	
-	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "line ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << endl;
-	}
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
+	writeParaviewMesh(out, mesh, "line", "  ", 0, 0);
+
 	out.close();
 }
 
 void createFile::fileForParaviewNodePropriety(string s, mesh1d<Line> * mesh, vector<Real> * prop)
 {
-	// creo il file
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 1 0 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "line ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 <<endl;
-	}
+	writeParaviewMesh(out, mesh, "line", "  ", 1, 0);
 	
 	// prorpietà
-	out << "1 1" << endl;
-	out << "none, adim" << endl;
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << "  " << prop->at(i) << endl;
-	}
+	writeParaviewProperty(out, prop, "none, adim");
 } 
 
 void createFile::fileForParaviewElementPropriety(string s, mesh1d<Line> * mesh, vector<Real>  * prop)
-{	
-	// creo il file
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 0 1 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}	
+{
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "line ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 <<endl;
-	}
+	writeParaviewMesh(out, mesh, "line", "  ", 0, 1);
 	
 	// prorpietà
-	out << "1 1" << endl;
-	out << "prop, null" << endl;
-	for(UInt i=0; i<mesh->getNumElements(); ++i)	out << i+1 << "  " << prop->at(i) << endl;
-	
+	writeParaviewProperty(out, prop, "prop, null");
 }
 
 // ------------------------------
@@ -184,37 +193,11 @@ void createFile::fileForParaviewElementPropriety(string s, mesh1d<Line> * mesh,
 // ------------------------------
 void createFile::fileForParaview(string s, mesh2d<Triangle> * mesh)
 {
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 0 0 0" << endl;	
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	out.precision(16);
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-		
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}	
-	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << " ";
-		out << "tri ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << " ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << " ";
-		out << (mesh->getElement(i)).getConnectedId(2)+1 << endl;
-	}
+	writeParaviewMesh(out, mesh, "tri", " ", 0, 0);
 }
 
 void createFile::fileForParaview(string s, mesh2d<Quad> * mesh)
@@ -255,127 +238,38 @@ void createFile::fileForParaview(string s, mesh2d<Quad> * mesh)
 
 void createFile::fileForParaviewNodePropriety(string s, mesh2d<Triangle> * mesh, vector<Real> * prop)
 {
-	// creo il file
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 1 0 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-		
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-  
-	}
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "tri ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(2)+1 << endl;
-	}
+	writeParaviewMesh(out, mesh, "tri", "  ", 1, 0);
 	
 	// prorpietà
-	out << "1 1" << endl;
-	out << "none, adim" << endl;
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << "  " << prop->at(i) << endl;
-	}
+	writeParaviewProperty(out, prop, "none, adim");
 } 
 
 void createFile::fileForParaviewElementPropriety(string s, mesh2d<Triangle> * mesh, vector<Real>  * prop)
-{	
-	// creo il file
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 0 1 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}	
+{
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "tri ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(2)+1 << endl;
-	}
+	writeParaviewMesh(out, mesh, "tri", "  ", 0, 1);
 	
 	// prorpietà
-	out << "1 1" << endl;
-	out << "prop, null" << endl;
-	for(UInt i=0; i<mesh->getNumElements(); ++i)	out << i+1 << "  " << prop->at(i) << endl;
-	
+	writeParaviewProperty(out, prop, "prop, null");
 }
 
 void createFile::fileForParaviewNodePropriety(string s, mesh2d<Triangle> * mesh, vector<point> * prop)
 {
-	// creo il file
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 3 0 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "tri ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(2)+1 << endl;
-	}
+	writeParaviewMesh(out, mesh, "tri", "  ", 3, 0);
 	
 	// prorpietà
-	out << "1 3" << endl;
-	out << "none, adim" << endl;
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << "  " << prop->at(i).getX() << "  " << prop->at(i).getY() << "  " << prop->at(i).getZ() << endl;
-	}
+	writeParaviewProperty(out, prop, "none, adim");
 }
 
 // ------------------------------
@@ -384,36 +278,11 @@ void createFile::fileForParaviewNodePropriety(string s, mesh2d<Triangle> * mesh,
 
 void createFile::fileForParaview(string s, mesh3d<Tetra> * mesh)
 {
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 0 0 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}	
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "tet ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(2)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(3)+1 <<endl;
-	}
+	writeParaviewMesh(out, mesh, "tet", "  ", 0, 0);
 }
 
 void createFile::fileForParaview(string s, mesh3d<Hexa> * mesh)
@@ -456,88 +325,26 @@ void createFile::fileForParaview(string s, mesh3d<Hexa> * mesh)
 
 void createFile::fileForParaviewNodePropriety(string s, mesh3d<Tetra> * mesh, vector<point> * prop)
 {
-	// creo il file
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 3 0 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "tet ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(2)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(3)+1 << endl;
-	}
+	writeParaviewMesh(out, mesh, "tet", "  ", 3, 0);
 	
 	// prorpietà
-	out << "1 3" << endl;
-	out << "none, adim" << endl;
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << "  " << prop->at(i).getX() << "  " << prop->at(i).getY() << "  " << prop->at(i).getZ() << endl;
-	}
+	writeParaviewProperty(out, prop, "none, adim");
 }
 
 void createFile::fileForParaviewNodePropriety(string s, mesh3d<Tetra> * mesh, vector<Real> * prop)
 {
-	// creo il file
-	ofstream out(s.c_str());
-		
-	out << mesh->getNumNodes() << " " << mesh->getNumElements() << " 1 0 0" << endl;	
-
-	// N.B. il fattore 1.00001 è stato introdotto per far funzionare meglio paraview
-	//      per il problema dei boundingbox
-
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getX() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getY() << " ";
-// 		out << (1.00001)*(mesh->getNode(i)).getZ() << endl;
-
-		out << (mesh->getNode(i)).getX() << " ";
-		out << (mesh->getNode(i)).getY() << " ";
-		out << (mesh->getNode(i)).getZ() << endl;
-	}
+	bufferedWriter out;
+	out.setNumThreads(numThreads);
+	out.open(s);
 	
-	// passo alle facce
-	for(UInt i=0; i<mesh->getNumElements(); ++i)
-	{
-		out << i+1 << " ";
-		out << (mesh->getElement(i)).getGeoId() << "  ";
-		out << "tet ";
-		out << (mesh->getElement(i)).getConnectedId(0)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(1)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(2)+1 << "  ";
-		out << (mesh->getElement(i)).getConnectedId(3)+1 << endl;
-	}
+	writeParaviewMesh(out, mesh, "tet", "  ", 1, 0);
 	
 	// prorpietà
-	out << "1 1" << endl;
-	out << "none, adim" << endl;
-	for(UInt i=0; i<mesh->getNumNodes(); ++i)
-	{
-		out << i+1 << "  " << prop->at(i) << endl;
-	}
+	writeParaviewProperty(out, prop, "none, adim");
 } 
 
 //
@@ -587,6 +394,157 @@ void createFile::fileForMedit(string s, mesh3d<Tetra> * mesh, mesh2d<Triangle> *
 
 }
 
+//
+// file binari
+//
+void createFile::fileForBinary(string s, mesh1d<Line> * mesh, vector<vector<Real> > * prop)
+{
+	fileForBinaryMesh(s, mesh, prop);
+}
+
+void createFile::fileForBinary(string s, mesh2d<Triangle> * mesh, vector<vector<Real> > * prop)
+{
+	fileForBinaryMesh(s, mesh, prop);
+}
+
+void createFile::fileForBinary(string s, mesh3d<Tetra> * mesh, vector<vector<Real> > * prop)
+{
+	fileForBinaryMesh(s, mesh, prop);
+}
+
+template<typename MESH> 
+void createFile::fileForBinaryMesh(string s, MESH * mesh, vector<vector<Real> > * prop)
+{
+	// variabili in uso
+	typedef decltype(mesh->getElement(0))				ELEMENT;
+	UInt					      numVertex = ELEMENT::numVertex;
+	UInt			  numProp = (prop!=NULL) ? prop->size() : 0;
+	binaryMeshHeader		h = binaryMesh::createHeader(numVertex, numProp, mesh->getNumNodes(), mesh->getNumElements());
+	size_t						       pos[5];
+	vector<double>					      nodi;
+	vector<uint32_t>				       conn;
+	const char				    zero[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+	
+	// controllo le proprietà
+	for(UInt k=0; k<numProp; ++k)	assert(prop->at(k).size()==mesh->getNumNodes());
+	
+	ofstream out(s.c_str(), ios::binary);
+	binaryMesh::layout(h, pos);
+	out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+	
+	// nodi 
+	nodi.resize(3*mesh->getNumNodes());
+	for(UInt i=0; i<mesh->getNumNodes(); ++i)
+	    for(UInt j=0; j<3; ++j)	nodi[3*i+j] = mesh->getNodePointer(i)->getI(j);
+	if(!nodi.empty())	out.write(reinterpret_cast<const char *>(&nodi[0]), nodi.size()*sizeof(double));
+	
+	// connettività e geoId 
+	conn.resize(numVertex*mesh->getNumElements());
+	for(UInt i=0; i<mesh->getNumElements(); ++i)
+	{
+	    assert(mesh->getElementPointer(i)->getNumConnected()==numVertex);
+	    for(UInt j=0; j<numVertex; ++j)	conn[numVertex*i+j] = mesh->getElementPointer(i)->getConnectedId(j);
+	}
+	if(!conn.empty())	out.write(reinterpret_cast<const char *>(&conn[0]), conn.size()*sizeof(uint32_t));
+	
+	conn.resize(mesh->getNumElements());
+	for(UInt i=0; i<mesh->getNumElements(); ++i)	conn[i] = mesh->getElementPointer(i)->getGeoId();
+	if(!conn.empty())	out.write(reinterpret_cast<const char *>(&conn[0]), conn.size()*sizeof(uint32_t));
+	
+	// proprietà allineate a 8 byte 
+	out.write(zero, pos[3]-static_cast<size_t>(out.tellp()));
+	for(UInt k=0; k<numProp; ++k)
+	{
+	    nodi.assign(prop->at(k).begin(), prop->at(k).end());
+	    if(!nodi.empty())	out.write(reinterpret_cast<const char *>(&nodi[0]), nodi.size()*sizeof(double));
+	}
+	
+	out.close();
+}
+
+//
+// file PLY
+//
+void createFile::fileForPly(string s, mesh2d<Triangle> * mesh, bool binario, vector<vector<Real> > * prop, vector<string> * nomi)
+{
+	// variabili in uso
+	UInt			  numProp = (prop!=NULL) ? prop->size() : 0;
+	bufferedWriter						   out;
+	ostringstream						  head;
+	
+	// controllo le proprietà
+	for(UInt k=0; k<numProp; ++k)	assert(prop->at(k).size()==mesh->getNumNodes());
+	assert(!binario || plyFormat::isLittleEndian());
+	
+	if(!out.open(s))
+	{
+	    cout << "ERRORE: non riesco a scrivere il file " << s << endl;
+	    return;
+	}
+	out.setNumThreads(numThreads);
+	
+	// intestazione 
+	head << "ply\n";
+	head << "format " << (binario ? "binary_little_endian" : "ascii") << " 1.0\n";
+	head << "element vertex " << mesh->getNumNodes() << "\n";
+	head << "property double x\nproperty double y\nproperty double z\n";
+	for(UInt k=0; k<numProp; ++k)
+	{
+	    if(nomi!=NULL && k<nomi->size())	head << "property double " << nomi->at(k) << "\n";
+	    else				head << "property double prop" << k << "\n";
+	}
+	head << "element face " << mesh->getNumElements() << "\n";
+	head << "property list uchar int vertex_indices\n";
+	head << "property int geoId\n";
+	head << "end_header\n";
+	out.write(head.str());
+	
+	// nodi 
+	out.writeBlock(mesh->getNumNodes(), [&](UInt i, string & buf)
+	{
+		for(UInt j=0; j<3+numProp; ++j)
+		{
+			double v = (j<3) ? mesh->getNodePointer(i)->getI(j) : prop->at(j-3)[i];
+			if(binario)
+			{
+				buf.append(reinterpret_cast<const char *>(&v), sizeof(double));
+			}
+			else
+			{
+				if(j>0)	buf += ' ';
+				bufferedWriter::appendReal(buf, v);
+			}
+		}
+		if(!binario)	buf += '\n';
+	});
+	
+	// facce 
+	out.writeBlock(mesh->getNumElements(), [&](UInt i, string & buf)
+	{
+		int32_t id[4];
+		for(UInt j=0; j<3; ++j)	id[j] = mesh->getElementPointer(i)->getConnectedId(j);
+		id[3] = mesh->getElementPointer(i)->getGeoId();
+		
+		if(binario)
+		{
+			buf += static_cast<char>(3);
+			buf.append(reinterpret_cast<const char *>(id), sizeof(id));
+		}
+		else
+		{
+			buf += '3';
+			for(UInt j=0; j<4; ++j)
+			{
+				buf += ' ';
+				bufferedWriter::appendUInt(buf, id[j]);
+			}
+			buf += '\n';
+		}
+	});
+	
+	out.close();
+}
+
 //
 // file .off
 //
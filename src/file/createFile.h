@@ -11,6 +11,10 @@
 #include "../geometry/mesh2d.hpp"
 #include "../geometry/mesh3d.hpp"
 
+#include "../file/binaryMesh.h"
+#include "../file/bufferedWriter.h"
+#include "../file/plyFormat.h"
+
 namespace geometry
 {
 
@@ -32,6 +36,9 @@ class createFile
 	  public:
 		  /*! Tolleranza */
 		  Real toll;
+		  
+		  /*! Numero di thread con cui si formattano i file per Paraview, se è 0 si usa quello di default di OpenMP */
+		  UInt numThreads;
 	  //
 	  // Costruttore di default
 	  //
@@ -48,6 +55,41 @@ class createFile
 		  /*! set */
 		  void setToll(Real _toll);
 	  //
+	  // get e set del numero di thread
+	  //
+	  public: 
+		  /*! get */
+		  UInt getNumThreads();
+		  
+		  /*! set */
+		  void setNumThreads(UInt _numThreads);
+	  //
+	  // Metodi che scrivono i blocchi dei file per Paraview con bufferedWriter, i reali sono scritti in modo da 
+	  // essere riletti esatti
+	  //
+	  public:
+		  /*! Metodo che scrive l'intestazione, i nodi e gli elementi 
+		   \param out file in cui scrivere
+		   \param mesh puntatore alla griglia 
+		   \param tipo tipo degli elementi (line, tri, tet)
+		   \param sep separatore fra i campi degli elementi 
+		   \param numNodeProp numero di proprietà dei nodi dell'intestazione 
+		   \param numElemProp numero di proprietà degli elementi dell'intestazione */
+		  template<typename MESH> void writeParaviewMesh(bufferedWriter & out, MESH * mesh, string tipo, string sep, 
+								 UInt numNodeProp, UInt numElemProp);
+		  
+		  /*! Metodo che scrive una proprietà scalare 
+		   \param out file in cui scrivere
+		   \param prop proprietà 
+		   \param nome nome e unità della proprietà */
+		  void writeParaviewProperty(bufferedWriter & out, vector<Real> * prop, string nome);
+		  
+		  /*! Metodo che scrive una proprietà vettoriale 
+		   \param out file in cui scrivere
+		   \param prop proprietà 
+		   \param nome nome e unità della proprietà */
+		  void writeParaviewProperty(bufferedWriter & out, vector<point> * prop, string nome);
+	  //
 	  // Metodi per creare i file per Paraview
 	  //
 	  public:		  
@@ -145,6 +187,45 @@ class createFile
 		   N.B. devono avere la stessa numerazione */
 		  void fileForMedit(string s, mesh3d<Tetra> * mesh, mesh2d<Triangle> * surf);
 	//
+	// file binari
+	//
+	public:
+		  /*! File binario di una mesh1d nel formato descritto in binaryMeshHeader 
+		   \param s stringa che contiene l'indirizzo del file
+		   \param mesh puntatore alla griglia 
+		   \param prop puntatore alle proprietà dei nodi, ogni vettore ha un valore per nodo */
+		  void fileForBinary(string s, mesh1d<Line> * mesh, vector<vector<Real> > * prop = NULL);
+		  
+		  /*! File binario di una mesh2d nel formato descritto in binaryMeshHeader 
+		   \param s stringa che contiene l'indirizzo del file
+		   \param mesh puntatore alla griglia 
+		   \param prop puntatore alle proprietà dei nodi, ogni vettore ha un valore per nodo */
+		  void fileForBinary(string s, mesh2d<Triangle> * mesh, vector<vector<Real> > * prop = NULL);
+		  
+		  /*! File binario di una mesh3d nel formato descritto in binaryMeshHeader 
+		   \param s stringa che contiene l'indirizzo del file
+		   \param mesh puntatore alla griglia 
+		   \param prop puntatore alle proprietà dei nodi, ogni vettore ha un valore per nodo */
+		  void fileForBinary(string s, mesh3d<Tetra> * mesh, vector<vector<Real> > * prop = NULL);
+		  
+		  /*! Metodo che scrive il file binario di una mesh qualsiasi 
+		   \param s stringa che contiene l'indirizzo del file
+		   \param mesh puntatore alla griglia 
+		   \param prop puntatore alle proprietà dei nodi */
+		  template<typename MESH> void fileForBinaryMesh(string s, MESH * mesh, vector<vector<Real> > * prop);
+	//
+	// file PLY
+	//
+	public:
+		  /*! File PLY di una mesh2d, i nodi sono scritti in double, le facce come liste di int con il geoId
+		   \param s stringa che contiene l'indirizzo del file
+		   \param mesh puntatore alla griglia 
+		   \param binario se è vero il file è binary_little_endian, altrimenti ascii
+		   \param prop puntatore alle proprietà dei nodi, ogni vettore ha un valore per nodo 
+		   \param nomi nomi delle proprietà, se non ci sono si usano prop0, prop1, ... */
+		  void fileForPly(string s, mesh2d<Triangle> * mesh, bool binario = true, vector<vector<Real> > * prop = NULL, 
+				  vector<string> * nomi = NULL);
+	//
 	// file .off
 	//
 	public:
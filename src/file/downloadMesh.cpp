@@ -1,3 +1,7 @@
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "downloadMesh.h"
 
 using namespace geometry;
@@ -151,65 +155,220 @@ void downloadMesh::fileFromParaview(string s, mesh1d<Line> * mesh)
 
 void downloadMesh::fileFromParaview(string s, mesh2d<Triangle> * mesh)
 {
-      file.open(s.c_str());
+      // si usa il lettore con il file mappato in memoria, se i record non sono uno per riga si legge a flusso
+      if(!fileFromParaviewMapped(s, mesh))
+	    fileFromParaviewStream(s, mesh);
+}
+
+bool downloadMesh::fileFromParaviewMapped(string s, mesh2d<Triangle> * mesh, UInt numThreads)
+{
+      // variabili in uso
+      mappedFile				    mappa;
+      UInt	      numNode=0,numElem=0,tmp,numChunk;
+      const char *				    p,*fine;
+      vector<const char *>				 inizi;
+      vector<UInt>				 righe,errori;
+      bool						    ok;
+      
+      // la mesh data in input non viene pulita: i nodi e gli elementi già presenti sono sovrascritti, così se si 
+      // ricarica nella stessa mesh non si rifanno le allocazioni dei vettori dei connessi. Gli errori non vengono 
+      // scritti, se ne occupa fileFromParaviewStream
+      if(!mappa.open(s))
+      {
+	      mesh->clear();
+	      return(false);
+      }
       
-      if(!file.is_open())
+#ifdef _OPENMP
+      // numero di thread
+      int numTh = (numThreads>0) ? numThreads : omp_get_max_threads();
+#else
+      int numTh = 1;
+#endif
+      
+      // Ottengo le informazioni generali
+      p    = mappa.begin();
+      fine = mappa.end();
+      ok   = true;
+      ok = ok && (p = mappedFile::readUInt(p, fine, numNode))!=NULL;
+      ok = ok && (p = mappedFile::readUInt(p, fine, numElem))!=NULL;
+      for(UInt i=0; i<3 && ok; ++i)	ok = (p = mappedFile::readUInt(p, fine, tmp))!=NULL;
+      if(!ok)
       {
-	      cout << "ERRORE: file " << s << " non trovato" << endl;
+	      mesh->clear();
+	      return(false);
       }
       
-      // pulisco la struttura mesh data in input
-      mesh->clear();
+      // i record partono dalla riga dopo l'intestazione
+      while(p<fine && *p!='\n')	++p;
       
-      // Variabili in gioco 
+      // divido il file in pezzi che iniziano a inizio riga, circa un MB per pezzo e almeno uno per thread
+      numChunk = max(static_cast<UInt>(numTh), static_cast<UInt>((fine-p)>>20));
+      inizi.resize(numChunk+1);
+      for(UInt k=0; k<numChunk; ++k)
+      {
+	    const char * q = p + static_cast<size_t>(fine-p)*k/numChunk;
+	    if(k>0)	while(q<fine && q[-1]!='\n')	++q;
+	    inizi[k] = q;
+      }
+      inizi[numChunk] = fine;
+      
+      // conto le righe non vuote di ogni pezzo, le somme danno il numero della prima riga di ogni pezzo
+      righe.assign(numChunk+1, 0);
+      
+      #pragma omp parallel for num_threads(numTh) schedule(dynamic,1)
+      for(UInt k=0; k<numChunk; ++k)
+      {
+	    for(const char * q=inizi[k]; q<inizi[k+1]; )
+	    {
+		  const char * r = static_cast<const char *>(memchr(q, '\n', inizi[k+1]-q));
+		  if(r==NULL)	r = inizi[k+1];
+		  if(mappedFile::skipSpaces(q, r)<r)	++righe[k+1];
+		  q = r+1;
+	    }
+      }
+      
+      for(UInt k=0; k<numChunk; ++k)	righe[k+1] += righe[k];
+      if(righe[numChunk]<numNode+numElem)
+      {
+	      mesh->clear();
+	      return(false);
+      }
+      
+      // leggo i pezzi in parallelo scrivendo direttamente nei vettori della mesh
+      mesh->getNodePointer()->resize(numNode);
+      mesh->getElementPointer()->resize(numElem);
+      errori.assign(numChunk, 0);
+      
+      #pragma omp parallel for num_threads(numTh) schedule(dynamic,1)
+      for(UInt k=0; k<numChunk; ++k)
+      {
+	    // variabili in uso
+	    UInt 	      riga=righe[k],id=0,geo=0,ids[3]={0,0,0};
+	    Real						 xyz[3];
+	    const char *					q,*r;
+	    
+	    for(q=inizi[k]; q<inizi[k+1] && riga<numNode+numElem && !errori[k]; q=r+1)
+	    {
+		  r = static_cast<const char *>(memchr(q, '\n', inizi[k+1]-q));
+		  if(r==NULL)	r = inizi[k+1];
+		  if(mappedFile::skipSpaces(q, r)==r)	continue;
+		  
+		  if(riga<numNode)
+		  {
+			// id x y z 
+			if((q = mappedFile::readUInt(q, r, id))==NULL)			errori[k] = 1;
+			for(UInt j=0; j<3 && !errori[k]; ++j)
+			    if((q = mappedFile::readReal(q, r, xyz[j]))==NULL)		errori[k] = 1;
+			if(!errori[k] && mappedFile::skipSpaces(q, r)!=r)		errori[k] = 1;
+			if(errori[k])	break;
+			
+			*mesh->getNodePointer(riga) = point(xyz[0], xyz[1], xyz[2]);
+			mesh->getNodePointer(riga)->setId(riga);
+		  }
+		  else
+		  {
+			// id geoId tipo n1 n2 n3 
+			if((q = mappedFile::readUInt(q, r, id))==NULL)			errori[k] = 1;
+			if(!errori[k] && (q = mappedFile::readUInt(q, r, geo))==NULL)	errori[k] = 1;
+			if(!errori[k])	q = mappedFile::skipWord(q, r);
+			for(UInt j=0; j<3 && !errori[k]; ++j)
+			    if((q = mappedFile::readUInt(q, r, ids[j]))==NULL || ids[j]==0 || ids[j]>numNode)	errori[k] = 1;
+			if(!errori[k] && mappedFile::skipSpaces(q, r)!=r)		errori[k] = 1;
+			if(errori[k])	break;
+			
+			geoElement<Triangle> * tria = mesh->getElementPointer(riga-numNode);
+			if(tria->getNumConnected()!=3)	*tria = geoElement<Triangle>();
+			for(UInt j=0; j<3; ++j)	tria->setConnectedId(j, ids[j]-1);
+			tria->setGeoId(geo);
+			tria->setId(riga-numNode);
+		  }
+		  
+		  ++riga;
+	    }
+      }
+      
+      for(UInt k=0; k<numChunk; ++k)
+      {
+	    if(errori[k])
+	    {
+		  mesh->clear();
+		  return(false);
+	    }
+      }
+      
+      return(true);
+}
+
+void downloadMesh::fileFromParaviewStream(string s, mesh2d<Triangle> * mesh)
+{
+      // variabili in uso
       string                   str;
       UInt     numNode,numElem,tmp;
-      UInt             id1,id2,id3;
-      Real                   x,y,z;
-      point                      p;
+      UInt               id[3],geo;
+      Real                  xyz[3];
       geoElement<Triangle>    tria;
       
+      // pulisco la struttura mesh data in input
+      mesh->clear();
+      
+      file.open(s.c_str());
+      if(!file.is_open())
+      {
+	      cout << "ERRORE: file " << s << " non trovato" << endl;
+	      return;
+      }
+      
       // Ottengo le informazioni generali
       file >> numNode;
       file >> numElem;
       file >> tmp;	file >> tmp;	file >> tmp;
+      if(!file)
+      {
+	      cout << "ERRORE: intestazione del file " << s << " non valida" << endl;
+	      file.close();
+	      return;
+      }
       
-      // Ricavo le informazioni dei nodi
+      // Ricavo le informazioni dei nodi, i vettori crescono con i record letti e non con i numeri dell'intestazione
       for(UInt i=0; i<numNode; ++i)
       {
-	    // prendo le informazioni
 	    file >> tmp;
-	    file >> x;
-	    file >> y;
-	    file >> z;
-	    
-	    // definisco la variabile p
-	    p.setX(x);	p.setY(y);  p.setZ(z);
-	    p.setId(i);
+	    file >> xyz[0];
+	    file >> xyz[1];
+	    file >> xyz[2];
+	    if(!file)
+	    {
+		  cout << "ERRORE: il file " << s << " si ferma al nodo " << i+1 << " di " << numNode << endl;
+		  mesh->clear();
+		  file.close();
+		  return;
+	    }
 	    
-	    // la metto nella mesh
-	    mesh->insertNode(p);
+	    mesh->insertNode(point(xyz[0], xyz[1], xyz[2]));
+	    mesh->getNodePointer(i)->setId(i);
       }
       
-      // Ricavo le informazioni dei nodi
+      // Ricavo le informazioni degli elementi
       for(UInt i=0; i<numElem; ++i)
       {
-	    // prendo le informazioni
-	    file >> tmp;
 	    file >> tmp;
+	    file >> geo;
 	    file >> str;
-	    file >> id1;
-	    file >> id2;
-	    file >> id3;
+	    file >> id[0];
+	    file >> id[1];
+	    file >> id[2];
+	    if(!file || id[0]==0 || id[0]>numNode || id[1]==0 || id[1]>numNode || id[2]==0 || id[2]>numNode)
+	    {
+		  cout << "ERRORE: record non valido nel file " << s << endl;
+		  mesh->clear();
+		  file.close();
+		  return;
+	    }
 	    
-	    // definisco la variabile tria
-	    tria.setConnectedId(0, id1-1);
-	    tria.setConnectedId(1, id2-1);
-	    tria.setConnectedId(2, id3-1);
-	    tria.setGeoId(tmp);
+	    for(UInt j=0; j<3; ++j)	tria.setConnectedId(j, id[j]-1);
+	    tria.setGeoId(geo);
 	    tria.setId(i);
-	    
-	    // la metto nella mesh
 	    mesh->insertElement(tria);
       }
       
@@ -219,6 +378,855 @@ void downloadMesh::fileFromParaview(string s, mesh2d<Triangle> * mesh)
       file.close();
 }
 
+// ----------------------------
+//      FILE BINARI
+// ----------------------------
+
+void downloadMesh::fileFromBinary(string s, mesh1d<Line> * mesh, vector<vector<Real> > * prop)
+{
+      binaryMesh bin;
+      if(!bin.open(s) || !fileFromBinary(bin, mesh, prop))	mesh->clear();
+}
+
+void downloadMesh::fileFromBinary(string s, mesh2d<Triangle> * mesh, vector<vector<Real> > * prop)
+{
+      binaryMesh bin;
+      if(!bin.open(s) || !fileFromBinary(bin, mesh, prop))	mesh->clear();
+}
+
+void downloadMesh::fileFromBinary(string s, mesh3d<Tetra> * mesh, vector<vector<Real> > * prop)
+{
+      binaryMesh bin;
+      if(!bin.open(s) || !fileFromBinary(bin, mesh, prop))	mesh->clear();
+}
+
+template<typename MESH>
+bool downloadMesh::fileFromBinary(const binaryMesh & file, MESH * mesh, vector<vector<Real> > * prop)
+{
+      // variabili in uso
+      typedef typename remove_reference<decltype(*mesh->getElementPointer(0))>::type		ELEMENT;
+      UInt						numVertex = ELEMENT::numVertex;
+      UInt						  numNode = file.getNumNodes();
+      UInt						  numElem = file.getNumElements();
+      const double *					     nodi = file.getNodes();
+      const uint32_t *				     conn = file.getConnectivity();
+      const uint32_t *				       geo = file.getGeoIds();
+      
+      if(file.getNumVertices()!=numVertex && numElem>0)
+      {
+	    cout << "ERRORE: il file ha " << file.getNumVertices() << " nodi per elemento invece di " << numVertex << endl;
+	    return(false);
+      }
+      
+      // controllo gli identificatori prima di toccare la mesh 
+      size_t						 numConn = static_cast<size_t>(numVertex)*numElem;
+      UInt							fuori = 0;
+      
+      #pragma omp parallel for schedule(static) reduction(+:fuori)
+      for(size_t i=0; i<numConn; ++i)	fuori += (conn[i]>=numNode);
+      
+      if(fuori>0)
+      {
+	    cout << "ERRORE: il file ha " << fuori << " identificatori di nodo fuori dai " << numNode << " nodi" << endl;
+	    return(false);
+      }
+      
+      // copio i blocchi nei vettori della mesh 
+      mesh->getNodePointer()->resize(numNode);
+      mesh->getElementPointer()->resize(numElem);
+      
+      #pragma omp parallel for schedule(static)
+      for(UInt i=0; i<numNode; ++i)
+      {
+	    *mesh->getNodePointer(i) = point(nodi[3*i], nodi[3*i+1], nodi[3*i+2]);
+	    mesh->getNodePointer(i)->setId(i);
+      }
+      
+      #pragma omp parallel for schedule(static)
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    ELEMENT * elem = mesh->getElementPointer(i);
+	    if(elem->getNumConnected()!=numVertex)	*elem = ELEMENT();
+	    for(UInt j=0; j<numVertex; ++j)	elem->setConnectedId(j, conn[static_cast<size_t>(numVertex)*i+j]);
+	    elem->setGeoId(geo[i]);
+	    elem->setId(i);
+      }
+      
+      // proprietà 
+      if(prop!=NULL)
+      {
+	    prop->resize(file.getNumProperties());
+	    for(UInt k=0; k<file.getNumProperties(); ++k)
+		prop->at(k).assign(file.getProperty(k), file.getProperty(k)+numNode);
+      }
+      
+      return(true);
+}
+
+template bool downloadMesh::fileFromBinary(const binaryMesh & file, mesh1d<Line> * mesh, vector<vector<Real> > * prop);
+template bool downloadMesh::fileFromBinary(const binaryMesh & file, mesh2d<Triangle> * mesh, vector<vector<Real> > * prop);
+template bool downloadMesh::fileFromBinary(const binaryMesh & file, mesh3d<Tetra> * mesh, vector<vector<Real> > * prop);
+
+// ----------------------------
+//      FILE PLY
+// ----------------------------
+
+void downloadMesh::fileFromPly(string s, mesh2d<Triangle> * mesh, vector<vector<Real> > * prop, vector<string> * nomi)
+{
+      // variabili in uso
+      mappedFile				  mappa;
+      plyEncoding				formato;
+      vector<plyElement>		       elementi;
+      vector<Real>				 valori;
+      vector<UInt>				  lista;
+      const char *			   p=NULL,*fine;
+      bool				      ok=true,vertici=false;
+      
+      if(!mappa.open(s))
+      {
+	      cout << "ERRORE: file " << s << " non trovato" << endl;
+	      mesh->clear();
+	      return;
+      }
+      
+      fine = mappa.end();
+      if(!plyFormat::readHeader(mappa.begin(), fine, formato, elementi, p))
+      {
+	      cout << "ERRORE: intestazione del file " << s << " non valida" << endl;
+	      mesh->clear();
+	      return;
+      }
+      
+      if(formato==PLYBIG || (formato==PLYLITTLE && !plyFormat::isLittleEndian()))
+      {
+	      cout << "ERRORE: l'ordine dei byte del file " << s << " non è supportato" << endl;
+	      mesh->clear();
+	      return;
+      }
+      
+      // gli elementi nell'ordine del file, quelli che non sono vertici o facce sono saltati
+      if(prop!=NULL)	prop->clear();
+      if(nomi!=NULL)	nomi->clear();
+      mesh->getNodePointer()->clear();
+      mesh->getElementPointer()->clear();
+      for(UInt k=0; k<elementi.size() && ok; ++k)
+      {
+	    if(elementi[k].nome=="vertex")
+	    {
+		  ok      = readPlyVertices(p, fine, formato, elementi[k], mesh, prop, nomi);
+		  vertici = true;
+	    }
+	    else if(elementi[k].nome=="face")
+	    {
+		  ok = vertici && readPlyFaces(p, fine, formato, elementi[k], mesh);
+	    }
+	    else if(formato!=PLYASCII && !plyFormat::hasLists(elementi[k]))
+	    {
+		  // record binari di dimensione fissa, si saltano in un colpo solo 
+		  size_t dim = static_cast<size_t>(plyFormat::recordSize(elementi[k], 0))*elementi[k].numero;
+		  ok = (static_cast<size_t>(fine-p)>=dim);
+		  if(ok)	p += dim;
+	    }
+	    else
+	    {
+		  for(UInt i=0; i<elementi[k].numero && ok; ++i)
+		      ok = (p = readPlyRecord(p, fine, formato, elementi[k], valori, lista, elementi[k].proprieta.size()))!=NULL;
+	    }
+      }
+      
+      if(!ok)
+      {
+	      cout << "ERRORE: il file " << s << " non è valido" << endl;
+	      mesh->clear();
+	      if(prop!=NULL)	prop->clear();
+	      if(nomi!=NULL)	nomi->clear();
+      }
+}
+
+const char * downloadMesh::readPlyRecord(const char * p, const char * fine, plyEncoding formato, const plyElement & elem, 
+					 vector<Real> & valori, vector<UInt> & lista, UInt tenuta)
+{
+      // variabili in uso
+      Real		    v;
+      UInt	       numero;
+      
+      valori.resize(elem.proprieta.size());
+      for(UInt j=0; j<elem.proprieta.size(); ++j)
+      {
+	    const plyProperty & pr = elem.proprieta[j];
+	    
+	    // il valore o il numero di valori della lista 
+	    plyType tipo = pr.lista ? pr.tipoConteggio : pr.tipo;
+	    if(formato==PLYASCII)
+	    {
+		  if((p = mappedFile::readReal(p, fine, v))==NULL)	return(NULL);
+	    }
+	    else
+	    {
+		  if(static_cast<size_t>(fine-p)<plyFormat::sizeOf(tipo))	return(NULL);
+		  v  = plyFormat::value(p, tipo);
+		  p += plyFormat::sizeOf(tipo);
+	    }
+	    valori[j] = v;
+	    
+	    if(!pr.lista)	continue;
+	    
+	    // il numero di valori non può superare i byte rimasti, in ascii ogni valore ha almeno un carattere 
+	    if(!(v>=0.0 && v<=static_cast<Real>(fine-p)))	return(NULL);
+	    numero = static_cast<UInt>(v);
+	    if(formato!=PLYASCII && static_cast<size_t>(numero)*plyFormat::sizeOf(pr.tipo)>static_cast<size_t>(fine-p))
+		return(NULL);
+	    
+	    // le liste che non servono sono saltate 
+	    if(j!=tenuta)
+	    {
+		  if(formato!=PLYASCII)
+		  {
+			p += static_cast<size_t>(numero)*plyFormat::sizeOf(pr.tipo);
+			continue;
+		  }
+		  for(UInt i=0; i<numero; ++i)
+		      if((p = mappedFile::readReal(p, fine, v))==NULL)	return(NULL);
+		  continue;
+	    }
+	    
+	    // i valori della lista 
+	    lista.resize(numero);
+	    for(UInt i=0; i<numero; ++i)
+	    {
+		  if(formato==PLYASCII)
+		  {
+			if((p = mappedFile::readReal(p, fine, v))==NULL)	return(NULL);
+		  }
+		  else
+		  {
+			v  = plyFormat::value(p, pr.tipo);
+			p += plyFormat::sizeOf(pr.tipo);
+		  }
+		  if(v<0.0)	return(NULL);
+		  lista[i] = static_cast<UInt>(v);
+	    }
+      }
+      
+      return(p);
+}
+
+bool downloadMesh::readPlyVertices(const char * & p, const char * fine, plyEncoding formato, const plyElement & elem, 
+				   mesh2d<Triangle> * mesh, vector<vector<Real> > * prop, vector<string> * nomi)
+{
+      // variabili in uso
+      UInt			      numNode=elem.numero;
+      UInt				 dim=0,xyz[3];
+      vector<UInt>			 altre,offset;
+      vector<Real>				valori;
+      vector<UInt>				 lista;
+      bool				      fissa=true;
+      
+      // posizione delle coordinate e delle altre proprietà scalari 
+      xyz[0] = xyz[1] = xyz[2] = elem.proprieta.size();
+      for(UInt j=0; j<elem.proprieta.size(); ++j)
+      {
+	    offset.push_back(dim);
+	    dim  += plyFormat::sizeOf(elem.proprieta[j].tipo);
+	    fissa = fissa && !elem.proprieta[j].lista;
+	    
+	    if(elem.proprieta[j].lista)		continue;
+	    if(elem.proprieta[j].nome=="x")		xyz[0] = j;
+	    else if(elem.proprieta[j].nome=="y")	xyz[1] = j;
+	    else if(elem.proprieta[j].nome=="z")	xyz[2] = j;
+	    else					altre.push_back(j);
+      }
+      if(xyz[0]==elem.proprieta.size() || xyz[1]==elem.proprieta.size() || xyz[2]==elem.proprieta.size())	return(false);
+      
+      // il numero di vertici dell'intestazione deve essere compatibile con la dimensione del file prima di allocare 
+      if(!plyFormat::fits(elem, formato, fine-p))	return(false);
+      
+      mesh->getNodePointer()->resize(numNode);
+      if(prop!=NULL)	prop->assign(altre.size(), vector<Real>(numNode));
+      if(nomi!=NULL)	for(UInt j=0; j<altre.size(); ++j)	nomi->push_back(elem.proprieta[altre[j]].nome);
+      
+      // record binari di dimensione fissa: ogni vertice è letto dalla sua posizione 
+      if(formato!=PLYASCII && fissa)
+      {
+	    if(static_cast<size_t>(fine-p)<static_cast<size_t>(dim)*numNode)	return(false);
+	    
+	    const char * base = p;
+	    #pragma omp parallel for schedule(static)
+	    for(UInt i=0; i<numNode; ++i)
+	    {
+		  const char * r = base + static_cast<size_t>(dim)*i;
+		  
+		  *mesh->getNodePointer(i) = point(plyFormat::value(r+offset[xyz[0]], elem.proprieta[xyz[0]].tipo),
+						   plyFormat::value(r+offset[xyz[1]], elem.proprieta[xyz[1]].tipo),
+						   plyFormat::value(r+offset[xyz[2]], elem.proprieta[xyz[2]].tipo));
+		  mesh->getNodePointer(i)->setId(i);
+		  
+		  if(prop!=NULL)
+		      for(UInt j=0; j<altre.size(); ++j)
+			  prop->at(j)[i] = plyFormat::value(r+offset[altre[j]], elem.proprieta[altre[j]].tipo);
+	    }
+	    
+	    p += static_cast<size_t>(dim)*numNode;
+	    return(true);
+      }
+      
+      // altrimenti un record alla volta 
+      for(UInt i=0; i<numNode; ++i)
+      {
+	    if((p = readPlyRecord(p, fine, formato, elem, valori, lista, elem.proprieta.size()))==NULL)	return(false);
+	    
+	    *mesh->getNodePointer(i) = point(valori[xyz[0]], valori[xyz[1]], valori[xyz[2]]);
+	    mesh->getNodePointer(i)->setId(i);
+	    
+	    if(prop!=NULL)
+		for(UInt j=0; j<altre.size(); ++j)	prop->at(j)[i] = valori[altre[j]];
+      }
+      
+      return(true);
+}
+
+bool downloadMesh::readPlyFaces(const char * & p, const char * fine, plyEncoding formato, const plyElement & elem, 
+				mesh2d<Triangle> * mesh)
+{
+      // variabili in uso
+      UInt	       numFace=elem.numero,numNode=mesh->getNumNodes();
+      UInt			  indici,geo,dim=0;
+      vector<UInt>				 offset;
+      vector<Real>				 valori;
+      vector<UInt>				  lista;
+      geoElement<Triangle>			   tria;
+      vector<geoElement<Triangle> > *	       elementi=mesh->getElementPointer();
+      bool					 tutti=true;
+      
+      // la lista con gli indici e il geoId 
+      indici = geo = elem.proprieta.size();
+      for(UInt j=0; j<elem.proprieta.size(); ++j)
+      {
+	    const plyProperty & pr = elem.proprieta[j];
+	    if(pr.lista && indici==elem.proprieta.size() && (pr.nome=="vertex_indices" || pr.nome=="vertex_index"))
+		indici = j;
+	    if(!pr.lista && pr.nome=="geoId")
+		geo = j;
+      }
+      if(indici==elem.proprieta.size())	return(false);
+      
+      // il numero di facce dell'intestazione deve essere compatibile con la dimensione del file prima di allocare 
+      if(!plyFormat::fits(elem, formato, fine-p))	return(false);
+      
+      // record binari: se tutte le liste hanno tre valori i record hanno dimensione fissa e si leggono in parallelo 
+      if(formato!=PLYASCII)
+      {
+	    for(UInt j=0; j<elem.proprieta.size(); ++j)
+	    {
+		  offset.push_back(dim);
+		  if(elem.proprieta[j].lista)	dim += plyFormat::sizeOf(elem.proprieta[j].tipoConteggio) + 3*plyFormat::sizeOf(elem.proprieta[j].tipo);
+		  else				dim += plyFormat::sizeOf(elem.proprieta[j].tipo);
+	    }
+	    
+	    const plyProperty & pr = elem.proprieta[indici];
+	    const char * base = p;
+	    if(static_cast<size_t>(fine-p)>=static_cast<size_t>(dim)*numFace)
+	    {
+		  // controllo i conteggi di tutte le liste 
+		  #pragma omp parallel for schedule(static) reduction(&&:tutti)
+		  for(UInt i=0; i<numFace; ++i)
+		  {
+			const char * r = base + static_cast<size_t>(dim)*i;
+			for(UInt j=0; j<elem.proprieta.size(); ++j)
+			    if(elem.proprieta[j].lista)
+				tutti = tutti && plyFormat::value(r+offset[j], elem.proprieta[j].tipoConteggio)==3.0;
+		  }
+	    }
+	    else
+	    {
+		  tutti = false;
+	    }
+	    
+	    if(tutti)
+	    {
+		  elementi->resize(numFace);
+		  
+		  #pragma omp parallel for schedule(static) reduction(&&:tutti)
+		  for(UInt i=0; i<numFace; ++i)
+		  {
+			const char * r = base + static_cast<size_t>(dim)*i + offset[indici] + plyFormat::sizeOf(pr.tipoConteggio);
+			geoElement<Triangle> * e = &elementi->at(i);
+			
+			if(e->getNumConnected()!=3)	*e = geoElement<Triangle>();
+			for(UInt j=0; j<3; ++j)
+			{
+			      Real v = plyFormat::value(r+j*plyFormat::sizeOf(pr.tipo), pr.tipo);
+			      tutti  = tutti && v>=0.0 && v<numNode;
+			      e->setConnectedId(j, static_cast<UInt>(v));
+			}
+			e->setGeoId((geo<elem.proprieta.size()) ? 
+			            static_cast<UInt>(plyFormat::value(base+static_cast<size_t>(dim)*i+offset[geo], elem.proprieta[geo].tipo)) : 0);
+			e->setId(i);
+		  }
+		  
+		  p += static_cast<size_t>(dim)*numFace;
+		  return(tutti);
+	    }
+      }
+      
+      // altrimenti un record alla volta, i poligoni sono divisi a ventaglio 
+      elementi->clear();
+      elementi->reserve(numFace);
+      for(UInt i=0; i<numFace; ++i)
+      {
+	    if((p = readPlyRecord(p, fine, formato, elem, valori, lista, indici))==NULL)	return(false);
+	    
+	    for(UInt j=0; j<lista.size(); ++j)	if(lista[j]>=numNode)	return(false);
+	    
+	    for(UInt j=2; j<lista.size(); ++j)
+	    {
+		  tria.setConnectedId(0, lista[0]);
+		  tria.setConnectedId(1, lista[j-1]);
+		  tria.setConnectedId(2, lista[j]);
+		  tria.setGeoId((geo<elem.proprieta.size()) ? static_cast<UInt>(valori[geo]) : 0);
+		  tria.setId(elementi->size());
+		  elementi->push_back(tria);
+	    }
+      }
+      
+      return(true);
+}
+
+// ----------------------------
+//      FILE STL
+// ----------------------------
+
+void downloadMesh::fileFromStl(string s, mesh2d<Triangle> * mesh, Real toll, UInt numThreads)
+{
+      // variabili in uso
+      mappedFile				  mappa;
+      uint32_t				       numTria=0;
+      vector<Real>				  coord;
+      const char *				      p,*fine;
+      
+      if(!mappa.open(s))
+      {
+	      cout << "ERRORE: file " << s << " non trovato" << endl;
+	      mesh->clear();
+	      return;
+      }
+      
+      p    = mappa.begin();
+      fine = mappa.end();
+      
+      // binario: 80 byte di intestazione, il numero di triangoli e 50 byte per triangolo, i vertici sono letti 
+      // direttamente dal file 
+      if(mappa.size()>=84)	memcpy(&numTria, p+80, sizeof(uint32_t));
+      if(mappa.size()>=84 && mappa.size()==84+static_cast<size_t>(50)*numTria && plyFormat::isLittleEndian())
+      {
+	      const char * base = p + 84 + 12;
+	      
+	      weldStl(numTria, [base](UInt v, UInt j)
+	      {
+		      float x;
+		      memcpy(&x, base + static_cast<size_t>(50)*(v/3) + 12*(v%3) + 4*j, sizeof(float));
+		      return(static_cast<Real>(x));
+	      }, toll, mesh, numThreads);
+	      return;
+      }
+      
+      // ascii 
+      p = mappedFile::skipSpaces(p, fine);
+      if(fine-p<5 || memcmp(p, "solid", 5)!=0 || !readStlAscii(p, fine, coord))
+      {
+	      cout << "ERRORE: il file " << s << " non è un file STL valido" << endl;
+	      mesh->clear();
+	      return;
+      }
+      
+      weldStl(coord.size()/9, [&coord](UInt v, UInt j)
+      {
+	      return(coord[3*static_cast<size_t>(v)+j]);
+      }, toll, mesh, numThreads);
+}
+
+bool downloadMesh::readStlAscii(const char * p, const char * fine, vector<Real> & coord)
+{
+      // variabili in uso
+      const char *				      q;
+      Real					      v;
+      
+      coord.clear();
+      
+      // si leggono solo i vertici, le altre parole (facet normal, outer loop, ...) sono saltate 
+      while((p = mappedFile::skipSpaces(p, fine))<fine)
+      {
+	    q = mappedFile::skipWord(p, fine);
+	    if(q-p==6 && memcmp(p, "vertex", 6)==0)
+	    {
+		  for(UInt j=0; j<3; ++j)
+		  {
+			if((q = mappedFile::readReal(q, fine, v))==NULL)	return(false);
+			coord.push_back(v);
+		  }
+	    }
+	    p = q;
+      }
+      
+      return(coord.size()%9==0);
+}
+
+// chiave di una coordinata: la cella di lato lato o, se lato è 0, i bit del numero 
+static inline int64_t stlCell(Real x, Real lato)
+{
+      // variabili in uso
+      int64_t	c;
+      
+      if(lato>0.0)
+      {
+	    x = floor(x/lato);
+	    return(static_cast<int64_t>(max(-4e18, min(4e18, x))));
+      }
+      
+      if(x==0.0)	return(0);
+      memcpy(&c, &x, sizeof(int64_t));
+      return(c);
+}
+
+static inline uint64_t stlHash(const int64_t * c)
+{
+      // variabili in uso
+      uint64_t	h;
+      
+      h  = static_cast<uint64_t>(c[0])*0x9E3779B97F4A7C15ULL;
+      h ^= static_cast<uint64_t>(c[1])*0xC2B2AE3D27D4EB4FULL;
+      h ^= static_cast<uint64_t>(c[2])*0x165667B19E3779F9ULL;
+      h ^= h>>29;	h *= 0xBF58476D1CE4E5B9ULL;	h ^= h>>32;
+      
+      return(h);
+}
+
+template<typename COORD> 
+void downloadMesh::weldStl(UInt numTria, COORD coord, Real toll, mesh2d<Triangle> * mesh, UInt numThreads)
+{
+      // variabili in uso
+      UInt			       numVert=3*numTria,numParti;
+      Real				    lato=toll/sqrt(3.0);
+      vector<UInt>	     rap,nuovo,inizio,ultimo,membri;
+      vector<unsigned char>			   parte,usato;
+      vector<vector<uint64_t> >		       tabelle,filtri;
+      vector<UInt>			    contaNodi,contaElem;
+      vector<vector<pair<UInt,UInt> > >		      coppie;
+      
+#ifdef _OPENMP
+      // numero di thread
+      int numTh = (numThreads>0) ? numThreads : omp_get_max_threads();
+#else
+      int numTh = 1;
+#endif
+      
+      // una tabella hash per parte, al massimo 256 parti. Ogni posto della tabella è un solo intero a 64 bit con 32 
+      // bit dell'hash e il vertice più uno, 0 è il posto vuoto: così ogni ricerca legge una sola riga di cache 
+      numParti = min(static_cast<UInt>(numTh), static_cast<UInt>(256));
+      tabelle.resize(numParti);
+      filtri.resize(numParti);
+      
+      // la cella di un vertice, la diagonale della cella è toll quindi due vertici nella stessa cella sono a 
+      // distanza minore di toll 
+      auto cella = [&](UInt v, int64_t * c) 
+      {
+	      for(UInt j=0; j<3; ++j)	c[j] = stlCell(coord(v, j), lato);
+      };
+      
+      // ricerca della cella c nella tabella t, restituisce il primo vertice della cella 
+      auto cerca = [&](UInt t, uint64_t h, const int64_t * c)
+      {
+	      int64_t   d[3];
+	      UInt	maschera = tabelle[t].size()-1;
+	      
+	      for(UInt k=(h>>8)&maschera; tabelle[t][k]!=0; k=(k+1)&maschera)
+	      {
+		    if((tabelle[t][k]>>32)!=(h>>32))	continue;
+		    
+		    UInt w = static_cast<UInt>(tabelle[t][k]) - 1;
+		    cella(w, d);
+		    if(d[0]==c[0] && d[1]==c[1] && d[2]==c[2])	return(w);
+	      }
+	      return(static_cast<UInt>(-1));
+      };
+      
+      auto inserisci = [&](UInt t, uint64_t h, UInt v)
+      {
+	      UInt maschera = tabelle[t].size()-1;
+	      UInt k	    = (h>>8)&maschera;
+	      
+	      while(tabelle[t][k]!=0)	k = (k+1)&maschera;
+	      tabelle[t][k] = (h & 0xFFFFFFFF00000000ULL) | (static_cast<uint64_t>(v)+1);
+	      
+	      // con la tolleranza un filtro di 8 bit per posto dice quali celle vicine possono essere nella tabella 
+	      if(toll>0.0)
+	      {
+		    uint64_t b = (h>>32) & (8*static_cast<uint64_t>(tabelle[t].size())-1);
+		    filtri[t][b>>6] |= static_cast<uint64_t>(1)<<(b&63);
+	      }
+      };
+      
+      auto presente = [&](UInt t, uint64_t h)
+      {
+	      uint64_t b = (h>>32) & (8*static_cast<uint64_t>(tabelle[t].size())-1);
+	      return(((filtri[t][b>>6]>>(b&63)) & 1)!=0);
+      };
+      
+      // la parte di ogni vertice
+      parte.assign(numVert, 0);
+      rap.resize(numVert);
+      
+      if(numParti>1)
+      {
+	    #pragma omp parallel for num_threads(numTh) schedule(static)
+	    for(UInt v=0; v<numVert; ++v)
+	    {
+		  int64_t c[3];
+		  cella(v, c);
+		  parte[v] = (stlHash(c) & 255)%numParti;
+	    }
+      }
+      
+      // ogni thread riempie la sua tabella scorrendo i vertici in ordine, il rappresentante della cella è il suo 
+      // primo vertice. Le tabelle partono dalla dimensione giusta per una superficie chiusa, dove ogni nodo è in 
+      // circa 6 triangoli. I triangoli vicini sono di solito vicini anche nel file, quindi prima della tabella si 
+      // guarda in una piccola cache delle celle viste da poco 
+      #pragma omp parallel for num_threads(numTh) schedule(dynamic,1)
+      for(UInt t=0; t<numParti; ++t)
+      {
+	    UInt		   numero=0,dim=1024;
+	    vector<uint64_t>	recenti(1<<16, 0);
+	    
+	    while(dim<numVert/(3*numParti))	dim *= 2;
+	    tabelle[t].assign(dim, 0);
+	    filtri[t].assign((toll>0.0) ? dim/8 : 0, 0);
+	    
+	    for(UInt v=0; v<numVert; ++v)
+	    {
+		  if(parte[v]!=t)	continue;
+		  
+		  int64_t  c[3],d[3];
+		  cella(v, c);
+		  uint64_t h = stlHash(c);
+		  uint64_t & r = recenti[(h>>20)&0xFFFF];
+		  
+		  if(r!=0 && (r>>32)==(h>>32))
+		  {
+			cella(static_cast<UInt>(r)-1, d);
+			if(d[0]==c[0] && d[1]==c[1] && d[2]==c[2])
+			{
+			      rap[v] = static_cast<UInt>(r)-1;
+			      continue;
+			}
+		  }
+		  
+		  rap[v] = cerca(t, h, c);
+		  r      = (h & 0xFFFFFFFF00000000ULL) | (static_cast<uint64_t>((rap[v]!=static_cast<UInt>(-1)) ? rap[v] : v)+1);
+		  if(rap[v]!=static_cast<UInt>(-1))	continue;
+		  
+		  // nuova cella, raddoppio la tabella se è piena a metà 
+		  rap[v] = v;
+		  if(2*(++numero)>tabelle[t].size())
+		  {
+			vector<uint64_t> vecchia(2*tabelle[t].size(), 0);
+			vecchia.swap(tabelle[t]);
+			filtri[t].assign((toll>0.0) ? tabelle[t].size()/8 : 0, 0);
+			
+			for(UInt k=0; k<vecchia.size(); ++k)
+			{
+			      if(vecchia[k]==0)	continue;
+			      
+			      UInt w = static_cast<UInt>(vecchia[k]) - 1;
+			      cella(w, c);
+			      inserisci(t, stlHash(c), w);
+			}
+		  }
+		  inserisci(t, h, v);
+	    }
+      }
+      
+      // con la tolleranza due celle sono unite se hanno due vertici a distanza minore di toll. I vertici di una 
+      // cella sono messi in fila dopo il suo rappresentante togliendo quelli con le stesse coordinate 
+      if(toll>0.0)
+      {
+	    coppie.resize(numTh);
+	    inizio.assign(numVert+1, 0);
+	    membri.resize(numVert);
+	    
+	    for(UInt v=0; v<numVert; ++v)	++inizio[rap[v]+1];
+	    for(UInt v=0; v<numVert; ++v)	inizio[v+1] += inizio[v];
+	    
+	    ultimo.assign(inizio.begin(), inizio.end()-1);
+	    for(UInt v=0; v<numVert; ++v)	membri[ultimo[rap[v]]++] = v;
+	    
+	    #pragma omp parallel for num_threads(numTh) schedule(static)
+	    for(UInt v=0; v<numVert; ++v)
+	    {
+		  if(rap[v]!=v)	continue;
+		  
+		  UInt n = inizio[v]+1;
+		  for(UInt a=inizio[v]+1; a<ultimo[v]; ++a)
+		  {
+			bool doppio = false;
+			for(UInt b=inizio[v]; b<n && !doppio; ++b)
+			    doppio = coord(membri[a], 0)==coord(membri[b], 0) && coord(membri[a], 1)==coord(membri[b], 1) && 
+				     coord(membri[a], 2)==coord(membri[b], 2);
+			if(!doppio)	membri[n++] = membri[a];
+		  }
+		  ultimo[v] = n;
+	    }
+	    
+	    // due vertici a distanza minore di toll hanno le celle distanti al massimo 2 in ogni direzione, le celle 
+	    // distanti 2 in tutte e tre sono più lontane di toll. Basta metà delle celle vicine: l'altra metà vede 
+	    // questa cella fra le sue. Le tabelle sono solo lette 
+	    #pragma omp parallel for num_threads(numTh) schedule(dynamic,1024)
+	    for(UInt v=0; v<numVert; ++v)
+	    {
+		  if(rap[v]!=v)	continue;
+		  
+#ifdef _OPENMP
+		  UInt th = omp_get_thread_num();
+#else
+		  UInt th = 0;
+#endif
+		  int64_t c[3],d[3];
+		  
+		  cella(v, c);
+		  for(int i=0; i<=2; ++i)
+		  for(int j=(i==0) ? 0 : -2; j<=2; ++j)
+		  for(int k=(i==0 && j==0) ? 1 : -2; k<=2; ++k)
+		  {
+			if(i==2 && abs(j)==2 && abs(k)==2)	continue;
+			
+			d[0] = c[0]+i;		d[1] = c[1]+j;		d[2] = c[2]+k;
+			uint64_t h = stlHash(d);
+			UInt	 p = (h & 255)%numParti;
+			if(!presente(p, h))	continue;
+			
+			UInt	 w = cerca(p, h, d);
+			if(w==static_cast<UInt>(-1))	continue;
+			
+			bool vicine = false;
+			for(UInt a=inizio[v]; a<ultimo[v] && !vicine; ++a)
+			{
+			      point pa(coord(membri[a], 0), coord(membri[a], 1), coord(membri[a], 2));
+			      for(UInt b=inizio[w]; b<ultimo[w] && !vicine; ++b)
+				  vicine = (pa-point(coord(membri[b], 0), coord(membri[b], 1), coord(membri[b], 2))).norm2()<toll;
+			}
+			if(vicine)	coppie[th].push_back(make_pair(v, w));
+		  }
+	    }
+	    
+	    // unione con il rappresentante più piccolo, le coppie sono poche 
+	    auto radice = [&](UInt v)
+	    {
+		    while(rap[v]!=v)	v = rap[v];
+		    return(v);
+	    };
+	    
+	    for(UInt th=0; th<coppie.size(); ++th)
+	    {
+		  for(UInt k=0; k<coppie[th].size(); ++k)
+		  {
+			UInt a = radice(coppie[th][k].first);
+			UInt b = radice(coppie[th][k].second);
+			if(a<b)		rap[b] = a;
+			else if(b<a)	rap[a] = b;
+		  }
+	    }
+	    
+	    for(UInt th=0; th<coppie.size(); ++th)
+	    {
+		  for(UInt k=0; k<coppie[th].size(); ++k)
+		  {
+			rap[coppie[th][k].first]  = radice(coppie[th][k].first);
+			rap[coppie[th][k].second] = radice(coppie[th][k].second);
+		  }
+	    }
+      }
+      
+      // il nodo di un vertice: i rappresentanti uniti puntano già alla radice 
+      auto nodo = [&](UInt v)
+      {
+	      return(rap[rap[v]]);
+      };
+      
+      auto buono = [&](UInt t)
+      {
+	      UInt a = nodo(3*t), b = nodo(3*t+1), c = nodo(3*t+2);
+	      return(a!=b && b!=c && a!=c);
+      };
+      
+      // conto i triangoli non degeneri di ogni pezzo 
+      contaElem.assign(numTh+1, 0);
+      contaNodi.assign(numTh+1, 0);
+      
+      #pragma omp parallel for num_threads(numTh) schedule(static,1)
+      for(int k=0; k<numTh; ++k)
+      {
+	    for(UInt t=static_cast<size_t>(numTria)*k/numTh; t<static_cast<size_t>(numTria)*(k+1)/numTh; ++t)
+		if(buono(t))	++contaElem[k+1];
+      }
+      for(int k=0; k<numTh; ++k)	contaElem[k+1] += contaElem[k];
+      
+      // i nodi sono le radici usate da almeno un triangolo, se non ci sono triangoli scartati basta la radice 
+      usato.resize(numVert);
+      if(contaElem[numTh]==numTria)
+      {
+	    #pragma omp parallel for num_threads(numTh) schedule(static)
+	    for(UInt v=0; v<numVert; ++v)	usato[v] = (nodo(v)==v);
+      }
+      else
+      {
+	    fill(usato.begin(), usato.end(), 0);
+	    for(UInt t=0; t<numTria; ++t)
+		if(buono(t))	for(UInt j=0; j<3; ++j)	usato[nodo(3*t+j)] = 1;
+      }
+      
+      #pragma omp parallel for num_threads(numTh) schedule(static,1)
+      for(int k=0; k<numTh; ++k)
+      {
+	    for(UInt v=static_cast<size_t>(numVert)*k/numTh; v<static_cast<size_t>(numVert)*(k+1)/numTh; ++v)
+		if(usato[v])	++contaNodi[k+1];
+      }
+      for(int k=0; k<numTh; ++k)	contaNodi[k+1] += contaNodi[k];
+      
+      // riempio i vettori della mesh, come in fileFromParaviewMapped non si pulisce la mesh 
+      nuovo.resize(numVert);
+      mesh->getNodePointer()->resize(contaNodi[numTh]);
+      mesh->getElementPointer()->resize(contaElem[numTh]);
+      
+      #pragma omp parallel for num_threads(numTh) schedule(static,1)
+      for(int k=0; k<numTh; ++k)
+      {
+	    UInt id = contaNodi[k];
+	    for(UInt v=static_cast<size_t>(numVert)*k/numTh; v<static_cast<size_t>(numVert)*(k+1)/numTh; ++v)
+	    {
+		  if(!usato[v])	continue;
+		  
+		  *mesh->getNodePointer(id) = point(coord(v, 0), coord(v, 1), coord(v, 2));
+		  mesh->getNodePointer(id)->setId(id);
+		  nuovo[v] = id++;
+	    }
+      }
+      
+      #pragma omp parallel for num_threads(numTh) schedule(static,1)
+      for(int k=0; k<numTh; ++k)
+      {
+	    UInt id = contaElem[k];
+	    for(UInt t=static_cast<size_t>(numTria)*k/numTh; t<static_cast<size_t>(numTria)*(k+1)/numTh; ++t)
+	    {
+		  if(!buono(t))	continue;
+		  
+		  geoElement<Triangle> * e = mesh->getElementPointer(id);
+		  if(e->getNumConnected()!=3)	*e = geoElement<Triangle>();
+		  for(UInt j=0; j<3; ++j)	e->setConnectedId(j, nuovo[nodo(3*t+j)]);
+		  e->setGeoId(0);
+		  e->setId(id++);
+	    }
+      }
+}
+
 void downloadMesh::fileFromParaview(string s, mesh3d<Tetra> * mesh)
 {
       file.open(s.c_str());
@@ -9,6 +9,7 @@
 #include <sstream>
 #include <map> 
 #include <cmath>
+#include <type_traits>
 
 #include "../core/shapes.hpp"
 #include "../core/point.h"
@@ -22,6 +23,10 @@
 
 #include "../doctor/meshHandler.hpp"
 
+#include "../file/mappedFile.h"
+#include "../file/binaryMesh.h"
+#include "../file/plyFormat.h"
+
 namespace geometry
 {
 
@@ -73,6 +78,19 @@ class downloadMesh
 		      \param mesh oggetto mesh in cui ricopiare le informazioni */
 		  void fileFromParaview(string s, mesh2d<Triangle> * mesh);
 		  
+		  /*! Download una mesh di paraview mappando il file in memoria. Le righe del file sono divise in pezzi letti 
+		      in parallelo che scrivono direttamente nei vettori della mesh già dimensionati. I numeri sono letti 
+		      da mappedFile e sono gli stessi di ifstream >>. È il metodo usato da fileFromParaview per le mesh di 
+		      triangoli 
+		      \param s stringa che identifica il file 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param numThreads numero di thread, se è 0 si usa quello di default di OpenMP 
+		      \return falso se il file non c'è o non ha un record valido per ogni riga non vuota, allora la mesh resta 
+			     vuota e non viene scritto nessun messaggio 
+		      N.B. ogni record deve stare su una riga, se un record è spezzato su più righe o una riga ne ha più di 
+			   uno fileFromParaview rilegge il file a flusso come ifstream >> */
+		  bool fileFromParaviewMapped(string s, mesh2d<Triangle> * mesh, UInt numThreads=0);
+		  
 		  /*! Download una mesh di paraview 
 		      \param s stringa che identifica il file 
 		      \param mesh oggetto mesh in cui ricopiare le informazioni */
@@ -83,6 +101,69 @@ class downloadMesh
 		      \param mesh oggetto mesh in cui ricopiare le informazioni */
 		  void fileFromParaviewNodePropriety(string s, mesh2d<Triangle> * mesh, vector<Real> * ris);
 		  
+		  // -------------------
+		  //  download binario
+		  // -------------------
+		  /*! Download di una mesh1d dal formato binario descritto in binaryMeshHeader 
+		      \param s stringa che identifica il file 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param prop puntatore al vettore in cui ricopiare le proprietà dei nodi, se è NULL non si leggono */
+		  void fileFromBinary(string s, mesh1d<Line> * mesh, vector<vector<Real> > * prop = NULL);
+		  
+		  /*! Download di una mesh2d dal formato binario descritto in binaryMeshHeader 
+		      \param s stringa che identifica il file 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param prop puntatore al vettore in cui ricopiare le proprietà dei nodi, se è NULL non si leggono */
+		  void fileFromBinary(string s, mesh2d<Triangle> * mesh, vector<vector<Real> > * prop = NULL);
+		  
+		  /*! Download di una mesh3d dal formato binario descritto in binaryMeshHeader 
+		      \param s stringa che identifica il file 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param prop puntatore al vettore in cui ricopiare le proprietà dei nodi, se è NULL non si leggono */
+		  void fileFromBinary(string s, mesh3d<Tetra> * mesh, vector<vector<Real> > * prop = NULL);
+		  
+		  /*! Metodo che copia i blocchi di un file binario già aperto in una mesh qualsiasi. Come in 
+		      fileFromParaviewMapped i vettori della mesh sono riusati e riempiti in parallelo 
+		      \param file file binario aperto 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param prop puntatore al vettore in cui ricopiare le proprietà dei nodi, se è NULL non si leggono 
+		      \return falso se il file ha un numero di nodi per elemento diverso da quello della mesh o un identificatore
+			     di nodo fuori dai nodi del file */
+		  template<typename MESH> bool fileFromBinary(const binaryMesh & file, MESH * mesh, vector<vector<Real> > * prop);
+		  
+		  // ----------------
+		  //  download .ply
+		  // ----------------
+		  /*! Download di un file PLY ascii o binary_little_endian. Le facce con più di tre nodi sono divise a 
+		      ventaglio, le proprietà scalari dei vertici diverse da x, y e z sono copiate in prop e la proprietà 
+		      geoId delle facce, se c'è, nei geoId. I file binari sono mappati in memoria e, se tutte le facce sono 
+		      triangoli, i record sono letti in parallelo con memcpy direttamente nei vettori della mesh 
+		      \param s stringa che identifica il file 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param prop puntatore al vettore in cui ricopiare le proprietà dei vertici, se è NULL non si leggono 
+		      \param nomi puntatore al vettore in cui ricopiare i nomi delle proprietà, se è NULL non si leggono 
+		      N.B. i file binary_big_endian non sono supportati, se il file non è valido la mesh resta vuota */
+		  void fileFromPly(string s, mesh2d<Triangle> * mesh, vector<vector<Real> > * prop = NULL, 
+				   vector<string> * nomi = NULL);
+		  
+		  // ----------------
+		  //  download STL
+		  // ----------------
+		  /*! Download di un file STL binario o ascii. Due vertici dei triangoli sono lo stesso nodo se sono a 
+		      distanza minore di toll o se sono uniti da una catena di vertici a distanza minore di toll, il nodo ha 
+		      le coordinate del primo di questi vertici nel file. I vertici sono messi in una tabella hash sulle celle 
+		      di lato toll/sqrt(3), così quelli nella stessa cella sono sempre vicini, e due celle distanti al 
+		      massimo 2 in ogni direzione sono unite se hanno due vertici a distanza minore di toll. Le tabelle sono 
+		      divise fra i thread secondo l'hash della cella. I nodi sono numerati nell'ordine in cui compaiono nel 
+		      file, quindi il risultato non dipende dal numero di thread, e i triangoli che degenerano sono scartati 
+		      \param s stringa che identifica il file 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param toll tolleranza, se è 0 si fondono solo i vertici con le stesse coordinate 
+		      \param numThreads numero di thread, se è 0 si usa quello di default di OpenMP 
+		      N.B. il file è binario se la sua dimensione corrisponde al numero di triangoli dell'intestazione, 
+		      se il file non è valido la mesh resta vuota */
+		  void fileFromStl(string s, mesh2d<Triangle> * mesh, Real toll=0.0, UInt numThreads=0);
+		  
 		  // ----------------
 		  //  download .off
 		  // ----------------
@@ -164,6 +245,73 @@ class downloadMesh
 		      \param mesh oggetto mesh in cui ricopiare le informazioni 
 		      N.B. si presuppone che sia una mesh piana la z è settata a 0*/
 		  void fileFromPlaneMSH(string s, mesh2d<Triangle> * mesh);
+	  //
+	  // Metodo interno per i file di paraview
+	  //
+	  protected:
+		  /*! Download una mesh di paraview leggendo il file a flusso, i record possono essere divisi in righe in 
+		      qualsiasi modo. È usato da fileFromParaview quando fileFromParaviewMapped non riesce a leggere il file 
+		      \param s stringa che identifica il file 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni, se il file non è valido resta vuota */
+		  void fileFromParaviewStream(string s, mesh2d<Triangle> * mesh);
+	  //
+	  // Metodi interni per i file PLY
+	  //
+	  protected:
+		  /*! Metodo che legge un record di un elemento PLY 
+		      \param p posizione del record 
+		      \param fine fine del file 
+		      \param formato formato del file 
+		      \param elem elemento 
+		      \param valori valori delle proprietà scalari, per le liste il numero di valori 
+		      \param lista valori della lista tenuta 
+		      \param tenuta indice della proprietà lista da tenere, le altre liste sono saltate 
+		      \return posizione dopo il record, NULL se il file finisce prima o una lista ha più valori di quelli 
+			     che possono stare nel file */
+		  const char * readPlyRecord(const char * p, const char * fine, plyEncoding formato, const plyElement & elem, 
+					     vector<Real> & valori, vector<UInt> & lista, UInt tenuta);
+		  
+		  /*! Metodo che legge i vertici 
+		      \param p posizione del blocco, viene spostata alla fine del blocco 
+		      \param fine fine del file 
+		      \param formato formato del file 
+		      \param elem elemento dei vertici 
+		      \param mesh mesh 
+		      \param prop proprietà dei vertici 
+		      \param nomi nomi delle proprietà 
+		      \return falso se il blocco non è valido */
+		  bool readPlyVertices(const char * & p, const char * fine, plyEncoding formato, const plyElement & elem, 
+				       mesh2d<Triangle> * mesh, vector<vector<Real> > * prop, vector<string> * nomi);
+		  
+		  /*! Metodo che legge le facce 
+		      \param p posizione del blocco, viene spostata alla fine del blocco 
+		      \param fine fine del file 
+		      \param formato formato del file 
+		      \param elem elemento delle facce 
+		      \param mesh mesh con i nodi già letti 
+		      \return falso se il blocco non è valido */
+		  bool readPlyFaces(const char * & p, const char * fine, plyEncoding formato, const plyElement & elem, 
+				    mesh2d<Triangle> * mesh);
+	  //
+	  // Metodi interni per i file STL
+	  //
+	  protected:
+		  /*! Metodo che legge le coordinate dei vertici di un file STL ascii 
+		      \param p inizio del file 
+		      \param fine fine del file 
+		      \param coord vettore con le tre coordinate di ogni vertice 
+		      \return falso se il file non è valido */
+		  bool readStlAscii(const char * p, const char * fine, vector<Real> & coord);
+		  
+		  /*! Metodo che fonde i vertici dei triangoli e riempie la mesh 
+		      \param numTria numero di triangoli 
+		      \param coord funzione coord(v, j) che restituisce la coordinata j del vertice v, il vertice v è il 
+		      vertice v%3 del triangolo v/3 
+		      \param toll tolleranza 
+		      \param mesh oggetto mesh in cui ricopiare le informazioni 
+		      \param numThreads numero di thread */
+		  template<typename COORD> void weldStl(UInt numTria, COORD coord, Real toll, mesh2d<Triangle> * mesh, 
+							UInt numThreads);
 
 };
 
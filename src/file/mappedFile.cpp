@@ -0,0 +1,83 @@
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPEDFILE_MMAP
+#endif
+
+#include "mappedFile.h"
+
+using namespace geometry;
+
+//
+// Costruttori
+//
+mappedFile::mappedFile()
+{
+      dati       = NULL;
+      dimensione = 0;
+      mappato    = false;
+}
+
+mappedFile::~mappedFile()
+{
+      close();
+}
+
+bool mappedFile::open(string s)
+{
+      // chiudo quello di prima
+      close();
+
+#ifdef MAPPEDFILE_MMAP
+      // variabili in uso
+      struct stat				   info;
+      int	     descrittore = ::open(s.c_str(), O_RDONLY);
+
+      if(descrittore<0)	return(false);
+
+      if(fstat(descrittore, &info)==0 && info.st_size>0)
+      {
+	    void * mappa = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, descrittore, 0);
+	    if(mappa!=MAP_FAILED)
+	    {
+		  // il file viene letto dall'inizio alla fine
+		  madvise(mappa, info.st_size, MADV_SEQUENTIAL);
+
+		  dati       = static_cast<const char *>(mappa);
+		  dimensione = info.st_size;
+		  mappato    = true;
+	    }
+      }
+      ::close(descrittore);
+
+      if(mappato)	return(true);
+#endif
+
+      // copio tutto il file
+      ifstream file(s.c_str(), ios::binary);
+      if(!file.is_open())	return(false);
+
+      file.seekg(0, ios::end);
+      copia.resize(static_cast<size_t>(file.tellg()));
+      file.seekg(0, ios::beg);
+      if(copia.size()>0)	file.read(&copia[0], copia.size());
+
+      dati       = copia.empty() ? NULL : &copia[0];
+      dimensione = copia.size();
+
+      return(true);
+}
+
+void mappedFile::close()
+{
+#ifdef MAPPEDFILE_MMAP
+      if(mappato)	munmap(const_cast<char *>(dati), dimensione);
+#endif
+
+      dati       = NULL;
+      dimensione = 0;
+      mappato    = false;
+      copia.clear();
+}
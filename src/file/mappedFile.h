@@ -0,0 +1,224 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../core/shapes.hpp"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Classe che mappa un file in memoria in sola lettura. Sui sistemi POSIX si usa mmap, altrimenti il file viene letto
+    tutto in un vettore. I metodi statici leggono numeri e parole direttamente dai byte del file senza passare dagli
+    stream: un numero reale è letto esattamente (mantissa fino a 2^53 e potenza di 10 fino a 22, come negli altri
+    casi si passa a strtod) quindi il risultato è lo stesso di ifstream >>. */
+
+class mappedFile
+{
+      //
+      // Variabili di classe
+      //
+      public:
+		  /*! Inizio del file in memoria */
+		  const char *				      dati;
+
+		  /*! Dimensione del file in byte */
+		  size_t				 dimensione;
+
+		  /*! Copia del file quando non si può usare mmap */
+		  vector<char>				      copia;
+
+		  /*! Vero se dati è stato ottenuto con mmap */
+		  bool					    mappato;
+      //
+      // Costruttori
+      //
+      public:
+		  /*! Costruttore */
+		  mappedFile();
+
+		  /*! Distruttore, chiude il file */
+		  ~mappedFile();
+
+		  /*! Il file non si copia */
+		  mappedFile(const mappedFile &) = delete;
+		  mappedFile & operator=(const mappedFile &) = delete;
+
+		  /*! Metodo che apre un file
+		      \param s nome del file
+		      \return falso se il file non si apre */
+		  bool open(string s);
+
+		  /*! Metodo che chiude il file */
+		  void close();
+
+		  /*! Inizio del file */
+		  inline const char * begin() const	{return(dati);};
+
+		  /*! Fine del file */
+		  inline const char * end() const	{return(dati+dimensione);};
+
+		  /*! Dimensione del file */
+		  inline size_t size() const		{return(dimensione);};
+      //
+      // Lettura dei numeri
+      //
+      public:
+		  /*! Metodo che salta gli spazi
+		      \param p posizione
+		      \param fine fine del file
+		      \return posizione del primo carattere che non è uno spazio */
+		  static inline const char * skipSpaces(const char * p, const char * fine);
+
+		  /*! Metodo che salta una parola
+		      \param p posizione
+		      \param fine fine del file
+		      \return posizione dopo la parola */
+		  static inline const char * skipWord(const char * p, const char * fine);
+
+		  /*! Metodo che legge un intero senza segno
+		      \param p posizione
+		      \param fine fine del file
+		      \param v valore letto
+		      \return posizione dopo il numero, NULL se non c'è un numero o se non sta in un UInt */
+		  static inline const char * readUInt(const char * p, const char * fine, UInt & v);
+
+		  /*! Metodo che legge un reale
+		      \param p posizione
+		      \param fine fine del file
+		      \param v valore letto
+		      \return posizione dopo il numero, NULL se non c'è un numero */
+		  static inline const char * readReal(const char * p, const char * fine, Real & v);
+};
+
+//
+// Lettura dei numeri
+//
+inline const char * mappedFile::skipSpaces(const char * p, const char * fine)
+{
+      while(p<fine && (*p==' ' || *p=='\t' || *p=='\n' || *p=='\r'))	++p;
+      return(p);
+}
+
+inline const char * mappedFile::skipWord(const char * p, const char * fine)
+{
+      p = skipSpaces(p, fine);
+      while(p<fine && *p!=' ' && *p!='\t' && *p!='\n' && *p!='\r')	++p;
+      return(p);
+}
+
+inline const char * mappedFile::readUInt(const char * p, const char * fine, UInt & v)
+{
+      // variabili in uso
+      const char *	inizio;
+      uint64_t		valore;
+
+      p = skipSpaces(p, fine);
+      if(p<fine && *p=='+')	++p;
+
+      // il valore cresce in 64 bit e si ferma appena esce da UInt
+      inizio = p;
+      valore = 0;
+      while(p<fine && *p>='0' && *p<='9')
+      {
+	    valore = 10*valore + (*p++ - '0');
+	    if(valore>numeric_limits<UInt>::max())	return(NULL);
+      }
+      v = static_cast<UInt>(valore);
+
+      return((p==inizio) ? NULL : p);
+}
+
+inline const char * mappedFile::readReal(const char * p, const char * fine, Real & v)
+{
+      // potenze di 10 rappresentate esattamente
+      static const Real potenze[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+				       1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+      // variabili in uso
+      const char *				inizio;
+      bool			negativo=false,ok=true,numero=false;
+      uint64_t				       mantissa=0;
+      int			  cifre=0,esponente=0,espFile=0;
+      char					  parola[64];
+      char *					     dopo;
+
+      p      = skipSpaces(p, fine);
+      inizio = p;
+
+      if(p<fine && (*p=='+' || *p=='-'))	negativo = (*p++=='-');
+
+      // parte intera e decimale, gli zeri iniziali non contano come cifre
+      for(; p<fine && *p>='0' && *p<='9'; ++p)
+      {
+	    numero = true;
+	    if(mantissa==0 && *p=='0')	continue;
+	    if(++cifre<=19)		mantissa = 10*mantissa + (*p - '0');
+	    else			++esponente;
+      }
+      if(p<fine && *p=='.')
+      {
+	    for(++p; p<fine && *p>='0' && *p<='9'; ++p)
+	    {
+		  numero = true;
+		  if(mantissa==0 && *p=='0')
+		  {
+			--esponente;
+			continue;
+		  }
+		  if(++cifre<=19)
+		  {
+			mantissa = 10*mantissa + (*p - '0');
+			--esponente;
+		  }
+	    }
+      }
+
+      // deve esserci almeno una cifra
+      if(!numero)	ok = false;
+
+      if(ok && p<fine && (*p=='e' || *p=='E'))
+      {
+	    const char * q = p+1;
+	    bool espNeg = false;
+	    if(q<fine && (*q=='+' || *q=='-'))	espNeg = (*q++=='-');
+	    if(q<fine && *q>='0' && *q<='9')
+	    {
+		  for(; q<fine && *q>='0' && *q<='9'; ++q)	if(espFile<100000)	espFile = 10*espFile + (*q - '0');
+		  esponente += espNeg ? -espFile : espFile;
+		  p = q;
+	    }
+      }
+
+      // caso esatto, altrimenti strtod sulla parola copiata
+      if(ok && p<fine && *p!=' ' && *p!='\t' && *p!='\n' && *p!='\r')	ok = false;
+      if(ok && cifre<=19 && mantissa<=(static_cast<uint64_t>(1)<<53) && esponente>=-22 && esponente<=22)
+      {
+	    v = static_cast<Real>(mantissa);
+	    v = (esponente<0) ? v/potenze[-esponente] : v*potenze[esponente];
+	    if(negativo)	v = -v;
+	    return(p);
+      }
+
+      p = skipWord(inizio, fine);
+      if(p==inizio || static_cast<size_t>(p-inizio)>=sizeof(parola))	return(NULL);
+
+      memcpy(parola, inizio, p-inizio);
+      parola[p-inizio] = '\0';
+      v = strtod(parola, &dopo);
+
+      return((dopo==parola) ? NULL : inizio+(dopo-parola));
+}
+
+}
+
+#endif
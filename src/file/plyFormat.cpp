@@ -0,0 +1,129 @@
+#include "plyFormat.h"
+
+using namespace geometry;
+
+//
+// Intestazione
+//
+bool plyFormat::readHeader(const char * inizio, const char * fine, plyEncoding & formato, vector<plyElement> & elementi,
+			   const char * & dati)
+{
+      // variabili in uso
+      const char *				      p=inizio,*r;
+      string				       riga,parola,tipo;
+      plyProperty					   prop;
+      plyElement					   elem;
+      bool					   trovato=false;
+
+      elementi.clear();
+
+      // le righe dell'intestazione fino a end_header
+      for(UInt n=0; p<fine; ++n)
+      {
+	    r = static_cast<const char *>(memchr(p, '\n', fine-p));
+	    if(r==NULL)	return(false);
+
+	    riga.assign(p, r);
+	    if(!riga.empty() && riga[riga.size()-1]=='\r')	riga.erase(riga.size()-1);
+	    p = r+1;
+
+	    istringstream in(riga);
+	    in >> parola;
+
+	    if(n==0)
+	    {
+		  if(parola!="ply")	return(false);
+		  continue;
+	    }
+
+	    if(parola=="format")
+	    {
+		  in >> parola;
+		  if(parola=="ascii")				formato = PLYASCII;
+		  else if(parola=="binary_little_endian")	formato = PLYLITTLE;
+		  else if(parola=="binary_big_endian")		formato = PLYBIG;
+		  else						return(false);
+		  trovato = true;
+	    }
+	    else if(parola=="element")
+	    {
+		  elem.proprieta.clear();
+		  in >> elem.nome >> elem.numero;
+		  if(in.fail())	return(false);
+		  elementi.push_back(elem);
+	    }
+	    else if(parola=="property")
+	    {
+		  if(elementi.empty())	return(false);
+
+		  in >> tipo;
+		  prop.lista = (tipo=="list");
+		  if(prop.lista)
+		  {
+			in >> tipo;
+			prop.tipoConteggio = typeOf(tipo);
+			in >> tipo;
+		  }
+		  else
+		  {
+			prop.tipoConteggio = PLYNONE;
+		  }
+		  prop.tipo = typeOf(tipo);
+		  in >> prop.nome;
+
+		  if(in.fail() || prop.tipo==PLYNONE || (prop.lista && prop.tipoConteggio==PLYNONE))	return(false);
+		  elementi.back().proprieta.push_back(prop);
+	    }
+	    else if(parola=="end_header")
+	    {
+		  dati = p;
+		  return(trovato);
+	    }
+      }
+
+      return(false);
+}
+
+plyType plyFormat::typeOf(string nome)
+{
+      if(nome=="char"   || nome=="int8")	return(PLYCHAR);
+      if(nome=="uchar"  || nome=="uint8")	return(PLYUCHAR);
+      if(nome=="short"  || nome=="int16")	return(PLYSHORT);
+      if(nome=="ushort" || nome=="uint16")	return(PLYUSHORT);
+      if(nome=="int"    || nome=="int32")	return(PLYINT);
+      if(nome=="uint"   || nome=="uint32")	return(PLYUINT);
+      if(nome=="float"  || nome=="float32")	return(PLYFLOAT);
+      if(nome=="double" || nome=="float64")	return(PLYDOUBLE);
+
+      return(PLYNONE);
+}
+
+UInt plyFormat::recordSize(const plyElement & elem, UInt numValori)
+{
+      // variabili in uso
+      UInt	dim=0;
+
+      for(UInt j=0; j<elem.proprieta.size(); ++j)
+      {
+	    if(elem.proprieta[j].lista)	dim += sizeOf(elem.proprieta[j].tipoConteggio) + numValori*sizeOf(elem.proprieta[j].tipo);
+	    else			dim += sizeOf(elem.proprieta[j].tipo);
+      }
+
+      return(dim);
+}
+
+bool plyFormat::hasLists(const plyElement & elem)
+{
+      for(UInt j=0; j<elem.proprieta.size(); ++j)
+	  if(elem.proprieta[j].lista)	return(true);
+
+      return(false);
+}
+
+bool plyFormat::fits(const plyElement & elem, plyEncoding formato, size_t byte)
+{
+      // variabili in uso
+      size_t	minimo = (formato==PLYASCII) ? 1 : recordSize(elem, 0);
+
+      return(static_cast<size_t>(elem.numero)*minimo<=byte);
+}
@@ -0,0 +1,150 @@
+#ifndef PLYFORMAT_H_
+#define PLYFORMAT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../core/shapes.hpp"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Tipi dei numeri di un file PLY */
+enum plyType {PLYCHAR=0, PLYUCHAR=1, PLYSHORT=2, PLYUSHORT=3, PLYINT=4, PLYUINT=5, PLYFLOAT=6, PLYDOUBLE=7, PLYNONE=8};
+
+/*! Formati di un file PLY */
+enum plyEncoding {PLYASCII=0, PLYLITTLE=1, PLYBIG=2};
+
+/*! Proprietà di un elemento PLY, se è una lista tipoConteggio è il tipo del numero di valori e tipo quello dei
+    valori */
+struct plyProperty
+{
+      /*! Nome */
+      string				nome;
+
+      /*! Tipo dei valori */
+      plyType				tipo;
+
+      /*! Vero se è una lista */
+      bool				lista;
+
+      /*! Tipo del numero di valori della lista */
+      plyType			 tipoConteggio;
+};
+
+/*! Elemento di un file PLY (vertex, face o altro) con il numero di record e le proprietà */
+struct plyElement
+{
+      /*! Nome */
+      string				nome;
+
+      /*! Numero di record */
+      UInt			      numero;
+
+      /*! Proprietà */
+      vector<plyProperty>	  proprieta;
+};
+
+/*! Classe con i metodi che leggono l'intestazione di un file PLY e i numeri dei blocchi binari. I numeri binari sono
+    letti con memcpy quindi possono non essere allineati. */
+
+class plyFormat
+{
+      //
+      // Intestazione
+      //
+      public:
+		  /*! Metodo che legge l'intestazione
+		      \param inizio inizio del file
+		      \param fine fine del file
+		      \param formato formato del file
+		      \param elementi elementi nell'ordine del file
+		      \param dati posizione del primo byte dopo end_header
+		      \return falso se l'intestazione non è valida */
+		  static bool readHeader(const char * inizio, const char * fine, plyEncoding & formato,
+					 vector<plyElement> & elementi, const char * & dati);
+
+		  /*! Metodo che restituisce il tipo dal nome (char, uchar, ..., int8, uint8, ..., float64)
+		      \param nome nome del tipo */
+		  static plyType typeOf(string nome);
+
+		  /*! Metodo che restituisce la dimensione in byte di un tipo
+		      \param tipo tipo */
+		  static inline UInt sizeOf(plyType tipo);
+
+		  /*! Metodo che legge un numero binario nell'ordine della macchina
+		      \param p posizione
+		      \param tipo tipo */
+		  static inline Real value(const char * p, plyType tipo);
+
+		  /*! Metodo che dice se la macchina è little endian */
+		  static inline bool isLittleEndian();
+
+		  /*! Metodo che restituisce la dimensione di un record binario se è fissa (nessuna lista o tutte le liste
+		      con numValori valori), 0 se l'elemento ha tipi non validi
+		      \param elem elemento
+		      \param numValori numero di valori delle liste */
+		  static UInt recordSize(const plyElement & elem, UInt numValori);
+
+		  /*! Metodo che dice se un elemento ha delle proprietà lista
+		      \param elem elemento */
+		  static bool hasLists(const plyElement & elem);
+
+		  /*! Metodo che dice se i record di un elemento possono stare nei byte rimasti: in binario ogni record ha 
+		      almeno recordSize(elem, 0) byte, in ascii almeno un carattere. Va chiamato prima di allocare i 
+		      vettori con il numero di record dell'intestazione 
+		      \param elem elemento
+		      \param formato formato del file
+		      \param byte byte rimasti nel file */
+		  static bool fits(const plyElement & elem, plyEncoding formato, size_t byte);
+};
+
+//
+// Numeri
+//
+inline UInt plyFormat::sizeOf(plyType tipo)
+{
+      switch(tipo)
+      {
+	    case(PLYCHAR):	case(PLYUCHAR):		return(1);
+	    case(PLYSHORT):	case(PLYUSHORT):	return(2);
+	    case(PLYINT):	case(PLYUINT):	case(PLYFLOAT):	return(4);
+	    case(PLYDOUBLE):			return(8);
+	    default:				return(0);
+      }
+}
+
+inline Real plyFormat::value(const char * p, plyType tipo)
+{
+      switch(tipo)
+      {
+	    case(PLYCHAR):	{int8_t   v;	memcpy(&v, p, 1);	return(v);}
+	    case(PLYUCHAR):	{uint8_t  v;	memcpy(&v, p, 1);	return(v);}
+	    case(PLYSHORT):	{int16_t  v;	memcpy(&v, p, 2);	return(v);}
+	    case(PLYUSHORT):	{uint16_t v;	memcpy(&v, p, 2);	return(v);}
+	    case(PLYINT):	{int32_t  v;	memcpy(&v, p, 4);	return(v);}
+	    case(PLYUINT):	{uint32_t v;	memcpy(&v, p, 4);	return(v);}
+	    case(PLYFLOAT):	{float    v;	memcpy(&v, p, 4);	return(v);}
+	    case(PLYDOUBLE):	{double   v;	memcpy(&v, p, 8);	return(v);}
+	    default:		return(0.0);
+      }
+}
+
+inline bool plyFormat::isLittleEndian()
+{
+      uint16_t	uno = 1;
+      char	  primo;
+
+      memcpy(&primo, &uno, 1);
+      return(primo==1);
+}
+
+}
+
+#endif
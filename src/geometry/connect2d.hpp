@@ -7,6 +7,8 @@
 #include <vector>
 #include <set>
 
+#include "../core/graphCSR.hpp"
+
 #include "../geometry/mesh1d.hpp"
 #include "../geometry/mesh2d.hpp"
 #include "../geometry/mesh3d.hpp"
@@ -15,6 +17,17 @@ namespace geometry{
 
 using namespace std;
 
+/*! Contenitore delle connettività di connect2d. Di default ogni nodo/elemento ha il suo graphItem; compilando con 
+    CSR_CONNECTIVITY (opzione CSR_CONNECTIVITY di cmake) si usa graphCSR che mette tutti gli id in un unico vettore 
+    e restituisce per ogni riga un graphRow con gli stessi metodi di graphItem. */
+#ifdef CSR_CONNECTIVITY
+typedef graphCSR	     graphList;
+typedef graphRow	      graphRef;
+#else
+typedef vector<graphItem>    graphList;
+typedef graphItem *	      graphRef;
+#endif
+
 /*! Classe che implementa le connessioni per le mesh2d. Restituisce principalmente le seguenti informazioni:
     
     <ol>
@@ -36,13 +49,13 @@ template<typename GEOSHAPE> class connect2d
 		mesh2d<GEOSHAPE>           *  meshPointer;
 			  
 		/*! Vettore che contiene la connettività nodo-nodo*/
-		vector<graphItem> 	       nodeToNode;
+		graphList 	       	       nodeToNode;
 		
 		/*! Vettore che contiene la connettività elemento-elemento*/
-		vector<graphItem> 	 elementToElement;
+		graphList 		 elementToElement;
 		
 		/*! Vettore che contiene la connettività nodo-elemento*/
-		vector<graphItem>           nodeToElement;
+		graphList 	            nodeToElement;
 	//
 	// Costruttori set/get
 	//
@@ -68,25 +81,25 @@ template<typename GEOSHAPE> class connect2d
 	//
 	public:
 		/*! Puntatore alla lista delle connettività nodo-nodo*/
-		vector<graphItem> * getNodeToNodePointer();
+		graphList * getNodeToNodePointer();
 		
 		/*! Puntatore alla lista delle connettività elemento-elemento*/
-		vector<graphItem> * getElementToElementPointer();
+		graphList * getElementToElementPointer();
 		
 		/*! Puntatore alla lista delle connettività nodo-elemento*/
-		vector<graphItem> * getNodeToElementPointer();
+		graphList * getNodeToElementPointer();
 		
 		/*! Puntatore alla connettività nodo-nodo del nodo nodeId
 		    \param nodeId identificatore del nodo*/
-		graphItem * getNodeToNodePointer(UInt nodeId);
+		graphRef getNodeToNodePointer(UInt nodeId);
 		
 		/*! Puntatore alla connettività elemento-elemento dell'elemento elemId
 		    \param elemId identificatore dell'elemento */
-		graphItem * getElementToElementPointer(UInt elemId);
+		graphRef getElementToElementPointer(UInt elemId);
 		
 		/*! Puntatore alla connettività nodo-elemento del nodo nodeId
 		    \param nodeId identificatore del nodo*/
-		graphItem * getNodeToElementPointer(UInt nodeId);
+		graphRef getNodeToElementPointer(UInt nodeId);
 	//
 	// Metodi che creano le connessioni partendo solo dall'informazioni della mesh2d
 	//
@@ -171,37 +184,37 @@ template<typename GEOSHAPE> void connect2d<GEOSHAPE>::clear()
 //
 // Metodi che restituiscono i puntatori alle strutture dati:
 //
-template<typename GEOSHAPE> vector<graphItem> * connect2d<GEOSHAPE>::getNodeToNodePointer()
+template<typename GEOSHAPE> graphList * connect2d<GEOSHAPE>::getNodeToNodePointer()
 {
 	return(&nodeToNode);
 }
 		
-template<typename GEOSHAPE> vector<graphItem> * connect2d<GEOSHAPE>::getElementToElementPointer()
+template<typename GEOSHAPE> graphList * connect2d<GEOSHAPE>::getElementToElementPointer()
 {
 	return(&elementToElement);
 }
 		
-template<typename GEOSHAPE> vector<graphItem> * connect2d<GEOSHAPE>::getNodeToElementPointer()
+template<typename GEOSHAPE> graphList * connect2d<GEOSHAPE>::getNodeToElementPointer()
 {
 	return(&nodeToElement);
 }
 
-template<typename GEOSHAPE> graphItem * connect2d<GEOSHAPE>::getNodeToNodePointer(UInt nodeId)
+template<typename GEOSHAPE> graphRef connect2d<GEOSHAPE>::getNodeToNodePointer(UInt nodeId)
 {
 	assert(nodeId<meshPointer->getNumNodes());
-	return(&nodeToNode[nodeId]);
+	return(graphReference(nodeToNode, nodeId));
 }
 		
-template<typename GEOSHAPE> graphItem * connect2d<GEOSHAPE>::getElementToElementPointer(UInt elemId)
+template<typename GEOSHAPE> graphRef connect2d<GEOSHAPE>::getElementToElementPointer(UInt elemId)
 {
 	assert(elemId<meshPointer->getNumElements());
-	return(&elementToElement[elemId]);
+	return(graphReference(elementToElement, elemId));
 }
 		
-template<typename GEOSHAPE> graphItem * connect2d<GEOSHAPE>::getNodeToElementPointer(UInt nodeId)
+template<typename GEOSHAPE> graphRef connect2d<GEOSHAPE>::getNodeToElementPointer(UInt nodeId)
 {
 	assert(nodeId<meshPointer->getNumNodes());
-	return(&nodeToElement[nodeId]);
+	return(graphReference(nodeToElement, nodeId));
 }
 
 //
@@ -263,10 +276,26 @@ template<typename GEOSHAPE> void connect2d<GEOSHAPE>::buildNodeToElement(bool ve
 	  if(verbose)	cout << "Costruzione connettività 2d nodoElemento..." << endl;
 	  time(&start);
 	  
+	  // conto gli elementi di ogni nodo così ogni lista viene allocata una sola volta
+	  vector<UInt> cont(meshPointer->getNumNodes(), 0);
+	  for(UInt i=0; i<meshPointer->getNumElements(); ++i)
+		  for(UInt j=0; j<num; ++j)	
+			  ++cont[meshPointer->getElement(i).getConnectedId(j)];
+	  
+	  for(UInt i=0; i<meshPointer->getNumNodes(); ++i)
+	  {
+		  nodeToElement[i].connectedResize(cont[i]);
+		  cont[i] = 0;
+	  }
+	  
 	  // Ciclo sugli elementi
 	  for(UInt i=0; i<meshPointer->getNumElements(); ++i)
 		  for(UInt j=0; j<num; ++j)	
-			  nodeToElement[meshPointer->getElement(i).getConnectedId(j)].connectedPushBack(i);
+		  {
+			  UInt id = meshPointer->getElement(i).getConnectedId(j);
+			  nodeToElement[id].setConnectedId(cont[id], i);
+			  ++cont[id];
+		  }
 	  
 	  time(&end);
 	  dif = difftime(end,start);
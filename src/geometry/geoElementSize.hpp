@@ -1,8 +1,10 @@
 #ifndef GEOELEMENTSIZE_HPP_
 #define GEOELEMENTSIZE_HPP_
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "../geometry/geoElement.hpp"
 
@@ -147,6 +149,23 @@ template<typename GEOSHAPE> void geoElementSize<GEOSHAPE>::print()
 	cout << endl;
 }
 
+
+//-------------------------------------------------------------------------------------------------------
+// FUNZIONI DI UTILITÀ
+//-------------------------------------------------------------------------------------------------------
+
+/*! Funzione che ordina un vettore di elementi e toglie quelli equivalenti tenendo il primo, come se fossero inseriti 
+    uno alla volta in un set. Serve per caricare in blocco le liste dopo aver calcolato i costi in parallelo 
+    \param lista vettore da ordinare */
+template<typename ELEMENT> void sortAsSet(vector<ELEMENT> * lista)
+{
+	// ordinamento stabile così fra gli equivalenti rimane il primo inserito 
+	stable_sort(lista->begin(), lista->end());
+	
+	// tolgo gli equivalenti 
+	lista->erase(unique(lista->begin(), lista->end(), 
+			    [](const ELEMENT & a, const ELEMENT & b) {return(!(a<b) && !(b<a));}), lista->end());
+}
 }
 
 #endif
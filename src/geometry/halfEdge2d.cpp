@@ -0,0 +1,446 @@
+#include "halfEdge2d.h"
+
+using namespace std;
+using namespace geometry;
+
+const UInt halfEdge2d<Triangle>::NONE;
+
+//
+// Constructors
+//
+halfEdge2d<Triangle>::halfEdge2d()
+{
+    meshPointer = NULL;
+}
+
+halfEdge2d<Triangle>::halfEdge2d(mesh2d<Triangle> * _meshPointer)
+{
+    setMeshPointer(_meshPointer);
+}
+
+bool halfEdge2d<Triangle>::setMeshPointer(mesh2d<Triangle> * _meshPointer)
+{
+    meshPointer = _meshPointer;
+    return(build());
+}
+
+bool halfEdge2d<Triangle>::build()
+{
+    // variables
+    bool						     ok=true;
+    UInt						   a,b,h1,h2;
+    vector<UInt>					     numOut;
+    vector<pair<unsigned long long, UInt> >			keys;
+
+    // clean
+    twin.assign(3*meshPointer->getNumElements(), NONE);
+    outgoing.assign(meshPointer->getNumNodes(), NONE);
+    singular.assign(meshPointer->getNumNodes(), false);
+    numOut.assign(meshPointer->getNumNodes(), 0);
+    keys.reserve(twin.size());
+
+    // every half edge is stored with the key of its edge
+    for(UInt t=0; t<meshPointer->getNumElements(); ++t)
+    {
+	if(isFaceDegenerate(t))	continue;
+
+	for(UInt k=0; k<3; ++k)
+	{
+	    a = origin(3*t+k);
+	    b = target(3*t+k);
+
+	    outgoing[a] = 3*t+k;
+	    ++numOut[a];
+	    keys.push_back(make_pair((static_cast<unsigned long long>(min(a,b))<<32) | max(a,b), 3*t+k));
+	}
+    }
+
+    // the two half edges of an edge are close after the sort
+    sort(keys.begin(), keys.end());
+    for(UInt i=0; i<keys.size(); )
+    {
+	UInt j = i+1;
+	while((j<keys.size()) && (keys[j].first==keys[i].first))	++j;
+
+	if(j-i==2)
+	{
+	    h1 = keys[i].second;
+	    h2 = keys[i+1].second;
+
+	    // the orientation has to be coherent
+	    if(origin(h1)==target(h2))
+	    {
+		twin[h1] = h2;
+		twin[h2] = h1;
+	    }
+	    else	ok = false;
+	}
+	else if(j-i>2)	ok = false;
+
+	i = j;
+    }
+
+    // the outgoing half edges of the boundary nodes are put on the boundary
+    for(UInt i=0; i<outgoing.size(); ++i)
+	if(outgoing[i]!=NONE)	fixOutgoing(i);
+
+    // if the rotation does not see all the half edges of the node more fans touch at the node
+    for(UInt i=0; i<outgoing.size(); ++i)
+	if(outgoing[i]!=NONE)	singular[i] = (getNumFan(i)!=numOut[i]);
+
+    if(!ok)	cout << "La mesh non è una varietà orientata in modo coerente, halfEdge2d non è completo" << endl;
+
+    return(ok);
+}
+
+void halfEdge2d<Triangle>::clear()
+{
+    meshPointer = NULL;
+    twin.clear();
+    outgoing.clear();
+    singular.clear();
+    fan.clear();
+}
+
+UInt halfEdge2d<Triangle>::findHalfEdge(UInt id1, UInt id2) const
+{
+    // rotation around id1
+    UInt start = outgoing[id1];
+    UInt h     = start;
+
+    if(h==NONE)	return(NONE);
+
+    do
+    {
+	if(target(h)==id2)	return(h);
+	h = nextAround(h);
+    }
+    while((h!=NONE) && (h!=start));
+
+    return(NONE);
+}
+
+//
+// Queries with the same meaning of the ones of tricky2d
+//
+void halfEdge2d<Triangle>::elementOnEdge(UInt id1, UInt id2, vector<UInt> * ele) const
+{
+    // clean
+    ele->clear();
+
+    // the edge can be oriented in both the directions
+    UInt h = findHalfEdge(id1, id2);
+    if(h==NONE)
+    {
+	h = findHalfEdge(id2, id1);
+	if(h==NONE)	return;
+    }
+
+    ele->push_back(face(h));
+    if(twin[h]!=NONE)	ele->push_back(face(twin[h]));
+}
+
+UInt halfEdge2d<Triangle>::numElementOnEdge(UInt id1, UInt id2) const
+{
+    UInt h = findHalfEdge(id1, id2);
+    if(h==NONE)	h = findHalfEdge(id2, id1);
+    if(h==NONE)	return(0);
+
+    return((twin[h]==NONE) ? 1 : 2);
+}
+
+void halfEdge2d<Triangle>::getElementAround(UInt id1, vector<UInt> * ids) const
+{
+    // clean
+    ids->clear();
+
+    UInt start = outgoing[id1];
+    UInt h     = start;
+
+    if(h==NONE)	return;
+
+    do
+    {
+	ids->push_back(face(h));
+	h = nextAround(h);
+    }
+    while((h!=NONE) && (h!=start));
+}
+
+void halfEdge2d<Triangle>::createStellata(UInt id1, vector<UInt> * ids) const
+{
+    // clean
+    ids->clear();
+
+    UInt start = outgoing[id1];
+    UInt h     = start;
+    UInt last  = start;
+
+    if(h==NONE)	return;
+
+    do
+    {
+	ids->push_back(target(h));
+	last = h;
+	h    = nextAround(h);
+    }
+    while((h!=NONE) && (h!=start));
+
+    // on the boundary the last node is the origin of the incoming half edge
+    if(h==NONE)	ids->push_back(origin(prev(last)));
+
+    // same order of tricky2d
+    sort(ids->begin(), ids->end());
+}
+
+UInt halfEdge2d<Triangle>::getValence(UInt id1) const
+{
+    UInt start = outgoing[id1];
+    UInt h     = start;
+    UInt cont  = 0;
+
+    if(h==NONE)	return(0);
+
+    do
+    {
+	++cont;
+	h = nextAround(h);
+    }
+    while((h!=NONE) && (h!=start));
+
+    // the last node of the boundary
+    if(h==NONE)	++cont;
+
+    return(cont);
+}
+
+void halfEdge2d<Triangle>::oppositeTria(UInt id1, UInt id2, UInt elemId, vector<UInt> * ids) const
+{
+    // variables
+    vector<UInt> tmp;
+
+    // triangles on the edge
+    elementOnEdge(id1, id2, &tmp);
+
+    for(UInt i=0; i<tmp.size(); ++i)
+	if(tmp[i]!=elemId)	ids->push_back(tmp[i]);
+}
+
+void halfEdge2d<Triangle>::atroEdge(vector<UInt> * edge, vector<UInt> * altro) const
+{
+    // clean
+    altro->clear();
+
+    UInt h = findHalfEdge(edge->at(0), edge->at(1));
+    if((h==NONE) || (twin[h]==NONE))	return;
+
+    // the third nodes of the two triangles
+    altro->push_back(origin(prev(h)));
+    altro->push_back(origin(prev(twin[h])));
+}
+
+void halfEdge2d<Triangle>::getLink(vector<UInt> * edge, vector<vector<UInt> > * link) const
+{
+    // variables
+    vector<UInt>	 ext(2),elem;
+    UInt		    third;
+
+    // triangles on the edge
+    elementOnEdge(edge->at(0), edge->at(1), &elem);
+
+    link->clear();
+    link->reserve(2*elem.size());
+
+    for(UInt i=0; i<elem.size(); ++i)
+    {
+	// the node of the triangle which is not on the edge
+	third = 0;
+	for(UInt k=0; k<3; ++k)
+	{
+	    UInt id = meshPointer->getElement(elem[i]).getConnectedId(k);
+	    if((id!=edge->at(0)) && (id!=edge->at(1)))	third = id;
+	}
+
+	ext[0] = third;
+	ext[1] = edge->at(0);
+	link->push_back(ext);
+
+	ext[1] = edge->at(1);
+	link->push_back(ext);
+    }
+}
+
+//
+// Collapse
+//
+bool halfEdge2d<Triangle>::isCollapsable(UInt from, UInt to) const
+{
+    // variables
+    UInt		   h,numOpposite=0,numCommon=0;
+    UInt		       opposite[2]={NONE,NONE};
+    vector<UInt>			    ring1,ring2;
+
+    // the nodes have to be regular
+    if(singular[from] || singular[to])	return(false);
+
+    // the edge has to exist
+    h = findHalfEdge(from, to);
+    if(h==NONE)	h = findHalfEdge(to, from);
+    if(h==NONE)	return(false);
+
+    // opposite nodes
+    opposite[numOpposite++] = origin(prev(h));
+    if(twin[h]!=NONE)	opposite[numOpposite++] = origin(prev(twin[h]));
+
+    // a boundary node can move only along the boundary
+    if(isBoundaryNode(from) && (twin[h]!=NONE))	return(false);
+
+    // link condition: the common neighbours are only the opposite nodes
+    createStellata(from, &ring1);
+    createStellata(to,   &ring2);
+
+    for(UInt i=0, j=0; (i<ring1.size()) && (j<ring2.size()); )
+    {
+	if(ring1[i]<ring2[j])		++i;
+	else if(ring2[j]<ring1[i])	++j;
+	else
+	{
+	    if((ring1[i]!=opposite[0]) && (ring1[i]!=opposite[1]))	return(false);
+	    ++numCommon;
+	    ++i;
+	    ++j;
+	}
+    }
+
+    if(numCommon!=numOpposite)	return(false);
+
+    // a tetrahedron cannot be collapsed
+    if((ring1.size()==3) && (ring2.size()==3) && (numOpposite==2))	return(false);
+
+    return(true);
+}
+
+bool halfEdge2d<Triangle>::collapse(UInt from, UInt to)
+{
+    // variables
+    UInt		     h,start,tn,tp,x,c,newOut;
+    UInt	  dead[2]={NONE,NONE},third[2]={NONE,NONE},edgeHalf[2];
+    UInt	 			 candidateTo=NONE;
+    UInt	   		    candidateThird[2]={NONE,NONE};
+
+    // the half edge on the edge
+    h = findHalfEdge(from, to);
+    if(h==NONE)	h = findHalfEdge(to, from);
+    if(h==NONE)	return(false);
+
+    // the two half edges of the edge, the twins are changed below
+    edgeHalf[0] = h;
+    edgeHalf[1] = twin[h];
+
+    dead[0] = face(h);
+    if(twin[h]!=NONE)	dead[1] = face(twin[h]);
+
+    // the fan of "from" is stored before changing anything
+    fan.clear();
+    start = outgoing[from];
+    x     = start;
+    do
+    {
+	fan.push_back(x);
+	x = nextAround(x);
+    }
+    while((x!=NONE) && (x!=start));
+
+    // the triangles on the edge are removed and the twins across them are joined
+    for(UInt s=0; s<2; ++s)
+    {
+	if(dead[s]==NONE)	continue;
+
+	x  = edgeHalf[s];
+	c  = origin(prev(x));
+	tn = twin[next(x)];
+	tp = twin[prev(x)];
+
+	third[s] = c;
+
+	// new outgoing half edges of the third node and of the merged node
+	if(tn!=NONE)		candidateThird[s] = tn;
+	else if(tp!=NONE)	candidateThird[s] = next(tp);
+
+	if((candidateTo==NONE) && (tp!=NONE))		candidateTo = tp;
+	else if((candidateTo==NONE) && (tn!=NONE))	candidateTo = next(tn);
+
+	if(tn!=NONE)	twin[tn] = tp;
+	if(tp!=NONE)	twin[tp] = tn;
+
+	twin[x] = twin[next(x)] = twin[prev(x)] = NONE;
+    }
+
+    // the triangles of "from" go to "to"
+    for(UInt i=0; i<fan.size(); ++i)
+	meshPointer->getElementPointer(face(fan[i]))->setConnectedId(fan[i]%3, to);
+
+    // the removed triangles become degenerate
+    for(UInt s=0; s<2; ++s)
+    {
+	if(dead[s]==NONE)	continue;
+
+	meshPointer->getElementPointer(dead[s])->setConnectedId(0, 0);
+	meshPointer->getElementPointer(dead[s])->setConnectedId(1, 0);
+	meshPointer->getElementPointer(dead[s])->setConnectedId(2, 0);
+    }
+
+    // outgoing half edges
+    outgoing[from] = NONE;
+
+    newOut = outgoing[to];
+    if((face(newOut)==dead[0]) || (face(newOut)==dead[1]))	newOut = candidateTo;
+    outgoing[to] = newOut;
+    if(newOut!=NONE)	fixOutgoing(to);
+
+    for(UInt s=0; s<2; ++s)
+    {
+	if(third[s]==NONE)	continue;
+
+	newOut = outgoing[third[s]];
+	if((face(newOut)==dead[0]) || (face(newOut)==dead[1]))	newOut = candidateThird[s];
+	outgoing[third[s]] = newOut;
+	if(newOut!=NONE)	fixOutgoing(third[s]);
+    }
+
+    return(true);
+}
+
+//
+// Internal methods
+//
+void halfEdge2d<Triangle>::fixOutgoing(UInt nodeId)
+{
+    // clockwise rotation until the boundary or until the start
+    UInt start = outgoing[nodeId];
+    UInt h     = start;
+
+    while(twin[h]!=NONE)
+    {
+	h = next(twin[h]);
+	if(h==start)	return;
+    }
+
+    outgoing[nodeId] = h;
+}
+
+UInt halfEdge2d<Triangle>::getNumFan(UInt nodeId) const
+{
+    UInt start = outgoing[nodeId];
+    UInt h     = start;
+    UInt cont  = 0;
+
+    do
+    {
+	++cont;
+	h = nextAround(h);
+    }
+    while((h!=NONE) && (h!=start));
+
+    return(cont);
+}
@@ -0,0 +1,270 @@
+#ifndef HALFEDGE2D_H_
+#define HALFEDGE2D_H_
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../core/shapes.hpp"
+#include "../core/point.h"
+
+#include "../geometry/geoElement.hpp"
+#include "../geometry/mesh2d.hpp"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Half-edge (directed edge) representation of a surface mesh */
+
+template<typename GEOSHAPE> class halfEdge2d
+{
+};
+
+/*! Directed edge representation of a triangular surface. The half edges are implicit: the half edge h = 3*t+k goes
+    from the k-th to the (k+1)-th node of the triangle t, so next, prev, face, origin and target are computed without
+    any storage. The class only stores the twin of every half edge and one outgoing half edge for each node (the
+    boundary one if the node is on the boundary, so that the counter-clockwise rotation visits the whole fan).
+
+    All the queries cost O(valence) and do not allocate memory apart from the output vectors given by the caller.
+    The half-edge collapse changes the triangles of mesh2d directly: the removed triangles are set degenerate as in
+    tricky2d::setTriangleDegenerate, so that the usual refresh can compact the mesh at the end.
+
+    The edges must be manifold with coherent orientation; build returns false otherwise. Nodes where two or more fans
+    touch are accepted but marked as singular: their queries only see one fan and they are never collapsed. */
+
+template<> class halfEdge2d<Triangle>
+{
+      //
+      // Class variables
+      //
+      public:
+		/*! Value of a missing half edge */
+		static const UInt NONE = static_cast<UInt>(-1);
+
+		/*! Pointer to the mesh */
+		mesh2d<Triangle> *	meshPointer;
+
+		/*! Twin of every half edge, NONE on the boundary */
+		vector<UInt>		       twin;
+
+		/*! One half edge leaving every node, NONE for the removed nodes */
+		vector<UInt>		   outgoing;
+
+		/*! Nodes where more fans touch, they cannot be described by one outgoing half edge and are never collapsed */
+		vector<bool>		   singular;
+
+		/*! Scratch vector used by the collapse */
+		vector<UInt>		       fan;
+      //
+      // Constructors
+      //
+      public:
+		/*! Empty constructor */
+		halfEdge2d();
+
+		/*! Constructor, the structure is built
+		    \param _meshPointer pointer to the mesh */
+		halfEdge2d(mesh2d<Triangle> * _meshPointer);
+
+		/*! Method that changes the mesh and builds the structure
+		    \param _meshPointer pointer to the mesh */
+		bool setMeshPointer(mesh2d<Triangle> * _meshPointer);
+
+		/*! Method that builds the twins and the outgoing half edges, the degenerate triangles are skipped */
+		bool build();
+
+		/*! Method that cleans the variables */
+		void clear();
+      //
+      // Navigation
+      //
+      public:
+		/*! Number of half edges */
+		inline UInt getNumHalfEdges() const;
+
+		/*! Triangle of the half edge */
+		inline UInt face(UInt h) const;
+
+		/*! Next half edge in the triangle */
+		inline UInt next(UInt h) const;
+
+		/*! Previous half edge in the triangle */
+		inline UInt prev(UInt h) const;
+
+		/*! Node where the half edge starts */
+		inline UInt origin(UInt h) const;
+
+		/*! Node where the half edge ends */
+		inline UInt target(UInt h) const;
+
+		/*! Twin of the half edge */
+		inline UInt getTwin(UInt h) const;
+
+		/*! Outgoing half edge of a node */
+		inline UInt getOutgoing(UInt nodeId) const;
+
+		/*! Next outgoing half edge counter-clockwise around its origin, NONE at the boundary */
+		inline UInt nextAround(UInt h) const;
+
+		/*! Method that checks if a half edge is on the boundary */
+		inline bool isBoundaryHalfEdge(UInt h) const;
+
+		/*! Method that checks if a node is on the boundary */
+		inline bool isBoundaryNode(UInt nodeId) const;
+
+		/*! Method that checks if a node has been removed by a collapse */
+		inline bool isNodeRemoved(UInt nodeId) const;
+
+		/*! Method that checks if more fans touch at a node */
+		inline bool isSingularNode(UInt nodeId) const;
+
+		/*! Half edge that goes from id1 to id2, NONE if it does not exist */
+		UInt findHalfEdge(UInt id1, UInt id2) const;
+      //
+      // Queries with the same meaning of the ones of tricky2d
+      //
+      public:
+		/*! Triangles on the edge
+		    \param id1 first node
+		    \param id2 second node
+		    \param ele OUTPUT triangles */
+		void elementOnEdge(UInt id1, UInt id2, vector<UInt> * ele) const;
+
+		/*! Number of triangles on the edge */
+		UInt numElementOnEdge(UInt id1, UInt id2) const;
+
+		/*! Triangles around a node in counter-clockwise order
+		    \param id1 node
+		    \param ids OUTPUT triangles */
+		void getElementAround(UInt id1, vector<UInt> * ids) const;
+
+		/*! Nodes around a node, sorted as in tricky2d::createStellata
+		    \param id1 node
+		    \param ids OUTPUT nodes */
+		void createStellata(UInt id1, vector<UInt> * ids) const;
+
+		/*! Number of nodes around a node */
+		UInt getValence(UInt id1) const;
+
+		/*! Adds to ids the triangles on the edge different from elemId, as tricky2d::oppositeTria */
+		void oppositeTria(UInt id1, UInt id2, UInt elemId, vector<UInt> * ids) const;
+
+		/*! Opposite nodes of the edge, empty if the edge does not have two triangles, as tricky2d::atroEdge */
+		void atroEdge(vector<UInt> * edge, vector<UInt> * altro) const;
+
+		/*! Edges of the link of an edge, as tricky2d::getLink */
+		void getLink(vector<UInt> * edge, vector<vector<UInt> > * link) const;
+      //
+      // Collapse
+      //
+      public:
+		/*! Topological check of the half-edge collapse from "from" to "to": the link condition has to hold, a
+		    boundary node can move only along the boundary and a tetrahedron cannot be collapsed
+		    \param from node that is removed
+		    \param to node that survives */
+		bool isCollapsable(UInt from, UInt to) const;
+
+		/*! Half-edge collapse: the node "from" is removed and its triangles are given to "to", the two triangles
+		    on the edge become degenerate. The coordinates of "to" are not changed.
+		    \param from node that is removed
+		    \param to node that survives */
+		bool collapse(UInt from, UInt to);
+      //
+      // Internal methods
+      //
+      protected:
+		/*! Method that moves the outgoing half edge of a node on the boundary if the node is on the boundary */
+		void fixOutgoing(UInt nodeId);
+
+		/*! Number of half edges seen by the rotation around a node */
+		UInt getNumFan(UInt nodeId) const;
+
+		/*! Method that checks if a triangle is degenerate */
+		inline bool isFaceDegenerate(UInt elemId) const;
+};
+
+//-------------------------------------------------------------------------------------------------------
+// INLINE FUNCTIONS
+//-------------------------------------------------------------------------------------------------------
+
+inline UInt halfEdge2d<Triangle>::getNumHalfEdges() const
+{
+    return(twin.size());
+}
+
+inline UInt halfEdge2d<Triangle>::face(UInt h) const
+{
+    return(h/3);
+}
+
+inline UInt halfEdge2d<Triangle>::next(UInt h) const
+{
+    return((h%3==2) ? h-2 : h+1);
+}
+
+inline UInt halfEdge2d<Triangle>::prev(UInt h) const
+{
+    return((h%3==0) ? h+2 : h-1);
+}
+
+inline UInt halfEdge2d<Triangle>::origin(UInt h) const
+{
+    return(meshPointer->getElement(h/3).getConnectedId(h%3));
+}
+
+inline UInt halfEdge2d<Triangle>::target(UInt h) const
+{
+    return(origin(next(h)));
+}
+
+inline UInt halfEdge2d<Triangle>::getTwin(UInt h) const
+{
+    return(twin[h]);
+}
+
+inline UInt halfEdge2d<Triangle>::getOutgoing(UInt nodeId) const
+{
+    return(outgoing[nodeId]);
+}
+
+inline UInt halfEdge2d<Triangle>::nextAround(UInt h) const
+{
+    return(twin[prev(h)]);
+}
+
+inline bool halfEdge2d<Triangle>::isBoundaryHalfEdge(UInt h) const
+{
+    return(twin[h]==NONE);
+}
+
+inline bool halfEdge2d<Triangle>::isBoundaryNode(UInt nodeId) const
+{
+    // the outgoing half edge of a boundary node is always on the boundary
+    return((outgoing[nodeId]!=NONE) && (twin[outgoing[nodeId]]==NONE));
+}
+
+inline bool halfEdge2d<Triangle>::isNodeRemoved(UInt nodeId) const
+{
+    return(outgoing[nodeId]==NONE);
+}
+
+inline bool halfEdge2d<Triangle>::isSingularNode(UInt nodeId) const
+{
+    return(singular[nodeId]);
+}
+
+inline bool halfEdge2d<Triangle>::isFaceDegenerate(UInt elemId) const
+{
+    UInt id1 = meshPointer->getElement(elemId).getConnectedId(0);
+    UInt id2 = meshPointer->getElement(elemId).getConnectedId(1);
+    UInt id3 = meshPointer->getElement(elemId).getConnectedId(2);
+
+    return((id1==id2) || (id2==id3) || (id1==id3));
+}
+
+}
+
+#endif
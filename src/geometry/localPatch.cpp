@@ -0,0 +1,130 @@
+#include "localPatch.h"
+
+using namespace std;
+using namespace geometry;
+
+const UInt localPatch::NONE;
+
+//
+// Costruttore
+//
+localPatch::localPatch() : epoch(0), numElem(0), numNodes(0)
+{
+}
+
+//
+// Costruzione
+//
+void localPatch::clear(UInt numElements)
+{
+      // la tabella è riempita al più per metà
+      UInt dim = 16;
+      while(dim<6*numElements)	dim = dim*2;
+
+      // ingrandisco solo se serve, quando cambia la dimensione le celle vengono ripulite
+      if(keys.size()<dim)
+      {
+	  keys.assign(dim, 0);
+	  vals.assign(dim, 0);
+	  mark.assign(dim, 0);
+	  epoch = 0;
+      }
+
+      // quando il contatore ricomincia si puliscono i marcatori
+      if(++epoch==0)
+      {
+	  fill(mark.begin(), mark.end(), 0);
+	  epoch = 1;
+      }
+
+      // preparo gli elementi
+      if(elemConn.size()<3*numElements)	elemConn.resize(3*numElements);
+      numElem  = 0;
+      numNodes = 0;
+}
+
+void localPatch::addElement(UInt id1, UInt id2, UInt id3)
+{
+      // il numero di elementi deve essere quello dato in clear
+      assert(3*(numElem+1)<=elemConn.size());
+      assert(6*(numElem+1)<=keys.size());
+
+      elemConn[3*numElem]   = insert(id1);
+      elemConn[3*numElem+1] = insert(id2);
+      elemConn[3*numElem+2] = insert(id3);
+      ++numElem;
+}
+
+void localPatch::buildNodeToElement()
+{
+      // conto gli elementi di ogni nodo
+      nodeStart.assign(numNodes+1, 0);
+      for(UInt i=0; i<3*numElem; ++i)	++nodeStart[elemConn[i]+1];
+
+      for(UInt i=0; i<numNodes; ++i)	nodeStart[i+1] += nodeStart[i];
+
+      // metto gli elementi in ordine crescente come fa connect2d
+      nodeElem.resize(3*numElem);
+      for(UInt i=0; i<numElem; ++i)
+	  for(UInt j=0; j<3; ++j)
+	      nodeElem[nodeStart[elemConn[3*i+j]]++] = i;
+
+      // riporto gli inizi al loro posto
+      for(UInt i=numNodes; i>0; --i)	nodeStart[i] = nodeStart[i-1];
+      nodeStart[0] = 0;
+}
+
+//
+// Interrogazioni
+//
+void localPatch::elementOnEdge(UInt id1, UInt id2, vector<UInt> * ele) const
+{
+      // pulisco il vettore in input
+      ele->clear();
+
+      // prendo gli identificatori locali
+      UInt loc1 = find(id1);
+      UInt loc2 = find(id2);
+      if((loc1==NONE) || (loc2==NONE))	return;
+
+      // ciclo sugli elementi connessi a id2 se sono connessi anche a id1 li metto nella lista
+      for(UInt i=nodeStart[loc2]; i<nodeStart[loc2+1]; ++i)
+	  for(UInt j=nodeStart[loc1]; j<nodeStart[loc1+1]; ++j)
+	      if(nodeElem[i]==nodeElem[j])
+	      {
+		  ele->push_back(nodeElem[i]);
+		  break;
+	      }
+}
+
+void localPatch::getElementAround(UInt id1, vector<UInt> * ids) const
+{
+      // pulisco il vettore in input
+      ids->clear();
+
+      UInt loc = find(id1);
+      if(loc==NONE)	return;
+
+      ids->insert(ids->end(), nodeElem.begin()+nodeStart[loc], nodeElem.begin()+nodeStart[loc+1]);
+}
+
+//
+// Metodi interni
+//
+UInt localPatch::insert(UInt id)
+{
+      UInt s = slot(id);
+
+      // linear probing fino ad una cella libera o al nodo cercato
+      while(mark[s]==epoch)
+      {
+	  if(keys[s]==id)	return(vals[s]);
+	  s = (s+1) & static_cast<UInt>(keys.size()-1);
+      }
+
+      // nuovo nodo
+      mark[s] = epoch;
+      keys[s] = id;
+      vals[s] = numNodes;
+      return(numNodes++);
+}
@@ -0,0 +1,145 @@
+#ifndef LOCALPATCH_H_
+#define LOCALPATCH_H_
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../core/shapes.hpp"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Piccola patch di triangoli usata come mesh temporanea durante la valutazione dei collassi. Gli elementi sono
+    salvati in array piatti, gli identificatori globali dei nodi vengono rinumerati con una tabella hash ad
+    indirizzamento aperto (linear probing) e la connettività nodo-elemento è in formato compresso. Il metodo clear
+    non libera la memoria: dopo le prime patch la costruzione non fa più allocazioni. */
+
+class localPatch
+{
+      //
+      // Variabili contenute nella classe
+      //
+      public:
+		  /*! Chiavi della tabella hash (identificatori globali) */
+		  vector<UInt>			keys;
+
+		  /*! Valori della tabella hash (identificatori locali) */
+		  vector<UInt>			vals;
+
+		  /*! Marcatore delle celle della tabella, la cella è occupata se vale epoch */
+		  vector<UInt>			mark;
+
+		  /*! Contatore della patch attuale */
+		  UInt			       epoch;
+
+		  /*! Connettività degli elementi con gli identificatori locali */
+		  vector<UInt>		    elemConn;
+
+		  /*! Inizio della lista di ogni nodo in nodeElem */
+		  vector<UInt>		   nodeStart;
+
+		  /*! Elementi connessi ai nodi */
+		  vector<UInt>		    nodeElem;
+
+		  /*! Numero di elementi e di nodi della patch */
+		  UInt		   numElem,numNodes;
+
+      //
+      // Costruttore
+      //
+      public:
+		  /*! Costruttore */
+		  localPatch();
+
+      //
+      // Costruzione
+      //
+      public:
+		  /*! Metodo che svuota la patch senza liberare la memoria
+		      \param numElements numero di elementi che verranno inseriti */
+		  void clear(UInt numElements);
+
+		  /*! Metodo che aggiunge un elemento, il suo identificatore locale è il numero di elementi già inseriti
+		      \param id1 primo nodo
+		      \param id2 secondo nodo
+		      \param id3 terzo nodo */
+		  void addElement(UInt id1, UInt id2, UInt id3);
+
+		  /*! Metodo che costruisce la connettività nodo-elemento, va chiamato dopo aver inserito tutti gli elementi */
+		  void buildNodeToElement();
+
+      //
+      // Interrogazioni
+      //
+      public:
+		  /*! Metodo che restituisce l'identificatore locale di un nodo, NONE se non è nella patch
+		      \param id identificatore globale */
+		  inline UInt find(UInt id) const;
+
+		  /*! Metodo che restituisce gli elementi che condividono il lato, come tricky2d::elementOnEdge
+		      \param id1 primo nodo (globale)
+		      \param id2 secondo nodo (globale)
+		      \param ele vettore con gli elementi */
+		  void elementOnEdge(UInt id1, UInt id2, vector<UInt> * ele) const;
+
+		  /*! Metodo che restituisce gli elementi attorno ad un nodo, come tricky2d::getElementAround
+		      \param id1 nodo (globale)
+		      \param ids vettore con gli elementi */
+		  void getElementAround(UInt id1, vector<UInt> * ids) const;
+
+		  /*! Metodo che restituisce il numero di elementi */
+		  inline UInt getNumElements() const;
+
+		  /*! Metodo che restituisce il numero di nodi */
+		  inline UInt getNumNodes() const;
+
+      //
+      // Metodi interni
+      //
+      private:
+		  /*! Metodo che inserisce un nodo se non è presente e restituisce il suo identificatore locale
+		      \param id identificatore globale */
+		  UInt insert(UInt id);
+
+		  /*! Cella iniziale della tabella per un identificatore */
+		  inline UInt slot(UInt id) const;
+
+      public:
+		  /*! Valore per i nodi non presenti */
+		  static const UInt NONE = static_cast<UInt>(-1);
+};
+
+//-------------------------------------------------------------------------------------------------------
+// INLINE FUNCTIONS
+//-------------------------------------------------------------------------------------------------------
+
+inline UInt localPatch::slot(UInt id) const
+{
+      // moltiplicazione di Fibonacci, la dimensione della tabella è una potenza di 2
+      return((id*2654435761u) & static_cast<UInt>(keys.size()-1));
+}
+
+inline UInt localPatch::find(UInt id) const
+{
+      for(UInt s=slot(id); mark[s]==epoch; s=(s+1) & static_cast<UInt>(keys.size()-1))
+	  if(keys[s]==id)	return(vals[s]);
+
+      return(NONE);
+}
+
+inline UInt localPatch::getNumElements() const
+{
+      return(numElem);
+}
+
+inline UInt localPatch::getNumNodes() const
+{
+      return(numNodes);
+}
+
+}
+
+#endif
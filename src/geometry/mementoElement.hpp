@@ -9,12 +9,16 @@
 #include "../utility/inSegment.h"
 #include "../utility/inTriangle.h"
 
+#include "../meshOperation/trackedStore.hpp"
+
 namespace geometry
 {
 
 using namespace std;
 
-/*! Classe derivata da geoElement che permette di associare a un elemento geometrico una serie di punti.*/
+/*! Classe derivata da geoElement che permette di associare a un elemento geometrico una serie di punti. I punti 
+    associati non sono salvati nell'elemento ma in un trackedStore condiviso, l'elemento conserva solo l'intervallo 
+    delle sue associazioni.*/
 	
 template<typename GEOSHAPE> class mementoElement : public geoElement<GEOSHAPE> 
 {
@@ -23,8 +27,11 @@ template<typename GEOSHAPE> class mementoElement : public geoElement<GEOSHAPE>
 	//
 	public:
 		
-		/*! Vettore con tutti i punti associati all'elemento*/
-		vector<point>			 	   ptAss;
+		/*! Contenitore in cui sono salvati i punti associati all'elemento */
+		trackedStore *				   store;
+		
+		/*! Inizio e numero dei punti associati all'elemento dentro store */
+		UInt				     ptStart,ptNum;
 		
 		/*! Tolleranza */
 		Real 					    toll;
@@ -42,9 +49,11 @@ template<typename GEOSHAPE> class mementoElement : public geoElement<GEOSHAPE>
 		mementoElement();
 		
 		/*! Costruttore non vuoto
-		    \param _ptAss vettore con i punti associati all'elemento 
+		    \param _store contenitore dei punti associati 
+		    \param _ptStart inizio dei punti associati all'elemento
+		    \param _ptNum numero dei punti associati all'elemento
 		    \param _nodi  vettore con i nodi dell'elemento */
-		mementoElement(vector<point> * _ptAss, vector<point> * _nodi);
+		mementoElement(trackedStore * _store, UInt _ptStart, UInt _ptNum, vector<point> * _nodi);
 			
 		/*! Costruttore di copia */
 		mementoElement<GEOSHAPE> (const mementoElement<GEOSHAPE> &E);
@@ -65,13 +74,18 @@ template<typename GEOSHAPE> class mementoElement : public geoElement<GEOSHAPE>
 		    \param E geoElement da cui prendere le informazioni */
 		void setElement(const geoElement<GEOSHAPE> &E);
 		
-		/*! Set, reserve, push_back, clear e get della variabile ptAss */
- 		inline vector<point> getPtAss() 	{return(ptAss);};
-		inline void          reserve(UInt num)	{ptAss.reserve(num);};
-		inline void          pushBack(point pt)	{ptAss.push_back(pt);};
-		inline void 	     clearPtAss()	{ptAss.clear();};
-		inline UInt 	     ptAssSize()	{return(ptAss.size());};
-		void setPtAss(vector<point> * _ptAss);
+		/*! Set, clear e get dei punti associati, getPtAss restituisce la proiezione con l'id del punto tracciato */
+		inline point          getPtAss(UInt i)	 {assert(i<ptNum); return(store->get(ptStart+i));};
+		inline UInt         getPtAssId(UInt i)	 {assert(i<ptNum); return(store->getId(ptStart+i));};
+		inline void 	     clearPtAss()	 {ptNum = 0;};
+		inline UInt 	     ptAssSize()	 {return(ptNum);};
+		inline UInt 	     getPtStart()	 {return(ptStart);};
+		inline trackedStore * getStore()	 {return(store);};
+		void setPtAss(trackedStore * _store, UInt _ptStart, UInt _ptNum);
+		
+		/*! Metodo che copia tutti i punti associati in un vettore 
+		    \param pts vettore con i punti associati */
+		void getPtAss(vector<point> * pts);
 		
 		/*! Set e get della variabile fatt */
 		inline Real getFatt()			{return(fatt);};
@@ -85,12 +99,13 @@ template<typename GEOSHAPE> class mementoElement : public geoElement<GEOSHAPE>
 		inline void setToll(Real _toll=1e-15) {toll=_toll;};
 		inline Real getToll()	 	      {return(toll);};
 		
-		/*! Metodo che prende il nodo in input e lo proietta se possibile sull'elemento
+		/*! Metodo che prende il nodo in input e lo proietta se possibile sull'elemento, la proiezione non viene 
+		    salvata ma restituita in proj così chi chiama decide in quale contenitore metterla
 		    \param pt punto da proiettare 
-		    \param id identificatore del punto 
 		    \param ptOriginal punto originale da cui si deve calcolare la distanza 
+		    \param proj proiezione del punto
 		    Il metodo restituisce una coppia con un intero che indica che tipo di associazione è stata fatta 		    e un reale che dice la distanza */
-		pair<int, Real> putPoint(point pt, UInt id, point ptOriginal);
+		pair<int, Real> projectPoint(point pt, point ptOriginal, point * proj);
 		
 		/*! Metodo che prende il nodo e controlla se viene può essere associato alla classe 
 		    \param pt punto da proiettare  
@@ -130,18 +145,22 @@ template<typename GEOSHAPE> class mementoElement : public geoElement<GEOSHAPE>
 template<typename GEOSHAPE> 
 mementoElement<GEOSHAPE>::mementoElement() : geoElement<GEOSHAPE>::geoElement() 
 {
-	toll = 1e-15;
- 	fatt = 9e99;
+	toll    = 1e-15;
+ 	fatt    = 9e99;
+	store   = NULL;
+	ptStart = 0;
+	ptNum   = 0;
 }
 
 template<typename GEOSHAPE> 
-mementoElement<GEOSHAPE>::mementoElement(vector<point> * _ptAss, vector<point> * _nodi)
+mementoElement<GEOSHAPE>::mementoElement(trackedStore * _store, UInt _ptStart, UInt _ptNum, vector<point> * _nodi)
 {
-	toll = 1e-15;
-	fatt = 9e99;
-	ptAss.resize(_ptAss->size());
+	toll    = 1e-15;
+	fatt    = 9e99;
+	store   = _store;
+	ptStart = _ptStart;
+	ptNum   = _ptNum;
 	nodi.resize(_nodi->size());
-	copy(_ptAss->begin(), _ptAss->end(), ptAss.begin());
 	copy(_nodi->begin(),  _nodi->end(),  nodi.begin());
 	
 	// assert per controllare che il numero di nodi sia corretto 
@@ -151,7 +170,9 @@ mementoElement<GEOSHAPE>::mementoElement(vector<point> * _ptAss, vector<point> *
 template<typename GEOSHAPE> 
 mementoElement<GEOSHAPE>::mementoElement(const mementoElement<GEOSHAPE> &E) : geoElement<GEOSHAPE>(E)
 {
-	ptAss = E.ptAss;
+	store   = E.store;
+	ptStart = E.ptStart;
+	ptNum   = E.ptNum;
 	toll  = E.toll;
 	fatt  = E.fatt;
 	nodi  = E.nodi;
@@ -161,7 +182,9 @@ template<typename GEOSHAPE>
 mementoElement<GEOSHAPE> mementoElement<GEOSHAPE>::operator=(const mementoElement<GEOSHAPE> &E) 
 {	
 	this->geoElement<GEOSHAPE>::operator=(E);
-	ptAss = E.ptAss;
+	store   = E.store;
+	ptStart = E.ptStart;
+	ptNum   = E.ptNum;
 	toll  = E.toll;
 	fatt  = E.fatt;
 	nodi  = E.nodi;
@@ -175,7 +198,9 @@ template<typename GEOSHAPE>
 void mementoElement<GEOSHAPE>::clear()
 {
 	// pulisco le liste 
-	ptAss.clear();
+	store   = NULL;
+	ptStart = 0;
+	ptNum   = 0;
 	nodi.clear();
 	
 	// setto a zero tutto 
@@ -186,7 +211,7 @@ void mementoElement<GEOSHAPE>::clear()
 template<typename GEOSHAPE> 
 bool mementoElement<GEOSHAPE>::isEmpty()
 {
-	if(ptAss.size()!=0)		return(false);
+	if(ptNum!=0)			return(false);
 	else if(nodi.size()!=0)		return(false);
 	else if(this->getId()!=0)	return(false);
 	else
@@ -208,11 +233,21 @@ void mementoElement<GEOSHAPE>::setElement(const geoElement<GEOSHAPE> & E)
 
 
 template<typename GEOSHAPE> 
-void mementoElement<GEOSHAPE>::setPtAss(vector<point> * _ptAss)
+void mementoElement<GEOSHAPE>::setPtAss(trackedStore * _store, UInt _ptStart, UInt _ptNum)
+{
+	store   = _store;
+	ptStart = _ptStart;
+	ptNum   = _ptNum;
+	
+	// l'intervallo deve essere contenuto nel contenitore
+	assert((ptNum==0) || (ptStart+ptNum<=store->size()));
+}
+
+template<typename GEOSHAPE> 
+void mementoElement<GEOSHAPE>::getPtAss(vector<point> * pts)
 {
-	ptAss.clear();
-	ptAss.resize(_ptAss->size());
-	copy(_ptAss->begin(), _ptAss->end(), ptAss.begin());
+	pts->resize(ptNum);
+	for(UInt i=0; i<ptNum; ++i)	pts->at(i) = store->get(ptStart+i);
 }
 
 template<typename GEOSHAPE> 
@@ -227,7 +262,7 @@ void mementoElement<GEOSHAPE>::setNodi(vector<point> * _nodi)
 }
 
 template<typename GEOSHAPE> 
-pair<int, Real> mementoElement<GEOSHAPE>::putPoint(point pt, UInt id, point ptOriginal)
+pair<int, Real> mementoElement<GEOSHAPE>::projectPoint(point pt, point ptOriginal, point * proj)
 {
 	// variabili in uso 
 	bool 	  	            found=false;
@@ -259,9 +294,8 @@ pair<int, Real> mementoElement<GEOSHAPE>::putPoint(point pt, UInt id, point ptOr
 	      // se coincidono 
 	      if((nodi[i]-ptOriginal).norm2()<toll)
 	      {
-		  // setto l'id e lo metto nella lista 
-		  pt.setId(id);
-		  ptAss.push_back(pt);
+		  // la proiezione è il punto stesso 
+		  *proj = pt;
 		  
 		  // riempio l'output
 		  result.first  = VERTEX;
@@ -294,8 +328,7 @@ pair<int, Real> mementoElement<GEOSHAPE>::putPoint(point pt, UInt id, point ptOr
 			  // se è dentro lo salvo 
 			  if((dist < distLimite) && (inTria.isIn(&nodi, piede)))
 			  {
-			      piede.setId(id);
-			      ptAss.push_back(piede);
+			      *proj = piede;
 			      
 			      // riempio l'output
 			      result.first  = FACE;
@@ -342,8 +375,7 @@ pair<int, Real> mementoElement<GEOSHAPE>::putPoint(point pt, UInt id, point ptOr
 			  // se l'ho trovato 
 			  if(found)
 			  {
-			      tmp.setId(id);
-			      ptAss.push_back(tmp);
+			      *proj = tmp;
 			      
 			      // riempio l'output
 			      result.first  = EDGE;
@@ -375,8 +407,7 @@ pair<int, Real> mementoElement<GEOSHAPE>::putPoint(point pt, UInt id, point ptOr
 	// se l'ho trovato 
 	if(found)
 	{
-	      tmp.setId(id);
-	      ptAss.push_back(tmp);
+	      *proj = tmp;
 	      
 	      // riempio l'output
 	      result.first  = VERTEX;
@@ -593,7 +624,7 @@ void mementoElement<GEOSHAPE>::print()
 	for(UInt i=0; i<nodi.size(); ++i)		nodi[i].print();
 	
 	std::cout << "Punti associati" << std::endl;
-	for(UInt i=0; i<ptAss.size(); ++i)		ptAss[i].print();
+	for(UInt i=0; i<ptNum; ++i)			getPtAss(i).print();
 }
 
 
@@ -0,0 +1,753 @@
+#ifndef MESHSEARCHDYNAMIC_HPP_
+#define MESHSEARCHDYNAMIC_HPP_
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "../core/shapes.hpp"
+#include "../core/point.h"
+
+#include "../geometry/geoElement.hpp"
+#include "../geometry/mesh1d.hpp"
+#include "../geometry/mesh2d.hpp"
+#include "../geometry/mesh3d.hpp"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*!
+    Struttura di ricerca dinamica basata su un albero di bounding box (AABB tree). Ogni foglia contiene un elemento della mesh
+    con un bounding box "grasso", allargato di una frazione della sua dimensione, così che piccoli spostamenti dei nodi non
+    richiedano di modificare l'albero. L'albero viene tenuto bilanciato con delle rotazioni, quindi inserimento, rimozione e
+    ricerca costano O(log n) anche quando gli elementi hanno dimensioni molto diverse e la griglia di meshSearchStructured
+    degenera. L'interfaccia è la stessa di meshSearchStructured.
+*/
+
+template<class MESH, UInt DIM=3> class meshSearchDynamic
+{
+	//
+	// Nodo dell'albero
+	//
+	public:
+		/*! Nodo dell'albero, è una foglia se left è NONE */
+		class nodo
+		{
+		      public:
+			    /*! Bounding box */
+			    Real     boxMin[DIM],boxMax[DIM];
+
+			    /*! Padre e figli, per i nodi liberi parent è il prossimo nodo libero */
+			    UInt	  parent,left,right;
+
+			    /*! Altezza del sottoalbero, zero per le foglie */
+			    UInt		     height;
+
+			    /*! Elemento della foglia */
+			    UInt		       elem;
+		};
+
+		/*! Valore per i collegamenti nulli */
+		static const UInt NONE = static_cast<UInt>(-1);
+	//
+	// Variabili
+	//
+	public:
+		/*! Tolleranza*/
+		Real                        toll;
+
+		/*! Frazione della dimensione dell'elemento di cui vengono allargati i box delle foglie */
+		Real                        fatt;
+
+		/*! Nodi dell'albero */
+		vector<nodo>               nodi;
+
+		/*! Radice e primo nodo libero */
+		UInt                root,libero;
+
+		/*! Foglia di ogni elemento della mesh, NONE se l'elemento non è nell'albero */
+		vector<UInt>             foglia;
+
+		/*! Puntatore alla mesh */
+		MESH		*    meshPointer;
+
+		/*! numero di elementi */
+		UInt                     number;
+	//
+	// Costruttuore
+	//
+	public:
+		/*! Costruttore di default */
+		meshSearchDynamic();
+
+		/*! Pulizia delle variabili */
+		void clear();
+	//
+	// Set/Get delle variabili
+	//
+	public:
+		/*! Set di tolleranza
+		    \param _toll valore della tolleranza*/
+		void setToll(Real _toll=1e-15);
+
+		/*! get di tolleranza*/
+		inline Real getToll();
+
+		/*! Set della frazione con cui allargare i box, va chiamato prima di setMeshPointer
+		    \param _fatt frazione della dimensione dell'elemento */
+		void setFatt(Real _fatt=0.1);
+
+		/*! get della frazione con cui allargare i box */
+		inline Real getFatt();
+
+		/*! set del puntatore alla mesh
+		    \param _meshPointer puntatore alla mesh */
+		inline void setMeshPointer(MESH * _meshPointer);
+
+		/*! get del puntatore alla mesh */
+		inline MESH * getMeshPointer();
+
+		/*! get del numero di elementi nell'albero */
+		inline UInt getNumElements();
+
+		/*! get dell'altezza dell'albero */
+		inline UInt getHeight();
+	//
+	// Creo la struttura dati per la ricerca
+	//
+	public:
+		/*! Metodo per creare la struttura dati */
+		void buildDataStructure();
+	//
+	// Metodi per trovare l'intersezione
+	//
+	public:
+		/*! Metodo per trovare gli elementi il cui box interseca un bbox
+		      \param boxMax punto massimo del box
+		      \param boxMin punto minimo del box
+		Il metodo ritorna una coppia che contiene un booleano che dice se ha trovato elementi e un vettore con quali
+		elementi*/
+		pair<bool, vector<UInt> > findIntersection(point boxMax, point boxMin) const;
+
+		/*! Come il precedente ma riempie un vettore dato da chi chiama
+		      \param boxMax punto massimo del box
+		      \param boxMin punto minimo del box
+		      \param ids vettore con gli elementi trovati */
+		void findIntersection(point boxMax, point boxMin, vector<UInt> * ids) const;
+	//
+	// Metodi per "editare" l'albero
+	//
+	public:
+		/*! Metodo che inserisce un elemento nella struttura dati
+		      \param elemId identificatore dell'elemento
+		      N.B. tale elemento deve essere nella mesh*/
+		void insertElement(UInt elemId);
+
+		/*! Metodo che toglie un elemento nella struttura dati
+		     \param elemId identificatore dell'elemento*/
+		void eraseElement(UInt elemId);
+
+		/*! Metodo da chiamare quando i nodi di un elemento sono stati spostati. Se il nuovo box è ancora contenuto in
+		    quello grasso della foglia non fa nulla, altrimenti reinserisce l'elemento. Ritorna vero se l'albero è cambiato
+		     \param elemId identificatore dell'elemento*/
+		bool moveElement(UInt elemId);
+	//
+	// Metodi interni
+	//
+	private:
+		/*! Metodo che calcola il box grasso di un elemento
+		      \param elemId identificatore dell'elemento
+		      \param n nodo in cui salvare il box */
+		void fatBox(UInt elemId, nodo & n);
+
+		/*! Metodo che prende un nodo libero */
+		UInt allocaNodo();
+
+		/*! Metodo che libera un nodo
+		      \param id nodo */
+		void liberaNodo(UInt id);
+
+		/*! Metodo che aggancia una foglia all'albero
+		      \param leaf foglia */
+		void insertLeaf(UInt leaf);
+
+		/*! Metodo che stacca una foglia dall'albero
+		      \param leaf foglia */
+		void removeLeaf(UInt leaf);
+
+		/*! Metodo che risale l'albero ricalcolando box e altezze e bilanciando
+		      \param id primo nodo da sistemare */
+		void refit(UInt id);
+
+		/*! Metodo che bilancia un nodo con una rotazione, ritorna il nodo che ha preso il suo posto
+		      \param iA nodo */
+		UInt balance(UInt iA);
+
+		/*! Metodo che mette in n il box che contiene a e b */
+		inline void unione(const nodo & a, const nodo & b, nodo & n) const;
+
+		/*! Metodo che calcola la superficie (o perimetro) di un box */
+		inline Real area(const nodo & n) const;
+
+		/*! Metodo che calcola la superficie del box che contiene a e b */
+		inline Real areaUnione(const nodo & a, const nodo & b) const;
+};
+
+//-------------------------------------------------------------------------------------------------------
+// IMPLEMENTATION
+//-------------------------------------------------------------------------------------------------------
+
+template<class MESH, UInt DIM>
+const UInt meshSearchDynamic<MESH, DIM>::NONE;
+
+template<class MESH, UInt DIM>
+meshSearchDynamic<MESH, DIM>::meshSearchDynamic()
+{
+	toll        = 1e-15;
+	fatt        = 0.1;
+	meshPointer = NULL;
+	clear();
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::clear()
+{
+	nodi.clear();
+	foglia.clear();
+	root   = NONE;
+	libero = NONE;
+	number = 0;
+}
+
+//
+// Set/Get delle variabili
+//
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::setToll(Real _toll)
+{
+	toll = _toll;
+}
+
+template<class MESH, UInt DIM>
+inline Real meshSearchDynamic<MESH, DIM>::getToll()
+{
+	return(toll);
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::setFatt(Real _fatt)
+{
+	fatt = _fatt;
+}
+
+template<class MESH, UInt DIM>
+inline Real meshSearchDynamic<MESH, DIM>::getFatt()
+{
+	return(fatt);
+}
+
+template<class MESH, UInt DIM>
+inline void meshSearchDynamic<MESH, DIM>::setMeshPointer(MESH * _meshPointer)
+{
+	meshPointer = _meshPointer;
+
+	// creo la struttura dati dato che è fortemente legata alla mesh
+	buildDataStructure();
+}
+
+template<class MESH, UInt DIM>
+inline MESH * meshSearchDynamic<MESH, DIM>::getMeshPointer()
+{
+	return(meshPointer);
+}
+
+template<class MESH, UInt DIM>
+inline UInt meshSearchDynamic<MESH, DIM>::getNumElements()
+{
+	return(number);
+}
+
+template<class MESH, UInt DIM>
+inline UInt meshSearchDynamic<MESH, DIM>::getHeight()
+{
+	return((root==NONE) ? 0 : nodi[root].height);
+}
+
+//
+// Metodi per la struttura dati di ricerca
+//
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::buildDataStructure()
+{
+	// Pulisco eventuali informazioni messe
+	clear();
+
+	// controllo che ci siano elementi nella mesh
+	if(meshPointer->getNumElements()==0)
+	{
+	    cout << "ATTENZIONE: la mesh puntata dalla classe è vuota non posso costruire la struttura di ricerca" << endl;
+	    return;
+	}
+
+	// un albero binario con n foglie ha 2n-1 nodi
+	nodi.reserve(2*meshPointer->getNumElements());
+	foglia.assign(meshPointer->getNumElements(), NONE);
+
+	// inserisco gli elementi uno alla volta, le rotazioni tengono l'albero bilanciato
+	for(UInt i=0; i<meshPointer->getNumElements(); ++i)	insertElement(i);
+}
+
+//
+// Metodi per trovare l'intersezione
+//
+template<class MESH, UInt DIM>
+pair<bool, vector<UInt> > meshSearchDynamic<MESH, DIM>::findIntersection(point boxMax, point boxMin) const
+{
+	// varaibili in uso
+	pair<bool, vector<UInt> >	result;
+
+	findIntersection(boxMax, boxMin, &result.second);
+	result.first = (result.second.size()!=0);
+
+	// ritorno il risultato
+	return(result);
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::findIntersection(point boxMax, point boxMin, vector<UInt> * ids) const
+{
+	// varaibili in uso
+	UInt			   id,top=0;
+	UInt		       pila[128];
+	vector<UInt>	    pilaGrande;
+	point			 p,tmp;
+	bool 			overlap;
+
+	ids->clear();
+	if(root==NONE)	return;
+
+	// do spessore ai box troppo piccoli come meshSearchStructured
+	tmp.setX(1.0);	tmp.setY(1.0);	tmp.setZ(1.0);
+	if((boxMax-boxMin).norm2()<toll)
+	{
+		p = boxMax;
+		boxMax = p + tmp*toll*1000.0;
+		boxMin = p - tmp*toll*1000.0;
+	}
+
+	// visita in profondità, l'albero è bilanciato quindi la pila sullo stack basta quasi sempre
+	pila[top++] = root;
+	while(top>0 || pilaGrande.size()>0)
+	{
+	      if(pilaGrande.size()>0)	{id = pilaGrande.back();  pilaGrande.pop_back();}
+	      else			id = pila[--top];
+
+	      const nodo & n = nodi[id];
+
+	      // controllo se i box si intersecano
+	      overlap = true;
+	      for(UInt i=0; i<DIM && overlap; ++i)
+		  overlap = (n.boxMin[i]<=boxMax.getI(i)) && (n.boxMax[i]>=boxMin.getI(i));
+
+	      if(!overlap)	continue;
+
+	      if(n.left==NONE)
+	      {
+		  ids->push_back(n.elem);
+	      }
+	      else if(top+2<=128)
+	      {
+		  pila[top++] = n.right;
+		  pila[top++] = n.left;
+	      }
+	      else
+	      {
+		  pilaGrande.push_back(n.right);
+		  pilaGrande.push_back(n.left);
+	      }
+	}
+}
+
+//
+// Metodi per "editare" l'albero
+//
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::insertElement(UInt elemId)
+{
+	// controllo che sia ok
+	assert(elemId<meshPointer->getNumElements());
+
+	// la mesh potrebbe essere cresciuta
+	if(foglia.size()<meshPointer->getNumElements())	foglia.resize(meshPointer->getNumElements(), NONE);
+
+	// se c'è già non faccio nulla
+	if(foglia[elemId]!=NONE)	return;
+
+	// creo la foglia
+	UInt leaf = allocaNodo();
+	nodi[leaf].elem   = elemId;
+	nodi[leaf].left   = NONE;
+	nodi[leaf].right  = NONE;
+	nodi[leaf].height = 0;
+	fatBox(elemId, nodi[leaf]);
+
+	// la aggancio
+	insertLeaf(leaf);
+	foglia[elemId] = leaf;
+	++number;
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::eraseElement(UInt elemId)
+{
+	// se non c'è non faccio nulla come meshSearchStructured
+	if((elemId>=foglia.size()) || (foglia[elemId]==NONE))	return;
+
+	removeLeaf(foglia[elemId]);
+	liberaNodo(foglia[elemId]);
+	foglia[elemId] = NONE;
+	--number;
+}
+
+template<class MESH, UInt DIM>
+bool meshSearchDynamic<MESH, DIM>::moveElement(UInt elemId)
+{
+	// se non c'è lo inserisco
+	if((elemId>=foglia.size()) || (foglia[elemId]==NONE))
+	{
+	      insertElement(elemId);
+	      return(true);
+	}
+
+	// variabili in uso
+	UInt 	leaf = foglia[elemId];
+	point        bBoxMax,bBoxMin;
+	bool 		 dentro=true;
+
+	// se il box stretto è ancora dentro quello grasso non faccio nulla
+	meshPointer->createBBox(elemId, bBoxMax, bBoxMin);
+	for(UInt i=0; i<DIM; ++i)
+	    dentro = dentro && (nodi[leaf].boxMin[i]<=bBoxMin.getI(i)) && (nodi[leaf].boxMax[i]>=bBoxMax.getI(i));
+
+	if(dentro)	return(false);
+
+	// altrimenti la reinserisco con un box nuovo
+	removeLeaf(leaf);
+	fatBox(elemId, nodi[leaf]);
+	insertLeaf(leaf);
+	return(true);
+}
+
+//
+// Metodi interni
+//
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::fatBox(UInt elemId, nodo & n)
+{
+	// variabili in uso
+	point        bBoxMax,bBoxMin;
+	Real         	 margine=0.0;
+
+	// box dell'elemento
+	meshPointer->createBBox(elemId, bBoxMax, bBoxMin);
+
+	// lo allargo in proporzione alla dimensione più grande
+	for(UInt i=0; i<DIM; ++i)	margine = max(margine, bBoxMax.getI(i)-bBoxMin.getI(i));
+	margine = fatt*margine+toll;
+
+	for(UInt i=0; i<DIM; ++i)
+	{
+	    n.boxMin[i] = bBoxMin.getI(i)-margine;
+	    n.boxMax[i] = bBoxMax.getI(i)+margine;
+	}
+}
+
+template<class MESH, UInt DIM>
+UInt meshSearchDynamic<MESH, DIM>::allocaNodo()
+{
+	// se non ci sono nodi liberi ne aggiungo uno
+	if(libero==NONE)
+	{
+	    nodi.push_back(nodo());
+	    nodi.back().parent = NONE;
+	    return(nodi.size()-1);
+	}
+
+	// prendo il primo libero
+	UInt id = libero;
+	libero = nodi[id].parent;
+	nodi[id].parent = NONE;
+	return(id);
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::liberaNodo(UInt id)
+{
+	nodi[id].parent = libero;
+	nodi[id].height = NONE;
+	libero = id;
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::insertLeaf(UInt leaf)
+{
+	// albero vuoto
+	if(root==NONE)
+	{
+	    root = leaf;
+	    nodi[root].parent = NONE;
+	    return;
+	}
+
+	// cerco il fratello migliore con l'euristica della superficie
+	UInt 	id = root;
+	Real  	 cost,costLeft,costRight,inheritance,combined;
+	while(nodi[id].left!=NONE)
+	{
+	    UInt left  = nodi[id].left;
+	    UInt right = nodi[id].right;
+
+	    // costo di creare un nuovo padre per questo nodo e la foglia
+	    combined    = areaUnione(nodi[id], nodi[leaf]);
+	    cost        = 2.0*combined;
+
+	    // costo minimo di scendere
+	    inheritance = 2.0*(combined-area(nodi[id]));
+
+	    costLeft  = areaUnione(nodi[leaf], nodi[left]) + inheritance;
+	    if(nodi[left].left!=NONE)	costLeft -= area(nodi[left]);
+
+	    costRight = areaUnione(nodi[leaf], nodi[right]) + inheritance;
+	    if(nodi[right].left!=NONE)	costRight -= area(nodi[right]);
+
+	    // se conviene fermarsi qui mi fermo
+	    if((cost<costLeft) && (cost<costRight))	break;
+
+	    id = (costLeft<costRight) ? left : right;
+	}
+
+	// creo il nuovo padre
+	UInt sibling   = id;
+	UInt oldParent = nodi[sibling].parent;
+	UInt newParent = allocaNodo();
+	nodi[newParent].parent = oldParent;
+	nodi[newParent].elem   = NONE;
+	nodi[newParent].height = nodi[sibling].height+1;
+	nodi[newParent].left   = sibling;
+	nodi[newParent].right  = leaf;
+	unione(nodi[leaf], nodi[sibling], nodi[newParent]);
+	nodi[sibling].parent   = newParent;
+	nodi[leaf].parent      = newParent;
+
+	// lo aggancio al vecchio padre
+	if(oldParent!=NONE)
+	{
+	    if(nodi[oldParent].left==sibling)	nodi[oldParent].left  = newParent;
+	    else				nodi[oldParent].right = newParent;
+	}
+	else
+	{
+	    root = newParent;
+	}
+
+	// sistemo i box e le altezze risalendo
+	refit(nodi[leaf].parent);
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::removeLeaf(UInt leaf)
+{
+	// era l'unico nodo
+	if(leaf==root)
+	{
+	    root = NONE;
+	    return;
+	}
+
+	// prendo il padre e il fratello
+	UInt parent      = nodi[leaf].parent;
+	UInt grandParent = nodi[parent].parent;
+	UInt sibling     = (nodi[parent].left==leaf) ? nodi[parent].right : nodi[parent].left;
+
+	// il fratello prende il posto del padre
+	if(grandParent!=NONE)
+	{
+	    if(nodi[grandParent].left==parent)	nodi[grandParent].left  = sibling;
+	    else				nodi[grandParent].right = sibling;
+	    nodi[sibling].parent = grandParent;
+	    liberaNodo(parent);
+
+	    refit(grandParent);
+	}
+	else
+	{
+	    root = sibling;
+	    nodi[sibling].parent = NONE;
+	    liberaNodo(parent);
+	}
+
+	nodi[leaf].parent = NONE;
+}
+
+template<class MESH, UInt DIM>
+void meshSearchDynamic<MESH, DIM>::refit(UInt id)
+{
+	while(id!=NONE)
+	{
+	    id = balance(id);
+
+	    UInt left  = nodi[id].left;
+	    UInt right = nodi[id].right;
+
+	    nodi[id].height = 1 + max(nodi[left].height, nodi[right].height);
+	    unione(nodi[left], nodi[right], nodi[id]);
+
+	    id = nodi[id].parent;
+	}
+}
+
+template<class MESH, UInt DIM>
+UInt meshSearchDynamic<MESH, DIM>::balance(UInt iA)
+{
+	nodo & A = nodi[iA];
+	if((A.left==NONE) || (A.height<2))	return(iA);
+
+	UInt iB = A.left;
+	UInt iC = A.right;
+	nodo & B = nodi[iB];
+	nodo & C = nodi[iC];
+
+	// C è troppo alto, lo porto su
+	if(C.height>B.height+1)
+	{
+	    UInt iF = C.left;
+	    UInt iG = C.right;
+	    nodo & F = nodi[iF];
+	    nodo & G = nodi[iG];
+
+	    // C prende il posto di A
+	    C.left   = iA;
+	    C.parent = A.parent;
+	    A.parent = iC;
+
+	    if(C.parent!=NONE)
+	    {
+		if(nodi[C.parent].left==iA)	nodi[C.parent].left  = iC;
+		else				nodi[C.parent].right = iC;
+	    }
+	    else
+	    {
+		root = iC;
+	    }
+
+	    // il figlio più alto di C resta a C
+	    if(F.height>G.height)
+	    {
+		C.right  = iF;
+		A.right  = iG;
+		G.parent = iA;
+		unione(B, G, A);
+		unione(A, F, C);
+		A.height = 1 + max(B.height, G.height);
+		C.height = 1 + max(A.height, F.height);
+	    }
+	    else
+	    {
+		C.right  = iG;
+		A.right  = iF;
+		F.parent = iA;
+		unione(B, F, A);
+		unione(A, G, C);
+		A.height = 1 + max(B.height, F.height);
+		C.height = 1 + max(A.height, G.height);
+	    }
+
+	    return(iC);
+	}
+
+	// B è troppo alto, lo porto su
+	if(B.height>C.height+1)
+	{
+	    UInt iD = B.left;
+	    UInt iE = B.right;
+	    nodo & D = nodi[iD];
+	    nodo & E = nodi[iE];
+
+	    // B prende il posto di A
+	    B.left   = iA;
+	    B.parent = A.parent;
+	    A.parent = iB;
+
+	    if(B.parent!=NONE)
+	    {
+		if(nodi[B.parent].left==iA)	nodi[B.parent].left  = iB;
+		else				nodi[B.parent].right = iB;
+	    }
+	    else
+	    {
+		root = iB;
+	    }
+
+	    // il figlio più alto di B resta a B
+	    if(D.height>E.height)
+	    {
+		B.right  = iD;
+		A.left   = iE;
+		E.parent = iA;
+		unione(C, E, A);
+		unione(A, D, B);
+		A.height = 1 + max(C.height, E.height);
+		B.height = 1 + max(A.height, D.height);
+	    }
+	    else
+	    {
+		B.right  = iE;
+		A.left   = iD;
+		D.parent = iA;
+		unione(C, D, A);
+		unione(A, E, B);
+		A.height = 1 + max(C.height, D.height);
+		B.height = 1 + max(A.height, E.height);
+	    }
+
+	    return(iB);
+	}
+
+	return(iA);
+}
+
+template<class MESH, UInt DIM>
+inline void meshSearchDynamic<MESH, DIM>::unione(const nodo & a, const nodo & b, nodo & n) const
+{
+	for(UInt i=0; i<DIM; ++i)
+	{
+	    n.boxMin[i] = min(a.boxMin[i], b.boxMin[i]);
+	    n.boxMax[i] = max(a.boxMax[i], b.boxMax[i]);
+	}
+}
+
+template<class MESH, UInt DIM>
+inline Real meshSearchDynamic<MESH, DIM>::area(const nodo & n) const
+{
+	// in 3d la superficie, in 2d il perimetro
+	Real d[3] = {0.0, 0.0, 0.0};
+	for(UInt i=0; i<DIM; ++i)	d[i] = n.boxMax[i]-n.boxMin[i];
+
+	if(DIM==3)	return(2.0*(d[0]*d[1] + d[1]*d[2] + d[2]*d[0]));
+	return(2.0*(d[0]+d[1]+d[2]));
+}
+
+template<class MESH, UInt DIM>
+inline Real meshSearchDynamic<MESH, DIM>::areaUnione(const nodo & a, const nodo & b) const
+{
+	nodo n;
+	unione(a, b, n);
+	return(area(n));
+}
+
+}
+
+#endif
@@ -114,6 +114,14 @@ template<class MESH, UInt DIM=3> class meshSearchStructured
 		/*! Metodo per creare la struttura dati */
 		void buildDataStructure();
 		
+		/*! Metodo che crea solamente la griglia, con celle di lato h sul bounding box dei nodi della mesh, senza 
+		    metterci gli elementi. Serve a chi vuole usare la numerazione delle celle di getPointToGridCoor (ad 
+		    esempio per raggruppare i nodi) senza la struttura di ricerca
+		    \param _meshPointer puntatore alla mesh 
+		    \param h lato delle celle 
+		    \return il lato usato, se le celle sono troppe per essere numerate il lato viene raddoppiato */
+		Real buildGridOnly(MESH * _meshPointer, Real h);
+		
 		/*! Metodo che partendo da delle coordinate trova le coordinate nel vettore grid 
 		    \param P coordinate del punto da cercare
 		    \param coor puntatore a un vettore che conterrà 
@@ -378,6 +386,64 @@ void meshSearchStructured<MESH, DIM>::buildDataStructure()
 	}
 }
 
+template<class MESH, UInt DIM>
+Real meshSearchStructured<MESH, DIM>::buildGridOnly(MESH * _meshPointer, Real h)
+{
+	// Pulisco eventuali informazioni messe
+	clear();
+	meshPointer = _meshPointer;
+	
+	// Variabili temporanee
+	Real 		      celle,hRichiesto=h;
+	point 	        bMax,bMin;
+	
+	// controllo che ci siano nodi nella mesh 
+	if((meshPointer->getNumNodes()==0) || (h<=0.0))
+	{
+	    cout << "ATTENZIONE: la mesh puntata dalla classe è vuota o il lato è nullo non posso costruire la griglia" << endl;
+	    return(h);
+	}
+	
+	// bounding box dei nodi 
+	bMax = meshPointer->getNode(0);
+	bMin = meshPointer->getNode(0);
+	for(UInt i=1; i<meshPointer->getNumNodes(); ++i)
+	{
+	    for(UInt j=0; j<DIM; ++j)
+	    {
+		bMax.setI(j, max(bMax.getI(j), meshPointer->getNode(i).getI(j)));
+		bMin.setI(j, min(bMin.getI(j), meshPointer->getNode(i).getI(j)));
+	    }
+	}
+	
+	// trovo le divisioni, i nodi stanno ad almeno mezza cella dal bordo della griglia 
+	do
+	{
+	    celle = 1.0;
+	    for(UInt i=0; i<DIM; ++i)
+	    {
+		div[i] = static_cast<UInt>(floor((bMax.getI(i)-bMin.getI(i))/h))+2;
+		celle  = celle*div[i];
+	    }
+	    
+	    // l'identificatore della cella deve stare in un UInt
+	    if(celle>=static_cast<Real>(numeric_limits<UInt>::max()))	h = 2.0*h;
+	}
+	while(celle>=static_cast<Real>(numeric_limits<UInt>::max()));
+	
+	if(h!=hRichiesto)	cout << "ATTENZIONE: troppe celle nella griglia, il lato passa da " << hRichiesto << " a " << h << endl;
+	
+	// sistemo gli estremi e lo spacing 
+	for(UInt i=0; i<DIM; ++i)
+	{
+	    pMin.setI(i, bMin.getI(i)-0.5*h);
+	    pMax.setI(i, pMin.getI(i)+div[i]*h);
+	    H.setI(i, h);
+	}
+	
+	return(h);
+}
+
 template<class MESH, UInt DIM>
 void meshSearchStructured<MESH, DIM>::getPointToGridCoor(point P, vector<UInt> * coor)
 {
@@ -878,6 +878,56 @@ void tricky2d<Triangle>::getNodeAround(UInt id1, UInt deph, vector<UInt> * ids,
       }
 }
 
+void tricky2d<Triangle>::getNodeAround(UInt id1, UInt deph, vector<UInt> * ids, ringScratch * scratch, UInt limite)
+{
+      assert(id1<meshPointer->getNumNodes());
+      assert(deph>=1);
+      
+      // variabili in uso
+      UInt 			elemId,id;
+      
+      // inizio una nuova visita 
+      scratch->newVisit(meshPointer->getNumNodes());
+      
+      // metto id1 nella lista ids e nel fronte 
+      ids->clear();
+      ids->push_back(id1);
+      scratch->visit(id1);
+      
+      scratch->fronte.clear();
+      scratch->fronte.push_back(id1);
+      
+      // faccio la ricerca in base alla profondità
+      for(UInt i=0; i<deph; ++i)
+      {
+	  scratch->nuovo.clear();
+	  
+	  // per ogni nodo del fronte prendo i nodi dei triangoli che non sono ancora stati visitati 
+	  for(UInt k=0; k<scratch->fronte.size(); ++k)
+	  {
+		for(UInt j=0; j<conn.getNodeToElementPointer(scratch->fronte[k])->getNumConnected(); ++j)
+		{
+		    elemId = conn.getNodeToElementPointer(scratch->fronte[k])->getConnectedId(j);
+		    for(UInt s=0; s<3; ++s)
+		    {
+			id = meshPointer->getElement(elemId).getConnectedId(s);
+			if(scratch->visit(id))	scratch->nuovo.push_back(id);
+		    }
+		}
+	  }
+	  
+	  // il nuovo fronte va nei risultati 
+	  ids->insert(ids->end(), scratch->nuovo.begin(), scratch->nuovo.end());
+	  scratch->fronte.swap(scratch->nuovo);
+	  
+	  // se ho già trovato id a sufficienza mi fermo
+	  if(ids->size()>limite)	break;
+      }
+      
+      // stesso ordine delle altre versioni 
+      sort(ids->begin(), ids->end());
+}
+
 bool tricky2d<Triangle>::sameEdge(vector<UInt> * edge, UInt id1, UInt id2)
 {
     if(edge->size()!=2)										 return(false);
@@ -1418,6 +1468,40 @@ point tricky2d<Triangle>::getTriangleNormal(UInt elemId)
       return(normale);
 }
 
+point tricky2d<Triangle>::getTriangleNormal(UInt elemId, UInt id1, UInt id2, point pNew)
+{
+      assert(elemId<meshPointer->getNumElements());
+      
+      // varaibile
+      point normale(0.0,0.0,0.0);
+      point p[3];
+      
+      // prendo i nodi e sostituisco quelli che si spostano 
+      for(UInt i=0; i<3; ++i)
+      {
+	  p[i] = meshPointer->getNode(meshPointer->getElement(elemId).getConnectedId(i));
+	  
+	  if((meshPointer->getElement(elemId).getConnectedId(i)==id1) || 
+	     (meshPointer->getElement(elemId).getConnectedId(i)==id2))
+	  {
+	      p[i].setX(pNew.getX());
+	      p[i].setY(pNew.getY());
+	      p[i].setZ(pNew.getZ());
+	  }
+      }
+      
+      point v1 = p[1]-p[0];
+      point v2 = p[2]-p[0];
+
+      // controllo che il prodotto vettore non sia degenere 
+      if((v1^v2).norm2()<p[1].getToll())   return(normale);
+      
+      // calcolo la normale e la normalizzo
+      normale = v1^v2;
+      normale = normale / normale.norm2();
+      return(normale);
+}
+
 point tricky2d<Triangle>::getEdgeNormal(UInt elemId, UInt id1, UInt id2)
 {
       assert(elemId<meshPointer->getNumElements());
@@ -1476,6 +1560,29 @@ Real tricky2d<Triangle>::getTriangleArea(UInt elemId)
 	return(sqrt(fabs(val)));
 }
 
+Real tricky2d<Triangle>::getTriangleArea(UInt elemId, UInt id1, UInt id2, point pNew)
+{
+      	// variabili temporanee
+	point    p[3];
+	
+	// prendo i nodi e sostituisco quelli che si spostano 
+	for(UInt i=0; i<3; ++i)
+	{
+	    p[i] = meshPointer->getNode(meshPointer->getElement(elemId).getConnectedId(i));
+	    
+	    if((meshPointer->getElement(elemId).getConnectedId(i)==id1) || 
+	       (meshPointer->getElement(elemId).getConnectedId(i)==id2))
+	    {
+		p[i].setX(pNew.getX());
+		p[i].setY(pNew.getY());
+		p[i].setZ(pNew.getZ());
+	    }
+	}
+	
+	// ritorno l'area 
+	return(getTriangleArea(p[0], p[1], p[2]));
+}
+
 Real tricky2d<Triangle>::getTriangleArea(point p1, point p2, point p3)
 {
       	// variabili temporanee
@@ -24,6 +24,53 @@ namespace geometry
 
 using namespace std;
 
+/*! Buffer di lavoro per la ricerca dei vicini di tricky2d. I nodi visitati sono marcati con un contatore (epoch) così fra
+    una chiamata e l'altra non si pulisce niente e, dopo le prime chiamate, non si alloca memoria. Ogni thread deve usare
+    il suo buffer. */
+
+class ringScratch
+{
+      public:
+		/*! Marcatore di ogni nodo, il nodo è visitato se vale epoch */
+		vector<UInt>		mark;
+		
+		/*! Contatore della visita attuale */
+		UInt		       epoch;
+		
+		/*! Fronte attuale e fronte successivo */
+		vector<UInt>	fronte,nuovo;
+		
+		/*! Vettore dei risultati che chi chiama può riutilizzare */
+		vector<UInt>		 ids;
+		
+      public:
+		/*! Costruttore */
+		ringScratch() : epoch(0) {};
+		
+		/*! Metodo che inizia una nuova visita
+		    \param numNodes numero di nodi della mesh */
+		inline void newVisit(UInt numNodes)
+		{
+		      if(mark.size()<numNodes)	mark.resize(numNodes, 0);
+		      
+		      // quando il contatore ricomincia si puliscono i marcatori 
+		      if(++epoch==0)
+		      {
+			    fill(mark.begin(), mark.end(), 0);
+			    epoch = 1;
+		      }
+		};
+		
+		/*! Metodo che marca un nodo, ritorna false se era già stato visitato 
+		    \param id nodo */
+		inline bool visit(UInt id)
+		{
+		      if(mark[id]==epoch)	return(false);
+		      mark[id] = epoch;
+		      return(true);
+		};
+};
+
 /*! Classe che permette di esplorare la mesh e calcolare determinate quantità. Il fatto interessante che riesce a ricavare queste
     informazioni solamente parendo dalla classe mesh2d e dalla connettività nodo-elemento */
 
@@ -244,6 +291,16 @@ template<> class tricky2d<Triangle>
 			  \param limite limite di punti da considerare */
 		      void getNodeAround(UInt id1, UInt deph, vector<UInt> * ids, UInt limite);
 		      
+		      /*! Metodo per trovare i vicini a un nodo dato con una determinata profondità senza allocare memoria. Il 
+			  risultato è lo stesso delle altre versioni (nodi ordinati compreso id1)
+			  \param id1 id del nodo in cui cercare
+			  \param deph intero che identifica la profondità con cui effettuare la ricerca
+			  \param ids puntatore a un vettore di interi che conterrà gli id dei nodi, può essere scratch->ids 
+			  \param scratch buffer di lavoro 
+			  \param limite limite di punti da considerare */
+		      void getNodeAround(UInt id1, UInt deph, vector<UInt> * ids, ringScratch * scratch, 
+					 UInt limite=static_cast<UInt>(-1));
+		      
 		      /*! Metodo che dice se il vettore ha quegli estremi (Utile principalmente per debug)
 			  \param edge puntatore all'edge 
 			  \param id1 estremo dell'edge
@@ -368,6 +425,14 @@ template<> class tricky2d<Triangle>
 			  \param elemId identificatore dell'elemento */
 		      point getTriangleNormal(UInt elemId);
 		      
+		      /*! Metodo che permette di ricavare la normale a un triangolo come se i nodi id1 e id2 fossero spostati
+			  in pNew, la mesh non viene modificata 
+			  \param elemId identificatore dell'elemento 
+			  \param id1 primo nodo da spostare 
+			  \param id2 secondo nodo da spostare 
+			  \param pNew nuova posizione dei due nodi */
+		      point getTriangleNormal(UInt elemId, UInt id1, UInt id2, point pNew);
+		      
 		      /*! Metodo per avere la normale al lato 
 			  \param elemId identificatore dell'elemento 
 			  \param id1 primo identificatore del lato 
@@ -378,6 +443,14 @@ template<> class tricky2d<Triangle>
 			  \param elemId identificatore dell'elemento */
 		      Real getTriangleArea(UInt elemId);
 		      
+		      /*! Metodo che permette di ricavare l'area di un triangolo come se i nodi id1 e id2 fossero spostati
+			  in pNew, la mesh non viene modificata 
+			  \param elemId identificatore dell'elemento 
+			  \param id1 primo nodo da spostare 
+			  \param id2 secondo nodo da spostare 
+			  \param pNew nuova posizione dei due nodi */
+		      Real getTriangleArea(UInt elemId, UInt id1, UInt id2, point pNew);
+		      
 		      /*! Metodo che permette di ricavare l'area di un triangolo partendo dai suoi punti 
 			  \param p1 primo punto 
 			  \param p2 secondo punto 
@@ -5,7 +5,7 @@ using namespace geometry;
 //-----------------------------------------------------------------------
 //                      Garland cost function 
 //-----------------------------------------------------------------------
-garlandCostFunction::garlandCostFunction() : costFunction()
+garlandCostFunction::garlandCostFunction() : costFunction(), accumulateQuadrics(false)
 {
 }
 
@@ -14,28 +14,29 @@ garlandCostFunction::garlandCostFunction() : costFunction()
 //
 Real garlandCostFunction::computeCost(UInt pointId, point & actualPoint)
 {
-    // the "1" in this function is the ring of points connected to contractedPoint 
-    std::vector<UInt> listOfPoints;
-    trickPointer->getNodeAround(pointId, 1, &listOfPoints);
+    // the "1" in this function is the ring of points connected to contractedPoint, the buffers of the thread are used 
+    ringScratch * scratch = getRingScratch();
+    std::vector<UInt> & listOfPoints = scratch->ids;
+    trickPointer->getNodeAround(pointId, 1, &listOfPoints, scratch);
     
-    std::vector<Real> QatTheContractingPoint = createQ(pointId);
+    // the quadrics are taken from the cache if it is set 
+    quadric QatTheContractingPoint, QatTheOtherOne;
+    getNodeQuadric(pointId, QatTheContractingPoint);
     
     // remove the point from the list 
     removeThePointFromVector(pointId, listOfPoints);
     
-    std::vector<std::vector<Real> > QatTheOtherOnes(listOfPoints.size());
-    for(UInt i=0; i<listOfPoints.size(); ++i)
-        QatTheOtherOnes[i] = createQ(listOfPoints[i]);
-    
     // initialize
     point otherPoint = trickPointer->meshPointer->getNode(listOfPoints[0]);
-    Real val = getEdgeCost(QatTheContractingPoint, QatTheOtherOnes[0], otherPoint);
+    getNodeQuadric(listOfPoints[0], QatTheOtherOne);
+    Real val = getEdgeCost(QatTheContractingPoint, QatTheOtherOne, otherPoint);
     
     // look the others 
     for(UInt i=1; i<listOfPoints.size(); ++i)
     {
         otherPoint = trickPointer->meshPointer->getNode(listOfPoints[i]);
-        Real tmpVal =  getEdgeCost(QatTheContractingPoint, QatTheOtherOnes[i], otherPoint);
+        getNodeQuadric(listOfPoints[i], QatTheOtherOne);
+        Real tmpVal =  getEdgeCost(QatTheContractingPoint, QatTheOtherOne, otherPoint);
         
         if(isTheValueBetter(tmpVal,val))
             val = tmpVal;
@@ -48,7 +49,7 @@ void garlandCostFunction::getEdgeToRemove(UInt contractedPoint, std::vector<UInt
 {
     // the "1" in this function is the ring of points connected to contractedPoint 
     std::vector<UInt> listOfPoints;
-    trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints);
+    trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints, getRingScratch());
     
     // remove the point from the list 
     removeThePointFromVector(contractedPoint, listOfPoints);
@@ -80,10 +81,29 @@ void garlandCostFunction::getEdgeToRemove(UInt contractedPoint, std::vector<UInt
     
 }
 
+//
+// Cache of the quadrics 
+//
+void garlandCostFunction::updateQuadricCache(const std::vector<UInt> & edge, UInt contractedPoint)
+{
+    // the quadrics are computed again on the actual triangles 
+    if(!accumulateQuadrics)
+    {
+        costFunction::updateQuadricCache(edge, contractedPoint);
+        return;
+    }
+    
+    // Q_new = Q1+Q2, the quadrics of the points around do not change; the contracted point can also be one of the 
+    // endpoints when the collapse reuses its slot 
+    cachePointer->sum(edge[0], edge[1], contractedPoint);
+    for(UInt j=0; j<2; ++j)
+        if(edge[j]!=contractedPoint)	cachePointer->invalidate(edge[j]);
+}
+
 //
 // Processo che crea la lista e i suoi elementi  
 //
-vector<Real> garlandCostFunction::createK_p(UInt nodeId, UInt elemId)
+quadric garlandCostFunction::createK_p(UInt nodeId, UInt elemId)
 {
     assert(nodeId<trickPointer->meshPointer->getNumNodes());
     assert(elemId<trickPointer->meshPointer->getNumElements());
@@ -91,7 +111,6 @@ vector<Real> garlandCostFunction::createK_p(UInt nodeId, UInt elemId)
     // varabile in uso 
     Real noto;
     point normal;
-    vector<Real> K_p;
     
     //	prendo la normale 
     normal = trickPointer->getTriangleNormal(elemId);
@@ -99,84 +118,29 @@ vector<Real> garlandCostFunction::createK_p(UInt nodeId, UInt elemId)
     // setto il termine noto 
     noto = (-1.0)*(trickPointer->meshPointer->getNode(nodeId)*normal);
     
-    // creo la matrice 
-    K_p.assign(16,0.0);
-    
-    // faccio gli elementi 
-    K_p[0]  = normal.getX()*normal.getX();	
-    K_p[1]  = normal.getX()*normal.getY();	
-    K_p[2]  = normal.getX()*normal.getZ();
-    K_p[3]  = normal.getX()*noto;
-    
-    K_p[4]  = normal.getY()*normal.getX();	
-    K_p[5]  = normal.getY()*normal.getY();	
-    K_p[6]  = normal.getY()*normal.getZ();
-    K_p[7]  = normal.getY()*noto;
-    
-    K_p[8]  = normal.getZ()*normal.getX();	
-    K_p[9]  = normal.getZ()*normal.getY();	
-    K_p[10] = normal.getZ()*normal.getZ();
-    K_p[11] = normal.getZ()*noto;
-    
-    K_p[12] = noto*normal.getX();	
-    K_p[13] = noto*normal.getY();	
-    K_p[14] = noto*normal.getZ();
-    K_p[15] = noto*noto;
-    
-    // ritorno la matrice 
-    return(K_p);
+    // ritorno la matrice del piano 
+    return(quadric(normal, noto));
 }
 
-vector<Real> garlandCostFunction::createQ(UInt nodeId)
+quadric garlandCostFunction::createQ(UInt nodeId)
 {
     assert(nodeId<trickPointer->meshPointer->getNumNodes());
     
     // varaibili in uso
-    vector<Real>	    QTmp,K_p;
-    
-    // faccio un resize
-    QTmp.assign(16,0.0);
+    quadric QTmp;
     
-    // prendo tutti i connessi 
+    // prendo tutti i connessi e aggiorno la matrice Q
     for(UInt i=0; i<trickPointer->conn.getNodeToElementPointer(nodeId)->getNumConnected(); ++i)
-    {
-	  // prendo la matrice 
-	  K_p = createK_p(nodeId, trickPointer->conn.getNodeToElementPointer(nodeId)->getConnectedId(i));
-	  
-	  // aggiorno la matrice Q
-	  for(UInt k=0; k<16; ++k)	QTmp[k] = QTmp[k]+K_p[k];
-    }
+	  QTmp += createK_p(nodeId, trickPointer->conn.getNodeToElementPointer(nodeId)->getConnectedId(i));
     
     // ritono la matrice 
     return(QTmp);
 }
 
-Real garlandCostFunction::getEdgeCost(const vector<Real> & Q1, const vector<Real> & Q2, point pNew)
+Real garlandCostFunction::getEdgeCost(const quadric & Q1, const quadric & Q2, point pNew)
 {     
-    // variabili in uso 
-    vector<Real> v1,vTmp,Q;
-    
-    // faccio il resize
-    Q.assign(Q2.size(),0.0);
-    
-    // faccio la somma 
-    for(UInt i=0; i<Q2.size(); ++i)	Q[i] = Q1[i]+Q2[i];
-    
-    // faccio un resize di v1
-    v1.assign(4,1.0);
-    for(UInt i=0; i<3; ++i)	v1[i] = pNew.getI(i);
-    
-    // faccio un resize e la moltiplicazione
-    vTmp.assign(4, 0.0);
-    
-    // riempio il vettore
-    vTmp[0] = Q[0]*v1[0] + Q[4]*v1[1] + Q[8]*v1[2]  + Q[12]*v1[3];
-    vTmp[1] = Q[1]*v1[0] + Q[5]*v1[1] + Q[9]*v1[2]  + Q[13]*v1[3];  
-    vTmp[2] = Q[2]*v1[0] + Q[6]*v1[1] + Q[10]*v1[2] + Q[14]*v1[3];  
-    vTmp[3] = Q[3]*v1[0] + Q[7]*v1[1] + Q[11]*v1[2] + Q[15]*v1[3];  
-          
-    // ritorno il valore 
-    return(inner_product(v1.begin(), v1.end(), vTmp.begin(), 0.0));
+    // faccio la somma e calcolo v^T Q v
+    return((Q1+Q2).evaluate(pNew));
 }
 
 
@@ -189,15 +153,16 @@ noiseCostFunction::noiseCostFunction() : costFunction()
 
 Real noiseCostFunction::computeCost(UInt pointId, point & actualPoint)
 {
-    // the "1" in this function is the ring of points connected to contractedPoint 
-    std::vector<UInt> listOfPoints;
-    trickPointer->getNodeAround(pointId, 1, &listOfPoints);
+    // the "1" in this function is the ring of points connected to contractedPoint, the buffers of the thread are used 
+    ringScratch * scratch = getRingScratch();
+    std::vector<UInt> & listOfPoints = scratch->ids;
+    trickPointer->getNodeAround(pointId, 1, &listOfPoints, scratch);
 
     // remove the point from the list 
     removeThePointFromVector(pointId, listOfPoints);
     
-    std::vector<Real> minMax;
-    findMinimumAndMaximumLength(listOfPoints, minMax);
+    Real minMax[2];
+    findMinimumAndMaximumLength(listOfPoints, minMax[0], minMax[1]);
     
     // compute the plane 
     point normal,ptOnPlane;
@@ -213,7 +178,7 @@ void noiseCostFunction::getEdgeToRemove(UInt contractedPoint, std::vector<UInt>
 {
     // the "1" in this function is the ring of points connected to contractedPoint 
     std::vector<UInt> listOfPoints;
-    trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints);
+    trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints, getRingScratch());
     
     // remove the point from the list 
     removeThePointFromVector(contractedPoint, listOfPoints);
@@ -248,46 +213,42 @@ void noiseCostFunction::getEdgeToRemove(UInt contractedPoint, std::vector<UInt>
 //
 // Methods to identify the outlayers 
 //
-void noiseCostFunction::findMinimumAndMaximumLength(const std::vector<UInt> & listOfPoints, std::vector<Real> & minMax)
+void noiseCostFunction::findMinimumAndMaximumLength(const std::vector<UInt> & listOfPoints, Real & minLength, Real & maxLength)
 {
-    // get the points 
-    std::vector<point> coordinates(listOfPoints.size());
-    for(UInt i=0; i<coordinates.size(); ++i)
-        coordinates[i] = trickPointer->meshPointer->getNode(listOfPoints[i]);
+    // the points are taken directly from the mesh 
+    const mesh2d<Triangle> * surf = trickPointer->meshPointer;
     
-    minMax.resize(2);
-    minMax[0] = (coordinates[0] - coordinates[1]).norm2();
-    minMax[1] = minMax[0];
+    minLength = (surf->getNode(listOfPoints[0]) - surf->getNode(listOfPoints[1])).norm2();
+    maxLength = minLength;
     
-    for(UInt i=1; i<coordinates.size(); ++i)
+    for(UInt i=1; i<listOfPoints.size(); ++i)
     {
-        for(UInt j=i+1; j<coordinates.size(); ++j)
+        for(UInt j=i+1; j<listOfPoints.size(); ++j)
         {
-          Real dist = (coordinates[i] - coordinates[j]).norm2();
+          Real dist = (surf->getNode(listOfPoints[i]) - surf->getNode(listOfPoints[j])).norm2();
           // checks 
-          if(dist<minMax[0])
-              minMax[0] = dist;
-          if(dist>minMax[1])
-              minMax[1] = dist;
+          if(dist<minLength)
+              minLength = dist;
+          if(dist>maxLength)
+              maxLength = dist;
         }
     }
 }
     
 void noiseCostFunction::computePlane(const std::vector<UInt> & listOfPoints, point & normal, point & ptOnPlane)
 {
-    // get the points 
-    std::vector<point> coordinates(listOfPoints.size());
-    for(UInt i=0; i<coordinates.size(); ++i)
-        coordinates[i] = trickPointer->meshPointer->getNode(listOfPoints[i]);
+    // the points are taken directly from the mesh 
+    const mesh2d<Triangle> * surf = trickPointer->meshPointer;
     
     // initialize the varabile to compute the normal and the ptOnPlane
     tensor MtM;
     ptOnPlane.setX(0.);    ptOnPlane.setY(0.);    ptOnPlane.setZ(0.);
-    for(UInt i=0; i<coordinates.size(); ++i)
+    for(UInt i=0; i<listOfPoints.size(); ++i)
     {
-        Real x = coordinates[i].getX();
-        Real y = coordinates[i].getY();
-        Real z = coordinates[i].getZ();
+        point coord = surf->getNode(listOfPoints[i]);
+        Real x = coord.getX();
+        Real y = coord.getY();
+        Real z = coord.getZ();
         
         // fill the point 
         ptOnPlane.setX(ptOnPlane.getX()+x);
@@ -296,15 +257,16 @@ void noiseCostFunction::computePlane(const std::vector<UInt> & listOfPoints, poi
     }
     
     // set the plane 
-    ptOnPlane.setX(ptOnPlane.getX()/static_cast<Real>(coordinates.size()));
-    ptOnPlane.setY(ptOnPlane.getY()/static_cast<Real>(coordinates.size()));
-    ptOnPlane.setZ(ptOnPlane.getZ()/static_cast<Real>(coordinates.size()));
+    ptOnPlane.setX(ptOnPlane.getX()/static_cast<Real>(listOfPoints.size()));
+    ptOnPlane.setY(ptOnPlane.getY()/static_cast<Real>(listOfPoints.size()));
+    ptOnPlane.setZ(ptOnPlane.getZ()/static_cast<Real>(listOfPoints.size()));
     
-    for(UInt i=0; i<coordinates.size(); ++i)
+    for(UInt i=0; i<listOfPoints.size(); ++i)
     {
-        Real x = coordinates[i].getX()-ptOnPlane.getX();
-        Real y = coordinates[i].getY()-ptOnPlane.getY();
-        Real z = coordinates[i].getZ()-ptOnPlane.getZ();
+        point coord = surf->getNode(listOfPoints[i]);
+        Real x = coord.getX()-ptOnPlane.getX();
+        Real y = coord.getY()-ptOnPlane.getY();
+        Real z = coord.getZ()-ptOnPlane.getZ();
         
         // fill the matrix 
         MtM.setIJ(0,0, MtM.getIJ(0,0)+x*x);
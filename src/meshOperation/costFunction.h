@@ -9,12 +9,18 @@
 #include <functional>
 #include <numeric>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "../core/shapes.hpp"
 #include "../core/point.h"
 #include "../core/graphItem.h"
 #include "../core/tensor.h"
+#include "../core/quadric.hpp"
 
 #include "../utility/sortList.hpp"
+#include "../utility/heapList.hpp"
 
 #include "../geometry/geoElement.hpp"
 #include "../geometry/geoElementSize.hpp"
@@ -27,6 +33,117 @@
 namespace geometry
 {
     
+/*! 
+    Per node cache of the quadrics used by the cost functions. The cache is stored in the simplification class and 
+    it is given to the cost functions that ask for it (see costFunction::usesQuadricCache)
+*/
+
+class quadricCache
+{
+    public:
+    
+    /*! Constructor */
+    quadricCache()
+    {
+    }
+    
+    /*! Method to clean the cache */
+    void clear()
+    {
+        Q.clear();
+        valid.clear();
+    }
+    
+    /*! Method to resize the cache, the new values are not valid 
+        \param numNodes number of nodes */
+    void resize(UInt numNodes)
+    {
+        Q.resize(numNodes);
+        valid.resize(numNodes, false);
+    }
+    
+    /*! Method to check if the quadric of a node is valid 
+        \param nodeId identifier of the node */
+    bool isValid(UInt nodeId) const
+    {
+        return((nodeId<valid.size()) && valid[nodeId]);
+    }
+    
+    /*! Method to get the quadric of a node, it must be valid 
+        \param nodeId identifier of the node */
+    const quadric & get(UInt nodeId) const
+    {
+        assert(isValid(nodeId));
+        return(Q[nodeId]);
+    }
+    
+    /*! Method to set the quadric of a node 
+        \param nodeId identifier of the node 
+        \param _Q the quadric */
+    void set(UInt nodeId, const quadric & _Q)
+    {
+        if(nodeId>=Q.size())	resize(nodeId+1);
+        Q[nodeId]     = _Q;
+        valid[nodeId] = true;
+    }
+    
+    /*! Method to invalidate the quadric of a node 
+        \param nodeId identifier of the node */
+    void invalidate(UInt nodeId)
+    {
+        if(nodeId<valid.size())	valid[nodeId] = false;
+    }
+    
+    /*! Method to set the quadric of the contracted point as the sum of the ones of the endpoints, if one of them 
+        is not valid also the new one is not valid
+        \param id1 first endpoint 
+        \param id2 second endpoint 
+        \param newId contracted point */
+    void sum(UInt id1, UInt id2, UInt newId)
+    {
+        if(newId>=Q.size())	resize(newId+1);
+        
+        if(!isValid(id1) || !isValid(id2))
+        {
+            valid[newId] = false;
+            return;
+        }
+        
+        Q[newId]     = Q[id1]+Q[id2];
+        valid[newId] = true;
+    }
+    
+    /*! Method to change the ids of the nodes after a refresh of the mesh 
+        \param newId new id of each node (-1 if the node was removed) 
+        \param numNodes number of nodes after the refresh */
+    void renumber(const std::vector<UInt> & newId, UInt numNodes)
+    {
+        std::vector<quadric>             QTmp(numNodes);
+        std::vector<unsigned char>       validTmp(numNodes, false);
+        
+        for(UInt i=0; i<newId.size() && i<Q.size(); ++i)
+        {
+            if(newId[i]!=static_cast<UInt>(-1))
+            {
+                QTmp[newId[i]]     = Q[i];
+                validTmp[newId[i]] = valid[i];
+            }
+        }
+        
+        Q.swap(QTmp);
+        valid.swap(validTmp);
+    }
+    
+    //
+    // Internal variables 
+    //
+    private:
+    // quadric of each node 
+    std::vector<quadric> Q;
+    // flag for the valid quadrics, not vector<bool> so that different nodes can be set in parallel 
+    std::vector<unsigned char> valid;
+};
+
 /*! 
     Basic definition of a cost function
 */
@@ -37,8 +154,13 @@ class costFunction
     public:
     
     /*! Constructor */
-    costFunction()
+    costFunction() : trickPointer(NULL), cachePointer(NULL)
     {
+#ifdef _OPENMP
+        ringBuffers.resize(std::max(omp_get_max_threads(), omp_get_num_procs()));
+#else
+        ringBuffers.resize(1);
+#endif
     }
     
     /*! Method to set the trick class 
@@ -48,6 +170,22 @@ class costFunction
         trickPointer = _trickPointer;
     }
     
+    /*! Method to set the per node cache of the quadrics 
+        \param _cachePointer a cache pointer (NULL to compute the quadrics every time) */
+    void setQuadricCachePointer(quadricCache * _cachePointer)
+    {
+        cachePointer = _cachePointer;
+    }
+    
+    /*! Method to have a ring buffer for each thread of a parallel region, it must be called outside the region 
+        and the region must not use more than numThreads threads 
+        \param numThreads number of threads */
+    void setNumThreads(UInt numThreads)
+    {
+        if(numThreads>ringBuffers.size())
+            ringBuffers.resize(numThreads);
+    }
+    
     //
     // Virtual function to be implemented to define a cost function 
     //
@@ -67,12 +205,22 @@ class costFunction
     virtual void getNeightbourPoints(UInt contractedPoint, std::vector<UInt> & listOfPoints) 
     {
         // the "1" in this function is the ring of points connected to contractedPoint 
-        trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints);
+        trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints, getRingScratch());
     }
     
     /*! Method to get the next element to simplificate 
         \param listaBase where I stored the costs 
-        \return the id*/
+        \return the id
+        N.B. the simplifier uses a heapList: subclasses must override this signature, mark it override */
+    virtual UInt getPointToRemove(heapList<geoElementSize<simplePoint> > & listaBase) const 
+    {
+        return(listaBase.findMin());
+    }
+    
+    /*! Method to get the next element to simplificate from a sortList, kept for the callers that still store 
+        the costs in a sortList 
+        \param listaBase where I stored the costs 
+        \return the id */
     virtual UInt getPointToRemove(sortList<geoElementSize<simplePoint> > & listaBase) const 
     {
         return(listaBase.findMin());
@@ -94,23 +242,89 @@ class costFunction
     {
     }
     
+    //
+    // Hooks for the per node cache of the quadrics 
+    //
+    
+    /*! Method that says if the cost function wants the per node cache, by default it is not used */
+    virtual bool usesQuadricCache() const
+    {
+        return(false);
+    }
+    
+    /*! Method to compute the quadric of a node, it is called when the cache has not a valid value 
+        \param nodeId identifier of the node 
+        \param Q the quadric (OUTPUT) */
+    virtual void computeNodeQuadric(UInt nodeId, quadric & Q)
+    {
+        Q.clear();
+    }
+    
+    /*! Method called after the contraction of an edge to update the cache. By default the quadrics of the 
+        endpoints and of the points around the contracted point are invalidated since their triangles changed 
+        \param edge endpoints of the contracted edge 
+        \param contractedPoint id of the new point */
+    virtual void updateQuadricCache(const std::vector<UInt> & edge, UInt contractedPoint)
+    {
+        std::vector<UInt> listOfPoints;
+        
+        // the new point is not in the cache 
+        cachePointer->resize(trickPointer->meshPointer->getNumNodes());
+        cachePointer->invalidate(edge[0]);
+        cachePointer->invalidate(edge[1]);
+        
+        // the list contains also the contracted point 
+        getNeightbourPoints(contractedPoint, listOfPoints);
+        for(UInt i=0; i<listOfPoints.size(); ++i)
+            cachePointer->invalidate(listOfPoints[i]);
+    }
+    
     //
     // Utility method 
     //
     protected:
+    
+    /*! Method to get the quadric of a node, if there is not the cache or the value in the cache is not valid it 
+        is computed with computeNodeQuadric 
+        \param nodeId identifier of the node 
+        \param Q the quadric (OUTPUT) */
+    void getNodeQuadric(UInt nodeId, quadric & Q)
+    {
+        if(cachePointer==NULL)
+        {
+            computeNodeQuadric(nodeId, Q);
+            return;
+        }
+        
+        if(!cachePointer->isValid(nodeId))
+        {
+            computeNodeQuadric(nodeId, Q);
+            cachePointer->set(nodeId, Q);
+            return;
+        }
+        
+        Q = cachePointer->get(nodeId);
+    }
 
     /*! Method to remove one id from a vector 
         \param ptToRemoveFromTheList id of the point 
         \param listToBeUpadated list to change */
     void removeThePointFromVector(UInt ptToRemoveFromTheList, std::vector<UInt> & listToBeUpadated)
     {
-        std::vector<UInt> tmpList;
-        tmpList.reserve(listToBeUpadated.size());
-        for(UInt i=0; i<listToBeUpadated.size(); ++i)
-            if(listToBeUpadated[i]!=ptToRemoveFromTheList)
-                tmpList.push_back(listToBeUpadated[i]);
-        
-        listToBeUpadated = tmpList;
+        // in place, the order of the other ids does not change 
+        listToBeUpadated.erase(std::remove(listToBeUpadated.begin(), listToBeUpadated.end(), ptToRemoveFromTheList), 
+                               listToBeUpadated.end());
+    }
+    
+    /*! Method to get the buffers of the ring traversal of the calling thread */
+    ringScratch * getRingScratch()
+    {
+#ifdef _OPENMP
+        assert(static_cast<UInt>(omp_get_thread_num())<ringBuffers.size());
+        return(&ringBuffers[omp_get_thread_num()]);
+#else
+        return(&ringBuffers[0]);
+#endif
     }
     
     //
@@ -120,6 +334,11 @@ class costFunction
         
     tricky2d<Triangle> * trickPointer;
     
+    quadricCache * cachePointer;
+    
+    // buffers of the ring traversal, one for each thread 
+    std::vector<ringScratch> ringBuffers;
+    
 };
 
 /*!
@@ -132,6 +351,15 @@ class garlandCostFunction : public costFunction
         
     garlandCostFunction();
     
+    /*! Method to choose how the cache is updated after a contraction 
+        \param _accumulateQuadrics if it is true the quadric of the contracted point is Q1+Q2 as in the paper of 
+        Garland, otherwise the quadrics around the contracted point are computed again on the actual triangles 
+        (default, it gives the same result of the computation without the cache) */
+    void setAccumulateQuadrics(bool _accumulateQuadrics)
+    {
+        accumulateQuadrics = _accumulateQuadrics;
+    }
+    
     //
     // Virtual function to be implemented to define a cost function 
     //
@@ -148,16 +376,19 @@ class garlandCostFunction : public costFunction
     void getNeightbourPoints(UInt contractedPoint, std::vector<UInt> & listOfPoints) 
     {
         // the "1" in this function is the ring of points connected to contractedPoint 
-        trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints);
+        trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints, getRingScratch());
     }
     
     /*! Method to get the next element to simplificate 
         \param listaBase where I stored the costs 
         \return the id*/
-    UInt getPointToRemove(sortList<geoElementSize<simplePoint> > & listaBase) const 
+    UInt getPointToRemove(heapList<geoElementSize<simplePoint> > & listaBase) const override
     {
         return(listaBase.findMin());
     }
+    
+    /*! The sortList overload of the base class stays visible */
+    using costFunction::getPointToRemove;
        
     /*! Method to compare the value 
         \param actualVal value to compare  
@@ -173,6 +404,29 @@ class garlandCostFunction : public costFunction
         \param coordinates coordinates of the point (OUTPUT)*/
     void getEdgeToRemove(UInt contractedPoint, std::vector<UInt> & edge, point & coordinates);
     
+    //
+    // Hooks for the per node cache of the quadrics 
+    //
+    
+    /*! Method that says if the cost function wants the per node cache */
+    bool usesQuadricCache() const
+    {
+        return(true);
+    }
+    
+    /*! Method to compute the quadric of a node 
+        \param nodeId identifier of the node 
+        \param Q the quadric (OUTPUT) */
+    void computeNodeQuadric(UInt nodeId, quadric & Q)
+    {
+        Q = createQ(nodeId);
+    }
+    
+    /*! Method called after the contraction of an edge to update the cache 
+        \param edge endpoints of the contracted edge 
+        \param contractedPoint id of the new point */
+    void updateQuadricCache(const std::vector<UInt> & edge, UInt contractedPoint);
+    
     //
     // Methods in the simplification paper of Garland 
     //
@@ -181,17 +435,24 @@ class garlandCostFunction : public costFunction
     /*! Method to get the matrix K_p 
         \param nodeId identifier of the node  
         \param elemId identifier of the element  */
-    vector<Real> createK_p(UInt nodeId, UInt elemId);
+    quadric createK_p(UInt nodeId, UInt elemId);
 
     /*! Method to create the matrix Q
         \param nodeId identifier of the node  */
-    vector<Real> createQ(UInt nodeId);
+    quadric createQ(UInt nodeId);
     
     /*! Method to get the cost of an edge 
         \param Q1 matrix associated with the first endpoint 
         \param Q2 matrix associated with the second endpoint 
         \param pNew new position of the point  */
-    Real getEdgeCost(const vector<Real> & Q1, const vector<Real> & Q2, point pNew);    
+    Real getEdgeCost(const quadric & Q1, const quadric & Q2, point pNew);    
+    
+    //
+    // Internal variables 
+    //
+    private:
+    // flag to sum the quadrics after a contraction 
+    bool accumulateQuadrics;
     
 };
 
@@ -221,16 +482,19 @@ class noiseCostFunction : public costFunction
     void getNeightbourPoints(UInt contractedPoint, std::vector<UInt> & listOfPoints) 
     {
         // the "1" in this function is the ring of points connected to contractedPoint 
-        trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints);
+        trickPointer->getNodeAround(contractedPoint, 1, &listOfPoints, getRingScratch());
     }
     
     /*! Method to get the next element to simplificate 
         \param listaBase where I stored the costs 
         \return the id*/
-    UInt getPointToRemove(sortList<geoElementSize<simplePoint> > & listaBase) const 
+    UInt getPointToRemove(heapList<geoElementSize<simplePoint> > & listaBase) const override
     {
         return(listaBase.findMin());
     }
+    
+    /*! The sortList overload of the base class stays visible */
+    using costFunction::getPointToRemove;
        
     /*! Method to compare the value 
         \param actualVal value to compare  
@@ -253,8 +517,9 @@ class noiseCostFunction : public costFunction
             
     /*! Method to get the minimum and maximun diameter 
         \param listOfPoints list of the points of the plane 
-        \param minMax vector which will be filled with the min max information */
-    void findMinimumAndMaximumLength(const std::vector<UInt> & listOfPoints, std::vector<Real> & minMax);
+        \param minLength minimum length (OUTPUT) 
+        \param maxLength maximum length (OUTPUT) */
+    void findMinimumAndMaximumLength(const std::vector<UInt> & listOfPoints, Real & minLength, Real & maxLength);
     
     /*! Method to compute the regression plane 
         \param listOfPoints list of the points of the plane 
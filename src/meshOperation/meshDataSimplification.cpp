@@ -24,6 +24,28 @@ meshDataSimplification<Triangle>::meshDataSimplification() : simplification2d<Tr
     pesoAss            = 1./3.;
     pesoDist           = 1./3.;
     listToUpdate       = false;
+    assGarbage         = 0;
+    useTree            = false;
+    numCandidates      = 1;
+    
+    // una copia degli oggetti per le intersezioni per ogni thread 
+#ifdef _OPENMP
+    intersec.resize(max(omp_get_max_threads(), omp_get_num_procs()));
+    inTria.resize(max(omp_get_max_threads(), omp_get_num_procs()));
+    scratch.resize(max(omp_get_max_threads(), omp_get_num_procs()));
+#else
+    intersec.resize(1);
+    inTria.resize(1);
+    scratch.resize(1);
+#endif
+}
+
+void meshDataSimplification<Triangle>::setNumThreads(UInt numThreads)
+{
+    // si allarga solamente, gli oggetti già creati tengono la loro memoria 
+    if(numThreads>intersec.size())	intersec.resize(numThreads);
+    if(numThreads>inTria.size())	inTria.resize(numThreads);
+    if(numThreads>scratch.size())	scratch.resize(numThreads);
 }
 
 void meshDataSimplification<Triangle>::setMeshPointer(mesh2d<Triangle> * _meshPointer)
@@ -40,6 +62,11 @@ void meshDataSimplification<Triangle>::setMeshPointer(mesh2d<Triangle> * _meshPo
     // riempi il vettore memento 
     mem.resize(meshPointer->getNumElements());
     
+    // all'inizio ogni elemento ha associati i suoi vertici 
+    assStore.clear();
+    assStore.reserve(3*meshPointer->getNumElements());
+    assGarbage = 0;
+    
     // metto a posto gli oggetti
     for(UInt i=0; i<mem.size(); ++i)
     {
@@ -51,8 +78,11 @@ void meshDataSimplification<Triangle>::setMeshPointer(mesh2d<Triangle> * _meshPo
 	
 	// setto i nodi e i connessi
 	mem[i].setNodi(&nodi);
-	mem[i].setPtAss(&nodi);
 	mem[i].setToll(toll);
+	
+	// metto i vertici nel contenitore delle associazioni 
+	for(UInt j=0; j<nodi.size(); ++j)	assStore.push(nodi[j], nodi[j].getId());
+	mem[i].setPtAss(&assStore, assStore.size()-nodi.size(), nodi.size());
     }
     
     // sistemo le atre variabili 
@@ -63,7 +93,7 @@ void meshDataSimplification<Triangle>::setMeshPointer(mesh2d<Triangle> * _meshPo
     meanAssValue  = 0.0;
     
     // sistemo la variabile finder 
-    finder.setMeshPointer(_meshPointer);
+    buildFinder();
 }
 
 void meshDataSimplification<Triangle>::refresh()
@@ -176,9 +206,8 @@ void meshDataSimplification<Triangle>::refresh()
 		  // li setto nel memento element
 		  memElem.setNodi(&tmpNode);
 		  
-		  // prendo gli associati e li setto nei nuovi memento 
-		  tmpNode = mem[i].getPtAss();
-		  memElem.setPtAss(&tmpNode);
+		  // i nuovi memento usano gli stessi associati, non serve copiarli 
+		  memElem.setPtAss(mem[i].getStore(), mem[i].getPtStart(), mem[i].ptAssSize());
 		  
 		  // lo metto nella lista 
 		  tmpMem.push_back(memElem);
@@ -194,6 +223,9 @@ void meshDataSimplification<Triangle>::refresh()
       mem.resize(tmpMem.size());
       copy(tmpMem.begin(), tmpMem.end(), mem.begin());
       
+      // elimino le associazioni degli elementi degeneri 
+      compactAss();
+      
       // libero le liste
       meshPointer->clear();
       
@@ -213,7 +245,7 @@ void meshDataSimplification<Triangle>::refresh()
       setUpQ();
       
       // pulisco la variabile finder 
-      finder.setMeshPointer(meshPointer);
+      buildFinder();
       
       // ricostruisco la lista 
       createElementList();
@@ -230,9 +262,20 @@ void meshDataSimplification<Triangle>::setToll(Real _toll)
     // setto la tolleranza negli oggetti mementoElement
     for(UInt i=0; i<mem.size(); ++i)	mem[i].setToll(toll);
     
-    // setto la variabile intersect
-    intersec.setToll(toll);
-    inTria.setToll(toll);
+    // setto le variabili per le intersezioni di ogni thread
+    for(UInt i=0; i<intersec.size(); ++i)	intersec[i].setToll(toll);
+    for(UInt i=0; i<inTria.size(); ++i)		inTria[i].setToll(toll);
+}
+
+void meshDataSimplification<Triangle>::setDynamicFinder(bool _useTree)
+{
+    // se non cambia nulla non ricostruisco
+    if(useTree==_useTree)	return;
+    
+    useTree = _useTree;
+    
+    // se la mesh è già stata data costruisco la nuova struttura 
+    if(meshPointer!=NULL)	buildFinder();
 }
 
 void meshDataSimplification<Triangle>::setFattMemento(Real _fatt)
@@ -310,7 +353,7 @@ Real meshDataSimplification<Triangle>::getMeanElemAss()
 Real meshDataSimplification<Triangle>::getEdgeMetricCost(vector<UInt> * edge, point pNew)
 {
     // variabili in uso     
-    vector<Real>	Q;
+    quadric		Q;
     
     // creo la matrice dell'edge 
     Q = createQ(edge);
@@ -414,18 +457,17 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
       // controllo il tipo di punti con cui stiamo lavorando
       bool			       found=false;
       int	            typeAssociation=NULLGEO;
-      UInt 	          id1,id2,numToAss,idMem,id;
-      Real		 	  	       dist;
-      vector<UInt>  elem,elemToCheck,tmp,ass,assTmp;
+      UInt 	          id1,id2,numToAss,idMem,id,idEl;
+      Real		 	  dist,margine,lb;
+      vector<UInt>            elem,tmp,ass,assTmp;
       vector<UInt>::iterator			it2;
-      vector<point>		      newNodi,toAss;
-      set<UInt>                           coinvolti;
-      set<UInt>::iterator                       it1;
+      vector<point>			    newNodi;
+      point				       proj;
       pair<int,Real>		     result,result2;
       vector<mementoElement<Triangle> >	     oldMem;
-      mesh2d<Triangle>			    tmpMesh;
-      tricky2d<Triangle>		   tmpTrick;
-      map<UInt,UInt>	          newToOld,oldToNew;
+      mementoScratch *             lavoro = getScratch();
+      vector<UInt> &      elemToCheck = lavoro->coinvolti;
+      vector<point> &		    toAss = lavoro->toAss;
       
       // setto le variabili per comodità
       id1 = edge->at(0);
@@ -434,28 +476,27 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
       // trovo i triangoli adiacenti al lato
       elementOnEdge(id1, id2, &elem);
       
-      // trovo TUTTI gli elementi coinvolti
+      // trovo TUTTI gli elementi coinvolti, ordinati e senza ripetizioni come in un set ma nel vettore di lavoro 
+      elemToCheck.clear();
       for(UInt s=0; s<edge->size(); ++s)
 	    for(UInt j=0; j<conn.getNodeToElementPointer(edge->at(s))->getNumConnected(); ++j)
-		  coinvolti.insert(conn.getNodeToElementPointer(edge->at(s))->getConnectedId(j));
+		  elemToCheck.push_back(conn.getNodeToElementPointer(edge->at(s))->getConnectedId(j));
+      sort(elemToCheck.begin(), elemToCheck.end());
+      elemToCheck.erase(unique(elemToCheck.begin(), elemToCheck.end()), elemToCheck.end());
             
       // elimino dalla lista dei coinvolti quelli in elem
       for(UInt s=0; s<elem.size(); ++s)
       {    
 	    // li cerco 
-	    it1 = coinvolti.find(elem[s]);
+	    it2 = lower_bound(elemToCheck.begin(), elemToCheck.end(), elem[s]);
 	    
 	    // li DEVO TROVARE!!
-	    assert(it1!=coinvolti.end());
+	    assert(it2!=elemToCheck.end() && *it2==elem[s]);
 	    
 	    // li elimino
-	    coinvolti.erase(it1);
+	    elemToCheck.erase(it2);
       }
       
-      // riempio elemToCheck
-      elemToCheck.resize(coinvolti.size());
-      copy(coinvolti.begin(), coinvolti.end(), elemToCheck.begin());
-      
       // ------------------------------------------------------------------
       // 	prendo tutti i memento element coinvolti e li cambio  
       // ------------------------------------------------------------------
@@ -465,6 +506,7 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
       
       // prendo tutti i mementoElement coinvolti
       newMem->resize(elemToCheck.size());
+      lavoro->box.resize(6*elemToCheck.size());
       for(UInt i=0; i<elemToCheck.size(); ++i)
       {
 	    // prendo l'elemento 
@@ -501,6 +543,23 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
 	    // setto la tolleranza
 	    newMem->at(i).setFatt(mem[0].getFatt());
 	    
+	    // bounding box dell'elemento 
+	    for(UInt c=0; c<3; ++c)
+	    {
+		lavoro->box[6*i+c]   = min(min(newNodi[0].getI(c), newNodi[1].getI(c)), newNodi[2].getI(c));
+		lavoro->box[6*i+3+c] = max(max(newNodi[0].getI(c), newNodi[1].getI(c)), newNodi[2].getI(c));
+	    }
+	    
+	    // lo allargo per tenere conto delle tolleranze usate da inTriangle e inSegment 
+	    margine = 0.0;
+	    for(UInt c=0; c<3; ++c)	margine = max(margine, lavoro->box[6*i+3+c]-lavoro->box[6*i+c]);
+	    margine = 2.0*newMem->at(i).getToll() + 1e-6*margine;
+	    for(UInt c=0; c<3; ++c)
+	    {
+		lavoro->box[6*i+c]   -= margine;
+		lavoro->box[6*i+3+c] += margine;
+	    }
+	    
 	    // incremento
 	    numToAss+= newMem->at(i).ptAssSize();
       }
@@ -512,26 +571,26 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
       // 	prendo tutti i nodi da associare 
       // ----------------------------------------------
       
-      // in coinvolti metterò gli id dei nodi associati 
-      coinvolti.clear();
+      // i nodi associati già presi sono marcati con una nuova epoca, così non serve svuotare il marcatore 
+      if(++lavoro->epoca==0)
+      {
+	    fill(lavoro->visto.begin(), lavoro->visto.end(), 0);
+	    lavoro->epoca = 1;
+      }
+      toAss.clear();
       toAss.reserve(numToAss);
       
       // prendo tutti nodi associati all'elemento 
       for(UInt i=0; i<newMem->size(); ++i)
       {
-	    // prendo i nodi
-	    newNodi = newMem->at(i).getPtAss();
-	    
 	    // se non l'ho già associato lo metto 
-	    for(UInt j=0; j<newNodi.size(); ++j)
+	    for(UInt j=0; j<newMem->at(i).ptAssSize(); ++j)
 	    {
-		if(coinvolti.find(newNodi[j].getId())==coinvolti.end())
+		if(!lavoro->prendi(newMem->at(i).getPtAssId(j)))
 		{
-		    // metto il suo id in coinvolti 
-		    coinvolti.insert(newNodi[j].getId());
 		    
 		    // lo metto nella lista dei nodi da associare
-		    toAss.push_back(newNodi[j]);
+		    toAss.push_back(newMem->at(i).getPtAss(j));
 		}
 	    }
 	    
@@ -546,37 +605,35 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
       // prendo anche i nodi che vengono dai due elementi collassati
       for(UInt i=0; i<elem.size(); ++i)
       {
-	    // prendo i nodi
-	    newNodi = mem[elem[i]].getPtAss();
-	    
 	    // se non l'ho già associato lo metto 
-	    for(UInt j=0; j<newNodi.size(); ++j)
+	    for(UInt j=0; j<mem[elem[i]].ptAssSize(); ++j)
 	    {	
-		if(coinvolti.find(newNodi[j].getId())==coinvolti.end())
+		if(!lavoro->prendi(mem[elem[i]].getPtAssId(j)))
 		{
-		    // metto il suo id in coinvolti 
-		    coinvolti.insert(newNodi[j].getId());
 		    
 		    // lo metto nella lista dei nodi da associare
-		    toAss.push_back(newNodi[j]);
+		    toAss.push_back(mem[elem[i]].getPtAss(j));
 		}
 	    }
       }
       
       // ----------------------------------------------
-      //   	     creo la Mesh temporanea
+      //   	     creo la patch temporanea
       // ----------------------------------------------
-      buildTmpMesh(newMem, pNew, &tmpMesh, newToOld, oldToNew);
-      tmpTrick.setMeshPointer(&tmpMesh);
+      buildTmpPatch(newMem, &lavoro->patch);
             
       //
-      // N.B. la mesh è fatta in modo che gli id locali degli elementi in tmpMesh siano quelli della lista 
-      //      newMem
+      // N.B. la patch è fatta in modo che gli id locali degli elementi siano quelli della lista newMem
       // 
             
       // ----------------------------------------------
       // 		li associo 
       // ----------------------------------------------
+      
+      // le associazioni vengono salvate in ordine in pend e raggruppate per elemento alla fine 
+      lavoro->pend.clear();
+      lavoro->pendElem.clear();
+      
       for(UInt i=0; i<toAss.size(); ++i)
       {
 	  // setto la distanza 
@@ -588,17 +645,37 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
 	  // prendo l'id del nodo 
 	  id = toAss[i].getId();
 	  
-	  // passo in rassegna gli elementi 
+	  // la distanza di un'associazione è almeno la distanza di toTrack[id] dal box dell'elemento, ordino gli 
+	  // elementi con questa stima così posso fermarmi appena la stima supera la migliore distanza trovata 
+	  lavoro->ordine.resize(newMem->size());
 	  for(UInt j=0; j<newMem->size(); ++j)
+	  {
+	      lb = 0.0;
+	      for(UInt c=0; c<3; ++c)
+	      {
+		  if(toTrack[id].getI(c)<lavoro->box[6*j+c])		
+		      lb += (lavoro->box[6*j+c]-toTrack[id].getI(c))*(lavoro->box[6*j+c]-toTrack[id].getI(c));
+		  else if(toTrack[id].getI(c)>lavoro->box[6*j+3+c])	
+		      lb += (toTrack[id].getI(c)-lavoro->box[6*j+3+c])*(toTrack[id].getI(c)-lavoro->box[6*j+3+c]);
+	      }
+	      lavoro->ordine[j] = make_pair(sqrt(lb), j);
+	  }
+	  sort(lavoro->ordine.begin(), lavoro->ordine.end());
+	  
+	  // passo in rassegna gli elementi 
+	  for(UInt k=0; (k<lavoro->ordine.size()) && (lavoro->ordine[k].first<=dist); ++k)
 	  {	      
+	      // prendo l'elemento 
+	      idEl = lavoro->ordine[k].second;
+	      
 	      // lo associo
-	      result = newMem->at(j).controlPoint(toAss[i], toTrack[id], &assTmp);
+	      result = newMem->at(idEl).controlPoint(toAss[i], toTrack[id], &assTmp);
 	      	      
-	      // se lo associo e la distanza è più piccola 
-	      if((result.first!=NULLGEO) && (result.second<dist))
+	      // se lo associo e la distanza è più piccola, a parità di distanza tengo il primo elemento di newMem 
+	      if((result.first!=NULLGEO) && ((result.second<dist) || ((result.second==dist) && (idEl<idMem))))
 	      {
 		  // setto l'id
-		  idMem           = j;
+		  idMem           = idEl;
 		  dist            = result.second;
 		  typeAssociation = result.first;
 		  ass.clear();	  ass.resize(assTmp.size());
@@ -611,14 +688,16 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
 	  {
 	      case(FACE):
 			  // caso della faccia lo associo a solo un elemento 
-			  result2 = newMem->at(idMem).putPoint(toAss[i], id, toTrack[id]);
+			  result2 = newMem->at(idMem).projectPoint(toAss[i], toTrack[id], &proj);
 			  
 			  // mi assicuro che sia associato 
 			  assert(result2.first!=NULLGEO);
+			  lavoro->pend.push(proj, id);
+			  lavoro->pendElem.push_back(idMem);
 			  break;
 	      case(EDGE):
 			  // caso dell'edge lo assoco ai triangoli che condividono l'edge 
-			  tmpTrick.elementOnEdge(oldToNew[ass[0]], oldToNew[ass[1]], &tmp);
+			  lavoro->patch.elementOnEdge(ass[0], ass[1], &tmp);
 			  	
 			  // scorro quelli di newMem
 			  for(UInt j=0; j<tmp.size(); ++j)	
@@ -626,17 +705,19 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
 			      // PERÒ sappiamo che almeno uno dei due lo associa 
 			      if(tmp[j]==idMem)
 			      {
-				  result2 = newMem->at(tmp[j]).putPoint(toAss[i], id, toTrack[id]);
+				  result2 = newMem->at(tmp[j]).projectPoint(toAss[i], toTrack[id], &proj);
 				  
 				  // mi assicuro che sia associato 
 				  assert(result2.first!=NULLGEO);
+				  lavoro->pend.push(proj, id);
+				  lavoro->pendElem.push_back(tmp[j]);
 			      }
 			  }
 			  
 			  break;			  
 	      case(VERTEX):
 			  // prendo tutti i triangoli 
-			  tmpTrick.getElementAround(oldToNew[ass[0]], &tmp);
+			  lavoro->patch.getElementAround(ass[0], &tmp);
 			  
 			  // inizializzo found 
 			  found = false;
@@ -644,11 +725,16 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
 			  // scorro quelli di newMem
 			  for(UInt j=0; j<tmp.size(); ++j)
 			  {
-			      result2 = newMem->at(tmp[j]).putPoint(toAss[i], id, toTrack[id]);
+			      result2 = newMem->at(tmp[j]).projectPoint(toAss[i], toTrack[id], &proj);
 			      
 			      // non è assolutamente detto che tutti i nodi sono associati a questo vertice 
 			      // ma ne devo trovare almeno uno!!
-			      if(result2.first!=NULLGEO)	found=true;
+			      if(result2.first!=NULLGEO)
+			      {
+				  found=true;
+				  lavoro->pend.push(proj, id);
+				  lavoro->pendElem.push_back(tmp[j]);
+			      }
 			  }
 			  
 			  // mi assicuro di averlo trovato 
@@ -661,6 +747,24 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
 			  return;
 	  }
       }
+      
+      // ----------------------------------------------
+      //   raggruppo le associazioni per elemento 
+      // ----------------------------------------------
+      
+      // conto le associazioni di ogni elemento e trovo dove inizia ognuno 
+      lavoro->cont.assign(newMem->size()+1, 0);
+      for(UInt k=0; k<lavoro->pendElem.size(); ++k)	++lavoro->cont[lavoro->pendElem[k]+1];
+      for(UInt j=0; j<newMem->size(); ++j)		lavoro->cont[j+1] += lavoro->cont[j];
+      
+      // setto gli intervalli prima di riempirli, cont verrà spostato alla fine di ogni intervallo 
+      lavoro->ass.resize(lavoro->pend.size());
+      for(UInt j=0; j<newMem->size(); ++j)
+	  newMem->at(j).setPtAss(&lavoro->ass, lavoro->cont[j], lavoro->cont[j+1]-lavoro->cont[j]);
+      
+      // copio mantenendo l'ordine in cui sono state fatte le associazioni 
+      for(UInt k=0; k<lavoro->pendElem.size(); ++k)
+	  lavoro->ass.set(lavoro->cont[lavoro->pendElem[k]]++, lavoro->pend, k);
 
       //---------------------------------------------------------------------------------------
       // PEZZO DA AGGIUNGERE SE SI EFFETTUA ANCHE UN CONTROLLO SULLA DISTRIBUZIONE DEI DATI !!
@@ -675,48 +779,20 @@ void meshDataSimplification<Triangle>::changeMemento(vector<UInt> * edge,
       return;
 }
 
-void meshDataSimplification<Triangle>::buildTmpMesh(vector<mementoElement<Triangle> > * newMem, 
-						    point pNew, 
-						    mesh2d<Triangle> * tmpMesh,
-						    map<UInt,UInt> & newToOld,
-						    map<UInt,UInt> & oldToNew)
+void meshDataSimplification<Triangle>::buildTmpPatch(vector<mementoElement<Triangle> > * newMem, 
+						     localPatch * patch)
 {
-      // variabili in uso 
-      UInt               cont=0;
-      set<UInt>		    ids;
-      geoElement<Triangle> elem;
+      // la patch riusa la memoria delle chiamate precedenti 
+      patch->clear(newMem->size());
       
-      // prendo tutti gli id trannne quello che verrà inserito
+      // faccio gli elementi, il nuovo nodo ha come id meshPointer->getNumNodes()
       for(UInt i=0; i<newMem->size(); ++i)
-        for(UInt j=0; j<3; ++j)
-	  if(newMem->at(i).getConnectedId(j)!=meshPointer->getNumNodes())
-	      ids.insert(newMem->at(i).getConnectedId(j));
+	  patch->addElement(newMem->at(i).getConnectedId(0), 
+			    newMem->at(i).getConnectedId(1), 
+			    newMem->at(i).getConnectedId(2));
       
-      // creo le mappe 
-      for(set<UInt>::iterator it=ids.begin(); it!=ids.end(); ++it)
-      {
-	  newToOld.insert(pair<UInt,UInt>(cont,*it));
-	  oldToNew.insert(pair<UInt,UInt>(*it,cont));
-	  ++cont;
-      }
-      
-      // faccio anche l'ultima 
-      newToOld.insert(pair<UInt,UInt>(cont,meshPointer->getNumNodes()));
-      oldToNew.insert(pair<UInt,UInt>(meshPointer->getNumNodes(),cont));
-      
-      // metto i nodi 
-      tmpMesh->getNodePointer()->reserve(cont);
-      for(UInt i=0; i<cont; ++i)	tmpMesh->insertNode(meshPointer->getNode(newToOld[i]));
-      tmpMesh->insertNode(pNew);
-      
-      // faccio gli elementi 
-      tmpMesh->getElementPointer()->reserve(newMem->size());
-      for(UInt i=0; i<newMem->size(); ++i)
-      {
-	  elem.setId(i);
-	  for(UInt j=0; j<3; ++j)  elem.setConnectedId(j, oldToNew[newMem->at(i).getConnectedId(j)]);
-	  tmpMesh->insertElement(elem);
-      }
+      // connettività nodo-elemento 
+      patch->buildNodeToElement();
 }
 
 Real meshDataSimplification<Triangle>::evaluateWeight(UInt elemId, vector<point> * nodiTria, point pt)
@@ -726,7 +802,7 @@ Real meshDataSimplification<Triangle>::evaluateWeight(UInt elemId, vector<point>
       vector<UInt>              ids(3);
       
       // controllo dove è il punto 
-      result = inTria.intersec(nodiTria, pt);
+      result = getInTria()->intersec(nodiTria, pt);
       
       // deve essere interno 
       assert(result.first);
@@ -768,7 +844,7 @@ Real meshDataSimplification<Triangle>::getElemAssCost(vector<mementoElement<Tria
       Real         valore,meanPatch,actualAssValue;
       vector<Real>                      val,tmpVal;
       pair<int,Real>			    result;
-      vector<point>		        ptAss,nodi;
+      vector<point>		              nodi;
       
       // valuto il valore attuale 
       actualAssValue = getMeanElemAss();
@@ -782,17 +858,14 @@ Real meshDataSimplification<Triangle>::getElemAssCost(vector<mementoElement<Tria
       // controllo le distanze delle associazioni 
       for(UInt i=0; i<newMem->size(); ++i)
       {
-	   // prendo gli associati 
-	   ptAss = newMem->at(i).getPtAss();
-	   
 	   // prendo i nodi 
 	   nodi = newMem->at(i).getNodi();
 	    
-	   // ciclo su ptAss
-	   tmpVal.assign(ptAss.size(),0.0);
+	   // ciclo sugli associati
+	   tmpVal.assign(newMem->at(i).ptAssSize(),0.0);
 	   
 	   // calcolo i pesi 
-	   for(UInt j=0; j<ptAss.size(); ++j) 	tmpVal[j] = evaluateWeight(newMem->at(i).getId(), &nodi, ptAss[j]);
+	   for(UInt j=0; j<tmpVal.size(); ++j) 	tmpVal[j] = evaluateWeight(newMem->at(i).getId(), &nodi, newMem->at(i).getPtAss(j));
 	   
 	   // controllo il size di tmpVal se ho creato un elemento che non ha associazioni per il momento lo peso in negativo 
 	   if(tmpVal.size()!=0) 	val.push_back(*max_element(tmpVal.begin(), tmpVal.end()));
@@ -831,7 +904,6 @@ Real meshDataSimplification<Triangle>::getElemDistCost(vector<mementoElement<Tri
 {
   
       // variabili in uso 
-      vector<point>			        ptAss;
       vector<Real>     			   val,tmpVal;
       
       // faccio un reserve 
@@ -843,14 +915,12 @@ Real meshDataSimplification<Triangle>::getElemDistCost(vector<mementoElement<Tri
       // passo in rassegna tutti i nodi e tutti i newMementoElements e vedo se li associo
       for(UInt i=0; i<newMem->size(); ++i)
       {
-	   // prendo gli associati 
-	   ptAss = newMem->at(i).getPtAss();
-	      
-	   // ciclo su ptAss
-	   tmpVal.assign(ptAss.size(),0.0);
+	   // ciclo sugli associati
+	   tmpVal.assign(newMem->at(i).ptAssSize(),0.0);
 	   
 	   // calcolo le distanze 
-	   for(UInt j=0; j<ptAss.size(); ++j)	      tmpVal[j] = (ptAss[j]-toTrack[ptAss[j].getId()]).norm2();
+	   for(UInt j=0; j<tmpVal.size(); ++j)
+	      tmpVal[j] = (newMem->at(i).getPtAss(j)-toTrack[newMem->at(i).getPtAssId(j)]).norm2();
 	   
 	   // controllo il size di tmpVal se ho creato un elemento che non ha associazioni per il momento lo peso in negativo 
 	   if(tmpVal.size()!=0) 	val.push_back(*max_element(tmpVal.begin(), tmpVal.end()));
@@ -939,14 +1009,15 @@ void meshDataSimplification<Triangle>::controlUpdatingList(vector<Real> * costi)
 void meshDataSimplification<Triangle>::createElementList()
 {
       // variabili in uso 
-      Real 				 costo = 0.0;
-      point 					   p;
-      vector<UInt>		        edge,toStore;
-      vector<Real>                             costi;
+      vector<UInt>		              toStore;
       vector<Real>          costGeo,costDist,costAss;
       map<UInt,Real>           mapGeo,mapDist,mapAss;
       geoElementSize<Triangle> 			elem;
-      set<geoElementSize<Triangle> >	    listaTmp;
+      vector<geoElementSize<Triangle> >	    listaTmp;
+      vector<Real>	    costo(meshPointer->getNumElements());
+      vector<vector<Real> >	    costi(meshPointer->getNumElements());
+      vector<vector<UInt> >	     edge(meshPointer->getNumElements());
+      vector<point>		        p(meshPointer->getNumElements());
       
       // pulisco le mappe 
       elemIdToEdge.clear();
@@ -958,26 +1029,34 @@ void meshDataSimplification<Triangle>::createElementList()
       costAss.reserve(meshPointer->getNumElements());
       toStore.reserve(meshPointer->getNumElements());
       
-      // calcolo i costi
+#ifdef _OPENMP
+      // una copia degli oggetti per le intersezioni per ogni thread della regione 
+      int numTh = omp_get_max_threads();
+      setNumThreads(numTh);
+#endif
+      
+      // calcolo i costi in parallelo, ogni elemento scrive solamente nelle sue posizioni 
+      #pragma omp parallel for num_threads(numTh) schedule(dynamic, 16)
+      for(UInt i=0; i<meshPointer->getNumElements(); ++i)
+	  costo[i] = getElementCost(i, &costi[i], &edge[i], &p[i]);
+      
+      // raccolgo i costi
       for(UInt i=0; i<meshPointer->getNumElements(); ++i)
       {
-	  // setto il suo costo 
-	  costo = getElementCost(i, &costi, &edge, &p);
-	  
 	  // controllo che tutto sia ok
-	  if(costo!=-1.) 
+	  if(costo[i]!=-1.) 
 	  {	 
 		 // sistemo le mappe 
-		 elemIdToEdge[meshPointer->getElement(i).getId()]  = edge;
-		 elemIdToPoint[meshPointer->getElement(i).getId()] = p;
-		 mapGeo[meshPointer->getElement(i).getId()]        = costi[0];
-		 mapAss[meshPointer->getElement(i).getId()]        = costi[1];
-		 mapDist[meshPointer->getElement(i).getId()]       = costi[2];
+		 elemIdToEdge[meshPointer->getElement(i).getId()]  = edge[i];
+		 elemIdToPoint[meshPointer->getElement(i).getId()] = p[i];
+		 mapGeo[meshPointer->getElement(i).getId()]        = costi[i][0];
+		 mapAss[meshPointer->getElement(i).getId()]        = costi[i][1];
+		 mapDist[meshPointer->getElement(i).getId()]       = costi[i][2];
 		 
  		 // li metto nei vettori da cui poi prendero il massimo se non ci sono i valrori troppo alti 
-		 costGeo.push_back(costi[0]);
-		 costAss.push_back(costi[1]);
-		 costDist.push_back(costi[2]);
+		 costGeo.push_back(costi[i][0]);
+		 costAss.push_back(costi[i][1]);
+		 costDist.push_back(costi[i][2]);
 		 
 		 // salvo gli identificatori di quelli da calcolare 
 		 toStore.push_back(i);
@@ -1007,11 +1086,12 @@ void meshDataSimplification<Triangle>::createElementList()
 		                 pesoDist*mapDist[meshPointer->getElement(toStore[i]).getId()]/maxDistCost);
 				 
 		 // lo metto nella lista
-		 listaTmp.insert(elem);		 
+		 listaTmp.push_back(elem);
 	  }
       }
       
-      // metto nella lista
+      // metto nella lista in blocco con lo stesso ordine del set 
+      sortAsSet(&listaTmp);
       sortedList.clear();
       sortedList.setElementVector(&listaTmp);
 }
@@ -1059,14 +1139,24 @@ void meshDataSimplification<Triangle>::deleteElementList(vector<UInt> * edge, ve
 void meshDataSimplification<Triangle>::upDate(vector<UInt> * vicini)
 {
     // variabili in uso 
-    Real 				 costo = 0.0;
-    point 					   p;
-    vector<UInt>				edge;
-    vector<Real>                               costi;
     geoElementSize<Triangle> 			elem;
-    set<geoElementSize<Triangle> >	    listaTmp;
+    vector<Real>		  costo(vicini->size());
+    vector<vector<Real> >	  costi(vicini->size());
+    vector<vector<UInt> >	   edge(vicini->size());
+    vector<point>		      p(vicini->size());
+    
+#ifdef _OPENMP
+    // una copia degli oggetti per le intersezioni per ogni thread della regione 
+    int numTh = omp_get_max_threads();
+    setNumThreads(numTh);
+#endif
+    
+    // calcolo i costi in parallelo, la mesh non viene toccata e ogni elemento scrive solamente nelle sue posizioni 
+    #pragma omp parallel for num_threads(numTh) schedule(dynamic, 1)
+    for(UInt i=0; i<vicini->size(); ++i)
+	  costo[i] = getElementCost(vicini->at(i), &costi[i], &edge[i], &p[i]);
       
-    // cambio gli eleemtnidi della lista 
+    // cambio gli eleemtnidi della lista nello stesso ordine 
     for(UInt i=0; i<vicini->size(); ++i)
     {
 	  // metto gli id dei connessi
@@ -1075,32 +1165,29 @@ void meshDataSimplification<Triangle>::upDate(vector<UInt> * vicini)
 	  // metto gli id dell'elemento 
 	  elem.setId(vicini->at(i));
 	  
-	  // setto il suo costo 
-	  costo = getElementCost(vicini->at(i), &costi, &edge, &p);
-	  
 	  // controllo che tutto sia ok
-	  if(costo!=-1.) 
+	  if(costo[i]!=-1.) 
 	  {
 		 // controllo se deve essere aggiornata la lista 
-		 controlUpdatingList(&costi);
+		 controlUpdatingList(&costi[i]);
 	    
 		 // prendo il costo 
-		 elem.setGeoSize(pesoGeo*(costi[0]/maxGeoCost)+pesoAss*(costi[1]/maxAssCost)+pesoDist*(costi[2]/maxDistCost));
+		 elem.setGeoSize(pesoGeo*(costi[i][0]/maxGeoCost)+pesoAss*(costi[i][1]/maxAssCost)+pesoDist*(costi[i][2]/maxDistCost));
 		 
 		 // setto il punto 
-		 elemIdToPoint[vicini->at(i)] = p;
-		 elemIdToEdge[vicini->at(i)]  = edge;
+		 elemIdToPoint[vicini->at(i)] = p[i];
+		 elemIdToEdge[vicini->at(i)]  = edge[i];
 		 
 		 // se è dentro 
 		 if(sortedList.isIn(vicini->at(i)))
 		 {		   
 		      // prendo il costo 
-		      sortedList.change(vicini->at(i), costo);
+		      sortedList.change(vicini->at(i), costo[i]);
 		 }
 		 else
 		 {
 		      // metto il costo 
-		      elem.setGeoSize(costo);
+		      elem.setGeoSize(costo[i]);
 		 
 		      // prendo il costo 
 		      sortedList.add(&elem);
@@ -1116,8 +1203,50 @@ void meshDataSimplification<Triangle>::upDate(vector<UInt> * vicini)
 
 void meshDataSimplification<Triangle>::upDateMemento(vector<mementoElement<Triangle> > * newMem)
 {
+      // variabili in uso 
+      UInt 	   id,start,num;
+      
       // rimetto in oridne gli elementi 
-      for(UInt i=0; i<newMem->size(); ++i)		mem[newMem->at(i).getId()] = newMem->at(i);
+      for(UInt i=0; i<newMem->size(); ++i)
+      {
+	    id  = newMem->at(i).getId();
+	    num = newMem->at(i).ptAssSize();
+	    
+	    // gli associati di newMem sono nella memoria di lavoro del thread, li copio in assStore
+	    assert((num==0) || (newMem->at(i).getStore()!=&assStore));
+	    start = (num==0) ? 0 : assStore.append(*newMem->at(i).getStore(), newMem->at(i).getPtStart(), num);
+	    
+	    // quelli vecchi non sono più usati 
+	    assGarbage += mem[id].ptAssSize();
+	    
+	    mem[id] = newMem->at(i);
+	    mem[id].setPtAss(&assStore, start, num);
+      }
+      
+      // se più di metà del contenitore non è usato lo ricompatto 
+      if(2*assGarbage>assStore.size())	compactAss();
+}
+
+void meshDataSimplification<Triangle>::compactAss()
+{
+      // variabili in uso 
+      UInt 	   start,num;
+      trackedStore    vecchio;
+      
+      // sposto il contenuto attuale in vecchio
+      vecchio.swap(assStore);
+      assStore.reserve(vecchio.size()-min(assGarbage, vecchio.size()));
+      
+      // copio gli intervalli usati nell'ordine degli elementi 
+      for(UInt i=0; i<mem.size(); ++i)
+      {
+	    num   = mem[i].ptAssSize();
+	    assert((num==0) || (mem[i].getStore()==&assStore));
+	    start = (num==0) ? 0 : assStore.append(vecchio, mem[i].getPtStart(), num);
+	    mem[i].setPtAss(&assStore, start, num);
+      }
+      
+      assGarbage = 0;
 }
 
 void meshDataSimplification<Triangle>::upDateFinder(vector<UInt> * edge, point pNew)
@@ -1146,6 +1275,23 @@ void meshDataSimplification<Triangle>::upDateFinder(vector<UInt> * edge, point p
       it = set_difference(tmp.begin(), tmp.end(), elem.begin(), elem.end(), toChange.begin());
       toChange.resize(it-toChange.begin());
       
+      // con l'albero tolgo solo gli elementi che spariscono, gli altri vengono spostati 
+      if(useTree)
+      {
+	    for(UInt i=0; i<elem.size(); ++i)	finderTree.eraseElement(elem[i]);
+	    
+	    // cambio le coordinate dei punti 
+	    for(UInt i=0; i<3; ++i)
+	    {
+		  meshPointer->getNodePointer(id1)->setI(i, pNew.getI(i));
+		  meshPointer->getNodePointer(id2)->setI(i, pNew.getI(i));
+	    }
+	    
+	    // si reinseriscono solo quelli che escono dal loro box allargato
+	    for(UInt i=0; i<toChange.size(); ++i)	finderTree.moveElement(toChange[i]);
+	    return;
+      }
+      
       // rimuovo gli elementi 
       for(UInt i=0; i<elem.size(); ++i)		finder.eraseElement(elem[i]);
       for(UInt i=0; i<toChange.size(); ++i)	finder.eraseElement(toChange[i]);
@@ -1161,6 +1307,21 @@ void meshDataSimplification<Triangle>::upDateFinder(vector<UInt> * edge, point p
       for(UInt i=0; i<toChange.size(); ++i)	finder.insertElement(toChange[i]);
 }
 
+void meshDataSimplification<Triangle>::buildFinder()
+{
+      // costruisco solo la struttura che viene usata e svuoto l'altra 
+      if(useTree)
+      {
+	    finder.clear();
+	    finderTree.setMeshPointer(meshPointer);
+      }
+      else
+      {
+	    finderTree.clear();
+	    finder.setMeshPointer(meshPointer);
+      }
+}
+
 
 //
 // Processi che effettuano i controlli geometrici 
@@ -1229,12 +1390,13 @@ bool meshDataSimplification<Triangle>::controlInt(vector<UInt> * edge, point pNe
 	   // faccio il bounding box 
 	   for(UInt j=0; j<3; ++j)
 	   {
-		pMax.setI(j, max(max(newCoor[i][0].getI(j),newCoor[i][1].getI(j)),newCoor[i][1].getI(j)));
-		pMin.setI(j, min(min(newCoor[i][0].getI(j),newCoor[i][1].getI(j)),newCoor[i][1].getI(j)));
+		pMax.setI(j, max(max(newCoor[i][0].getI(j),newCoor[i][1].getI(j)),newCoor[i][2].getI(j)));
+		pMin.setI(j, min(min(newCoor[i][0].getI(j),newCoor[i][1].getI(j)),newCoor[i][2].getI(j)));
 	   }
 	   
 	   // lo cerco nella struttura dati 
-	   result = finder.findIntersection(pMax,pMin);
+	   if(useTree)	result = finderTree.findIntersection(pMax,pMin);
+	   else		result = finder.findIntersection(pMax,pMin);
 	   
 	   // controllo le intersezioni solamente di quelli che non sono connessi 
 	   for(UInt j=0; j<result.second.size(); ++j)
@@ -1246,13 +1408,13 @@ bool meshDataSimplification<Triangle>::controlInt(vector<UInt> * edge, point pNe
 		      meshPointer->getNodeOfElement(result.second[j], &nodi);
 		      
 		      // faccio le intersezioni 
-		      resultInt = intersec.intersec(&nodi, &newCoor[i]);
+		      resultInt = getIntersec()->intersec(&nodi, &newCoor[i]);
 		      
 		      // l'intersezione potrebbe essere un vertice del triangolo 
 		      if(resultInt.second.size()==1)
 		      {
 			    // calcolo le coordinate baricentriche e controllo che la somma faccia 1
-			    resultTria = inTria.intersec(&nodi, resultInt.second[0]);
+			    resultTria = getInTria()->intersec(&nodi, resultInt.second[0]);
 			    
 			    // se cono interno e se è un vertice 
 			    if(resultTria.first && resultTria.second.size()!=1)	      return(false);
@@ -1260,13 +1422,13 @@ bool meshDataSimplification<Triangle>::controlInt(vector<UInt> * edge, point pNe
 		      else if(resultInt.second.size()==2)
 		      {
 			    // calcolo le coordinate baricentriche e controllo che la somma faccia 1
-			    resultTria = inTria.intersec(&nodi, resultInt.second[0]);
+			    resultTria = getInTria()->intersec(&nodi, resultInt.second[0]);
 			    
 			    // se cono interno e se è un vertice 
 			    if(resultTria.first && resultTria.second.size()!=1)	      return(false);
 								      
 			    // calcolo le coordinate baricentriche e controllo che la somma faccia 1
-			    resultTria = inTria.intersec(&nodi, resultInt.second[1]);
+			    resultTria = getInTria()->intersec(&nodi, resultInt.second[1]);
 			    
 			    // se cono interno e se è un vertice 
 			    if(resultTria.first && resultTria.second.size()!=1)	      return(false);
@@ -1312,7 +1474,7 @@ bool meshDataSimplification<Triangle>::controlInv(vector<UInt> * edge, point pNe
       set<UInt>::iterator                             it1;
       vector<UInt>            common,elem,stellata,tmpEle;
       UInt                                        id1,id2;
-      point                  oldId1,oldId2,nPrima,nDopo,p;
+      point                                nPrima,nDopo,p;
       bool                                            inv;
       
       // controllo che pNew non sia degenere 
@@ -1346,50 +1508,20 @@ bool meshDataSimplification<Triangle>::controlInv(vector<UInt> * edge, point pNe
       // controllo che TUTTE le condizioni che ammettano il collasso siano verificate:
       // inv      = non devono esserci elementi invertiti
       
-      // inserisco le coordinate di id1 e id2 in questi due punti
-      // id1 ...
-      oldId1.setX(meshPointer->getNode(id1).getX());
-      oldId1.setY(meshPointer->getNode(id1).getY());
-      oldId1.setZ(meshPointer->getNode(id1).getZ());
-      // ... e id2
-      oldId2.setX(meshPointer->getNode(id2).getX());
-      oldId2.setY(meshPointer->getNode(id2).getY());
-      oldId2.setZ(meshPointer->getNode(id2).getZ());
-      
-      // setto queste due variabili vere e poi nel ciclo le aggiorno
+      // setto questa variabile vera e poi nel ciclo la aggiorno
       inv  = true;
       
+      // le coordinate dei nodi non vengono toccate, la normale dopo il collasso si calcola sostituendo il punto così il 
+      // controllo può essere fatto in parallelo 
       for(it1 = coinvolti.begin(); it1!=coinvolti.end(); ++it1)
       {
-	    // calcolo la normale prima del collasso 
+	    // calcolo la normale prima e dopo il collasso 
 	    nPrima = getTriangleNormal(*it1);
-	    
-	    // sostituisco il punto
-	    // per sicurezza sostituisco sia a id1 ...
-	    meshPointer->getNodePointer(id1)->setX(pNew.getX());
-	    meshPointer->getNodePointer(id1)->setY(pNew.getY());
-	    meshPointer->getNodePointer(id1)->setZ(pNew.getZ());
-	    // ...che a id2, lo so che è sovrabbondante come cosa ma non costa nulla
-	    meshPointer->getNodePointer(id2)->setX(pNew.getX());
-	    meshPointer->getNodePointer(id2)->setY(pNew.getY());
-	    meshPointer->getNodePointer(id2)->setZ(pNew.getZ());
-	            
-	    // calcolo la normale dopo il collasso 
-	    nDopo = getTriangleNormal(*it1);
+	    nDopo  = getTriangleNormal(*it1, id1, id2, pNew);
 	    
 	    // vedo i due controlli
 	    inv  = ((nPrima*nDopo)>(sqrt(3.)/2.));
 	    
-	    // ripristino le vecchie coordinate
-	    // per sicurezza sostituisco sia a id1 ...
-	    meshPointer->getNodePointer(id1)->setX(oldId1.getX());
-	    meshPointer->getNodePointer(id1)->setY(oldId1.getY());
-	    meshPointer->getNodePointer(id1)->setZ(oldId1.getZ());
-	    // ...che a id2, lo so che è sovrabbondante come cosa ma non costa nulla
-	    meshPointer->getNodePointer(id2)->setX(oldId2.getX());
-	    meshPointer->getNodePointer(id2)->setY(oldId2.getY());
-	    meshPointer->getNodePointer(id2)->setZ(oldId2.getZ());
-	    
 	    // controllo preventivo sull'inversione
 	    if(!inv)		  return(false);
       }
@@ -1684,22 +1816,76 @@ void meshDataSimplification<Triangle>::simplificationProcess(UInt numNodesMax, U
 void meshDataSimplification<Triangle>::simplificate(UInt numNodesMax)
 {
       // variabili in uso
-      UInt 	 	       			counter=0,updateCounter=0;
+      UInt 	 	       		counter=0,updateCounter=0,fatti;
       UInt			       numNode=meshPointer->getNumNodes();
       UInt			  numNodeStart=meshPointer->getNumNodes();
       UInt	             limite=static_cast<UInt>(numNodeStart*times);
+      bool 						      libero;
       point								p;
-      vector<UInt>					       edge,toAdd;
+      vector<UInt>		 edge,toAdd,toUpDate,candidati,regione;
+      vector<bool>	    marcati(meshPointer->getNumElements(), false);
+      vector<UInt>						   usati;
       vector<mementoElement<Triangle> >                            newMem;
       
       // fino a che i nodi sono più grandi di quanto voglio proseguo con la decimazione 
       while(numNode>numNodesMax && counter<limite)
       {	  
-	  // prendo l'id
-	  p = getEdgeToSimplificate(&edge);
+	  // prendo i candidati con il costo più basso 
+	  sortedList.findKMin(min(numCandidates, numNode-numNodesMax), &candidati);
+	  
+	  // se la lista è vuota incremento solamente il contatore 
+	  if(candidati.size()==0)
+	  {
+	      ++counter;
+	      continue;
+	  }
+	  
+	  // tengo, in ordine di costo, i candidati la cui grande stellata non tocca quelle dei candidati già presi: 
+	  // i loro collassi non cambiano gli elementi degli altri e i costi attorno possono essere calcolati insieme
+	  if(candidati.size()>1)
+	  {
+	      UInt numPresi = 0;
+	      for(UInt i=0; i<candidati.size(); ++i)
+	      {
+		  createBigStellataEdge(&elemIdToEdge[candidati[i]], &regione);
+		  
+		  libero = true;
+		  for(UInt j=0; j<regione.size() && libero; ++j)	libero = !marcati[regione[j]];
+		  
+		  if(!libero)	continue;
+		  
+		  for(UInt j=0; j<regione.size(); ++j)
+		  {
+		      marcati[regione[j]] = true;
+		      usati.push_back(regione[j]);
+		  }
+		  candidati[numPresi++] = candidati[i];
+	      }
+	      candidati.resize(numPresi);
+	      
+	      // pulisco i marcatori 
+	      for(UInt j=0; j<usati.size(); ++j)	marcati[usati[j]] = false;
+	      usati.clear();
+	  }
 	  
-	  if(p!=pNull)
-	  {	   	    
+	  // eseguo i collassi in ordine di costo 
+	  toUpDate.clear();
+	  fatti = 0;
+	  for(UInt i=0; i<candidati.size(); ++i)
+	  {
+	      // prendo l'edge e il punto 
+	      edge = elemIdToEdge[candidati[i]];
+	      p    = elemIdToPoint[candidati[i]];
+	      
+	      // i controlli sono stati fatti prima dei collassi precedenti: le stellate sono disgiunte ma i nuovi 
+	      // triangoli possono comunque intersecarsi, quindi li rifaccio sulla geometria attuale. Se non passano 
+	      // il candidato non viene collassato e il suo costo viene ricalcolato 
+	      if(i>0 && !(controlInv(&edge, p) && controlInt(&edge, p)))
+	      {
+		  toUpDate.push_back(candidati[i]);
+		  continue;
+	      }
+	      
 	      // metto i dati in Q
 	      Q.push_back(createQ(&edge));
 	      	      
@@ -1708,6 +1894,7 @@ void meshDataSimplification<Triangle>::simplificate(UInt numNodesMax)
 	      
 	      // metto a posto la lista 
 	      deleteElementList(&edge, &toAdd);
+	      toUpDate.insert(toUpDate.end(), toAdd.begin(), toAdd.end());
 	      
 	      // faccio gli update delle liste
 	      upDateMemento(&newMem);
@@ -1721,40 +1908,34 @@ void meshDataSimplification<Triangle>::simplificate(UInt numNodesMax)
 		
 	      // diminuisco i punto 
 	      --numNode;
-	      
-	      //cout << numNode << "  " << numNodesMax << endl;
+	      ++fatti;
+	  }
+	  
+	  // aggiungo gli elementi modificati, i costi sono calcolati in parallelo 
+	  upDate(&toUpDate);
 	  
-	      // aggiungo gli elementi modificati 
-	      upDate(&toAdd);
+	  //
+	  // SE NON DEVO FARE IL CONTROLLO SULL'ASSICIAZIONE DEI DATI SISTEMO NON DEVO FARE I 
+	  // CONTROLLI SULLA VARIABILE "listToUpdate"
+	  //
+	  // se devo aggiornare la lista lo faccio 
+	  if(listToUpdate)	
+	  {
+	      // aggiorno il contatore 
+	      ++updateCounter;
 	      
-	      //
-	      // SE NON DEVO FARE IL CONTROLLO SULL'ASSICIAZIONE DEI DATI SISTEMO NON DEVO FARE I 
-	      // CONTROLLI SULLA VARIABILE "listToUpdate"
-	      //
-	      // se devo aggiornare la lista lo faccio 
-	      if(listToUpdate)	
-	      {
-		  // aggiorno il contatore 
-		  ++updateCounter;
-		  
-		  // stampo un messaggio 
-		  //cout << "Aggiorno per la " << updateCounter << " volta" << endl;
-		  
-		  // aggiorno il valore medio 
-		  meanAssValue = getMeanElemAss();
-		  
-		  // creo la lista 
-		  createElementList();
-		  
-		  listToUpdate = false;
-	      }
+	      // aggiorno il valore medio 
+	      meanAssValue = getMeanElemAss();
+	      
+	      // creo la lista 
+	      createElementList();
 	      
-	      // aggiorno i numero di elementi 
-	      numGlobElem = numGlobElem-2.;
+	      listToUpdate = false;
 	  }
 	  
-	  // incremento il contatore 
-	  ++counter;
+	  // aggiorno i numero di elementi e il contatore 
+	  numGlobElem = numGlobElem-2.*fatti;
+	  counter    += candidati.size();
       }
       cout << endl;
       cout << "Il metodo ha aggiornato la lista " << updateCounter  << " volte" << endl;
@@ -1901,7 +2082,7 @@ void meshDataSimplification<Triangle>::saveAss(string s)
       for(UInt i=0; i<mem.size(); ++i)
       {	
 	    // prendo i punti da associare 
-	    assTmp = mem[i].getPtAss();
+	    mem[i].getPtAss(&assTmp);
 	    
 	    // prendo gli id 
 	    for(UInt j=0; j<assTmp.size(); ++j)		nodiId.insert(assTmp[j].getId());
@@ -1919,7 +2100,7 @@ void meshDataSimplification<Triangle>::saveAss(string s)
       for(UInt i=0; i<mem.size(); ++i)
       {
 	    // prendo i punti da associare 
-	    assTmp = mem[i].getPtAss();
+	    mem[i].getPtAss(&assTmp);
 	    
 	    // incremento e riempio il vettore che contiene tutti i nodi 
 	    for(UInt j=0; j<assTmp.size(); ++j)
@@ -2022,7 +2203,7 @@ void meshDataSimplification<Triangle>::saveAss(string s, string link)
       for(UInt i=0; i<mem.size(); ++i)
       {	
 	    // prendo i punti da associare 
-	    assTmp = mem[i].getPtAss();
+	    mem[i].getPtAss(&assTmp);
 	    
 // 	    cout << i << endl;
 	    
@@ -2047,7 +2228,7 @@ void meshDataSimplification<Triangle>::saveAss(string s, string link)
       for(UInt i=0; i<mem.size(); ++i)
       {
 	    // prendo i punti da associare 
-	    assTmp = mem[i].getPtAss();
+	    mem[i].getPtAss(&assTmp);
 	    
 // 	    cout << i << endl;
 	    
@@ -10,23 +10,31 @@
 #include <numeric>
 #include <limits>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "../core/shapes.hpp"
 #include "../core/point.h"
 #include "../core/graphItem.h"
 
 #include "../utility/sortList.hpp"
+#include "../utility/heapList.hpp"
 #include "../utility/barCoordinates.h"
 
 #include "../geometry/geoElement.hpp"
 #include "../geometry/geoElementSize.hpp"
 #include "../geometry/meshSearch.hpp"
+#include "../geometry/meshSearchDynamic.hpp"
 #include "../geometry/mesh2d.hpp"
+#include "../geometry/localPatch.h"
 
 #include "../doctor/doctor2d.h"
 
 #include "../meshOperation/isotropicQuality2d.h"
 #include "../meshOperation/simplification2d.h"
 #include "../meshOperation/mementoElement.hpp"
+#include "../meshOperation/trackedStore.hpp"
 
 #include "../intersec/triangleIntersection.h"
 #include "../intersec/meshIntersec.hpp"
@@ -48,6 +56,57 @@ namespace geometry
 
 using namespace std;
 
+/*! Memoria di lavoro di changeMemento, una per ogni thread. Viene svuotata ad ogni chiamata senza liberare la memoria, 
+    quindi i punti associati dei memento element restituiti da changeMemento restano validi fino alla chiamata successiva 
+    dello stesso thread */
+
+class mementoScratch
+{
+      public:
+		  /*! Patch temporanea */
+		  localPatch				       patch;
+		  
+		  /*! Associazioni nell'ordine in cui sono fatte e elemento di newMem a cui vanno */
+		  trackedStore					pend;
+		  vector<UInt>				    pendElem;
+		  
+		  /*! Associazioni raggruppate per elemento, i memento element di newMem puntano qui */
+		  trackedStore					 ass;
+		  
+		  /*! Contatore delle associazioni di ogni elemento */
+		  vector<UInt>				        cont;
+		  
+		  /*! Elementi coinvolti nel collasso, ordinati e senza ripetizioni */
+		  vector<UInt>				   coinvolti;
+		  
+		  /*! Bounding box allargati degli elementi di newMem (minimo e massimo, 6 valori per elemento) */
+		  vector<Real>					 box;
+		  
+		  /*! Elementi di newMem ordinati per distanza dal box del punto da associare */
+		  vector<pair<Real,UInt> >			      ordine;
+		  
+		  /*! Nodi da associare */
+		  vector<point>					toAss;
+		  
+		  /*! Marcatore dei nodi associati già presi, il nodo è preso se vale epoca */
+		  vector<UInt>					visto;
+		  UInt						epoca;
+		  
+		  /*! Costruttore */
+		  mementoScratch() : epoca(0) {};
+		  
+		  /*! Metodo che marca un nodo associato nell'epoca attuale
+		      \param id identificatore del nodo 
+		      \return vero se il nodo era già stato preso */
+		  inline bool prendi(UInt id)
+		  {
+			if(id>=visto.size())	visto.resize(max(static_cast<size_t>(id)+1, 2*visto.size()), 0);
+			if(visto[id]==epoca)	return(true);
+			visto[id] = epoca;
+			return(false);
+		  };
+};
+
 /*! Classe che permette di effetuare il processo di eliminazione degli elementi di una griglia che però tiene traccia dei nodi 
     di partenza */
 
@@ -66,6 +125,10 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 		  /*! vettore che contiene le associazioni */
 		  vector<mementoElement<Triangle> >	  	  mem;
 		  
+		  /*! Contenitore dei punti associati agli elementi di mem e numero di associazioni non più usate */
+		  trackedStore				     assStore;
+		  UInt					    assGarbage;
+		  
 		  /*! Variabile che permette di settare il numero di iterazioni massime */
 		  Real 					        times;
 		  
@@ -81,6 +144,9 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 		  /*! Variabili per la gestione della mesh */
 		  Real 			     numGlobElem,numGlobPtAss;
 		  
+		  /*! Numero di candidati presi dalla lista ad ogni passo del processo di collasso */
+		  UInt 					numCandidates;
+		  
 		  /*! Variabile interna che permette di sapere se devo aggiornare la lista o no */
 		  bool 					 listToUpdate;
 		  
@@ -93,21 +159,28 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 		  /*! vettore che contiene la struttura di ricerca */
 		  meshSearchStructured<mesh2d<Triangle>,3>     finder;
 		  
+		  /*! struttura di ricerca ad albero, usata al posto di finder se useTree è vero */
+		  meshSearchDynamic<mesh2d<Triangle>,3>    finderTree;
+		  bool 					      useTree;
+		  
 		  /*! vettore con i punti da proiettare */
 		  vector<point>				      toTrack;
 		  
 		  /*! lista con l'elenco degli elementi da eliminare */
-		  sortList<geoElementSize<Triangle> >     sortedList;
+		  heapList<geoElementSize<Triangle> >     sortedList;
 		  
 		  /*! mappa che fa le associazioni */
 		  map<UInt, vector<UInt> >		elemIdToEdge;
 		  map<UInt, point>		       elemIdToPoint;
 		  
-		  /*! metodo che permette di fare le intersezioni con il triangolo */
-		  triangleIntersection 		             intersec;
+		  /*! metodo che permette di fare le intersezioni con il triangolo, uno per ogni thread */
+		  vector<triangleIntersection> 		     intersec;
 		  
-		  /*! Metodo per calcolare le coordinate baricentriche */
-		  inTriangle			               inTria;
+		  /*! Metodo per calcolare le coordinate baricentriche, uno per ogni thread */
+		  vector<inTriangle>			       inTria;
+		  
+		  /*! Memoria di lavoro di changeMemento, una per ogni thread */
+		  vector<mementoScratch>		     scratch;
 		  
       //
       // Costruttori
@@ -138,6 +211,12 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 		  inline void setTimes(Real _times) {times=_times;};
 		  inline Real getTimes()	    {return(times);};
 		  
+		  /*! get e set del numero di candidati presi ad ogni passo: con più di uno vengono collassati insieme, in
+		      ordine di costo, quelli le cui stellate non si sovrappongono 
+		      \param _numCandidates numero di candidati */
+		  inline void setNumCandidates(UInt _numCandidates) {numCandidates=max(_numCandidates, static_cast<UInt>(1));};
+		  inline UInt getNumCandidates()		    {return(numCandidates);};
+		  
 		  /*! get e set della varaibile dontTouch*/
 		  inline void activeDontTouch()	    {dontTouch=true;};
 		  inline void disactiveDontTouch()  {dontTouch=false;};
@@ -151,6 +230,12 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 		  inline UInt getColorElemDontTouch() 		     		{return(colorElemDontTouch);};
 		  inline void setColorElemDontTouch(UInt _colorElemDontTouch) 	{colorElemDontTouch=_colorElemDontTouch;};
 		  
+		  /*! get e set della struttura di ricerca usata per le intersezioni: la griglia (default) oppure l'albero
+		      di bounding box, più adatto alle mesh con elementi di dimensioni molto diverse
+		      \param _useTree vero per usare l'albero */
+		  void setDynamicFinder(bool _useTree);
+		  inline bool getDynamicFinder()    {return(useTree);};
+		  
 		  /*! Metodo che setta la variabile fatt a tutti gli elementi di memento */
 		  void setFattMemento(Real _fatt);
 		  Real getFattMemento();
@@ -202,19 +287,28 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 				     point pNew, 
 				     vector<mementoElement<Triangle> > * newMem);
 				     
-		  /*! Metodo che crea una mesh temporanea per controllare le associazioni 
+		  /*! Metodo che crea una patch temporanea per controllare le associazioni, gli id locali degli elementi 
+		      sono quelli della lista newMem
 		      \param newMem nuova lista di memento elements
-		      \param pNew nuovo punto inserito 
-		      \param tmpMesh mesh temporanea che viene creata
-		      \param newToOld mappa per passare dalla nuova alla vecchia 
-		      \param newToOld mappa per passare dalla vecchia alla nuova*/
-		  void buildTmpMesh(vector<mementoElement<Triangle> > * newMem, 
-				    point pNew, 
-				    mesh2d<Triangle> * tmpMesh,
-	  		            map<UInt,UInt> & newToOld,
-	  		            map<UInt,UInt> & oldToNew);
+		      \param patch patch che viene riempita */
+		  void buildTmpPatch(vector<mementoElement<Triangle> > * newMem, 
+				     localPatch * patch);
 				    
 				     
+		  /*! Metodo che restituisce l'oggetto per le intersezioni del thread che lo chiama */
+		  inline triangleIntersection * getIntersec();
+		  
+		  /*! Metodo che restituisce l'oggetto per le coordinate baricentriche del thread che lo chiama */
+		  inline inTriangle * getInTria();
+		  
+		  /*! Metodo che restituisce la memoria di lavoro del thread che lo chiama */
+		  inline mementoScratch * getScratch();
+		  
+		  /*! Metodo che assicura una copia degli oggetti per ogni thread di una regione parallela, va chiamato fuori 
+		      dalla regione e la regione non deve usare più di numThreads thread 
+		      \param numThreads numero di thread */
+		  void setNumThreads(UInt numThreads);
+		  
 		  /*! Metodo che associa un valore al nodo 
 		      \param elemId identificatore dell'elemento
 		      \param nodiTria lista dei vertici 
@@ -260,10 +354,16 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 		      \param newMem nuovi elementi da inserire */
 		  void upDateMemento(vector<mementoElement<Triangle> > * newMem);
 		  
+		  /*! Metodo che ricompatta assStore eliminando le associazioni che nessun elemento usa più */
+		  void compactAss();
+		  
 		  /*! Metodo che aggiorna la struttura di ricerca se viene collassato un lato 
 		      \param edge edge di input
 		      \param pNew nuovo punto inserito */
 		  void upDateFinder(vector<UInt> * edge, point pNew);
+		  
+		  /*! Metodo che costruisce la struttura di ricerca in uso */
+		  void buildFinder();
       //
       // Processi che effettuano i controlli geometrici 
       //
@@ -357,6 +457,41 @@ template<> class meshDataSimplification<Triangle> : public simplification2d<Tria
 
 
 
+
+//-------------------------------------------------------------------------------------------------------
+// INLINE FUNCTIONS
+//-------------------------------------------------------------------------------------------------------
+
+inline triangleIntersection * meshDataSimplification<Triangle>::getIntersec()
+{
+#ifdef _OPENMP
+      assert(static_cast<UInt>(omp_get_thread_num())<intersec.size());
+      return(&intersec[omp_get_thread_num()]);
+#else
+      return(&intersec[0]);
+#endif
+}
+
+inline inTriangle * meshDataSimplification<Triangle>::getInTria()
+{
+#ifdef _OPENMP
+      assert(static_cast<UInt>(omp_get_thread_num())<inTria.size());
+      return(&inTria[omp_get_thread_num()]);
+#else
+      return(&inTria[0]);
+#endif
+}
+
+inline mementoScratch * meshDataSimplification<Triangle>::getScratch()
+{
+#ifdef _OPENMP
+      assert(static_cast<UInt>(omp_get_thread_num())<scratch.size());
+      return(&scratch[omp_get_thread_num()]);
+#else
+      return(&scratch[0]);
+#endif
+}
+
 }
 
 #endif
@@ -1,5 +1,9 @@
 #include <chrono>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "simplification2d.h"
 
 using namespace std;
@@ -11,10 +15,17 @@ using namespace geometry;
 //
 simplification2d<Triangle>::simplification2d() : doctor2d<Triangle>()
 {
+    // di default si usa lo heap indicizzato
+    queueType = HEAPQUEUE;
+    memoryMode = APPENDNODE;
 }
 
 simplification2d<Triangle>::simplification2d(mesh2d<Triangle> * _meshPointer) : doctor2d<Triangle>(_meshPointer)
 {  
+    // di default si usa lo heap indicizzato
+    queueType = HEAPQUEUE;
+    memoryMode = APPENDNODE;
+    
     // creo il vettore Q
     setUpQ();
 }
@@ -28,6 +39,16 @@ void simplification2d<Triangle>::setMeshPointer(mesh2d<Triangle> * _meshPointer)
     setUpQ();
 }
 
+void simplification2d<Triangle>::setQueueType(collapseQueue _queueType)
+{
+    queueType = _queueType;
+}
+
+void simplification2d<Triangle>::setMemoryMode(collapseMemory _memoryMode)
+{
+    memoryMode = _memoryMode;
+}
+
 void simplification2d<Triangle>::refresh()
 {
       
@@ -43,6 +64,8 @@ void simplification2d<Triangle>::refresh()
       Real                             x,y,z;
       vector<geoElement<Line> >  lineListTmp;
       vector<graphItem>		tmpTrackList;
+      vector<quadric>		        tmpQ;
+      bool    	  renumberQ=(Q.size()==meshPointer->getNumNodes());
       
       // faccio un reserve
       active.reserve(meshPointer->getNumNodes());
@@ -96,9 +119,15 @@ void simplification2d<Triangle>::refresh()
 		    
 		    // inserisco nella lista temporanea dei nodi
 		    tmpPt.push_back(p);
+		    
+		    // tengo la matrice del nodo
+		    if(renumberQ)	tmpQ.push_back(Q[i]);
 	    }
       }
       
+      // le matrici seguono i nodi
+      if(renumberQ)	Q.swap(tmpQ);
+      
       // ciclo sugli elementi per sistemare gli id dei nodi e metterli nella lista temporanea
       cont = 0;
       for(UInt i=0; i<meshPointer->getNumElements(); ++i)
@@ -143,7 +172,7 @@ void simplification2d<Triangle>::refresh()
 //
 // Processo che crea la lista e i suoi elementi  
 //
-vector<Real> simplification2d<Triangle>::createK_p(UInt nodeId, UInt elemId)
+quadric simplification2d<Triangle>::createK_p(UInt nodeId, UInt elemId)
 {
     assert(nodeId<meshPointer->getNumNodes());
     assert(elemId<meshPointer->getNumElements());
@@ -151,7 +180,6 @@ vector<Real> simplification2d<Triangle>::createK_p(UInt nodeId, UInt elemId)
     // varabile in uso 
     Real 			   noto;
     point			 normal;
-    vector<Real>		    K_p;
     
     //	prendo la normale 
     normal = getTriangleNormal(elemId);
@@ -159,53 +187,20 @@ vector<Real> simplification2d<Triangle>::createK_p(UInt nodeId, UInt elemId)
     // setto il termine noto 
     noto = (-1.0)*(meshPointer->getNode(nodeId)*normal);
     
-    // creo la matrice 
-    K_p.assign(16,0.0);
-    
-    // faccio gli elementi 
-    K_p[0]  = normal.getX()*normal.getX();	
-    K_p[1]  = normal.getX()*normal.getY();	
-    K_p[2]  = normal.getX()*normal.getZ();
-    K_p[3]  = normal.getX()*noto;
-    
-    K_p[4]  = normal.getY()*normal.getX();	
-    K_p[5]  = normal.getY()*normal.getY();	
-    K_p[6]  = normal.getY()*normal.getZ();
-    K_p[7]  = normal.getY()*noto;
-    
-    K_p[8]  = normal.getZ()*normal.getX();	
-    K_p[9]  = normal.getZ()*normal.getY();	
-    K_p[10] = normal.getZ()*normal.getZ();
-    K_p[11] = normal.getZ()*noto;
-    
-    K_p[12] = noto*normal.getX();	
-    K_p[13] = noto*normal.getY();	
-    K_p[14] = noto*normal.getZ();
-    K_p[15] = noto*noto;
-    
-    // ritorno la matrice 
-    return(K_p);
+    // ritorno la matrice del piano
+    return(quadric(normal, noto));
 }
 
-vector<Real> simplification2d<Triangle>::createQ(UInt nodeId)
+quadric simplification2d<Triangle>::createQ(UInt nodeId)
 {
     assert(nodeId<meshPointer->getNumNodes());
     
     // varaibili in uso
-    vector<Real>	    QTmp,K_p;
+    quadric	    QTmp;
     
-    // faccio un resize
-    QTmp.assign(16,0.0);
-    
-    // prendo tutti i connessi 
+    // prendo tutti i connessi e aggiorno la matrice Q
     for(UInt i=0; i<conn.getNodeToElementPointer(nodeId)->getNumConnected(); ++i)
-    {
-	  // prendo la matrice 
-	  K_p = createK_p(nodeId, conn.getNodeToElementPointer(nodeId)->getConnectedId(i));
-	  
-	  // aggiorno la matrice Q
-	  for(UInt k=0; k<16; ++k)	QTmp[k] = QTmp[k]+K_p[k];
-    }
+	  QTmp += createK_p(nodeId, conn.getNodeToElementPointer(nodeId)->getConnectedId(i));
     
     // ritono la matrice 
     return(QTmp);
@@ -224,18 +219,10 @@ void simplification2d<Triangle>::setUpQ()
 //
 // Metodo per trovare i punti 
 //
-vector<Real> simplification2d<Triangle>::createQ(vector<UInt> * edge)
+quadric simplification2d<Triangle>::createQ(vector<UInt> * edge)
 {
-    // variabili in uso 
-    vector<Real> QEdge;
-    
-    // faccio il resize
-    QEdge.assign(16,0.0);
-    
     // faccio la somma 
-    for(UInt i=0; i<16; ++i)	QEdge[i] = Q[edge->at(0)][i]+Q[edge->at(1)][i];
-      
-    return(QEdge);
+    return(Q[edge->at(0)]+Q[edge->at(1)]);
 }
 
 void simplification2d<Triangle>::createPointList(vector<UInt> * edge, vector<point> * newNodes)
@@ -253,7 +240,14 @@ void simplification2d<Triangle>::createPointList(vector<UInt> * edge, vector<poi
     newNodeTmp.clear();
     newNodeTmp.reserve(5);
     
-    switch(bound1)
+    // i nodi bloccati (boundary 2) non si spostano: l'edge si collassa sul nodo bloccato se l'altro estremo è interno 
+    // oppure è di bordo e l'edge è di bordo, se sono bloccati tutti e due non si collassa
+    if(bound1==2 || bound2==2)
+    {
+	if(bound1==2 && bound2!=2 && (bound2==0 || isBoundary(edge)))		newNodeTmp.push_back(p1);
+	else if(bound2==2 && bound1!=2 && (bound1==0 || isBoundary(edge)))	newNodeTmp.push_back(p2);
+    }
+    else switch(bound1)
     {
       case(0):
 	      switch(bound2)
@@ -321,36 +315,20 @@ void simplification2d<Triangle>::createPointList(vector<UInt> * edge, vector<poi
 	newNodes->push_back(newNodeTmp[i]);
 }
 
-Real simplification2d<Triangle>::getEdgeCost(vector<Real> * Q, point pNew)
+Real simplification2d<Triangle>::getEdgeCost(quadric * Q, point pNew)
 {     
-      // variabili in uso 
-      vector<Real>	          v1,vTmp;
-      
-      // faccio un resize di v1
-      v1.assign(4,1.0);
-      for(UInt i=0; i<3; ++i)	v1[i] = pNew.getI(i);
-     
-      // faccio un resize e la moltiplicazione
-      vTmp.assign(4, 0.0);
-      
-      // riempio il vettore
-      vTmp[0] = Q->at(0)*v1[0] + Q->at(4)*v1[1] + Q->at(8)*v1[2]  + Q->at(12)*v1[3];
-      vTmp[1] = Q->at(1)*v1[0] + Q->at(5)*v1[1] + Q->at(9)*v1[2]  + Q->at(13)*v1[3];  
-      vTmp[2] = Q->at(2)*v1[0] + Q->at(6)*v1[1] + Q->at(10)*v1[2] + Q->at(14)*v1[3];  
-      vTmp[3] = Q->at(3)*v1[0] + Q->at(7)*v1[1] + Q->at(11)*v1[2] + Q->at(15)*v1[3];  
-            
-      // ritorno il valore 
-      return(inner_product(v1.begin(), v1.end(), vTmp.begin(), 0.0));
+      // calcolo v^T Q v 
+      return(Q->evaluate(pNew));
 }
 
-pair<point, vector<Real> > simplification2d<Triangle>::getEdgeCost(vector<UInt> * edge)
+pair<point, quadric> simplification2d<Triangle>::getEdgeCost(vector<UInt> * edge)
 {
       // varaibili in uso 
       Real 	  	             costo,costoTmp;
       point 	  			       pNew;
       vector<point>			   newNodes;
-      vector<Real>				  Q;
-      pair<point, vector<Real> >	     result;
+      quadric				  Q;
+      pair<point, quadric>	     result;
       
       // creo la matrice dell'edge 
       Q = createQ(edge);
@@ -390,7 +368,7 @@ pair<point, vector<Real> > simplification2d<Triangle>::getEdgeCost(vector<UInt>
       return(result);
 }
 
-pair<point, vector<Real> > simplification2d<Triangle>::getMinEdgeCost(UInt elemId, vector<UInt> * edge)
+pair<point, quadric> simplification2d<Triangle>::getMinEdgeCost(UInt elemId, vector<UInt> * edge)
 {
     // controllo 
     assert(elemId<meshPointer->getNumElements());
@@ -398,8 +376,8 @@ pair<point, vector<Real> > simplification2d<Triangle>::getMinEdgeCost(UInt elemI
     // variabili in uso
     Real 		     costo=9.9e99,costoTmp=0.0;
     vector<UInt>	 		     tmpLin(2);
-    pair<point, vector<Real> >			result;
-    pair<point, vector<Real> >		     resultTmp;
+    pair<point, quadric>			result;
+    pair<point, quadric>		     resultTmp;
     
     // setto result
     result.first = pNull;
@@ -444,47 +422,55 @@ pair<point, vector<Real> > simplification2d<Triangle>::getMinEdgeCost(UInt elemI
 //
 // Metodo per creare le liste
 //
-void simplification2d<Triangle>::createElementList(sortList<geoElementSize<Triangle> > * lista)
+template<typename LIST>
+void simplification2d<Triangle>::createElementList(LIST * lista)
 {
       // variabili in uso 
-      Real 				 costo = 0.0;
       vector<UInt>				edge;
+      vector<Real>		     costi(meshPointer->getNumElements(), 0.0);
+      vector<UInt>		     valid(meshPointer->getNumElements(), 0);
       geoElementSize<Triangle> 			elem;
-      pair<point, vector<Real> >	      result;
-      set<geoElementSize<Triangle> >	    listaTmp;
+      vector<geoElementSize<Triangle> >	    listaTmp;
+      
+      // calcolo i costi in parallelo, ogni elemento scrive solo il suo costo 
+      // N.B. le flag sono UInt perché vector<bool> non può essere scritto in parallelo
+      #pragma omp parallel for schedule(dynamic, 256) private(edge)
+      for(UInt i=0; i<meshPointer->getNumElements(); ++i)
+      {
+	  pair<point, quadric> result = getMinEdgeCost(i, &edge);
+	  
+	  // controllo che tutto sia ok
+	  if((result.first-pNull).norm2()>1e-10)
+	  {
+		costi[i] = getEdgeCost(&result.second, result.first);
+		valid[i] = 1;
+	  }
+      }
       
       // creo la lista 
+      listaTmp.reserve(meshPointer->getNumElements());
       for(UInt i=0; i<meshPointer->getNumElements(); ++i)
       {
+	  if(!valid[i])	continue;
+	  
 	  // metto gli id dei connessi
 	  for(UInt j=0; j<3; ++j)  elem.setConnectedId(j, meshPointer->getElement(i).getConnectedId(j));
 	  
 	  // metto gli id dell'elemento 
 	  elem.setId(meshPointer->getElement(i).getId());
 	  
-	  // setto il suo costo 
-	  result = getMinEdgeCost(i, &edge);
-	  
-	  // controllo che tutto sia ok
-	  if((result.first-pNull).norm2()>1e-10)	
-	  {
-		 // prendo il costo 
-		 costo = getEdgeCost(&result.second, result.first);
-		 
-		 // prendo il costo 
-		 elem.setGeoSize(costo);
-		 
-		 // lo metto nella lista
-		 listaTmp.insert(elem);
-	  }	  
+	  // prendo il costo 
+	  elem.setGeoSize(costi[i]);
+	  listaTmp.push_back(elem);
       }
       
-      // metto nella lista
+      // metto nella lista in blocco con lo stesso ordine del set 
+      sortAsSet(&listaTmp);
       lista->setElementVector(&listaTmp);
 }
 
-void simplification2d<Triangle>::deleteElementList(sortList<geoElementSize<Triangle> > * lista, vector<UInt> * edge, 
-						   vector<UInt> * toUpDate)
+template<typename LIST>
+void simplification2d<Triangle>::deleteElementList(LIST * lista, vector<UInt> * edge, vector<UInt> * toUpDate)
 {
     // variabili in gioco 
     vector<UInt>   	     onEdge,edgeTmp,vicini;
@@ -514,13 +500,14 @@ void simplification2d<Triangle>::deleteElementList(sortList<geoElementSize<Trian
     copy(vicini.begin(), vicini.end(), toUpDate->begin());
 }
 
-void simplification2d<Triangle>::upDate(sortList<geoElementSize<Triangle> > * listaBase, vector<UInt> * vicini)
+template<typename LIST>
+void simplification2d<Triangle>::upDate(LIST * listaBase, vector<UInt> * vicini)
 {
     // variabili in gioco 
     Real 			       costo = 0.0;
     vector<UInt>   	                   edgeTmp;
     geoElementSize<Triangle> 		      elem;
-    pair<point, vector<Real> >		    result;
+    pair<point, quadric>		    result;
         
     // cambio gli eleemtnidi della lista 
     for(UInt i=0; i<vicini->size(); ++i)
@@ -563,7 +550,8 @@ void simplification2d<Triangle>::upDate(sortList<geoElementSize<Triangle> > * li
     }
 }
 
-UInt simplification2d<Triangle>::getElementToSimplificate(sortList<geoElementSize<Triangle> > * listaBase)
+template<typename LIST>
+UInt simplification2d<Triangle>::getElementToSimplificate(LIST * listaBase)
 {
       return(listaBase->findMin());
 }
@@ -579,7 +567,7 @@ bool simplification2d<Triangle>::control(vector<UInt> * edge, point pNew)
       set<UInt>::iterator                             it1;
       vector<UInt>            common,elem,stellata,tmpEle;
       UInt                                        id1,id2;
-      point                  oldId1,oldId2,nPrima,nDopo,p;
+      point                               nPrima,nDopo;
       bool                                            inv;
       
       // controllo che pNew non sia degenere 
@@ -613,16 +601,6 @@ bool simplification2d<Triangle>::control(vector<UInt> * edge, point pNew)
       // controllo che TUTTE le condizioni che ammettano il collasso siano verificate:
       // inv      = non devono esserci elementi invertiti
       
-      // inserisco le coordinate di id1 e id2 in questi due punti
-      // id1 ...
-      oldId1.setX(meshPointer->getNode(id1).getX());
-      oldId1.setY(meshPointer->getNode(id1).getY());
-      oldId1.setZ(meshPointer->getNode(id1).getZ());
-      // ... e id2
-      oldId2.setX(meshPointer->getNode(id2).getX());
-      oldId2.setY(meshPointer->getNode(id2).getY());
-      oldId2.setZ(meshPointer->getNode(id2).getZ());
-      
       // setto queste due variabili vere e poi nel ciclo le aggiorno
       inv  = true;
       
@@ -631,32 +609,12 @@ bool simplification2d<Triangle>::control(vector<UInt> * edge, point pNew)
 	    // calcolo la normale prima del collasso 
 	    nPrima = getTriangleNormal(*it1);
 	    
-	    // sostituisco il punto
-	    // per sicurezza sostituisco sia a id1 ...
-	    meshPointer->getNodePointer(id1)->setX(pNew.getX());
-	    meshPointer->getNodePointer(id1)->setY(pNew.getY());
-	    meshPointer->getNodePointer(id1)->setZ(pNew.getZ());
-	    // ...che a id2, lo so che è sovrabbondante come cosa ma non costa nulla
-	    meshPointer->getNodePointer(id2)->setX(pNew.getX());
-	    meshPointer->getNodePointer(id2)->setY(pNew.getY());
-	    meshPointer->getNodePointer(id2)->setZ(pNew.getZ());
-	            
-	    // calcolo la normale dopo il collasso 
-	    nDopo = getTriangleNormal(*it1);
+	    // calcolo la normale dopo il collasso senza spostare i nodi 
+	    nDopo = getTriangleNormal(*it1, id1, id2, pNew);
 	    
 	    // vedo i due controlli
 	    inv  = ((nPrima*nDopo)>(sqrt(3)/2));
 	    
-	    // ripristino le vecchie coordinate
-	    // per sicurezza sostituisco sia a id1 ...
-	    meshPointer->getNodePointer(id1)->setX(oldId1.getX());
-	    meshPointer->getNodePointer(id1)->setY(oldId1.getY());
-	    meshPointer->getNodePointer(id1)->setZ(oldId1.getZ());
-	    // ...che a id2, lo so che è sovrabbondante come cosa ma non costa nulla
-	    meshPointer->getNodePointer(id2)->setX(oldId2.getX());
-	    meshPointer->getNodePointer(id2)->setY(oldId2.getY());
-	    meshPointer->getNodePointer(id2)->setZ(oldId2.getZ());
-	    
 	    // controllo preventivo sull'inversione
 	    if(!inv)		  return(false);
       }
@@ -694,6 +652,66 @@ bool simplification2d<Triangle>::control(vector<UInt> * edge, point pNew)
         
 }
 
+bool simplification2d<Triangle>::controlHalfEdge(halfEdge2d<Triangle> * he, UInt from, UInt to)
+{
+      // variabili in uso 
+      vector<UInt>				elem;
+      point 			 nPrima,nDopo,pNew;
+      bool 					 onEdge;
+      
+      // condizione topologica 
+      if(!he->isCollapsable(from, to))	return(false);
+      
+      // il nodo from va nella posizione di to 
+      pNew = meshPointer->getNode(to);
+      
+      // controllo i triangoli di from che rimangono 
+      he->getElementAround(from, &elem);
+      for(UInt i=0; i<elem.size(); ++i)
+      {
+	    // quelli sull'edge vengono eliminati 
+	    onEdge = false;
+	    for(UInt j=0; j<3; ++j)	onEdge = onEdge || (meshPointer->getElement(elem[i]).getConnectedId(j)==to);
+	    if(onEdge)	continue;
+	    
+	    // normali prima e dopo il collasso 
+	    nPrima = getTriangleNormal(elem[i]);
+	    nDopo  = getTriangleNormal(elem[i], from, from, pNew);
+	    
+	    // stessi controlli di controlColl
+	    if((nPrima*nDopo)<=0.9)					return(false);
+	    if(getTriangleArea(elem[i], from, from, pNew)<toll)		return(false);
+      }
+      
+      return(true);
+}
+
+pair<UInt, Real> simplification2d<Triangle>::getHalfEdgeCost(halfEdge2d<Triangle> * he, UInt nodeId)
+{
+      // variabili in uso 
+      vector<UInt>					vicini;
+      pair<UInt, Real>	 best(halfEdge2d<Triangle>::NONE, 0.0);
+      Real 						  costo;
+      
+      // provo tutti i vicini, a parità di costo vince il primo 
+      he->createStellata(nodeId, &vicini);
+      for(UInt i=0; i<vicini.size(); ++i)
+      {
+	    if(!controlHalfEdge(he, nodeId, vicini[i]))	continue;
+	    
+	    // costo di Garland nel nodo che rimane 
+	    costo = (Q[nodeId]+Q[vicini[i]]).evaluate(meshPointer->getNode(vicini[i]));
+	    
+	    if((best.first==halfEdge2d<Triangle>::NONE) || (costo<best.second))
+	    {
+		  best.first  = vicini[i];
+		  best.second = costo;
+	    }
+      }
+      
+      return(best);
+}
+
 //
 // Metodo che fa la semplificazione 
 //
@@ -705,7 +723,7 @@ void simplification2d<Triangle>::simplificate(UInt numNodesMax)
       //time_t 				 start,end;
       //Real          			       dif;
       vector<UInt>			      edge;
-      pair<point, vector<Real> >	    result;
+      pair<point, quadric>	    result;
       
       // controllo che i punti non siano già sotto 
       if(numNodesMax>=meshPointer->getNumNodes())
@@ -773,6 +791,28 @@ void simplification2d<Triangle>::simplificate(UInt numNodesMax)
 }
 
 void simplification2d<Triangle>::simplificateGreedy(UInt numNodesMax)
+{
+      // variabili in uso
+      sortList<geoElementSize<Triangle> >    listaSort;
+      heapList<geoElementSize<Triangle> >    listaHeap;
+      lazyList<geoElementSize<Triangle> >    listaLazy;
+      
+      // scelgo la lista 
+      switch(queueType)
+      {
+	  case(SORTQUEUE):
+		simplificateGreedy(numNodesMax, &listaSort);
+		break;
+	  case(LAZYQUEUE):
+		simplificateGreedy(numNodesMax, &listaLazy);
+		break;
+	  default:
+		simplificateGreedy(numNodesMax, &listaHeap);
+      }
+}
+
+template<typename LIST>
+void simplification2d<Triangle>::simplificateGreedy(UInt numNodesMax, LIST * lista)
 {
       // variabili in uso
       UInt 	 	        elemId=0,counter=0;
@@ -782,8 +822,7 @@ void simplification2d<Triangle>::simplificateGreedy(UInt numNodesMax)
       //Real          			       dif;
       point 					 p;
       vector<UInt>			edge,toAdd;
-      pair<point, vector<Real> > 	    result;
-      sortList<geoElementSize<Triangle> >    lista;
+      pair<point, quadric> 	    result;
       
       // controllo che i punti non siano già sotto 
       if(numNodesMax>=meshPointer->getNumNodes())
@@ -799,13 +838,16 @@ void simplification2d<Triangle>::simplificateGreedy(UInt numNodesMax)
       high_resolution_clock::time_point start = high_resolution_clock::now();
       
       // creo la lista 
-      createElementList(&lista);
+      createElementList(lista);
       
       // fino a che i nodi sono più grandi di quanto voglio proseguo con la decimazione 
       while(numNode>numNodesMax && counter<numNodeStart)
       {		
+	  // se la lista è vuota non posso più collassare 
+	  if(lista->isEmpty())	break;
+	  
 	  // prendo l'id
-	  elemId = getElementToSimplificate(&lista);
+	  elemId = getElementToSimplificate(lista);
 	  
 	  // prendo l'informazione 
 	  result = getMinEdgeCost(elemId, &edge);
@@ -813,32 +855,51 @@ void simplification2d<Triangle>::simplificateGreedy(UInt numNodesMax)
 	  if(control(&edge, result.first))
 	  {
 		// metto a posto la lista 
-		deleteElementList(&lista, &edge, &toAdd);
+		deleteElementList(lista, &edge, &toAdd);
 		
-		// inserisco il nodo 
-		meshPointer->insertNode(result.first);
-		  
-		// collasso tenendo buono l'id del secondo 
-		collEdge(&edge);
-		  
-		// metto Q 
-		Q.push_back(result.second);
+		if(memoryMode==REUSENODE)
+		{
+		      // collasso sul primo estremo riusando il suo posto 
+		      collEdgeInPlace(&edge, edge[0], result.first);
+		      
+		      // metto Q 
+		      Q[edge[0]] = result.second;
+		}
+		else
+		{
+		      // inserisco il nodo 
+		      meshPointer->insertNode(result.first);
+			
+		      // collasso tenendo buono l'id del secondo 
+		      collEdge(&edge);
+			
+		      // metto Q 
+		      Q.push_back(result.second);
+		}
 	  
 		// diminuisco i punto 
 		--numNode;
 	  
 		// aggiungo gli elementi modificati 
-		upDate(&lista, &toAdd);
+		upDate(lista, &toAdd);
 	  }
 	  else
 	  {
 		// metto a posto la lista 
-		deleteElementList(&lista, &edge, &toAdd);
+		deleteElementList(lista, &edge, &toAdd);
 		
 	  }
 	  
 	  // incremento counter 
 	  ++counter;
+	  
+	  // compattazione periodica: quando i nodi morti superano quelli vivi si rinumera tutto e si ricrea la lista
+	  if(memoryMode==REUSENODE && 2*numNode<meshPointer->getNumNodes() && numNode>numNodesMax)
+	  {
+		refresh();
+		lista->clear();
+		createElementList(lista);
+	  }
 	    
  	  //cout << numNode << " nodi su un limite massimo di " << numNodesMax << "                            \r";
       }
@@ -864,7 +925,7 @@ void simplification2d<Triangle>::simplificateGreedyEasy(UInt numNodesMax)
       Real          			       dif;
       point 					 p;
       vector<UInt>			edge,toAdd;
-      pair<point, vector<Real> > 	    result;
+      pair<point, quadric> 	    result;
       sortList<geoElementSize<Triangle> >    lista;
       
       // controllo che i punti non siano già sotto 
@@ -934,7 +995,7 @@ void simplification2d<Triangle>::simplificateStep(UInt numNodesMax, UInt step)
       Real          			       dif;
       point 					 p;
       vector<UInt>		       edge,toSimp;
-      pair<point, vector<Real> > 	    result;
+      pair<point, quadric> 	    result;
       sortList<geoElementSize<Triangle> >    lista;
       
       // controllo che i punti non siano già sotto 
@@ -1019,6 +1080,469 @@ void simplification2d<Triangle>::simplificateStep(UInt numNodesMax, UInt step)
       cout << "Processo di semplificazione con Step completato: " <<  dif << " sec." << endl;
 }
 
+void simplification2d<Triangle>::simplificateParallel(UInt numNodesMax, UInt numThreads, UInt window)
+{
+      // variabili in uso
+      UInt	numNode=meshPointer->getNumNodes();
+      UInt numNodeStart=meshPointer->getNumNodes();
+      UInt 	 	            counter=0,numRound=0,stamp=0;
+      bool 						free;
+      vector<UInt>	  mark,stellata,tmpEdge,scelti,vicini,newIds;
+      vector<UInt>		      		    valid,interni;
+      vector<vector<UInt> >		     edges,onEdge,toUpDate;
+      vector<pair<point, quadric> >	   results;
+      vector<Real>					costi;
+      geoElementSize<Triangle> 			      elem;
+      vector<geoElementSize<Triangle> >		  candidati;
+      heapList<geoElementSize<Triangle> >	      lista;
+      
+#ifdef _OPENMP
+      // numero di thread
+      int numTh = (numThreads>0) ? numThreads : omp_get_max_threads();
+#else
+      // senza OpenMP si lavora su un thread
+      if(numThreads>1)	cout << "OpenMP non è disponibile, la semplificazione è fatta su un thread" << endl;
+#endif
+      
+      // controllo che i punti non siano già sotto 
+      if(numNodesMax>=meshPointer->getNumNodes())
+      {
+	  cout << "I punti della mesh sono " << meshPointer->getNumNodes();
+	  cout << " e sono già sotto la soglia " << numNodesMax << endl;
+	  return;
+      }
+      
+      // setto la finestra 
+      if(window==0)	window = max(static_cast<UInt>(1), static_cast<UInt>(meshPointer->getNumElements()/100));
+      
+      // stampe 
+      cout << "Processo di semplificazione Parallelo..." << endl;
+      high_resolution_clock::time_point start = high_resolution_clock::now();
+      
+      // creo la lista 
+      createElementList(&lista);
+      
+      // ad ogni turno si collassano edge con stellate disgiunte
+      while(numNode>numNodesMax && counter<numNodeStart && !lista.isEmpty())
+      {
+	  // prendo i window elementi meno costosi 
+	  candidati.clear();
+	  while(candidati.size()<window && !lista.isEmpty())
+	  {
+	      candidati.push_back(lista.getElement(lista.findMin()));
+	      lista.remove(candidati.back().getId());
+	  }
+	  
+	  // calcolo in parallelo l'edge e il punto di ogni candidato
+	  edges.assign(candidati.size(), vector<UInt>());
+	  results.resize(candidati.size());
+	  
+	  #pragma omp parallel for num_threads(numTh) schedule(dynamic)
+	  for(UInt i=0; i<candidati.size(); ++i)	results[i] = getMinEdgeCost(candidati[i].getId(), &edges[i]);
+	  
+	  // scelgo seguendo l'ordine gli edge che hanno la stellata disgiunta da quelle già scelte, gli altri tornano 
+	  // nella lista 
+	  ++stamp;
+	  mark.resize(meshPointer->getNumNodes(), 0);
+	  scelti.clear();
+	  for(UInt i=0; i<candidati.size(); ++i)
+	  {
+	      // se non trova il punto non lo rimetto nella lista come farebbe upDate
+	      if(results[i].first==pNull)
+	      {
+		  ++counter;
+		  continue;
+	      }
+	      
+	      // non collasso più nodi di quelli che servono 
+	      free = (scelti.size()<(numNode-numNodesMax));
+	      
+	      // prendo i nodi della stellata dell'edge 
+	      createStellataEdgeNode(&edges[i], &stellata);
+	      stellata.push_back(edges[i][0]);
+	      stellata.push_back(edges[i][1]);
+	      
+	      // controllo che siano liberi
+	      for(UInt j=0; (j<stellata.size()) && free; ++j)	free = (mark[stellata[j]]!=stamp);
+	      
+	      // se non è libero torna nella lista 
+	      if(!free)
+	      {
+		  lista.add(&candidati[i]);
+		  continue;
+	      }
+	      
+	      // segno i nodi e lo scelgo 
+	      for(UInt j=0; j<stellata.size(); ++j)	mark[stellata[j]] = stamp;
+	      scelti.push_back(i);
+	  }
+	  
+	  // controllo in parallelo gli edge scelti e prendo gli elementi coinvolti prima di collassare 
+	  // N.B. le flag sono UInt perché vector<bool> non può essere scritto in parallelo
+	  valid.assign(scelti.size(), 0);
+	  interni.assign(scelti.size(), 0);
+	  onEdge.assign(scelti.size(), vector<UInt>());
+	  toUpDate.assign(scelti.size(), vector<UInt>());
+	  
+	  #pragma omp parallel for num_threads(numTh) schedule(dynamic)
+	  for(UInt k=0; k<scelti.size(); ++k)
+	  {
+	      valid[k]   = control(&edges[scelti[k]], results[scelti[k]].first);
+	      interni[k] = (meshPointer->getNode(edges[scelti[k]][0]).getBoundary()==0) && 
+			   (meshPointer->getNode(edges[scelti[k]][1]).getBoundary()==0);
+	      elementOnEdge(edges[scelti[k]][0], edges[scelti[k]][1], &onEdge[k]);
+	      if(valid[k])	createBigStellataEdge(&edges[scelti[k]], &toUpDate[k]);
+	  }
+	  
+	  // tolgo dalla lista gli elementi sugli edge e inserisco i nuovi nodi, il posto nella connettività viene creato 
+	  // prima così i collassi possono essere fatti in parallelo
+	  newIds.assign(scelti.size(), 0);
+	  for(UInt k=0; k<scelti.size(); ++k)
+	  {
+	      for(UInt j=0; j<onEdge[k].size(); ++j)
+		if(lista.isIn(onEdge[k][j]))
+		  lista.remove(onEdge[k][j]);
+	      
+	      if(valid[k])
+	      {
+		  meshPointer->insertNode(results[scelti[k]].first);
+		  newIds[k] = meshPointer->getNumNodes()-1;
+		  conn.getNodeToElementPointer()->push_back(graphItem());
+		  Q.push_back(results[scelti[k]].second);
+		  --numNode;
+	      }
+	      
+	      ++counter;
+	  }
+	  
+#ifdef CSR_CONNECTIVITY
+	  // con graphCSR una riga che cresce viene spostata in fondo al vettore comune: riservo prima il posto per le 
+	  // righe dei nuovi nodi così i collassi in parallelo non toccano il vettore e il risultato non dipende dai thread
+	  for(UInt k=0; k<scelti.size(); ++k)
+	    if(valid[k] && interni[k])
+	      conn.getNodeToElementPointer()->reserveRow(newIds[k], 
+				conn.getNodeToElementPointer(edges[scelti[k]][0])->getNumConnected()+
+				conn.getNodeToElementPointer(edges[scelti[k]][1])->getNumConnected());
+#endif
+	  
+	  // collasso in parallelo gli edge interni 
+	  #pragma omp parallel for num_threads(numTh) schedule(dynamic)
+	  for(UInt k=0; k<scelti.size(); ++k)
+	    if(valid[k] && interni[k])
+	      collEdge(&edges[scelti[k]], newIds[k]);
+	  
+	  // quelli di bordo cambiano la lista del bordo e vanno fatti uno alla volta 
+	  for(UInt k=0; k<scelti.size(); ++k)
+	    if(valid[k] && !interni[k])
+	      collEdge(&edges[scelti[k]], newIds[k]);
+	  
+	  // prendo tutti gli elementi da aggiornare una sola volta 
+	  vicini.clear();
+	  for(UInt k=0; k<scelti.size(); ++k)	vicini.insert(vicini.end(), toUpDate[k].begin(), toUpDate[k].end());
+	  sort(vicini.begin(), vicini.end());
+	  vicini.erase(unique(vicini.begin(), vicini.end()), vicini.end());
+	  
+	  // calcolo in parallelo i nuovi costi, gli elementi collassati hanno costo negativo 
+	  costi.assign(vicini.size(), -1.0);
+	  
+	  #pragma omp parallel for num_threads(numTh) schedule(dynamic) private(tmpEdge)
+	  for(UInt i=0; i<vicini.size(); ++i)
+	  {
+	      if(isTriangleDegenerate(vicini[i]))	continue;
+	      
+	      pair<point, quadric> result = getMinEdgeCost(vicini[i], &tmpEdge);
+	      if((result.first-pNull).norm2()>1e-10)	costi[i] = getEdgeCost(&result.second, result.first);
+	  }
+	  
+	  // aggiorno la lista come fa upDate
+	  for(UInt i=0; i<vicini.size(); ++i)
+	  {
+	      if(costi[i]<0.0)
+	      {
+		  if(lista.isIn(vicini[i]))	lista.remove(vicini[i]);
+		  continue;
+	      }
+	      
+	      if(lista.isIn(vicini[i]))
+	      {
+		  lista.change(vicini[i], costi[i]);
+	      }
+	      else
+	      {
+		  for(UInt j=0; j<3; ++j)  elem.setConnectedId(j, meshPointer->getElement(vicini[i]).getConnectedId(j));
+		  elem.setId(vicini[i]);
+		  elem.setGeoSize(costi[i]);
+		  lista.add(&elem);
+	      }
+	  }
+	  
+	  // incremento i turni 
+	  ++numRound;
+      }
+      
+      // faccio un refresh 
+      refresh();
+      
+      high_resolution_clock::time_point stop = high_resolution_clock::now();
+      auto dif = duration_cast<milliseconds>(stop-start).count();
+      cout << "Il processo è partito da " << numNodeStart << " a " << meshPointer->getNumNodes() << " nodi in ";
+      cout << numRound << " turni" << endl;
+      cout << "Processo di semplificazione Parallelo completato: " <<  dif << " ms" << endl;
+}
+
+void simplification2d<Triangle>::simplificateHalfEdge(UInt numNodesMax)
+{
+      // variabili in uso
+      UInt 				   from,to;
+      UInt	numNode=meshPointer->getNumNodes();
+      UInt numNodeStart=meshPointer->getNumNodes();
+      halfEdge2d<Triangle>			he;
+      heapList<geoElementSize<simplePoint> > 	     lista;
+      vector<geoElementSize<simplePoint> >	  elements;
+      geoElementSize<simplePoint>			tmp;
+      vector<UInt>			       target,vicini;
+      pair<UInt, Real>				       best;
+      
+      // controllo che i punti non siano già sotto 
+      if(numNodesMax>=meshPointer->getNumNodes())
+      {
+	  cout << "I punti della mesh sono " << meshPointer->getNumNodes();
+	  cout << " e sono già sotto la soglia " << numNodesMax << endl;
+	  return;
+      }
+      
+      // stampe 
+      cout << "Processo di semplificazione Half Edge..." << endl;
+      high_resolution_clock::time_point start = high_resolution_clock::now();
+      
+      // creo la struttura half edge 
+      if(!he.setMeshPointer(meshPointer))
+      {
+	  cout << "La semplificazione Half Edge non può essere fatta su questa mesh" << endl;
+	  return;
+      }
+      
+      // le matrici devono essere una per nodo 
+      if(Q.size()!=meshPointer->getNumNodes())	setUpQ();
+      
+      // creo la lista con il collasso migliore di ogni nodo 
+      target.assign(meshPointer->getNumNodes(), halfEdge2d<Triangle>::NONE);
+      elements.reserve(meshPointer->getNumNodes());
+      for(UInt i=0; i<meshPointer->getNumNodes(); ++i)
+      {
+	  best = getHalfEdgeCost(&he, i);
+	  if(best.first==halfEdge2d<Triangle>::NONE)	continue;
+	  
+	  target[i] = best.first;
+	  tmp.setId(i);
+	  tmp.setConnectedId(0, i);
+	  tmp.setGeoSize(best.second);
+	  elements.push_back(tmp);
+      }
+      if(elements.size()>0)	lista.setElementVector(&elements);
+      
+      // fino a che i nodi sono più grandi di quanto voglio proseguo con la decimazione 
+      while(numNode>numNodesMax && !lista.isEmpty())
+      {
+	  // prendo il nodo meno costoso 
+	  from = lista.findMin();
+	  to   = target[from];
+	  lista.remove(from);
+	  
+	  // se nel frattempo è cambiato l'intorno ricalcolo il suo collasso migliore 
+	  if(!controlHalfEdge(&he, from, to))
+	  {
+		best = getHalfEdgeCost(&he, from);
+		if(best.first!=halfEdge2d<Triangle>::NONE)
+		{
+		      target[from] = best.first;
+		      tmp.setId(from);
+		      tmp.setConnectedId(0, from);
+		      tmp.setGeoSize(best.second);
+		      lista.add(&tmp);
+		}
+		continue;
+	  }
+	  
+	  // collasso 
+	  Q[to] += Q[from];
+	  he.collapse(from, to);
+	  --numNode;
+	  
+	  // aggiorno to e i suoi vicini 
+	  he.createStellata(to, &vicini);
+	  vicini.push_back(to);
+	  for(UInt i=0; i<vicini.size(); ++i)
+	  {
+		best = getHalfEdgeCost(&he, vicini[i]);
+		
+		if(best.first==halfEdge2d<Triangle>::NONE)
+		{
+		      if(lista.isIn(vicini[i]))	lista.remove(vicini[i]);
+		      continue;
+		}
+		
+		target[vicini[i]] = best.first;
+		if(lista.isIn(vicini[i]))
+		{
+		      lista.change(vicini[i], best.second);
+		}
+		else
+		{
+		      tmp.setId(vicini[i]);
+		      tmp.setConnectedId(0, vicini[i]);
+		      tmp.setGeoSize(best.second);
+		      lista.add(&tmp);
+		}
+	  }
+      }
+      
+      // faccio un refresh 
+      refresh();
+      
+      high_resolution_clock::time_point stop = high_resolution_clock::now();
+      auto dif = duration_cast<milliseconds>(stop-start).count();
+      cout << "Il processo è partito da " << numNodeStart << " a " << meshPointer->getNumNodes() << " nodi" << endl;
+      cout << "Processo di semplificazione Half Edge completato: " <<  dif << " ms" << endl;
+}
+
+void simplification2d<Triangle>::simplificateRandom(UInt numNodesMax, UInt numChoices, UInt numThreads, UInt seed)
+{
+      // variabili in uso
+      UInt	numNode=meshPointer->getNumNodes();
+      UInt numNodeStart=meshPointer->getNumNodes();
+      UInt 	 	  pos,migliore,fallimenti=0,numStep=0;
+      Real						costo;
+      vector<UInt>				    vivi,scelti;
+      vector<vector<UInt> >				  edges;
+      vector<pair<point, quadric> >			results;
+      vector<Real>					  costi;
+      mt19937					  generatore(seed);
+      
+#ifdef _OPENMP
+      // numero di thread
+      int numTh = (numThreads>0) ? numThreads : omp_get_max_threads();
+#else
+      // senza OpenMP si lavora su un thread
+      if(numThreads>1)	cout << "OpenMP non è disponibile, la semplificazione è fatta su un thread" << endl;
+#endif
+      
+      // controllo che i punti non siano già sotto 
+      if(numNodesMax>=meshPointer->getNumNodes())
+      {
+	  cout << "I punti della mesh sono " << meshPointer->getNumNodes();
+	  cout << " e sono già sotto la soglia " << numNodesMax << endl;
+	  return;
+      }
+      
+      // almeno un candidato 
+      numChoices = max(static_cast<UInt>(1), numChoices);
+      
+      // stampe 
+      cout << "Processo di semplificazione Random..." << endl;
+      high_resolution_clock::time_point start = high_resolution_clock::now();
+      
+      // elementi vivi, quelli degeneri sono tolti solo quando vengono estratti
+      vivi.resize(meshPointer->getNumElements());
+      iota(vivi.begin(), vivi.end(), 0);
+      
+      // fino a che i nodi sono più grandi di quanto voglio proseguo con la decimazione, ci si ferma se per più passi 
+      // che elementi vivi non si trova un collasso valido
+      while(numNode>numNodesMax && fallimenti<=vivi.size())
+      {
+	  // estraggo i candidati: un elemento vivo e uno dei suoi tre edge 
+	  scelti.clear();
+	  edges.clear();
+	  while(scelti.size()<numChoices && !vivi.empty())
+	  {
+		pos = generatore()%vivi.size();
+		if(isTriangleDegenerate(vivi[pos]))
+		{
+		      vivi[pos] = vivi.back();
+		      vivi.pop_back();
+		      continue;
+		}
+		
+		scelti.push_back(generatore()%3);
+		edges.push_back(vector<UInt>(2));
+		edges.back()[0] = meshPointer->getElement(vivi[pos]).getConnectedId(scelti.back());
+		edges.back()[1] = meshPointer->getElement(vivi[pos]).getConnectedId((scelti.back()+1)%3);
+	  }
+	  if(edges.empty())	break;
+	  
+	  // calcolo in parallelo il punto e il costo di ogni candidato
+	  results.resize(edges.size());
+	  costi.resize(edges.size());
+	  
+	  #pragma omp parallel for num_threads(numTh) if(numTh>1)
+	  for(UInt i=0; i<edges.size(); ++i)
+	  {
+		results[i] = getEdgeCost(&edges[i]);
+		costi[i]   = (results[i].first!=pNull) ? getEdgeCost(&results[i].second, results[i].first) : 0.0;
+	  }
+	  
+	  // prendo il meno costoso che passa il controllo, a parità di costo vince il primo estratto 
+	  migliore = edges.size();
+	  costo    = 0.0;
+	  for(UInt i=0; i<edges.size(); ++i)
+	  {
+		if(results[i].first==pNull)				continue;
+		if(migliore<edges.size() && costi[i]>=costo)		continue;
+		if(!control(&edges[i], results[i].first))		continue;
+		
+		migliore = i;
+		costo    = costi[i];
+	  }
+	  
+	  ++numStep;
+	  if(migliore==edges.size())
+	  {
+		++fallimenti;
+		continue;
+	  }
+	  fallimenti = 0;
+	  
+	  if(memoryMode==REUSENODE)
+	  {
+		// collasso sul primo estremo riusando il suo posto 
+		collEdgeInPlace(&edges[migliore], edges[migliore][0], results[migliore].first);
+		
+		// metto Q 
+		Q[edges[migliore][0]] = results[migliore].second;
+	  }
+	  else
+	  {
+		// inserisco il nodo 
+		meshPointer->insertNode(results[migliore].first);
+		
+		// collasso tenendo buono l'id del secondo 
+		collEdge(&edges[migliore]);
+		
+		// metto Q 
+		Q.push_back(results[migliore].second);
+	  }
+	  
+	  // diminuisco i punti 
+	  --numNode;
+	  
+	  // compattazione periodica come in simplificateGreedy, dopo il refresh gli elementi sono tutti vivi 
+	  if(memoryMode==REUSENODE && 2*numNode<meshPointer->getNumNodes() && numNode>numNodesMax)
+	  {
+		refresh();
+		vivi.resize(meshPointer->getNumElements());
+		iota(vivi.begin(), vivi.end(), 0);
+	  }
+      }
+      
+      // faccio un refresh 
+      refresh();
+      
+      high_resolution_clock::time_point stop = high_resolution_clock::now();
+      auto dif = duration_cast<milliseconds>(stop-start).count();
+      cout << "Il processo è partito da " << numNodeStart << " a " << meshPointer->getNumNodes() << " nodi in ";
+      cout << numStep << " passi" << endl;
+      cout << "Processo di semplificazione Random completato: " <<  dif << " ms" << endl;
+}
 
 //
 // Metodi che stampano 
@@ -1028,7 +1552,7 @@ void simplification2d<Triangle>::print(string s)
     // variabili  in uso 
     vector<Real>			     val;
     vector<UInt>			    edge;
-    pair<point, vector<Real> >		  result; 
+    pair<point, quadric>		  result; 
     createFile				    file;
     
     // faccio un resize 
@@ -1048,3 +1572,22 @@ void simplification2d<Triangle>::print(string s)
     // stampi il file 
     file.fileForParaviewElementPropriety(s, meshPointer, &val);
 }
+
+//
+// Istanze dei metodi che gestiscono la lista 
+//
+template void simplification2d<Triangle>::createElementList(sortList<geoElementSize<Triangle> > * lista);
+template void simplification2d<Triangle>::createElementList(heapList<geoElementSize<Triangle> > * lista);
+template void simplification2d<Triangle>::deleteElementList(sortList<geoElementSize<Triangle> > * lista, vector<UInt> * edge, 
+							    vector<UInt> * toUpDate);
+template void simplification2d<Triangle>::deleteElementList(heapList<geoElementSize<Triangle> > * lista, vector<UInt> * edge, 
+							    vector<UInt> * toUpDate);
+template void simplification2d<Triangle>::upDate(sortList<geoElementSize<Triangle> > * listaBase, vector<UInt> * vicini);
+template void simplification2d<Triangle>::upDate(heapList<geoElementSize<Triangle> > * listaBase, vector<UInt> * vicini);
+template UInt simplification2d<Triangle>::getElementToSimplificate(sortList<geoElementSize<Triangle> > * listaBase);
+template UInt simplification2d<Triangle>::getElementToSimplificate(heapList<geoElementSize<Triangle> > * listaBase);
+template void simplification2d<Triangle>::createElementList(lazyList<geoElementSize<Triangle> > * lista);
+template void simplification2d<Triangle>::deleteElementList(lazyList<geoElementSize<Triangle> > * lista, vector<UInt> * edge, 
+							    vector<UInt> * toUpDate);
+template void simplification2d<Triangle>::upDate(lazyList<geoElementSize<Triangle> > * listaBase, vector<UInt> * vicini);
+template UInt simplification2d<Triangle>::getElementToSimplificate(lazyList<geoElementSize<Triangle> > * listaBase);
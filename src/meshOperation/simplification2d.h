@@ -8,16 +8,21 @@
 #include <set>
 #include <functional>
 #include <numeric>
+#include <random>
 
 #include "../core/shapes.hpp"
 #include "../core/point.h"
 #include "../core/graphItem.h"
+#include "../core/quadric.hpp"
 
 #include "../utility/sortList.hpp"
+#include "../utility/heapList.hpp"
+#include "../utility/lazyList.hpp"
 
 #include "../geometry/geoElement.hpp"
 #include "../geometry/geoElementSize.hpp"
 #include "../geometry/mesh2d.hpp"
+#include "../geometry/halfEdge2d.h"
 
 #include "../doctor/doctor2d.h"
 
@@ -30,6 +35,15 @@ namespace geometry
 
 using namespace std;
 
+/*! Tipo di lista usata nel processo di semplificazione Greedy:
+    <ol>
+    <li> SORTQUEUE la lista ordinata sortList;
+    <li> HEAPQUEUE lo heap indicizzato heapList, ogni aggiornamento sposta l'elemento nello heap;
+    <li> LAZYQUEUE lo heap con versioni lazyList, gli aggiornamenti sono solo inserimenti e gli elementi vecchi sono
+	 scartati quando arrivano in cima.
+    </ol> */
+enum collapseQueue {SORTQUEUE=0, HEAPQUEUE=1, LAZYQUEUE=2};
+
 /*! Classe che permette di effetuare il processo di eliminazione degli elementi di una griglia */
 
 template<typename GEOSHAPE> class simplification2d : public doctor2d<GEOSHAPE>
@@ -46,10 +60,16 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
       //
       public:
 		  /*! vettore con le matrici */
-		  vector<vector<Real> > 		Q;     
+		  vector<quadric> 		Q;     
 		  
 		  /*! Vettore che tiene traccia */
 		  vector<graphItem>             trackList;
+		  
+		  /*! Tipo di lista usata da simplificateGreedy */
+		  collapseQueue			queueType;
+		  
+		  /*! Gestione della memoria usata da simplificateGreedy */
+		  collapseMemory		memoryMode;
       //
       // Costruttori
       //
@@ -66,9 +86,18 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
 		  void setMeshPointer(mesh2d<Triangle> * _meshPointer);
 		  
 		  /*! Metodo che fa il refresh delle variabili dopo il processo di collasso
-		      N.B. fa le stesse cose del refresh della classe doctor2d ma tiene conto anche di track */
+		      N.B. fa le stesse cose del refresh della classe doctor2d ma tiene conto anche di track e, se Q ha 
+		      un elemento per nodo, rinumera anche le matrici Q */
 		  void refresh();
 		  
+		  /*! Metodo che cambia la lista usata da simplificateGreedy
+		    \param _queueType tipo di lista */
+		  void setQueueType(collapseQueue _queueType);
+		  
+		  /*! Metodo che cambia la gestione della memoria usata da simplificateGreedy
+		    \param _memoryMode APPENDNODE o REUSENODE */
+		  void setMemoryMode(collapseMemory _memoryMode);
+		  
       //
       // Processo che crea la lista e i suoi elementi  
       //
@@ -76,11 +105,11 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
 		  /*! Metodo che costruisce la matrice K_p 
 		      \param nodeId identificatore del nodo
 		      \param elemId identificatore dell'elemento */
-		  vector<Real> createK_p(UInt nodeId, UInt elemId);
+		  quadric createK_p(UInt nodeId, UInt elemId);
 		  
 		  /*! Metodo che costruisce la matrice Q 
 		      \param nodeId identificatore del nodo*/
-		  vector<Real> createQ(UInt nodeId);
+		  quadric createQ(UInt nodeId);
 		  
 		  /*! Metodo che riempie i vettore delle Q della classe */
 		  void setUpQ();		  
@@ -90,11 +119,12 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
       public:
 		  /*! Metodo che costruisce la matrice Q 
 		      \param edge puntatore all'edge */
-		  vector<Real> createQ(vector<UInt> * edge);
+		  quadric createQ(vector<UInt> * edge);
 		  
 		  /*! Metodo che crea l'intera lista dei nodi da testare, il metodo tiene conto sia di problemi legati alla 
 		      inversione di triangoli, del fatto che non si possa trovare l'ottimale con il metodo "createPointFromMatrix" 
-		      e del fatto che gli estremi possono essere di bordo 
+		      e del fatto che gli estremi possono essere di bordo. I nodi con boundary 2 sono bloccati: non vengono 
+		      spostati e gli edge con entrambi gli estremi bloccati non si collassano 
 		      \param edge puntatore al vettore che identifica i punti 
 		      \param list puntatore a un vettore di punti */
 		  void createPointList(vector<UInt> * edge, vector<point> * newNodes);
@@ -102,41 +132,42 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
 		  /*! Metodo che da il costo di un edge per il collasso 
 		      \param Q matrice realtiva all'edge
 		      \param pNew posizione del nuovo nodo */
-		  Real getEdgeCost(vector<Real> * Q, point pNew);
+		  Real getEdgeCost(quadric * Q, point pNew);
 		  
 		  /*! Metodo che restituisce una coppia con il punto dove verrà collassato l'edge e la sua matrice Q partendo 
 		      dall'edge restituisce la nuova posizione che ha il minor costo
 		      \param edge puntatore all'edge*/
- 		  pair<point, vector<Real> > getEdgeCost(vector<UInt> * edge);
+ 		  pair<point, quadric> getEdgeCost(vector<UInt> * edge);
 		  
 		  /*! Metodo che trova per ogni elemento quale è l'edge con il minore costo 
 		      \param elemId identificatore dell'elemento 
 		      \param edge puntatore a un vettore che conterrà l'edge
 		      Il metodo restituisce una coppia con vertice e matrice Q*/
-		  pair<point, vector<Real> > getMinEdgeCost(UInt elemId, vector<UInt> * edge);
+		  pair<point, quadric> getMinEdgeCost(UInt elemId, vector<UInt> * edge);
 	//
 	// Metodo che creano la lista
+	// N.B. i metodi sono templatizzati sul tipo di lista, sono istanziati per sortList, heapList e lazyList
 	//
 	public:		  
 		  /*! Metodo che crea la lista 
 		      \param lista puntatore a un contenitore vector che contiene gli elementi */
-		  void createElementList(sortList<geoElementSize<Triangle> > * lista);
+		  template<typename LIST> void createElementList(LIST * lista);
 		  
 		  /*! Metodo che elimina dalla lista gli elementi coinvolti nel collasso dell'edge  
 		      \param listaBase lista da cui si deve partire con gli elementi 
 		      \param edge edge che è stato eliminato
 		      \param toUpDate lista degli elementi da ridefinire*/
-		  void deleteElementList(sortList<geoElementSize<Triangle> > * listaBase, vector<UInt> * edge, 
-					 vector<UInt> * toUpDate);
+		  template<typename LIST> void deleteElementList(LIST * listaBase, vector<UInt> * edge, 
+								 vector<UInt> * toUpDate);
 		  
 		  /*! Metodo che aggiorna gli elementi nella lista vicini 
 		      \param listaBase lista in cui si devono aggiornare gli elementi 
 		      \param vicini lista degli elementi da ridefinire*/
-		  void upDate(sortList<geoElementSize<Triangle> > * listaBase, vector<UInt> * vicini);
+		  template<typename LIST> void upDate(LIST * listaBase, vector<UInt> * vicini);
 		  
 		  /*! Metodo che permette di ottenere l'elemento ottimale da collassare 
 		      \param listaBase lista degli elementi ordinati*/
-		  UInt getElementToSimplificate(sortList<geoElementSize<Triangle> > * listaBase);
+		  template<typename LIST> UInt getElementToSimplificate(LIST * listaBase);
 	//
 	// Metodi che fanno i controlli
 	//
@@ -146,6 +177,20 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
 		     \param edge vettore con gli id dei nodi 
 		     \param pNew nuovo punto */
 		 bool control(vector<UInt> * edge, point pNew);
+		 
+		 /*! Metodo che controlla il collasso lungo l'half edge from->to: oltre alla condizione topologica di 
+		     halfEdge2d controlla che i triangoli di from non si invertano e non diventino degeneri 
+		     \param he puntatore alla struttura half edge 
+		     \param from nodo che viene eliminato 
+		     \param to nodo che rimane */
+		 bool controlHalfEdge(halfEdge2d<Triangle> * he, UInt from, UInt to);
+		 
+		 /*! Metodo che trova il collasso meno costoso di un nodo lungo i suoi half edge, il costo è quello di 
+		     Garland calcolato nel nodo che rimane 
+		     \param he puntatore alla struttura half edge 
+		     \param nodeId nodo 
+		     \return il nodo in cui collassare (halfEdge2d<Triangle>::NONE se non ce ne sono) e il costo */
+		 pair<UInt, Real> getHalfEdgeCost(halfEdge2d<Triangle> * he, UInt nodeId);
 	
 	//
 	// Metodi che fanno la semplificazione 
@@ -159,9 +204,15 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
 		      processo è fatto partendo sempre dall'elemento meno costoso 
 		      \param numNodesMax numero massimo di nodi 
 		      N.B. spesso può accadere che tale metodo non arrivi al risultato sperato perché i triangoli diventano 
-			   degeneri */
+			   degeneri 
+		      N.B. la lista usata si sceglie con setQueueType */
 		  void simplificateGreedy(UInt numNodesMax);
 		  
+		  /*! Metodo che fa il ciclo di simplificateGreedy con una lista data
+		      \param numNodesMax numero massimo di nodi 
+		      \param lista puntatore alla lista da usare */
+		  template<typename LIST> void simplificateGreedy(UInt numNodesMax, LIST * lista);
+		  
 		  /*! Metodo che spezza gli edge finché non raggiunge un numero di nodi obiettivo dato in input questo 
 		      processo è fatto partendo sempre dall'elemento meno costoso 
 		      \param numNodesMax numero massimo di nodi 
@@ -174,6 +225,38 @@ template<> class simplification2d<Triangle> : public doctor2d<Triangle>
 		      \param numNodesMax numero massimo di nodi 
 		      \param step quanti collassarne di fila */
 		  void simplificateStep(UInt numNodesMax, UInt step);
+		  
+		  /*! Metodo che fa la semplificazione a turni su più thread. Ad ogni turno si prendono i window elementi meno 
+		      costosi della lista e, seguendo l'ordine dei costi, si scelgono quelli che hanno la stellata dell'edge 
+		      disgiunta da quelle già scelte. Gli edge scelti vengono controllati e collassati in parallelo (quelli di 
+		      bordo uno alla volta) e alla fine del turno i costi degli elementi vicini sono ricalcolati in parallelo. 
+		      \param numNodesMax numero massimo di nodi 
+		      \param numThreads numero di thread, se è 0 si usa quello di default di OpenMP 
+		      \param window numero di elementi presi in esame ad ogni turno, se è 0 si usa l'1% degli elementi 
+		      N.B. ogni collasso fatto in un turno è uno dei window elementi meno costosi all'inizio del turno, con 
+			   window=1 si ha lo stesso ordine di simplificateGreedy. La perdita di qualità rispetto all'ordine 
+			   Greedy è quindi limitata da window. Il risultato non dipende dal numero di thread. */
+		  void simplificateParallel(UInt numNodesMax, UInt numThreads=0, UInt window=0);
+		  
+		  /*! Metodo che fa la semplificazione Greedy con i collassi lungo gli half edge: ogni nodo ha nella lista il 
+		      costo del suo collasso migliore su uno dei vicini. La topologia è gestita solo da halfEdge2d, senza 
+		      aggiornare le connettività di connect2d che vengono ricreate dal refresh finale. 
+		      \param numNodesMax numero massimo di nodi 
+		      N.B. la mesh deve essere una varietà orientata in modo coerente */
+		  void simplificateHalfEdge(UInt numNodesMax);
+		  
+		  /*! Metodo che fa la semplificazione a scelta multipla senza lista: ad ogni passo si estraggono a caso 
+		      numChoices edge (un elemento vivo e uno dei suoi lati), si calcola il loro costo con getEdgeCost e si 
+		      collassa il meno costoso che passa il controllo. Non c'è una lista da tenere aggiornata, quindi la 
+		      memoria usata è solo quella della mesh e delle matrici Q. 
+		      \param numNodesMax numero massimo di nodi 
+		      \param numChoices numero di edge estratti ad ogni passo 
+		      \param numThreads numero di thread con cui si calcolano i costi dei candidati, se è 0 si usa quello di 
+			     default di OpenMP 
+		      \param seed seme del generatore di numeri casuali 
+		      N.B. con più candidati ci si avvicina all'ordine di simplificateGreedy. Il risultato dipende dal seme 
+			   ma non dal numero di thread. */
+		  void simplificateRandom(UInt numNodesMax, UInt numChoices=8, UInt numThreads=0, UInt seed=0);
 	//
 	// Metodi che stampano 
 	//
@@ -8,10 +8,20 @@ simplification2dCostFunctionBased::simplification2dCostFunctionBased(costFunctio
                                                                      vector<UInt> & _pointMaterialId) 
   : doctor2d<Triangle>(_meshPointer), 
     costFunctionPointer(_costFunctionPointer),
-    pointMaterialId(_pointMaterialId)
+    pointMaterialId(_pointMaterialId),
+    memoryMode(APPENDNODE)
 {
     // set the trick pointer 
     costFunctionPointer->setTrickyClassPointer(this);
+    
+    // set the cache if the cost function uses it 
+    if(costFunctionPointer->usesQuadricCache())
+        costFunctionPointer->setQuadricCachePointer(&nodeQuadrics);
+}
+
+void simplification2dCostFunctionBased::setMemoryMode(collapseMemory _memoryMode)
+{
+    memoryMode = _memoryMode;
 }
 
 //
@@ -25,7 +35,7 @@ void simplification2dCostFunctionBased::simplificateGreedy(UInt numNodesMax)
     UInt numNodeStart=meshPointer->getNumNodes();
     time_t start,end;
     Real dif;
-    sortList<geoElementSize<simplePoint> > listOfPossiblePointRemoval;
+    heapList<geoElementSize<simplePoint> > listOfPossiblePointRemoval;
 
     // check if I already reached the limit on the point 
     if(numNodesMax>=meshPointer->getNumNodes())
@@ -39,6 +49,10 @@ void simplification2dCostFunctionBased::simplificateGreedy(UInt numNodesMax)
     cout << "Greedy Simplification process..." << endl;
     time(&start);
 
+    // the cache is filled once at the first use of each quadric 
+    nodeQuadrics.clear();
+    nodeQuadrics.resize(meshPointer->getNumNodes());
+    
     // build the list 
     createElementList(listOfPossiblePointRemoval);
     
@@ -60,15 +74,33 @@ void simplification2dCostFunctionBased::simplificateGreedy(UInt numNodesMax)
         // check if I can contract the edge 
         if(control(&edge, newCoordinates))
         {
-            // add the new point 
-            meshPointer->insertNode(newCoordinates);
-            UInt newAddedPointId = meshPointer->getNumNodes()-1;
+            UInt newAddedPointId;
             
-            // contract the edge 
-            collEdge(&edge);
+            if(memoryMode==REUSENODE)
+            {
+                // the point that survives keeps its slot and its material Id 
+                newAddedPointId = (edge[0]==pointId) ? edge[1] : edge[0];
+                
+                // contract the edge on it 
+                collEdgeInPlace(&edge, newAddedPointId, newCoordinates);
+            }
+            else
+            {
+                // add the new point 
+                meshPointer->insertNode(newCoordinates);
+                newAddedPointId = meshPointer->getNumNodes()-1;
+                
+                // contract the edge 
+                collEdge(&edge);
+            }
+            
+            // update the cache of the quadrics 
+            if(costFunctionPointer->usesQuadricCache())
+                costFunctionPointer->updateQuadricCache(edge, newAddedPointId);
             
             // method to fill the material Id 
-            fillTheMaterialIdAfterContraction(pointId, edge);
+            if(memoryMode!=REUSENODE)
+                fillTheMaterialIdAfterContraction(pointId, edge);
             
             // update the list 
             updateAndAddElementList(listOfPossiblePointRemoval, newAddedPointId);
@@ -79,6 +111,15 @@ void simplification2dCostFunctionBased::simplificateGreedy(UInt numNodesMax)
         
         // incremento counter 
         ++counter;
+        
+        // periodic compaction: when the dead points are more than the live ones everything is renumbered and the 
+        // list is built again 
+        if(memoryMode==REUSENODE && 2*numNode<meshPointer->getNumNodes() && numNode>numNodesMax)
+        {
+            refresh();
+            listOfPossiblePointRemoval.clear();
+            createElementList(listOfPossiblePointRemoval);
+        }
             
         cout << numNode << " nodes over the max limit of " << numNodesMax << "                            \r";
     }
@@ -306,6 +347,9 @@ void simplification2dCostFunctionBased::refresh()
              newPointMaterialId[newId[i]] = pointMaterialId[i];
       pointMaterialId = newPointMaterialId;
       
+      // the cache follows the new ids 
+      nodeQuadrics.renumber(newId, tmpPt.size());
+      
       
       // ciclo sugli elementi per sistemare gli id dei nodi e metterli nella lista temporanea
       cont = 0;
@@ -351,24 +395,45 @@ void simplification2dCostFunctionBased::refresh()
 //
 // Methods to manage the list
 //
-void simplification2dCostFunctionBased::createElementList(sortList<geoElementSize<simplePoint> > & sortedList)
+void simplification2dCostFunctionBased::createElementList(heapList<geoElementSize<simplePoint> > & sortedList)
 {
-    std::set<geoElementSize<simplePoint> >  listaTmp;
+    std::vector<geoElementSize<simplePoint> >  listaTmp(meshPointer->getNumNodes());
     
-    // loop over the point and create the list 
-    for(UInt pointId=0; pointId<meshPointer->getNumNodes(); ++pointId)
+#ifdef _OPENMP
+    // the cost function has a ring buffer for each thread of the regions below 
+    int numTh = omp_get_max_threads();
+    costFunctionPointer->setNumThreads(numTh);
+#endif
+    
+    // the missing quadrics are computed before, so that the costs only read the cache; every node writes only its 
+    // own quadric 
+    if(costFunctionPointer->usesQuadricCache())
     {
-        geoElementSize<simplePoint> tmpPointWithCost;
-        computeCostOfAPoint(pointId, tmpPointWithCost);
+        nodeQuadrics.resize(meshPointer->getNumNodes());
         
-        listaTmp.insert(tmpPointWithCost);
+        #pragma omp parallel for num_threads(numTh) schedule(dynamic, 256)
+        for(UInt pointId=0; pointId<meshPointer->getNumNodes(); ++pointId)
+        {
+            if(nodeQuadrics.isValid(pointId))
+                continue;
+            
+            quadric Q;
+            costFunctionPointer->computeNodeQuadric(pointId, Q);
+            nodeQuadrics.set(pointId, Q);
+        }
     }
     
-    // metto nella lista
+    // loop over the point and compute the costs in parallel 
+    #pragma omp parallel for num_threads(numTh) schedule(dynamic, 256)
+    for(UInt pointId=0; pointId<meshPointer->getNumNodes(); ++pointId)
+        computeCostOfAPoint(pointId, listaTmp[pointId]);
+    
+    // bulk load of the list with the same order of a set 
+    sortAsSet(&listaTmp);
     sortedList.setElementVector(&listaTmp);
 }
 
-void simplification2dCostFunctionBased::updateAndAddElementList(sortList<geoElementSize<simplePoint> > & sortedList, 
+void simplification2dCostFunctionBased::updateAndAddElementList(heapList<geoElementSize<simplePoint> > & sortedList, 
                                                                 UInt contractedPoint)
 {
     std::vector<UInt> listOfPoints;
@@ -398,7 +463,7 @@ void simplification2dCostFunctionBased::computeCostOfAPoint(UInt pointId, geoEle
     pointWithCost.setId(pointId);
 }
 
-UInt simplification2dCostFunctionBased::getPointToRemoveAndTakeOffItFromTheList(sortList<geoElementSize<simplePoint> > & listOfPossiblePointRemoval)
+UInt simplification2dCostFunctionBased::getPointToRemoveAndTakeOffItFromTheList(heapList<geoElementSize<simplePoint> > & listOfPossiblePointRemoval)
 {
     point pt = pNull;
     UInt pointId = meshPointer->getNumNodes();
@@ -14,6 +14,7 @@
 #include "../core/graphItem.h"
 
 #include "../utility/sortList.hpp"
+#include "../utility/heapList.hpp"
 
 #include "../geometry/geoElement.hpp"
 #include "../geometry/geoElementSize.hpp"
@@ -53,6 +54,10 @@ class simplification2dCostFunctionBased : public doctor2d<Triangle>
         \param numNodesMax target number of nodes */
     void simplificateGreedy(UInt numNodesMax);
     
+    /*! Method to choose how the memory is managed by simplificateGreedy 
+        \param _memoryMode APPENDNODE (default) or REUSENODE */
+    void setMemoryMode(collapseMemory _memoryMode);
+    
     //
     // Methods to manage the list
     //
@@ -60,12 +65,12 @@ class simplification2dCostFunctionBased : public doctor2d<Triangle>
    
     /*! Method to build up the list 
         \param sortedList list of the point to store */
-    void createElementList(sortList<geoElementSize<simplePoint> > & sortedList);
+    void createElementList(heapList<geoElementSize<simplePoint> > & sortedList);
     
     /*! Method to update the list after a contraction and add the cost of the contractedPoint
         \param sortedList list of the point to store
         \param contractedPoint point where we contract the edge  */
-    void updateAndAddElementList(sortList<geoElementSize<simplePoint> > & sortedList, UInt contractedPoint);
+    void updateAndAddElementList(heapList<geoElementSize<simplePoint> > & sortedList, UInt contractedPoint);
     
     /*! General method to create the pointWithCost 
         \param pointId identifier of the point 
@@ -76,7 +81,7 @@ class simplification2dCostFunctionBased : public doctor2d<Triangle>
         \param listOfPossiblePointRemoval list where get the points 
         \return the id of the point (this function may return the number of nodes, if it do this it means that it is not 
         able to find a good point)*/
-    UInt getPointToRemoveAndTakeOffItFromTheList(sortList<geoElementSize<simplePoint> > & listOfPossiblePointRemoval);
+    UInt getPointToRemoveAndTakeOffItFromTheList(heapList<geoElementSize<simplePoint> > & listOfPossiblePointRemoval);
     
     //
     // Internal methods to manage the mesh 
@@ -114,6 +119,10 @@ class simplification2dCostFunctionBased : public doctor2d<Triangle>
     costFunction * costFunctionPointer;
     // list of the material ids
     std::vector<UInt> pointMaterialId;
+    // per node cache of the quadrics, used only if the cost function asks for it 
+    quadricCache nodeQuadrics;
+    // how the memory is managed during the collapses 
+    collapseMemory memoryMode;
         
 };
     
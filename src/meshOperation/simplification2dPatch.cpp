@@ -0,0 +1,381 @@
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "simplification2dPatch.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace geometry;
+
+//
+// Costruttori
+//
+simplification2dPatch::simplification2dPatch()
+{
+      meshPointer = NULL;
+      numPatches  = 0;
+      numRings    = 2;
+      numThreads  = 0;
+}
+
+simplification2dPatch::simplification2dPatch(mesh2d<Triangle> * _meshPointer)
+{
+      meshPointer = _meshPointer;
+      numPatches  = 0;
+      numRings    = 2;
+      numThreads  = 0;
+}
+
+void simplification2dPatch::setMeshPointer(mesh2d<Triangle> * _meshPointer)
+{
+      meshPointer = _meshPointer;
+      patchId.clear();
+      numPatches  = 0;
+}
+
+//
+// Divisione in pezzi
+//
+void simplification2dPatch::createPatches(UInt _numPatches)
+{
+      assert(meshPointer!=NULL);
+      assert(meshPointer->getNumElements()>0);
+
+      // variabili in uso
+      UInt				numElem=meshPointer->getNumElements();
+      UInt					     tmp,minimo;
+      connect2d<Triangle>				   conn;
+      vector<UInt>			     semi,dist,conta;
+      queue<UInt>					  coda;
+
+      // connettività elemento-elemento
+      conn.setMeshPointer(meshPointer);
+      conn.buildNodeToElement(false);
+      conn.buildElementToElement(false);
+
+      numPatches = max(static_cast<UInt>(1), min(_numPatches, numElem));
+
+      // semi: ognuno è l'elemento più lontano da quelli già presi, il primo è il più lontano dall'elemento 0
+      semi.push_back(0);
+      distance(conn, semi, &dist);
+      semi[0] = max_element(dist.begin(), dist.end()) - dist.begin();
+      for(UInt k=1; k<numPatches; ++k)
+      {
+	    distance(conn, semi, &dist);
+	    semi.push_back(max_element(dist.begin(), dist.end()) - dist.begin());
+      }
+
+      // faccio crescere le regioni insieme, ogni elemento va al seme più vicino
+      patchId.assign(numElem, numPatches);
+      conta.assign(numPatches, 0);
+      for(UInt k=0; k<numPatches; ++k)
+      {
+	    patchId[semi[k]] = k;
+	    coda.push(semi[k]);
+      }
+
+      for(UInt i=0; i<=numElem; ++i)
+      {
+	    while(!coda.empty())
+	    {
+		  tmp = coda.front();
+		  coda.pop();
+		  ++conta[patchId[tmp]];
+
+		  for(UInt j=0; j<conn.getElementToElementPointer(tmp)->getNumConnected(); ++j)
+		  {
+			UInt vicino = conn.getElementToElementPointer(tmp)->getConnectedId(j);
+			if(patchId[vicino]!=numPatches)	continue;
+
+			patchId[vicino] = patchId[tmp];
+			coda.push(vicino);
+		  }
+	    }
+
+	    // le parti non raggiunte vanno al pezzo più piccolo
+	    if(i<numElem && patchId[i]==numPatches)
+	    {
+		  minimo = min_element(conta.begin(), conta.end()) - conta.begin();
+		  patchId[i] = minimo;
+		  coda.push(i);
+	    }
+      }
+}
+
+void simplification2dPatch::createPatchesGeoId()
+{
+      assert(meshPointer!=NULL);
+
+      // variabili in uso
+      map<UInt, UInt>		  numera;
+
+      // numero i geoId in ordine crescente
+      for(UInt i=0; i<meshPointer->getNumElements(); ++i)	numera[meshPointer->getElement(i).getGeoId()] = 0;
+
+      numPatches = 0;
+      for(map<UInt, UInt>::iterator it=numera.begin(); it!=numera.end(); ++it)	it->second = numPatches++;
+
+      patchId.resize(meshPointer->getNumElements());
+      for(UInt i=0; i<meshPointer->getNumElements(); ++i)
+	  patchId[i] = numera[meshPointer->getElement(i).getGeoId()];
+}
+
+//
+// Processi di semplificazione
+//
+void simplification2dPatch::simplificate(UInt numNodesMax, UInt _numPatches)
+{
+      // di default un pezzo per thread
+      if(_numPatches==0)
+      {
+#ifdef _OPENMP
+	    _numPatches = (numThreads>0) ? numThreads : omp_get_max_threads();
+#else
+	    _numPatches = 1;
+#endif
+      }
+
+      createPatches(_numPatches);
+      simplificatePatches(numNodesMax);
+}
+
+void simplification2dPatch::simplificatePatches(UInt numNodesMax)
+{
+      assert(meshPointer!=NULL);
+      assert(patchId.size()==meshPointer->getNumElements());
+
+      // variabili in uso
+      UInt				  numNode=meshPointer->getNumNodes();
+      UInt			       numElem=meshPointer->getNumElements();
+      UInt					   numSeam,id,cont;
+      Real						 rapporto;
+      vector<UInt>	      patchStart,patchList,nodePatch,locale,target;
+      vector<bool>				     cucitura,fascia;
+      vector<vector<bool> >				bloccato;
+      vector<mesh2d<Triangle> >			  	   pezzi;
+      vector<point>					    tmpPt;
+      vector<geoElement<Triangle> >			    tmpTr;
+      geoElement<Triangle>				     tria;
+      point							p;
+      map<array<Real,3>, UInt>				  cuciture;
+      map<array<Real,3>, UInt>::iterator		        it;
+
+      // controllo
+      if(numNodesMax>=numNode)
+      {
+	  cout << "I punti della mesh sono " << numNode;
+	  cout << " e sono già sotto la soglia " << numNodesMax << endl;
+	  return;
+      }
+
+      cout << "Processo di semplificazione a pezzi con " << numPatches << " pezzi..." << endl;
+      high_resolution_clock::time_point start = high_resolution_clock::now();
+
+      // elementi di ogni pezzo
+      patchStart.assign(numPatches+1, 0);
+      for(UInt i=0; i<numElem; ++i)		++patchStart[patchId[i]+1];
+      for(UInt k=0; k<numPatches; ++k)	patchStart[k+1] += patchStart[k];
+      patchList.resize(numElem);
+      locale.assign(patchStart.begin(), patchStart.end()-1);
+      for(UInt i=0; i<numElem; ++i)		patchList[locale[patchId[i]]++] = i;
+
+      // i nodi delle cuciture sono quelli che stanno in più di un pezzo
+      nodePatch.assign(numNode, numPatches);
+      cucitura.assign(numNode, false);
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    for(UInt j=0; j<3; ++j)
+	    {
+		  id = meshPointer->getElement(i).getConnectedId(j);
+		  if(nodePatch[id]==numPatches)		nodePatch[id] = patchId[i];
+		  else if(nodePatch[id]!=patchId[i])	cucitura[id]  = true;
+	    }
+      }
+
+      // copio i pezzi, i nodi sono numerati nell'ordine in cui li trovo
+      pezzi.resize(numPatches);
+      bloccato.resize(numPatches);
+      target.resize(numPatches);
+      nodePatch.assign(numNode, numPatches);
+      locale.resize(numNode);
+      rapporto = static_cast<Real>(numNodesMax)/static_cast<Real>(numNode);
+      for(UInt k=0; k<numPatches; ++k)
+      {
+	    tmpPt.clear();
+	    tmpTr.clear();
+	    numSeam = 0;
+
+	    for(UInt i=patchStart[k]; i<patchStart[k+1]; ++i)
+	    {
+		  for(UInt j=0; j<3; ++j)
+		  {
+			id = meshPointer->getElement(patchList[i]).getConnectedId(j);
+			if(nodePatch[id]!=k)
+			{
+			      nodePatch[id] = k;
+			      locale[id]    = tmpPt.size();
+			      p = meshPointer->getNode(id);
+			      p.setBoundary(0);
+			      p.setId(tmpPt.size());
+			      tmpPt.push_back(p);
+			      bloccato[k].push_back(cucitura[id]);
+			      if(cucitura[id])	++numSeam;
+			}
+			tria.setConnectedId(j, locale[id]);
+		  }
+		  tria.setGeoId(meshPointer->getElement(patchList[i]).getGeoId());
+		  tria.setId(tmpTr.size());
+		  tmpTr.push_back(tria);
+	    }
+
+	    pezzi[k].insertNode(&tmpPt);
+	    pezzi[k].insertElement(&tmpTr);
+	    pezzi[k].setUpIds();
+
+	    // i nodi interni del pezzo scendono nello stesso rapporto della mesh intera
+	    target[k] = numSeam + static_cast<UInt>(rapporto*(tmpPt.size()-numSeam)+0.5);
+      }
+
+      // semplifico i pezzi in parallelo con le cuciture bloccate
+#ifdef _OPENMP
+      int numTh = (numThreads>0) ? numThreads : omp_get_max_threads();
+#endif
+      #pragma omp parallel for num_threads(numTh) schedule(dynamic, 1)
+      for(UInt k=0; k<numPatches; ++k)
+      {
+	    if(pezzi[k].getNumElements()==0)	continue;
+
+	    simplification2d<Triangle> simp;
+	    simp.setMeshPointer(&pezzi[k]);
+	    for(UInt i=0; i<pezzi[k].getNumNodes(); ++i)
+		if(bloccato[k][i])	pezzi[k].getNodePointer(i)->setBoundary(2);
+
+	    simp.simplificateGreedy(target[k]);
+      }
+
+      // ricucio: i nodi delle cuciture non si sono mossi e vengono riconosciuti dalle coordinate, vanno per primi
+      tmpPt.clear();
+      tmpTr.clear();
+      for(UInt i=0; i<numNode; ++i)
+      {
+	    if(!cucitura[i])	continue;
+
+	    p = meshPointer->getNode(i);
+	    p.setBoundary(0);
+	    p.setId(tmpPt.size());
+	    cuciture[array<Real,3>{{p.getX(), p.getY(), p.getZ()}}] = tmpPt.size();
+	    tmpPt.push_back(p);
+      }
+      numSeam = tmpPt.size();
+
+      for(UInt k=0; k<numPatches; ++k)
+      {
+	    locale.resize(pezzi[k].getNumNodes());
+	    for(UInt i=0; i<pezzi[k].getNumNodes(); ++i)
+	    {
+		  p  = pezzi[k].getNode(i);
+		  it = cuciture.find(array<Real,3>{{p.getX(), p.getY(), p.getZ()}});
+		  if(it!=cuciture.end())
+		  {
+			locale[i] = it->second;
+			continue;
+		  }
+
+		  locale[i] = tmpPt.size();
+		  p.setBoundary(0);
+		  p.setId(tmpPt.size());
+		  tmpPt.push_back(p);
+	    }
+
+	    for(UInt i=0; i<pezzi[k].getNumElements(); ++i)
+	    {
+		  for(UInt j=0; j<3; ++j)	tria.setConnectedId(j, locale[pezzi[k].getElement(i).getConnectedId(j)]);
+		  tria.setGeoId(pezzi[k].getElement(i).getGeoId());
+		  tria.setId(tmpTr.size());
+		  tmpTr.push_back(tria);
+	    }
+
+	    pezzi[k].clear();
+      }
+
+      meshPointer->clear();
+      meshPointer->insertNode(&tmpPt);
+      meshPointer->insertElement(&tmpTr);
+      meshPointer->setUpIds();
+
+      cout << "Pezzi semplificati e ricuciti: " << meshPointer->getNumNodes() << " nodi" << endl;
+
+      // ultimo passo sulla fascia attorno alle cuciture, gli altri nodi sono bloccati
+      simplification2d<Triangle> simp;
+      simp.setMeshPointer(meshPointer);
+
+      fascia.assign(meshPointer->getNumNodes(), false);
+      for(UInt i=0; i<numSeam; ++i)	fascia[i] = true;
+      for(UInt r=0; r<numRings; ++r)
+      {
+	    vector<bool> tmpFascia(fascia);
+	    for(UInt i=0; i<meshPointer->getNumElements(); ++i)
+	    {
+		  cont = 0;
+		  for(UInt j=0; j<3; ++j)	cont += tmpFascia[meshPointer->getElement(i).getConnectedId(j)];
+		  if(cont>0)
+		      for(UInt j=0; j<3; ++j)	fascia[meshPointer->getElement(i).getConnectedId(j)] = true;
+	    }
+      }
+      for(UInt i=0; i<meshPointer->getNumNodes(); ++i)
+	  if(!fascia[i])	meshPointer->getNodePointer(i)->setBoundary(2);
+
+      simp.simplificateGreedy(numNodesMax);
+
+      // i nodi bloccati tornano liberi: rifaccio il rilevamento del bordo (0 interni, 1 bordo)
+      connect2d<Triangle>	  connFinale;
+      mesh1d<Line>			 bor;
+      map<UInt, UInt>		  borToSurf;
+      meshPointer->setUpIds();
+      connFinale.setMeshPointer(meshPointer);
+      connFinale.buildNodeToElement(false);
+      connFinale.buildBoundaryConnectivity(&bor, &borToSurf, true, false);
+      for(UInt i=0; i<meshPointer->getNumNodes(); ++i)	meshPointer->getNodePointer(i)->setBoundary(0);
+      for(UInt i=0; i<bor.getNumNodes(); ++i)	meshPointer->getNodePointer(borToSurf[i])->setBoundary(1);
+
+      high_resolution_clock::time_point stop = high_resolution_clock::now();
+      auto dif = duration_cast<milliseconds>(stop-start).count();
+      cout << "Il processo è partito da " << numNode << " a " << meshPointer->getNumNodes() << " nodi" << endl;
+      cout << "Processo di semplificazione a pezzi completato: " <<  dif << " ms" << endl;
+}
+
+//
+// Metodi interni
+//
+void simplification2dPatch::distance(connect2d<Triangle> & conn, const vector<UInt> & start, vector<UInt> * dist)
+{
+      // variabili in uso
+      UInt		numElem=meshPointer->getNumElements();
+      UInt				       tmp,vicino;
+      queue<UInt>				     coda;
+
+      dist->assign(numElem, numElem);
+      for(UInt k=0; k<start.size(); ++k)
+      {
+	    dist->at(start[k]) = 0;
+	    coda.push(start[k]);
+      }
+
+      while(!coda.empty())
+      {
+	    tmp = coda.front();
+	    coda.pop();
+
+	    for(UInt j=0; j<conn.getElementToElementPointer(tmp)->getNumConnected(); ++j)
+	    {
+		  vicino = conn.getElementToElementPointer(tmp)->getConnectedId(j);
+		  if(dist->at(vicino)!=numElem)	continue;
+
+		  dist->at(vicino) = dist->at(tmp)+1;
+		  coda.push(vicino);
+	    }
+      }
+}
@@ -0,0 +1,128 @@
+#ifndef SIMPLIFICATION2DPATCH_H_
+#define SIMPLIFICATION2DPATCH_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <vector>
+
+#include "../core/shapes.hpp"
+#include "../core/point.h"
+
+#include "../geometry/geoElement.hpp"
+#include "../geometry/mesh2d.hpp"
+#include "../geometry/connect2d.hpp"
+
+#include "../meshOperation/simplification2d.h"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Classe che fa la semplificazione di una superficie dividendola in pezzi (patch) semplificati in parallelo.
+
+    La superficie viene divisa in pezzi connessi, o con i geoId degli elementi o facendo crescere delle regioni a
+    partire da semi lontani fra loro come in virus2d::virusDiffusion. Ogni pezzo viene copiato in una mesh a sé e
+    semplificato da un thread con simplification2d<Triangle>::simplificateGreedy tenendo bloccati (boundary 2) i nodi
+    che ha in comune con gli altri pezzi, così i pezzi semplificati si ricuciono sulle cuciture senza cambiare nulla.
+    Alla fine si fa un'ultima semplificazione Greedy sulla fascia di elementi attorno alle cuciture bloccando tutti gli
+    altri nodi.
+
+    Ogni thread lavora su una mesh piccola e sua, quindi le strutture dati restano in cache e non ci sono
+    sincronizzazioni. Il risultato non dipende dal numero di thread ma dipende dal numero di pezzi. */
+
+class simplification2dPatch
+{
+      //
+      // Variabili di classe
+      //
+      public:
+		  /*! Puntatore alla mesh */
+		  mesh2d<Triangle> *			  meshPointer;
+
+		  /*! Pezzo di ogni elemento */
+		  vector<UInt>				     patchId;
+
+		  /*! Numero di pezzi */
+		  UInt					  numPatches;
+
+		  /*! Numero di anelli di elementi attorno alle cuciture semplificati nell'ultimo passo */
+		  UInt					   numRings;
+
+		  /*! Numero di thread, se è 0 si usa quello di default di OpenMP */
+		  UInt					 numThreads;
+      //
+      // Costruttori
+      //
+      public:
+		  /*! Costruttore */
+		  simplification2dPatch();
+
+		  /*! Costruttore
+		      \param _meshPointer puntatore alla mesh */
+		  simplification2dPatch(mesh2d<Triangle> * _meshPointer);
+
+		  /*! Metodo che cambia il puntatore della mesh
+		      \param _meshPointer puntatore alla mesh */
+		  void setMeshPointer(mesh2d<Triangle> * _meshPointer);
+
+		  /*! get del puntatore della mesh */
+		  inline mesh2d<Triangle> * getMeshPointer()	{return(meshPointer);};
+
+		  /*! set e get del numero di anelli attorno alle cuciture
+		      \param _numRings numero di anelli */
+		  inline void setNumRings(UInt _numRings)	{numRings = _numRings;};
+		  inline UInt getNumRings()			{return(numRings);};
+
+		  /*! set e get del numero di thread
+		      \param _numThreads numero di thread, se è 0 si usa quello di default di OpenMP */
+		  inline void setNumThreads(UInt _numThreads)	{numThreads = _numThreads;};
+		  inline UInt getNumThreads()			{return(numThreads);};
+
+		  /*! get del numero di pezzi dell'ultima divisione */
+		  inline UInt getNumPatches()			{return(numPatches);};
+      //
+      // Divisione in pezzi
+      //
+      public:
+		  /*! Metodo che divide la mesh facendo crescere le regioni in ampiezza a partire da semi scelti lontani fra
+		      loro (il primo è l'elemento più lontano dall'elemento 0, ognuno dei successivi è il più lontano dai
+		      semi già presi). Le parti della mesh non connesse ai semi vanno al pezzo più piccolo
+		      \param _numPatches numero di pezzi */
+		  void createPatches(UInt _numPatches);
+
+		  /*! Metodo che usa i geoId degli elementi come pezzi */
+		  void createPatchesGeoId();
+      //
+      // Processi di semplificazione
+      //
+      public:
+		  /*! Metodo che divide la mesh in pezzi e la semplifica
+		      \param numNodesMax numero massimo di nodi
+		      \param _numPatches numero di pezzi, se è 0 si usa il numero di thread */
+		  void simplificate(UInt numNodesMax, UInt _numPatches=0);
+
+		  /*! Metodo che semplifica la mesh con i pezzi già creati da createPatches o createPatchesGeoId
+		      \param numNodesMax numero massimo di nodi
+		      N.B. come per simplificateGreedy il numero di nodi voluto può non essere raggiunto se la fascia
+			   attorno alle cuciture non ha abbastanza nodi da togliere */
+		  void simplificatePatches(UInt numNodesMax);
+      //
+      // Metodi interni
+      //
+      protected:
+		  /*! Metodo che fa una visita in ampiezza sugli elementi e mette in dist la distanza, in numero di
+		      elementi, da quelli di partenza. Gli elementi non raggiunti hanno distanza pari al numero di elementi
+		      \param conn connettività della mesh
+		      \param start elementi di partenza
+		      \param dist vettore delle distanze */
+		  void distance(connect2d<Triangle> & conn, const vector<UInt> & start, vector<UInt> * dist);
+};
+
+}
+
+#endif
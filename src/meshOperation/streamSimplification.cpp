@@ -0,0 +1,758 @@
+#include <chrono>
+#include <cmath>
+
+#include "streamSimplification.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace geometry;
+
+const size_t streamSimplification::bytePerElement;
+const UInt streamSimplification::profonditaMax;
+
+//
+// Costruttori
+//
+streamSimplification::streamSimplification()
+{
+      memoria   = static_cast<size_t>(1)<<30;
+      tmpPrefix = "streamSimplification";
+      maxFile   = 64;
+      lato      = 1.0;
+      div[0] = div[1] = div[2] = 1;
+      numBlocchi = 1;
+      maxBlocco  = 0;
+}
+
+//
+// Processo di semplificazione
+//
+UInt streamSimplification::simplificate(string in, string out, UInt numNodesMax)
+{
+      // variabili in uso
+      UInt		      numNode;
+      string	   tmpFile = tmpPrefix + ".giro.inp";
+
+      high_resolution_clock::time_point start = high_resolution_clock::now();
+      maxBlocco = 0;
+
+      // primo giro, le cuciture restano ferme
+      numNode = round(in, tmpFile, numNodesMax, false, false);
+
+      // secondo giro con la griglia spostata
+      if(numNode>numNodesMax)
+      {
+	    numNode = round(tmpFile, out, numNodesMax, true, true);
+	    remove(tmpFile.c_str());
+      }
+      else if(numNode>0 && std::rename(tmpFile.c_str(), out.c_str())!=0)
+      {
+	    numNode = 0;
+	    fileError(out);
+	    remove(tmpFile.c_str());
+      }
+
+      if(numNode==0)
+      {
+	    cout << "ERRORE: semplificazione a blocchi di " << in << " interrotta" << endl;
+	    return(0);
+      }
+
+      high_resolution_clock::time_point stop = high_resolution_clock::now();
+      auto dif = duration_cast<milliseconds>(stop-start).count();
+      cout << "Processo di semplificazione a blocchi completato: " << numNode << " nodi in " << dif << " ms" << endl;
+
+      return(numNode);
+}
+
+//
+// Metodi interni
+//
+UInt streamSimplification::round(string in, string out, UInt numNodesMax, bool shift, bool ultimo)
+{
+      // variabili in uso
+      UInt			numNode,numElem,numSeam,numFree,numTria;
+      Real						rapporto;
+      point						bMin,bMax;
+      vector<UInt>					  blocchi;
+
+      if(!readInput(in, numNode, numElem, bMin, bMax))
+      {
+	    cleanUp(&blocchi);
+	    return(0);
+      }
+
+      createGrid(numElem, bMin, bMax, shift);
+      cout << "Blocchi " << div[0] << " x " << div[1] << " x " << div[2] << " di lato " << lato << endl;
+
+      // i blocchi con troppi triangoli vengono divisi e i blocchi dei triangoli rifatti finché nessuno supera il limite
+      bool diviso = true;
+      while(diviso)
+      {
+	    if(!createOwners(numNode, numElem) || !splitBlocks(numElem, diviso))
+	    {
+		  cleanUp(&blocchi);
+		  return(0);
+	    }
+      }
+
+      if(!createSeams(numNode, numElem, numSeam))
+      {
+	    cleanUp(&blocchi);
+	    return(0);
+      }
+
+      // rapporto dei nodi liberi
+      if(ultimo && numNode>numSeam)
+	  rapporto = (static_cast<Real>(numNodesMax)-numSeam)/(static_cast<Real>(numNode)-numSeam);
+      else
+	  rapporto = static_cast<Real>(numNodesMax)/static_cast<Real>(numNode);
+      rapporto = max(0.0, min(1.0, rapporto));
+
+      cout << "Nodi " << numNode << " di cui " << numSeam << " sulle cuciture" << endl;
+
+      if(!distribute(numElem, &blocchi) || !simplificateChunks(&blocchi, rapporto, numFree, numTria) ||
+	 !writeOutput(out, numNode, numSeam, numFree, numTria))
+      {
+	    cleanUp(&blocchi);
+	    remove(out.c_str());
+	    return(0);
+      }
+
+      cleanUp(&blocchi);
+
+      return(numSeam+numFree);
+}
+
+bool streamSimplification::readInput(string in, UInt & numNode, UInt & numElem, point & bMin, point & bMax)
+{
+      // variabili in uso
+      ifstream				file(in.c_str());
+      ofstream	  nodi((tmpPrefix + ".nodi").c_str(), ios::binary);
+      ofstream	  tria((tmpPrefix + ".tria").c_str(), ios::binary);
+      string					   str;
+      UInt			      tmp,rec[4];
+      Real					 xyz[3];
+
+      if(!file.is_open())
+      {
+	    cout << "ERRORE: file " << in << " non trovato" << endl;
+	    return(false);
+      }
+      if(!nodi.is_open())	return(fileError(tmpPrefix + ".nodi"));
+      if(!tria.is_open())	return(fileError(tmpPrefix + ".tria"));
+
+      // informazioni generali
+      file >> numNode;
+      file >> numElem;
+      file >> tmp;	file >> tmp;	file >> tmp;
+      if(!file || numNode==0)
+      {
+	    cout << "ERRORE: intestazione del file " << in << " non valida" << endl;
+	    return(false);
+      }
+
+      // nodi
+      for(UInt i=0; i<numNode; ++i)
+      {
+	    file >> tmp;
+	    file >> xyz[0];
+	    file >> xyz[1];
+	    file >> xyz[2];
+	    if(!file)
+	    {
+		  cout << "ERRORE: il file " << in << " si ferma al nodo " << i+1 << " di " << numNode << endl;
+		  return(false);
+	    }
+	    nodi.write(reinterpret_cast<char*>(xyz), sizeof(xyz));
+
+	    for(UInt j=0; j<3; ++j)
+	    {
+		  if(i==0 || xyz[j]<bMin.getI(j))	bMin.setI(j, xyz[j]);
+		  if(i==0 || xyz[j]>bMax.getI(j))	bMax.setI(j, xyz[j]);
+	    }
+      }
+
+      // triangoli: i tre nodi partendo da 0 e il geoId
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    file >> tmp;
+	    file >> rec[3];
+	    file >> str;
+	    file >> rec[0];
+	    file >> rec[1];
+	    file >> rec[2];
+	    if(!file)
+	    {
+		  cout << "ERRORE: il file " << in << " si ferma al triangolo " << i+1 << " di " << numElem << endl;
+		  return(false);
+	    }
+
+	    for(UInt j=0; j<3; ++j)
+	    {
+		  if(rec[j]==0 || rec[j]>numNode)
+		  {
+			cout << "ERRORE: il triangolo " << i+1 << " del file " << in << " ha il nodo " << rec[j];
+			cout << " fuori da 1.." << numNode << endl;
+			return(false);
+		  }
+		  --rec[j];
+	    }
+	    tria.write(reinterpret_cast<char*>(rec), sizeof(rec));
+      }
+
+      nodi.close();
+      tria.close();
+      if(!nodi)	return(fileError(tmpPrefix + ".nodi"));
+      if(!tria)	return(fileError(tmpPrefix + ".tria"));
+
+      return(true);
+}
+
+void streamSimplification::createGrid(UInt numElem, point bMin, point bMax, bool shift)
+{
+      // variabili in uso
+      Real	       perLato,lMax;
+      size_t	       perBlocco = max(static_cast<size_t>(1000), memoria/bytePerElement);
+
+      // una superficie in una griglia di n^3 blocchi ne tocca circa n^2, ogni blocco deve avere perBlocco triangoli
+      perLato = sqrt(max(1.0, static_cast<Real>(numElem)/perBlocco));
+
+      lMax = 0.0;
+      for(UInt i=0; i<3; ++i)	lMax = max(lMax, bMax.getI(i)-bMin.getI(i));
+      lato = (lMax>0.0) ? lMax/perLato : 1.0;
+
+      // la griglia spostata parte mezzo blocco prima e ha un blocco in più
+      for(UInt i=0; i<3; ++i)
+      {
+	    origine.setI(i, bMin.getI(i) - (shift ? 0.5*lato : 0.0));
+	    div[i] = static_cast<UInt>(floor((bMax.getI(i)-origine.getI(i))/lato))+1;
+      }
+
+      // nessun blocco diviso, i figli avranno gli identificatori dopo quelli della griglia
+      figli.clear();
+      livello.clear();
+      numBlocchi = div[0]*div[1]*div[2];
+}
+
+UInt streamSimplification::getCell(const point & p)
+{
+      // variabili in uso
+      UInt			 id[3],blocco,ottante;
+      Real			      inizio[3],l;
+      map<UInt, UInt>::iterator			 it;
+
+      for(UInt i=0; i<3; ++i)
+      {
+	    Real c = floor((p.getI(i)-origine.getI(i))/lato);
+	    id[i] = static_cast<UInt>(max(0.0, min(c, static_cast<Real>(div[i]-1))));
+	    inizio[i] = origine.getI(i) + id[i]*lato;
+      }
+      blocco = id[0]+id[1]*div[0]+id[2]*div[0]*div[1];
+
+      // scendo nei blocchi divisi, ad ogni livello il lato si dimezza e l'ottante dice quale figlio prendere
+      l = lato;
+      while((it=figli.find(blocco))!=figli.end())
+      {
+	    l *= 0.5;
+	    ottante = 0;
+	    for(UInt i=0; i<3; ++i)
+	    {
+		  if(p.getI(i)>=inizio[i]+l)
+		  {
+			ottante   += 1<<i;
+			inizio[i] += l;
+		  }
+	    }
+	    blocco = it->second + ottante;
+      }
+
+      return(blocco);
+}
+
+bool streamSimplification::splitBlocks(UInt numElem, bool & diviso)
+{
+      // variabili in uso
+      UInt						   owner;
+      map<UInt, UInt>					conteggio;
+      size_t	       perBlocco = max(static_cast<size_t>(1000), memoria/bytePerElement);
+      ifstream	  ownerFile((tmpPrefix + ".owner").c_str(), ios::binary);
+
+      if(!ownerFile.is_open())	return(fileError(tmpPrefix + ".owner"));
+
+      // conto i triangoli di ogni blocco
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    ownerFile.read(reinterpret_cast<char*>(&owner), sizeof(UInt));
+	    ++conteggio[owner];
+      }
+      if(!ownerFile)	return(fileError(tmpPrefix + ".owner"));
+
+      // divido quelli troppo grandi, i figli hanno un livello in più
+      diviso = false;
+      for(map<UInt, UInt>::iterator it=conteggio.begin(); it!=conteggio.end(); ++it)
+      {
+	    if(it->second<=perBlocco)	continue;
+
+	    UInt liv = livello.count(it->first) ? livello[it->first] : 0;
+	    if(liv>=profonditaMax)
+	    {
+		  cout << "ATTENZIONE: il blocco " << it->first << " ha " << it->second << " triangoli e non viene più diviso";
+		  cout << endl;
+		  continue;
+	    }
+
+	    figli[it->first] = numBlocchi;
+	    for(UInt k=0; k<8; ++k)	livello[numBlocchi+k] = liv+1;
+	    numBlocchi += 8;
+	    diviso      = true;
+      }
+
+      return(true);
+}
+
+bool streamSimplification::cellOfNodes(UInt a, UInt b, vector<UInt> * cella)
+{
+      // variabili in uso
+      ifstream	   nodi((tmpPrefix + ".nodi").c_str(), ios::binary);
+      Real					 xyz[3];
+
+      if(!nodi.is_open())	return(fileError(tmpPrefix + ".nodi"));
+
+      nodi.seekg(static_cast<streamoff>(a)*sizeof(xyz));
+      cella->resize(b-a);
+      for(UInt i=a; i<b; ++i)
+      {
+	    nodi.read(reinterpret_cast<char*>(xyz), sizeof(xyz));
+	    cella->at(i-a) = getCell(point(xyz[0], xyz[1], xyz[2]));
+      }
+
+      if(!nodi)	return(fileError(tmpPrefix + ".nodi"));
+
+      return(true);
+}
+
+UInt streamSimplification::getRange()
+{
+      return(static_cast<UInt>(max(static_cast<size_t>(1024), memoria/(sizeof(UInt)+1))));
+}
+
+string streamSimplification::blockName(UInt blocco)
+{
+      ostringstream nome;
+      nome << tmpPrefix << ".blocco" << blocco;
+      return(nome.str());
+}
+
+bool streamSimplification::fileError(string nome)
+{
+      cout << "ERRORE: lettura o scrittura del file " << nome << " fallita" << endl;
+      return(false);
+}
+
+void streamSimplification::cleanUp(vector<UInt> * blocchi)
+{
+      remove((tmpPrefix + ".nodi").c_str());
+      remove((tmpPrefix + ".tria").c_str());
+      remove((tmpPrefix + ".owner").c_str());
+      remove((tmpPrefix + ".owner.tmp").c_str());
+      remove((tmpPrefix + ".seam").c_str());
+      remove((tmpPrefix + ".outNodi").c_str());
+      remove((tmpPrefix + ".outTria").c_str());
+      remove((tmpPrefix + ".outTria.tmp").c_str());
+      for(UInt k=0; k<blocchi->size(); ++k)	remove(blockName(blocchi->at(k)).c_str());
+}
+
+bool streamSimplification::createOwners(UInt numNode, UInt numElem)
+{
+      // variabili in uso
+      UInt			  rec[4],owner,minimo;
+      vector<UInt>					cella;
+      string		     nome = tmpPrefix + ".owner";
+      string		    nomeTmp = nome + ".tmp";
+
+      // ogni triangolo va nel blocco del suo nodo più piccolo, i blocchi dei nodi sono calcolati a intervalli e ad ogni
+      // passata il file dei blocchi dei triangoli viene riscritto
+      for(UInt a=0; a<numNode; a+=getRange())
+      {
+	    UInt b = min(numNode, a+getRange());
+	    if(!cellOfNodes(a, b, &cella))	return(false);
+
+	    ifstream tria((tmpPrefix + ".tria").c_str(), ios::binary);
+	    ifstream vecchio;
+	    ofstream nuovo(nomeTmp.c_str(), ios::binary);
+	    if(a>0)	vecchio.open(nome.c_str(), ios::binary);
+	    if(!tria.is_open())			return(fileError(tmpPrefix + ".tria"));
+	    if(a>0 && !vecchio.is_open())	return(fileError(nome));
+	    if(!nuovo.is_open())		return(fileError(nomeTmp));
+
+	    for(UInt i=0; i<numElem; ++i)
+	    {
+		  tria.read(reinterpret_cast<char*>(rec), sizeof(rec));
+		  owner = 0;
+		  if(a>0)	vecchio.read(reinterpret_cast<char*>(&owner), sizeof(UInt));
+
+		  minimo = min(rec[0], min(rec[1], rec[2]));
+		  if(minimo>=a && minimo<b)	owner = cella[minimo-a];
+
+		  nuovo.write(reinterpret_cast<char*>(&owner), sizeof(UInt));
+	    }
+
+	    nuovo.close();
+	    if(!tria)				return(fileError(tmpPrefix + ".tria"));
+	    if(a>0 && !vecchio)			return(fileError(nome));
+	    if(!nuovo)				return(fileError(nomeTmp));
+	    vecchio.close();
+	    if(std::rename(nomeTmp.c_str(), nome.c_str())!=0)	return(fileError(nome));
+      }
+
+      return(true);
+}
+
+bool streamSimplification::createSeams(UInt numNode, UInt numElem, UInt & numSeam)
+{
+      // variabili in uso
+      UInt			   rec[4],owner;
+      vector<UInt>				 cella;
+      vector<char>				  seam;
+      ofstream	 seamFile((tmpPrefix + ".seam").c_str(), ios::binary);
+
+      if(!seamFile.is_open())	return(fileError(tmpPrefix + ".seam"));
+      numSeam = 0;
+
+      // un nodo è libero se tutti i suoi triangoli stanno nel suo blocco
+      for(UInt a=0; a<numNode; a+=getRange())
+      {
+	    UInt b = min(numNode, a+getRange());
+	    if(!cellOfNodes(a, b, &cella))	return(false);
+	    seam.assign(b-a, 0);
+
+	    ifstream tria((tmpPrefix + ".tria").c_str(), ios::binary);
+	    ifstream ownerFile((tmpPrefix + ".owner").c_str(), ios::binary);
+	    if(!tria.is_open())		return(fileError(tmpPrefix + ".tria"));
+	    if(!ownerFile.is_open())	return(fileError(tmpPrefix + ".owner"));
+	    for(UInt i=0; i<numElem; ++i)
+	    {
+		  tria.read(reinterpret_cast<char*>(rec), sizeof(rec));
+		  ownerFile.read(reinterpret_cast<char*>(&owner), sizeof(UInt));
+
+		  for(UInt j=0; j<3; ++j)
+		      if(rec[j]>=a && rec[j]<b && cella[rec[j]-a]!=owner)	seam[rec[j]-a] = 1;
+	    }
+
+	    if(!tria)		return(fileError(tmpPrefix + ".tria"));
+	    if(!ownerFile)	return(fileError(tmpPrefix + ".owner"));
+
+	    for(UInt i=0; i<seam.size(); ++i)	numSeam += seam[i];
+	    seamFile.write(&seam[0], seam.size());
+      }
+
+      seamFile.close();
+      if(!seamFile)	return(fileError(tmpPrefix + ".seam"));
+
+      return(true);
+}
+
+bool streamSimplification::distribute(UInt numElem, vector<UInt> * blocchi)
+{
+      // variabili in uso
+      UInt				      rec[4],owner;
+      set<UInt>					     usati;
+      vector<UInt>::iterator				it;
+
+      // prima passata sui soli blocchi dei triangoli per sapere quali blocchi sono usati
+      ifstream	  ownerFile((tmpPrefix + ".owner").c_str(), ios::binary);
+      if(!ownerFile.is_open())	return(fileError(tmpPrefix + ".owner"));
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    ownerFile.read(reinterpret_cast<char*>(&owner), sizeof(UInt));
+	    usati.insert(owner);
+      }
+      if(!ownerFile)	return(fileError(tmpPrefix + ".owner"));
+      ownerFile.close();
+
+      blocchi->assign(usati.begin(), usati.end());
+
+      // i file dei blocchi sono aperti a gruppi di maxFile, una passata sui triangoli per ogni gruppo
+      for(UInt a=0; a<blocchi->size(); a+=maxFile)
+      {
+	    UInt b = min(static_cast<UInt>(blocchi->size()), a+maxFile);
+	    vector<ofstream> file(b-a);
+	    for(UInt k=a; k<b; ++k)
+	    {
+		  file[k-a].open(blockName(blocchi->at(k)).c_str(), ios::binary);
+		  if(!file[k-a].is_open())	return(fileError(blockName(blocchi->at(k))));
+	    }
+
+	    ifstream tria((tmpPrefix + ".tria").c_str(), ios::binary);
+	    ownerFile.open((tmpPrefix + ".owner").c_str(), ios::binary);
+	    if(!tria.is_open())		return(fileError(tmpPrefix + ".tria"));
+	    if(!ownerFile.is_open())	return(fileError(tmpPrefix + ".owner"));
+
+	    for(UInt i=0; i<numElem; ++i)
+	    {
+		  tria.read(reinterpret_cast<char*>(rec), sizeof(rec));
+		  ownerFile.read(reinterpret_cast<char*>(&owner), sizeof(UInt));
+
+		  it = lower_bound(blocchi->begin()+a, blocchi->begin()+b, owner);
+		  if(it!=blocchi->begin()+b && *it==owner)
+		      file[it-blocchi->begin()-a].write(reinterpret_cast<char*>(rec), sizeof(rec));
+	    }
+
+	    if(!tria)		return(fileError(tmpPrefix + ".tria"));
+	    if(!ownerFile)	return(fileError(tmpPrefix + ".owner"));
+	    ownerFile.close();
+
+	    for(UInt k=a; k<b; ++k)
+	    {
+		  file[k-a].close();
+		  if(!file[k-a])	return(fileError(blockName(blocchi->at(k))));
+	    }
+      }
+
+      return(true);
+}
+
+bool streamSimplification::simplificateChunks(vector<UInt> * blocchi, Real rapporto, UInt & numFree, UInt & numTria)
+{
+      // variabili in uso
+      UInt				    rec[4],ref[7],numLocked;
+      Real						 xyz[3];
+      char						   flag;
+      vector<UInt>				    triangoli,ids;
+      vector<point>					  tmpPt;
+      vector<geoElement<Triangle> >			  tmpTr;
+      geoElement<Triangle>				   tria;
+      mesh2d<Triangle>					  pezzo;
+      point						      p;
+      map<array<Real,3>, UInt>			       bloccati;
+      map<array<Real,3>, UInt>::iterator			     it;
+      vector<UInt>					 locale;
+      ifstream	      nodi((tmpPrefix + ".nodi").c_str(), ios::binary);
+      ifstream	      seam((tmpPrefix + ".seam").c_str(), ios::binary);
+      ofstream	   outNodi((tmpPrefix + ".outNodi").c_str(), ios::binary);
+      ofstream	   outTria((tmpPrefix + ".outTria").c_str(), ios::binary);
+
+      if(!nodi.is_open())	return(fileError(tmpPrefix + ".nodi"));
+      if(!seam.is_open())	return(fileError(tmpPrefix + ".seam"));
+      if(!outNodi.is_open())	return(fileError(tmpPrefix + ".outNodi"));
+      if(!outTria.is_open())	return(fileError(tmpPrefix + ".outTria"));
+
+      numFree = 0;
+      numTria = 0;
+      for(UInt k=0; k<blocchi->size(); ++k)
+      {
+	    // leggo i triangoli del blocco
+	    string nome = blockName(blocchi->at(k));
+	    ifstream file(nome.c_str(), ios::binary);
+	    if(!file.is_open())	return(fileError(nome));
+	    triangoli.clear();
+	    while(file.read(reinterpret_cast<char*>(rec), sizeof(rec)))	triangoli.insert(triangoli.end(), rec, rec+4);
+	    file.close();
+	    remove(nome.c_str());
+	    maxBlocco = max(maxBlocco, static_cast<UInt>(triangoli.size()/4));
+
+	    // nodi del blocco in ordine crescente, letti dai file con accessi in avanti
+	    ids.clear();
+	    for(UInt i=0; i<triangoli.size(); i+=4)	ids.insert(ids.end(), triangoli.begin()+i, triangoli.begin()+i+3);
+	    sort(ids.begin(), ids.end());
+	    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+	    tmpPt.resize(ids.size());
+	    bloccati.clear();
+	    numLocked = 0;
+	    for(UInt i=0; i<ids.size(); ++i)
+	    {
+		  nodi.seekg(static_cast<streamoff>(ids[i])*sizeof(xyz));
+		  nodi.read(reinterpret_cast<char*>(xyz), sizeof(xyz));
+		  seam.seekg(ids[i]);
+		  seam.read(&flag, 1);
+
+		  tmpPt[i] = point(xyz[0], xyz[1], xyz[2]);
+		  tmpPt[i].setId(i);
+		  tmpPt[i].setBoundary(flag ? 2 : 0);
+		  if(flag)
+		  {
+			bloccati[array<Real,3>{{xyz[0], xyz[1], xyz[2]}}] = ids[i];
+			++numLocked;
+		  }
+	    }
+	    if(!nodi)	return(fileError(tmpPrefix + ".nodi"));
+	    if(!seam)	return(fileError(tmpPrefix + ".seam"));
+
+	    tmpTr.clear();
+	    for(UInt i=0; i<triangoli.size(); i+=4)
+	    {
+		  for(UInt j=0; j<3; ++j)
+		      tria.setConnectedId(j, lower_bound(ids.begin(), ids.end(), triangoli[i+j])-ids.begin());
+		  tria.setGeoId(triangoli[i+3]);
+		  tria.setId(tmpTr.size());
+		  tmpTr.push_back(tria);
+	    }
+
+	    pezzo.clear();
+	    pezzo.insertNode(&tmpPt);
+	    pezzo.insertElement(&tmpTr);
+	    pezzo.setUpIds();
+
+	    // semplifico con le cuciture bloccate, setMeshPointer ricalcola i bordi
+	    UInt target = numLocked + static_cast<UInt>(rapporto*(ids.size()-numLocked)+0.5);
+	    if(target<pezzo.getNumNodes())
+	    {
+		  simplification2d<Triangle> simp;
+		  simp.setMeshPointer(&pezzo);
+		  for(UInt i=0; i<ids.size(); ++i)
+		      if(tmpPt[i].getBoundary()==2)	pezzo.getNodePointer(i)->setBoundary(2);
+		  simp.simplificateGreedy(target);
+	    }
+
+	    // i nodi bloccati non si sono mossi e sono riconosciuti dalle coordinate, gli altri vanno in coda
+	    locale.resize(pezzo.getNumNodes());
+	    for(UInt i=0; i<pezzo.getNumNodes(); ++i)
+	    {
+		  p  = pezzo.getNode(i);
+		  it = bloccati.find(array<Real,3>{{p.getX(), p.getY(), p.getZ()}});
+		  if(it!=bloccati.end())
+		  {
+			locale[i] = 2*it->second+1;
+			continue;
+		  }
+
+		  for(UInt j=0; j<3; ++j)	xyz[j] = p.getI(j);
+		  outNodi.write(reinterpret_cast<char*>(xyz), sizeof(xyz));
+		  locale[i] = 2*numFree;
+		  ++numFree;
+	    }
+
+	    // triangoli: per ogni nodo la flag bloccato e l'identificatore, poi il geoId
+	    for(UInt i=0; i<pezzo.getNumElements(); ++i)
+	    {
+		  for(UInt j=0; j<3; ++j)
+		  {
+			ref[2*j]   = locale[pezzo.getElement(i).getConnectedId(j)]%2;
+			ref[2*j+1] = locale[pezzo.getElement(i).getConnectedId(j)]/2;
+		  }
+		  ref[6] = pezzo.getElement(i).getGeoId();
+		  outTria.write(reinterpret_cast<char*>(ref), sizeof(ref));
+		  ++numTria;
+	    }
+      }
+
+      pezzo.clear();
+
+      outNodi.close();
+      outTria.close();
+      if(!outNodi)	return(fileError(tmpPrefix + ".outNodi"));
+      if(!outTria)	return(fileError(tmpPrefix + ".outTria"));
+
+      return(true);
+}
+
+bool streamSimplification::writeOutput(string out, UInt numNode, UInt numSeam, UInt numFree, UInt numTria)
+{
+      // variabili in uso
+      UInt				   ref[7],cont;
+      Real					 xyz[3];
+      char					   flag;
+      vector<UInt>				  rango;
+      string	      nome = tmpPrefix + ".outTria";
+      string	     nomeTmp = nome + ".tmp";
+
+      // i nodi bloccati vanno per primi nell'ordine di partenza, il loro nuovo identificatore è il numero di nodi
+      // bloccati che vengono prima e viene calcolato a intervalli come in createOwners. Alla fine la flag vale 2
+      cont = 0;
+      for(UInt a=0; a<numNode; a+=getRange())
+      {
+	    UInt b = min(numNode, a+getRange());
+	    ifstream seam((tmpPrefix + ".seam").c_str(), ios::binary);
+	    if(!seam.is_open())	return(fileError(tmpPrefix + ".seam"));
+	    seam.seekg(a);
+	    rango.resize(b-a);
+	    for(UInt i=a; i<b; ++i)
+	    {
+		  seam.read(&flag, 1);
+		  rango[i-a] = cont;
+		  if(flag)	++cont;
+	    }
+	    if(!seam)	return(fileError(tmpPrefix + ".seam"));
+
+	    ifstream vecchio(nome.c_str(), ios::binary);
+	    ofstream nuovo(nomeTmp.c_str(), ios::binary);
+	    if(!vecchio.is_open())	return(fileError(nome));
+	    if(!nuovo.is_open())	return(fileError(nomeTmp));
+	    for(UInt i=0; i<numTria; ++i)
+	    {
+		  vecchio.read(reinterpret_cast<char*>(ref), sizeof(ref));
+		  for(UInt j=0; j<3; ++j)
+		  {
+			if(ref[2*j]==1 && ref[2*j+1]>=a && ref[2*j+1]<b)
+			{
+			      ref[2*j]   = 2;
+			      ref[2*j+1] = rango[ref[2*j+1]-a];
+			}
+		  }
+		  nuovo.write(reinterpret_cast<char*>(ref), sizeof(ref));
+	    }
+	    nuovo.close();
+	    if(!vecchio)	return(fileError(nome));
+	    if(!nuovo)		return(fileError(nomeTmp));
+	    vecchio.close();
+	    if(std::rename(nomeTmp.c_str(), nome.c_str())!=0)	return(fileError(nome));
+      }
+
+      // scrivo il file
+      ofstream file(out.c_str());
+      if(!file.is_open())	return(fileError(out));
+      file.precision(16);
+      file << numSeam+numFree << " " << numTria << " 0 0 0" << endl;
+
+      ifstream nodi((tmpPrefix + ".nodi").c_str(), ios::binary);
+      ifstream seam((tmpPrefix + ".seam").c_str(), ios::binary);
+      ifstream outNodi((tmpPrefix + ".outNodi").c_str(), ios::binary);
+      ifstream outTria(nome.c_str(), ios::binary);
+      if(!nodi.is_open())	return(fileError(tmpPrefix + ".nodi"));
+      if(!seam.is_open())	return(fileError(tmpPrefix + ".seam"));
+      if(!outNodi.is_open())	return(fileError(tmpPrefix + ".outNodi"));
+      if(!outTria.is_open())	return(fileError(nome));
+      cont = 0;
+      for(UInt i=0; i<numNode; ++i)
+      {
+	    nodi.read(reinterpret_cast<char*>(xyz), sizeof(xyz));
+	    seam.read(&flag, 1);
+	    if(!flag)	continue;
+
+	    file << ++cont << " " << xyz[0] << " " << xyz[1] << " " << xyz[2] << endl;
+      }
+
+      for(UInt i=0; i<numFree; ++i)
+      {
+	    outNodi.read(reinterpret_cast<char*>(xyz), sizeof(xyz));
+	    file << ++cont << " " << xyz[0] << " " << xyz[1] << " " << xyz[2] << endl;
+      }
+
+      for(UInt i=0; i<numTria; ++i)
+      {
+	    outTria.read(reinterpret_cast<char*>(ref), sizeof(ref));
+	    file << i+1 << " " << ref[6] << " tri ";
+	    for(UInt j=0; j<3; ++j)
+	    {
+		  assert(ref[2*j]!=1);
+		  file << ((ref[2*j]==2) ? ref[2*j+1]+1 : numSeam+ref[2*j+1]+1) << ((j<2) ? " " : "");
+	    }
+	    file << endl;
+      }
+
+      file.close();
+      if(!nodi)			return(fileError(tmpPrefix + ".nodi"));
+      if(!seam)			return(fileError(tmpPrefix + ".seam"));
+      if(!outNodi)		return(fileError(tmpPrefix + ".outNodi"));
+      if(!outTria)		return(fileError(nome));
+      if(!file)			return(fileError(out));
+
+      outNodi.close();
+      outTria.close();
+      remove((tmpPrefix + ".outNodi").c_str());
+      remove(nome.c_str());
+
+      return(true);
+}
@@ -0,0 +1,230 @@
+#ifndef STREAMSIMPLIFICATION_H_
+#define STREAMSIMPLIFICATION_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../core/shapes.hpp"
+#include "../core/point.h"
+
+#include "../geometry/geoElement.hpp"
+#include "../geometry/mesh2d.hpp"
+
+#include "../meshOperation/simplification2d.h"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Classe che semplifica una superficie in formato paraview (.inp) senza caricarla tutta in memoria.
+
+    Il file viene letto una volta sola e copiato in file binari temporanei. Lo spazio viene diviso in una griglia di
+    blocchi, ogni triangolo va nel blocco del suo nodo con l'identificatore più piccolo e i triangoli vengono
+    distribuiti in un file per blocco (un ordinamento esterno per cella). Un nodo che ha tutti i triangoli nel blocco in
+    cui cade è libero, gli altri sono sulle cuciture. Ogni blocco viene caricato da solo, semplificato con
+    simplification2d<Triangle>::simplificateGreedy tenendo bloccati (boundary 2) i nodi delle cuciture e scritto in
+    coda al risultato, così i blocchi si ricuciono senza cambiare nulla.
+
+    Le cuciture restano con la risoluzione iniziale, quindi il processo viene ripetuto sul risultato con una griglia
+    spostata di mezzo blocco: le cuciture del primo giro sono quasi tutte interne ai blocchi del secondo.
+
+    La memoria usata è limitata da memoria: i blocchi hanno al massimo memoria/bytePerElement triangoli (almeno 1000) e
+    i vettori sui nodi sono costruiti a intervalli di identificatori che stanno in memoria, facendo più passate sui file
+    temporanei se serve. La griglia è scelta per avere circa quel numero di triangoli per blocco, poi i triangoli di
+    ogni blocco vengono contati e i blocchi che superano il limite vengono divisi in otto come in un octree, fino a
+    profonditaMax livelli (oltre non si divide più, per esempio se ci sono molti nodi coincidenti). Anche i file dei blocchi sono scritti a gruppi di maxFile, così i file aperti insieme sono limitati. Lo spazio
+    su disco usato è qualche volta quello del file di partenza.
+
+    Un errore su un file (file mancante, identificatori fuori dai nodi, disco pieno) ferma il processo, cancella i file
+    temporanei e fa restituire 0 a simplificate. */
+
+class streamSimplification
+{
+      //
+      // Variabili di classe
+      //
+      public:
+		  /*! Memoria massima in byte */
+		  size_t					memoria;
+
+		  /*! Stima della memoria usata da simplification2d per ogni triangolo */
+		  static const size_t		     bytePerElement = 1024;
+
+		  /*! Prefisso dei file temporanei */
+		  string				      tmpPrefix;
+
+		  /*! Numero massimo di file dei blocchi aperti insieme */
+		  UInt						maxFile;
+
+		  /*! Origine della griglia dei blocchi */
+		  point					       origine;
+
+		  /*! Lato dei blocchi */
+		  Real						  lato;
+
+		  /*! Numero di blocchi nelle tre direzioni */
+		  UInt						div[3];
+
+		  /*! Blocchi divisi: identificatore del primo degli otto figli, i figli sono consecutivi */
+		  map<UInt, UInt>				       figli;
+
+		  /*! Livello dei blocchi ottenuti dalle divisioni */
+		  map<UInt, UInt>				     livello;
+
+		  /*! Primo identificatore libero per i figli */
+		  UInt					      numBlocchi;
+
+		  /*! Numero massimo di divisioni di un blocco */
+		  static const UInt		       profonditaMax = 16;
+
+		  /*! Numero di triangoli del blocco più grande semplificato dall'ultima chiamata a simplificate */
+		  UInt					      maxBlocco;
+      //
+      // Costruttori
+      //
+      public:
+		  /*! Costruttore, la memoria di default è 1 GB */
+		  streamSimplification();
+
+		  /*! set e get della memoria
+		      \param _memoria memoria massima in byte */
+		  inline void setMemoryBudget(size_t _memoria)		{memoria = _memoria;};
+		  inline size_t getMemoryBudget()			{return(memoria);};
+
+		  /*! set e get del prefisso dei file temporanei
+		      \param _tmpPrefix prefisso, può contenere una cartella */
+		  inline void setTmpPrefix(string _tmpPrefix)		{tmpPrefix = _tmpPrefix;};
+		  inline string getTmpPrefix()				{return(tmpPrefix);};
+
+		  /*! set e get del numero massimo di file dei blocchi aperti insieme
+		      \param _maxFile numero di file, almeno 1 */
+		  inline void setMaxOpenFiles(UInt _maxFile)		{maxFile = max(static_cast<UInt>(1), _maxFile);};
+		  inline UInt getMaxOpenFiles()				{return(maxFile);};
+
+		  /*! get del numero di triangoli del blocco più grande semplificato dall'ultima chiamata a simplificate */
+		  inline UInt getMaxBlockSize()				{return(maxBlocco);};
+      //
+      // Processo di semplificazione
+      //
+      public:
+		  /*! Metodo che semplifica il file in e scrive il risultato nel file out
+		      \param in file .inp di partenza
+		      \param out file .inp del risultato
+		      \param numNodesMax numero massimo di nodi
+		      \return numero di nodi del risultato, 0 se c'è un errore sui file
+		      N.B. come per simplificateGreedy il numero di nodi voluto può non essere raggiunto se le cuciture del
+			   secondo giro hanno troppi nodi */
+		  UInt simplificate(string in, string out, UInt numNodesMax);
+      //
+      // Metodi interni
+      //
+      protected:
+		  /*! Metodo che fa un giro completo
+		      \param in file di partenza
+		      \param out file del risultato
+		      \param numNodesMax numero massimo di nodi
+		      \param shift se vero la griglia è spostata di mezzo blocco
+		      \param ultimo se vero i nodi liberi scendono in modo da arrivare a numNodesMax tenendo conto di quelli
+			     bloccati, altrimenti scendono nel rapporto numNodesMax/numNode
+		      \return numero di nodi del risultato, 0 se c'è un errore */
+		  UInt round(string in, string out, UInt numNodesMax, bool shift, bool ultimo);
+
+		  /*! Metodo che legge il file .inp e scrive i file binari dei nodi e dei triangoli
+		      \param in file di partenza
+		      \param numNode numero di nodi
+		      \param numElem numero di triangoli
+		      \param bMin minimo del bounding box
+		      \param bMax massimo del bounding box
+		      \return falso se il file non si apre, è troncato o ha identificatori fuori dai nodi */
+		  bool readInput(string in, UInt & numNode, UInt & numElem, point & bMin, point & bMax);
+
+		  /*! Metodo che crea la griglia dei blocchi
+		      \param numElem numero di triangoli
+		      \param bMin minimo del bounding box
+		      \param bMax massimo del bounding box
+		      \param shift se vero la griglia è spostata di mezzo blocco */
+		  void createGrid(UInt numElem, point bMin, point bMax, bool shift);
+
+		  /*! Metodo che restituisce il blocco di un punto, scendendo nei figli dei blocchi divisi
+		      \param p punto */
+		  UInt getCell(const point & p);
+
+		  /*! Metodo che conta i triangoli di ogni blocco e divide in otto quelli che superano il limite
+		      \param numElem numero di triangoli
+		      \param diviso vero se almeno un blocco è stato diviso, allora i blocchi dei triangoli vanno rifatti
+		      \return falso se il file dei blocchi dei triangoli non si legge */
+		  bool splitBlocks(UInt numElem, bool & diviso);
+
+		  /*! Metodo che mette in cella i blocchi dei nodi con identificatore in [a,b)
+		      \param a primo nodo
+		      \param b ultimo nodo escluso
+		      \param cella vettore dei blocchi
+		      \return falso se il file dei nodi non si legge */
+		  bool cellOfNodes(UInt a, UInt b, vector<UInt> * cella);
+
+		  /*! Metodo che scrive il file con il blocco di ogni triangolo
+		      \param numNode numero di nodi
+		      \param numElem numero di triangoli
+		      \return falso se c'è un errore sui file */
+		  bool createOwners(UInt numNode, UInt numElem);
+
+		  /*! Metodo che scrive il file con le flag dei nodi delle cuciture
+		      \param numNode numero di nodi
+		      \param numElem numero di triangoli
+		      \param numSeam numero di nodi delle cuciture
+		      \return falso se c'è un errore sui file */
+		  bool createSeams(UInt numNode, UInt numElem, UInt & numSeam);
+
+		  /*! Metodo che distribuisce i triangoli nei file dei blocchi
+		      \param numElem numero di triangoli
+		      \param blocchi vettore con i blocchi usati
+		      \return falso se c'è un errore sui file */
+		  bool distribute(UInt numElem, vector<UInt> * blocchi);
+
+		  /*! Metodo che semplifica i blocchi uno alla volta e scrive i nodi liberi e i triangoli del risultato
+		      \param blocchi blocchi usati
+		      \param rapporto rapporto con cui scendono i nodi liberi
+		      \param numFree numero di nodi liberi del risultato
+		      \param numTria numero di triangoli del risultato
+		      \return falso se c'è un errore sui file */
+		  bool simplificateChunks(vector<UInt> * blocchi, Real rapporto, UInt & numFree, UInt & numTria);
+
+		  /*! Metodo che scrive il file .inp del risultato
+		      \param out file del risultato
+		      \param numNode numero di nodi di partenza
+		      \param numSeam numero di nodi delle cuciture
+		      \param numFree numero di nodi liberi del risultato
+		      \param numTria numero di triangoli del risultato
+		      \return falso se c'è un errore sui file */
+		  bool writeOutput(string out, UInt numNode, UInt numSeam, UInt numFree, UInt numTria);
+
+		  /*! Metodo che restituisce il numero di nodi che stanno in memoria in una passata */
+		  UInt getRange();
+
+		  /*! Metodo che restituisce il nome del file di un blocco
+		      \param blocco blocco */
+		  string blockName(UInt blocco);
+
+		  /*! Metodo che scrive il messaggio di errore su un file
+		      \param nome file
+		      \return sempre falso */
+		  bool fileError(string nome);
+
+		  /*! Metodo che cancella i file temporanei di un giro
+		      \param blocchi blocchi i cui file possono essere rimasti */
+		  void cleanUp(vector<UInt> * blocchi);
+};
+
+}
+
+#endif
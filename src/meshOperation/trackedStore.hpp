@@ -0,0 +1,156 @@
+#ifndef TRACKEDSTORE_HPP_
+#define TRACKEDSTORE_HPP_
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+#include "../core/shapes.hpp"
+#include "../core/point.h"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Contenitore dei punti associati ai mementoElement. Ogni associazione è la proiezione di un punto tracciato su un
+    elemento più l'identificatore del punto originale; le coordinate sono salvate per componenti (structure of arrays)
+    e ogni mementoElement conserva solo l'intervallo [start, start+num) delle sue associazioni. Spostare le
+    associazioni da un elemento ad un altro significa quindi copiare degli intervalli di array di Real e UInt. */
+
+class trackedStore
+{
+      //
+      // Variabili contenute nella classe
+      //
+      public:
+		  /*! Coordinate delle proiezioni */
+		  vector<Real>		     X,Y,Z;
+
+		  /*! Identificatori dei punti tracciati */
+		  vector<UInt>			 ids;
+
+      //
+      // Costruttore
+      //
+      public:
+		  /*! Costruttore */
+		  trackedStore() {};
+
+      //
+      // Metodi
+      //
+      public:
+		  /*! Metodo che restituisce il numero di associazioni salvate */
+		  inline UInt size() const
+		  {
+			return(ids.size());
+		  };
+
+		  /*! Metodo che svuota il contenitore senza liberare la memoria */
+		  inline void clear()
+		  {
+			X.clear();	Y.clear();	Z.clear();
+			ids.clear();
+		  };
+
+		  /*! Metodo che riserva la memoria
+		      \param num numero di associazioni */
+		  inline void reserve(UInt num)
+		  {
+			X.reserve(num);	  Y.reserve(num);   Z.reserve(num);
+			ids.reserve(num);
+		  };
+
+		  /*! Metodo che cambia il numero di associazioni, quelle nuove vanno riempite con set
+		      \param num numero di associazioni */
+		  inline void resize(UInt num)
+		  {
+			X.resize(num);	  Y.resize(num);    Z.resize(num);
+			ids.resize(num);
+		  };
+
+		  /*! Metodo che aggiunge un'associazione
+		      \param pt proiezione
+		      \param id identificatore del punto tracciato */
+		  inline void push(const point & pt, UInt id)
+		  {
+			X.push_back(pt.getX());
+			Y.push_back(pt.getY());
+			Z.push_back(pt.getZ());
+			ids.push_back(id);
+		  };
+
+		  /*! Metodo che sovrascrive un'associazione
+		      \param i posizione
+		      \param pt proiezione
+		      \param id identificatore del punto tracciato */
+		  inline void set(UInt i, const point & pt, UInt id)
+		  {
+			assert(i<ids.size());
+			X[i]   = pt.getX();
+			Y[i]   = pt.getY();
+			Z[i]   = pt.getZ();
+			ids[i] = id;
+		  };
+
+		  /*! Metodo che copia un'associazione da un altro contenitore
+		      \param i posizione in questo contenitore
+		      \param other contenitore da cui copiare
+		      \param j posizione in other */
+		  inline void set(UInt i, const trackedStore & other, UInt j)
+		  {
+			assert((i<ids.size()) && (j<other.size()));
+			X[i]   = other.X[j];
+			Y[i]   = other.Y[j];
+			Z[i]   = other.Z[j];
+			ids[i] = other.ids[j];
+		  };
+
+		  /*! Metodo che restituisce la proiezione con l'identificatore del punto tracciato
+		      \param i posizione */
+		  inline point get(UInt i) const
+		  {
+			assert(i<ids.size());
+			point pt(X[i], Y[i], Z[i]);
+			pt.setId(ids[i]);
+			return(pt);
+		  };
+
+		  /*! Metodo che restituisce l'identificatore del punto tracciato
+		      \param i posizione */
+		  inline UInt getId(UInt i) const
+		  {
+			assert(i<ids.size());
+			return(ids[i]);
+		  };
+
+		  /*! Metodo che copia in coda un intervallo di un altro contenitore, restituisce l'inizio del nuovo intervallo
+		      \param other contenitore da cui copiare, deve essere diverso da questo
+		      \param start inizio dell'intervallo
+		      \param num lunghezza dell'intervallo */
+		  inline UInt append(const trackedStore & other, UInt start, UInt num)
+		  {
+			UInt inizio = ids.size();
+			assert(&other!=this);
+			assert(start+num<=other.size());
+
+			X.insert(X.end(), other.X.begin()+start, other.X.begin()+start+num);
+			Y.insert(Y.end(), other.Y.begin()+start, other.Y.begin()+start+num);
+			Z.insert(Z.end(), other.Z.begin()+start, other.Z.begin()+start+num);
+			ids.insert(ids.end(), other.ids.begin()+start, other.ids.begin()+start+num);
+			return(inizio);
+		  };
+
+		  /*! Metodo che scambia il contenuto con un altro contenitore
+		      \param other contenitore */
+		  inline void swap(trackedStore & other)
+		  {
+			X.swap(other.X);	Y.swap(other.Y);	Z.swap(other.Z);
+			ids.swap(other.ids);
+		  };
+};
+
+}
+
+#endif
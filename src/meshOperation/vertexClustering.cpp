@@ -0,0 +1,384 @@
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "vertexClustering.h"
+
+using namespace std;
+using namespace std::chrono;
+using namespace geometry;
+
+//
+// Costruttori
+//
+vertexClustering::vertexClustering()
+{
+      meshPointer = NULL;
+      toll        = 1e-6;
+}
+
+vertexClustering::vertexClustering(mesh2d<Triangle> * _meshPointer)
+{
+      meshPointer = _meshPointer;
+      toll        = 1e-6;
+}
+
+void vertexClustering::setMeshPointer(mesh2d<Triangle> * _meshPointer)
+{
+      meshPointer = _meshPointer;
+}
+
+//
+// Processi di decimazione
+//
+void vertexClustering::simplificate(UInt numNodesMax)
+{
+      // variabili in uso
+      Real		      area,h,hMax;
+      UInt		      num,numMax;
+      vector<Real>	     aree;
+      point		  p1,p2,p3;
+
+      assert(meshPointer!=NULL);
+
+      // controllo, con zero nodi il lato delle celle non è definito 
+      if(numNodesMax==0)
+      {
+	    cout << "ERRORE: il numero di nodi del clustering deve essere almeno 1" << endl;
+	    return;
+      }
+      
+      if(numNodesMax>=meshPointer->getNumNodes())
+      {
+	    cout << "Il numero di nodi della mesh è già minore di " << numNodesMax << endl;
+	    return;
+      }
+
+      // area della superficie, le aree sono sommate in ordine per non dipendere dal numero di thread
+      aree.resize(meshPointer->getNumElements());
+      #pragma omp parallel for private(p1,p2,p3)
+      for(UInt i=0; i<meshPointer->getNumElements(); ++i)
+      {
+	    p1 = meshPointer->getNode(meshPointer->getElement(i).getConnectedId(0));
+	    p2 = meshPointer->getNode(meshPointer->getElement(i).getConnectedId(1));
+	    p3 = meshPointer->getNode(meshPointer->getElement(i).getConnectedId(2));
+	    aree[i] = 0.5*((p2-p1)^(p3-p1)).norm2();
+      }
+      area = 0.0;
+      for(UInt i=0; i<aree.size(); ++i)	area += aree[i];
+
+      // una superficie di area A tocca circa A/h^2 celle, si parte da lì e si corregge h contando le celle. Il
+      // numero di celle cresce come 1/h^2 quindi h va scalato con la radice del rapporto
+      h      = sqrt(max(area, toll)/numNodesMax);
+      hMax   = 0.0;
+      numMax = 0;
+      for(UInt it=0; it<6; ++it)
+      {
+	    num = countCells(h);
+
+	    // tengo il lato più piccolo che non supera il limite
+	    if(num<=numNodesMax && (hMax==0.0 || h<hMax))
+	    {
+		  hMax   = h;
+		  numMax = num;
+	    }
+
+	    // sono abbastanza vicino
+	    if(num<=numNodesMax && num>=0.95*numNodesMax)	break;
+
+	    // correggo stando un po' sotto il limite
+	    h = h*sqrt(static_cast<Real>(num)/(0.97*numNodesMax));
+      }
+
+      // se non ho mai rispettato il limite allargo fino a rispettarlo
+      while(hMax==0.0)
+      {
+	    h   = 1.1*h;
+	    num = countCells(h);
+	    if(num<=numNodesMax)
+	    {
+		  hMax   = h;
+		  numMax = num;
+	    }
+      }
+
+      cout << "Lato delle celle " << hMax << " con " << numMax << " celle occupate" << endl;
+
+      // faccio il clustering
+      simplificateCellSize(hMax);
+}
+
+UInt vertexClustering::countCells(Real h)
+{
+      vector<UInt>	cluster;
+
+      return(createClusters(h, &cluster));
+}
+
+void vertexClustering::simplificateCellSize(Real h)
+{
+      // variabili in uso
+      UInt					 numCluster,numNodeStart,numElem,cont,c;
+      UInt					     id1,id2,id3;
+      unsigned long long				     key;
+      vector<UInt>		      cluster,nodeStart,nodeList,faceStart,faceList;
+      vector<UInt>					   newId;
+      vector<quadric>				  QFaccia,QCluster;
+      vector<point>				   rappr,tmpPt;
+      vector<bool>					   tieni;
+      vector<geoElement<Triangle> >			  tmpTr;
+      vector<pair<array<UInt,3>, UInt> >		      triangoli;
+      unordered_map<unsigned long long, UInt>	       lati;
+      geoElement<Triangle>				     tria;
+      point					      p1,p2,p3,normal;
+      Real							 len;
+
+      assert(meshPointer!=NULL);
+
+      high_resolution_clock::time_point start = high_resolution_clock::now();
+      numNodeStart = meshPointer->getNumNodes();
+      numElem      = meshPointer->getNumElements();
+
+      // cella di ogni nodo
+      numCluster = createClusters(h, &cluster);
+
+      // nodi di ogni cella (compressed sparse row, i nodi di una cella sono in ordine crescente)
+      nodeStart.assign(numCluster+1, 0);
+      for(UInt i=0; i<numNodeStart; ++i)	++nodeStart[cluster[i]+1];
+      for(UInt i=0; i<numCluster; ++i)	nodeStart[i+1] += nodeStart[i];
+      nodeList.resize(numNodeStart);
+      newId.assign(nodeStart.begin(), nodeStart.end()-1);
+      for(UInt i=0; i<numNodeStart; ++i)	nodeList[newId[cluster[i]]++] = i;
+
+      // elementi che toccano ogni cella, un elemento compare una volta per ogni suo nodo nella cella
+      faceStart.assign(numCluster+1, 0);
+      for(UInt i=0; i<numElem; ++i)
+	  for(UInt j=0; j<3; ++j)
+	      ++faceStart[cluster[meshPointer->getElement(i).getConnectedId(j)]+1];
+      for(UInt i=0; i<numCluster; ++i)	faceStart[i+1] += faceStart[i];
+      faceList.resize(3*numElem);
+      newId.assign(faceStart.begin(), faceStart.end()-1);
+      for(UInt i=0; i<numElem; ++i)
+	  for(UInt j=0; j<3; ++j)
+	      faceList[newId[cluster[meshPointer->getElement(i).getConnectedId(j)]]++] = i;
+
+      // quadriche degli elementi pesate con l'area
+      QFaccia.resize(numElem);
+      #pragma omp parallel for private(p1,p2,p3,normal,len)
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    p1 = meshPointer->getNode(meshPointer->getElement(i).getConnectedId(0));
+	    p2 = meshPointer->getNode(meshPointer->getElement(i).getConnectedId(1));
+	    p3 = meshPointer->getNode(meshPointer->getElement(i).getConnectedId(2));
+
+	    normal = (p2-p1)^(p3-p1);
+	    len    = normal.norm2();
+	    if(len>0.0)
+	    {
+		  normal = normal/len;
+		  QFaccia[i] = quadric(normal, -(p1*normal))*(0.5*len);
+	    }
+      }
+
+      // quadriche e nodi rappresentativi delle celle, le somme seguono l'ordine delle liste
+      QCluster.resize(numCluster);
+      rappr.resize(numCluster);
+      #pragma omp parallel for schedule(dynamic, 256) private(p1)
+      for(UInt i=0; i<numCluster; ++i)
+      {
+	    UInt bound = 0;
+
+	    for(UInt j=faceStart[i]; j<faceStart[i+1]; ++j)	QCluster[i] += QFaccia[faceList[j]];
+
+	    p1 = point(0.0, 0.0, 0.0);
+	    for(UInt j=nodeStart[i]; j<nodeStart[i+1]; ++j)
+	    {
+		  p1    = p1 + meshPointer->getNode(nodeList[j]);
+		  bound = max(bound, meshPointer->getNode(nodeList[j]).getBoundary());
+	    }
+	    p1 = p1/static_cast<Real>(nodeStart[i+1]-nodeStart[i]);
+
+	    rappr[i] = getRepresentative(QCluster[i], p1, h);
+	    rappr[i].setBoundary(bound);
+      }
+
+      // triangoli che sopravvivono, hanno i tre nodi in celle diverse
+      triangoli.reserve(numElem);
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    id1 = cluster[meshPointer->getElement(i).getConnectedId(0)];
+	    id2 = cluster[meshPointer->getElement(i).getConnectedId(1)];
+	    id3 = cluster[meshPointer->getElement(i).getConnectedId(2)];
+	    if(id1==id2 || id2==id3 || id1==id3)	continue;
+
+	    triangoli.push_back(make_pair(array<UInt,3>{{id1, id2, id3}}, i));
+	    sort(triangoli.back().first.begin(), triangoli.back().first.end());
+      }
+
+      // tolgo i doppi: fra i triangoli con gli stessi nodi tengo quello che viene prima nella mesh
+      sort(triangoli.begin(), triangoli.end());
+      tieni.assign(numElem, false);
+      for(UInt i=0; i<triangoli.size(); ++i)
+	  if(i==0 || triangoli[i].first!=triangoli[i-1].first)
+	      tieni[triangoli[i].second] = true;
+
+      // tolgo i triangoli che userebbero un lato per la terza volta
+      lati.reserve(3*triangoli.size());
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    if(!tieni[i])	continue;
+
+	    UInt	ids[3];
+	    bool	ok=true;
+	    for(UInt j=0; j<3; ++j)	ids[j] = cluster[meshPointer->getElement(i).getConnectedId(j)];
+
+	    for(UInt j=0; j<3 && ok; ++j)
+	    {
+		  key = (static_cast<unsigned long long>(min(ids[j], ids[(j+1)%3]))<<32) | max(ids[j], ids[(j+1)%3]);
+		  ok  = (lati[key]<2);
+	    }
+
+	    if(!ok)
+	    {
+		  tieni[i] = false;
+		  continue;
+	    }
+
+	    for(UInt j=0; j<3; ++j)
+	    {
+		  key = (static_cast<unsigned long long>(min(ids[j], ids[(j+1)%3]))<<32) | max(ids[j], ids[(j+1)%3]);
+		  ++lati[key];
+	    }
+      }
+
+      // numero i nodi usati nell'ordine delle celle
+      newId.assign(numCluster, numCluster);
+      for(UInt i=0; i<numElem; ++i)
+	  if(tieni[i])
+	      for(UInt j=0; j<3; ++j)
+		  newId[cluster[meshPointer->getElement(i).getConnectedId(j)]] = 0;
+
+      cont = 0;
+      tmpPt.reserve(numCluster);
+      for(UInt i=0; i<numCluster; ++i)
+      {
+	    if(newId[i]==numCluster)	continue;
+
+	    newId[i] = cont;
+	    rappr[i].setId(cont);
+	    tmpPt.push_back(rappr[i]);
+	    ++cont;
+      }
+
+      // creo i triangoli tenendo l'orientazione e il geoId
+      cont = 0;
+      tmpTr.reserve(numElem);
+      for(UInt i=0; i<numElem; ++i)
+      {
+	    if(!tieni[i])	continue;
+
+	    for(UInt j=0; j<3; ++j)
+	    {
+		  c = cluster[meshPointer->getElement(i).getConnectedId(j)];
+		  tria.setConnectedId(j, newId[c]);
+	    }
+	    tria.setGeoId(meshPointer->getElement(i).getGeoId());
+	    tria.setId(cont);
+	    tmpTr.push_back(tria);
+	    ++cont;
+      }
+
+      // libero le liste
+      meshPointer->clear();
+
+      // riempio i nodi e gli elementi
+      meshPointer->insertNode(&tmpPt);
+      meshPointer->insertElement(&tmpTr);
+
+      // metto a posto gli id
+      meshPointer->setUpIds();
+
+      high_resolution_clock::time_point stop = high_resolution_clock::now();
+      auto dif = duration_cast<milliseconds>(stop-start).count();
+      cout << "Il processo è partito da " << numNodeStart << " a " << meshPointer->getNumNodes() << " nodi" << endl;
+      cout << "Processo di clustering completato: " <<  dif << " ms" << endl;
+}
+
+//
+// Metodi interni
+//
+UInt vertexClustering::createClusters(Real & h, vector<UInt> * cluster)
+{
+      // variabili in uso
+      UInt				numCluster;
+      vector<UInt>			   celle;
+      unordered_map<UInt, UInt>	    rinumera;
+
+      // creo la griglia, i rappresentanti devono usare il lato della griglia 
+      h = griglia.buildGridOnly(meshPointer, h);
+
+      // cella di ogni nodo
+      celle.resize(meshPointer->getNumNodes());
+      #pragma omp parallel
+      {
+	    vector<UInt> coor;
+
+	    #pragma omp for
+	    for(UInt i=0; i<meshPointer->getNumNodes(); ++i)
+	    {
+		  griglia.getPointToGridCoor(meshPointer->getNode(i), &coor);
+		  celle[i] = coor[0];
+	    }
+      }
+
+      // numero le celle occupate nell'ordine dei nodi
+      numCluster = 0;
+      cluster->resize(meshPointer->getNumNodes());
+      rinumera.reserve(meshPointer->getNumNodes());
+      for(UInt i=0; i<meshPointer->getNumNodes(); ++i)
+      {
+	    auto ins = rinumera.insert(make_pair(celle[i], numCluster));
+	    if(ins.second)	++numCluster;
+	    cluster->at(i) = ins.first->second;
+      }
+
+      return(numCluster);
+}
+
+point vertexClustering::getRepresentative(const quadric & Q, const point & media, Real h)
+{
+      // variabili in uso
+      Real		a[3][3],b[3],det,scala,x[3];
+      point			   result;
+
+      // sistema A x = -b del minimo di v^T Q v
+      for(UInt i=0; i<3; ++i)
+      {
+	    for(UInt j=0; j<3; ++j)	a[i][j] = Q.getI(i, j);
+	    b[i] = -Q.getI(i, 3);
+      }
+
+      // determinante confrontato con la scala della matrice, se le quadriche sono quasi parallele il minimo non è
+      // definito e uso la media
+      det   = a[0][0]*(a[1][1]*a[2][2]-a[1][2]*a[2][1]) - a[0][1]*(a[1][0]*a[2][2]-a[1][2]*a[2][0]) +
+	      a[0][2]*(a[1][0]*a[2][1]-a[1][1]*a[2][0]);
+      scala = (a[0][0]+a[1][1]+a[2][2])/3.0;
+      if(scala<=0.0 || fabs(det)<=toll*scala*scala*scala)	return(media);
+
+      // regola di Cramer
+      x[0] = (b[0]*(a[1][1]*a[2][2]-a[1][2]*a[2][1]) - a[0][1]*(b[1]*a[2][2]-a[1][2]*b[2]) +
+	      a[0][2]*(b[1]*a[2][1]-a[1][1]*b[2]))/det;
+      x[1] = (a[0][0]*(b[1]*a[2][2]-a[1][2]*b[2]) - b[0]*(a[1][0]*a[2][2]-a[1][2]*a[2][0]) +
+	      a[0][2]*(a[1][0]*b[2]-b[1]*a[2][0]))/det;
+      x[2] = (a[0][0]*(a[1][1]*b[2]-b[1]*a[2][1]) - a[0][1]*(a[1][0]*b[2]-b[1]*a[2][0]) +
+	      b[0]*(a[1][0]*a[2][1]-a[1][1]*a[2][0]))/det;
+      result = point(x[0], x[1], x[2]);
+
+      // il minimo deve stare vicino alla cella, altrimenti la mesh si può ripiegare
+      for(UInt i=0; i<3; ++i)
+	  if(fabs(x[i]-media.getI(i))>h)	return(media);
+
+      return(result);
+}
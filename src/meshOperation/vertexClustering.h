@@ -0,0 +1,113 @@
+#ifndef VERTEXCLUSTERING_H_
+#define VERTEXCLUSTERING_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+
+#include "../core/shapes.hpp"
+#include "../core/point.h"
+#include "../core/quadric.hpp"
+
+#include "../geometry/geoElement.hpp"
+#include "../geometry/mesh2d.hpp"
+#include "../geometry/meshSearchStructured.hpp"
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! Classe che decima una superficie raggruppando i nodi (vertex clustering di Rossignac e Borrel, con i nodi
+    rappresentativi calcolati con le quadriche come in "Out-of-core simplification of large polygonal models" di
+    Lindstrom). I nodi vengono messi nelle celle di una griglia uniforme costruita con meshSearchStructured, ogni cella
+    occupata diventa un nodo posto nel minimo della somma delle quadriche dei triangoli che la toccano e restano solo i
+    triangoli che hanno i tre nodi in celle diverse.
+
+    I passi sono lineari nel numero di nodi e di elementi, a meno dell'ordinamento usato per togliere i triangoli
+    doppi, e i cicli sui nodi, sugli elementi e sulle celle sono fatti in parallelo. La qualità è minore di quella del
+    collasso degli edge, quindi la classe serve come primo stadio per le mesh molto grandi: si scende di 5-10 volte con
+    il clustering e poi si arriva al numero di nodi voluto con simplification2d<Triangle>::simplificateGreedy.
+
+    La mesh prodotta non ha triangoli degeneri o doppi, non ha nodi che non sono usati e ogni lato è condiviso al più
+    da due triangoli. Il risultato non dipende dal numero di thread. */
+
+class vertexClustering
+{
+      //
+      // Variabili di classe
+      //
+      public:
+		  /*! Puntatore alla mesh */
+		  mesh2d<Triangle> *				meshPointer;
+
+		  /*! Griglia usata per numerare le celle */
+		  meshSearchStructured<mesh2d<Triangle>,3>	    griglia;
+
+		  /*! Tolleranza usata per decidere se il sistema delle quadriche è singolare */
+		  Real						       toll;
+      //
+      // Costruttori
+      //
+      public:
+		  /*! Costruttore */
+		  vertexClustering();
+
+		  /*! Costruttore
+		      \param _meshPointer puntatore alla mesh */
+		  vertexClustering(mesh2d<Triangle> * _meshPointer);
+
+		  /*! Metodo che cambia il puntatore della mesh
+		      \param _meshPointer puntatore alla mesh */
+		  void setMeshPointer(mesh2d<Triangle> * _meshPointer);
+
+		  /*! get del puntatore della mesh */
+		  inline mesh2d<Triangle> * getMeshPointer()	{return(meshPointer);};
+
+		  /*! get e set della tolleranza
+		      \param _toll tolleranza */
+		  inline void setToll(Real _toll)		{toll=_toll;};
+		  inline Real getToll()				{return(toll);};
+
+		  /*! get del lato delle celle usato nell'ultimo clustering */
+		  inline Real getCellSize()			{return(griglia.getSpacing().getX());};
+      //
+      // Processi di decimazione
+      //
+      public:
+		  /*! Metodo che sceglie il lato delle celle in modo da avere circa numNodesMax nodi e fa il clustering
+		      \param numNodesMax numero massimo di nodi, almeno 1
+		      N.B. il numero di nodi ottenuto non supera numNodesMax ma può essere un po' più basso */
+		  void simplificate(UInt numNodesMax);
+
+		  /*! Metodo che fa il clustering con celle di lato dato
+		      \param h lato delle celle */
+		  void simplificateCellSize(Real h);
+
+		  /*! Metodo che conta le celle occupate dai nodi con celle di lato dato
+		      \param h lato delle celle */
+		  UInt countCells(Real h);
+      //
+      // Metodi interni
+      //
+      protected:
+		  /*! Metodo che mette in cluster l'identificatore della cella di ogni nodo, le celle sono numerate da 0
+		      nell'ordine in cui vengono trovate scorrendo i nodi. Ritorna il numero di celle occupate
+		      \param h lato delle celle, in uscita quello usato dalla griglia che può essere più grande
+		      \param cluster vettore con la cella di ogni nodo */
+		  UInt createClusters(Real & h, vector<UInt> * cluster);
+
+		  /*! Metodo che calcola il nodo rappresentativo di una cella, il minimo della quadrica se è definito e dista
+		      dalla media dei nodi meno di un lato di cella per ogni coordinata, altrimenti la media
+		      \param Q quadrica della cella
+		      \param media media dei nodi della cella
+		      \param h lato delle celle */
+		  point getRepresentative(const quadric & Q, const point & media, Real h);
+};
+
+}
+
+#endif
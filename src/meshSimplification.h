@@ -3,6 +3,7 @@
 #include "core/insideVolume.h"   
 #include "core/point.h"
 #include "core/graphItem.h"
+#include "core/graphCSR.hpp"
 #include "core/inTetrahedron.h"  
 #include "core/tensor.h"
 #include "core/inSegment.h"       
@@ -11,16 +12,20 @@
 #include "core/insidePolygon.h"   
 #include "core/miniMatrix.h"
 #include "core/bin.hpp"                  
+#include "core/quadric.hpp"
 #include "core/dump.hpp"        
 #include "core/shapes.hpp"
 #include "core/bisection.hpp"            
 #include "core/exceptions.hpp"  
-#include "core/sortList.hpp"
 #include "core/newton.hpp"      
 #include "core/tree.hpp"
 // for the files 
 #include "file/createFile.h"  
 #include "file/downloadMesh.h"
+#include "file/mappedFile.h"
+#include "file/binaryMesh.h"
+#include "file/bufferedWriter.h"
+#include "file/plyFormat.h"
 // for the intersection 
 #include "intersec/intersecHandler.hpp"
 #include "intersec/meshIntersec.hpp"
@@ -43,6 +48,8 @@
 #include "geometry/geoElement.hpp"      
 #include "geometry/geoElementSearch.h"  
 #include "geometry/geoElementSize.hpp"  
+#include "geometry/halfEdge2d.h"
+#include "geometry/localPatch.h"
 #include "geometry/mesh0d.hpp"          
 #include "geometry/mesh1d.hpp"
 #include "geometry/mesh2d.hpp"
@@ -50,6 +57,7 @@
 #include "geometry/mesh3dSebe.hpp"
 #include "geometry/meshSearch.hpp"
 #include "geometry/meshSearchStructured.hpp"
+#include "geometry/meshSearchDynamic.hpp"
 #include "geometry/tricky1d.h"
 #include "geometry/tricky2d.h"
 #include "geometry/tricky3d.h"
@@ -62,6 +70,9 @@
 #include "meshOperation/taubinSmoothing.h"
 #include "meshOperation/mementoElement.hpp"
 #include "meshOperation/meshDataSimplification.h"
+#include "meshOperation/vertexClustering.h"
+#include "meshOperation/simplification2dPatch.h"
+#include "meshOperation/streamSimplification.h"
 // utility functions 
 #include "utility/barCoordinates.h"  
 #include "utility/bin.hpp"           
@@ -75,5 +86,7 @@
 #include "utility/inTriangle.h"
 #include "utility/newton.hpp"
 #include "utility/sortList.hpp"
+#include "utility/heapList.hpp"
+#include "utility/lazyList.hpp"
 #include "utility/tree.hpp"
 #include "utility/triangleMapping.h"
@@ -0,0 +1,502 @@
+#ifndef heapList_HPP_
+#define heapList_HPP_
+
+#include "../core/shapes.hpp"
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <limits>
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! This class implements an indexed d-ary heap with the same interface of the class sortList. It can be used instead
+    of sortList in the collapsing loops: the elements are stored in a contiguous vector indexed by their id and the heap
+    only moves the ids, so every add/change/remove costs O(log n) without any allocation of nodes.
+
+    The class is templated on ELEMENT which must contain
+    <ol>
+    <li> the method "getId()" which gives the identifier of the element;
+    <li> the methods "getGeoSize()" and "setGeoSize()";
+    <li> the operator "<".
+    </ol>
+
+    The ordering is exactly the one defined by the operator "<" of ELEMENT, so findMin returns the same element that
+    sortList would return. Elements that are equivalent for "<" (which sortList cannot hold together) are given in
+    order of id, so the order never depends on the sequence of operations that built the heap. The identifiers are
+    used to index a vector, so they are supposed to be dense (e.g. the ids of the nodes or of the elements of a
+    mesh). */
+
+template<class ELEMENT> class heapList
+{
+      //
+      // Class variables
+      //
+      public:
+		/*! Number of children of each node of the heap */
+		static const UInt arity = 4;
+
+		/*! Value used to mark an id which is not in the heap */
+		static const UInt npos = static_cast<UInt>(-1);
+
+		/*! Vector with the ids in heap order */
+		vector<UInt>			  heap;
+
+		/*! Position in the heap of each id (npos if it is not present) */
+		vector<UInt>			position;
+
+		/*! Elements stored by id */
+		vector<ELEMENT>			elements;
+      //
+      // Constructor and setting
+      //
+      public:
+		/*! Empty constructor */
+		heapList();
+
+		/*! Method that cleans the lists */
+		void clear();
+
+		/*! Method that reserves the memory for the ids up to maxId
+		    \param maxId maximum id that will be stored */
+		void reserve(UInt maxId);
+
+		/*! Method that sets the class variables starting from a list, the heap is built in linear time
+		    \param lista pointer to the list */
+		void setElementVector(vector<ELEMENT> * _lista);
+		void setElementVector(set<ELEMENT>    * _lista);
+      //
+      // Methods to get the minimum and the other elements
+      //
+      public:
+		/*! Method that gives the first */
+		inline UInt findMin();
+
+		/*! Method that gives the k smallest elements in increasing order without changing the heap
+		    \param k number of elements
+		    \param ids vector with the identifiers */
+		void findKMin(UInt k, vector<UInt> * ids);
+
+		/*! Method that gives the k-th median
+		    \param k position */
+		UInt findKMedian(UInt k);
+
+		/*! Method that gives the median */
+		inline UInt findMedian();
+
+		/*! Method that gives the last */
+		UInt findMax();
+
+		/*! Method to check if an element is in the list
+		    \param elemId identifier of the element */
+		inline bool isIn(UInt elemId);
+
+		/*! Method that checks if the list is empty */
+		inline bool isEmpty();
+
+		/*! Number of elements in the list */
+		inline UInt size();
+
+		/*! Method to get an element
+		    \param elemId identifier of the element */
+		inline ELEMENT getElement(UInt elemId);
+
+		/*! Method that gives the geoSize of an element
+		    \param elemId identifier of the element */
+		inline Real getGeoSize(UInt elemId);
+      //
+      // Methods to modify the list
+      //
+      public:
+		/*! Method that changes the geoSize of the element
+		    \param elemId identifier of the element
+		    \param val new value */
+		void change(UInt elemId, Real val);
+
+		/*! Method that adds an element
+		    \param toAdd pointer to an element */
+		inline void add(ELEMENT * toAdd);
+
+		/*! Method that removes an element
+		    \param elemId identifier of the element */
+		void remove(UInt elemId);
+      //
+      // Internal methods of the heap
+      //
+      protected:
+		/*! Comparison between the elements in two positions of the heap */
+		inline bool less(UInt i, UInt j);
+
+		/*! Method that swaps two positions of the heap */
+		inline void swapPositions(UInt i, UInt j);
+
+		/*! Method that moves up the element in position i */
+		void siftUp(UInt i);
+
+		/*! Method that moves down the element in position i */
+		void siftDown(UInt i);
+      //
+      // Print
+      //
+      public:
+		/*! Method that prints the content of the list in order */
+		void print();
+};
+
+//-------------------------------------------------------------------------------------------------------
+// IMPLEMENTATION
+//-------------------------------------------------------------------------------------------------------
+
+template<class ELEMENT> const UInt heapList<ELEMENT>::arity;
+template<class ELEMENT> const UInt heapList<ELEMENT>::npos;
+
+//
+// Constructor and setting
+//
+template<class ELEMENT>
+heapList<ELEMENT>::heapList()
+{
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::clear()
+{
+    // clean the vectors
+    heap.clear();
+    position.clear();
+    elements.clear();
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::reserve(UInt maxId)
+{
+    // the ids are used as indexes
+    if(position.size()<=maxId)
+    {
+	position.resize(maxId+1, npos);
+	elements.resize(maxId+1);
+    }
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::setElementVector(vector<ELEMENT> * _lista)
+{
+    // clean
+    clear();
+
+    // if it is empty print an error
+    if(_lista->size()==0)
+    {
+	cout << "Il vettore che hai passato a heapList è vuoto" << endl;
+	return;
+    }
+
+    // find the maximum id to size the vectors once
+    UInt maxId = 0;
+    for(UInt i=0; i<_lista->size(); ++i)	maxId = max(maxId, _lista->at(i).getId());
+    reserve(maxId);
+
+    // store the elements
+    heap.reserve(_lista->size());
+    for(UInt i=0; i<_lista->size(); ++i)
+    {
+	UInt id = _lista->at(i).getId();
+
+	// same policy of sortList: an id is stored only once
+	if(position[id]!=npos)	continue;
+
+	elements[id] = _lista->at(i);
+	position[id] = heap.size();
+	heap.push_back(id);
+    }
+
+    // build the heap bottom-up
+    if(heap.size()>1)
+	for(UInt i=(heap.size()-2)/arity+1; i>0; --i)	siftDown(i-1);
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::setElementVector(set<ELEMENT> * _lista)
+{
+    // if it is empty print an error
+    if(_lista->size()==0)
+    {
+	cout << "Il set che hai passato a heapList è vuoto" << endl;
+	return;
+    }
+
+    // create a vector
+    vector<ELEMENT>	 tmp(_lista->begin(), _lista->end());
+
+    // call the other method
+    setElementVector(&tmp);
+}
+
+//
+// Methods to get the minimum and the other elements
+//
+template<class ELEMENT>
+inline UInt heapList<ELEMENT>::findMin()
+{
+    return(heap[0]);
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::findKMin(UInt k, vector<UInt> * ids)
+{
+    // variables
+    vector<UInt>	frontier;
+
+    ids->clear();
+    if(heap.size()>0)	frontier.push_back(0);
+
+    // best-first visit: the next smallest element is always a child of one already taken
+    while((ids->size()<k) && (frontier.size()>0))
+    {
+	UInt best = 0;
+	for(UInt i=1; i<frontier.size(); ++i)
+	    if(less(frontier[i], frontier[best]))	best = i;
+
+	UInt pos = frontier[best];
+	frontier[best] = frontier.back();
+	frontier.pop_back();
+	ids->push_back(heap[pos]);
+
+	UInt first = pos*arity+1;
+	UInt end   = min(first+arity, static_cast<UInt>(heap.size()));
+	for(UInt c=first; c<end; ++c)	frontier.push_back(c);
+    }
+}
+
+template<class ELEMENT>
+UInt heapList<ELEMENT>::findKMedian(UInt k)
+{
+    // if k is too high print an error
+    if(k>=heap.size())
+    {
+	cout << "Mi hai dato un k troppo alto" << endl;
+	return(-1);
+    }
+
+    // this is not a frequent operation, select on a copy of the elements
+    vector<ELEMENT> tmp(heap.size());
+    for(UInt i=0; i<heap.size(); ++i)	tmp[i] = elements[heap[i]];
+    nth_element(tmp.begin(), tmp.begin()+k, tmp.end());
+
+    return(tmp[k].getId());
+}
+
+template<class ELEMENT>
+inline UInt heapList<ELEMENT>::findMedian()
+{
+    return(findKMedian(static_cast<UInt>(heap.size()*0.5)));
+}
+
+template<class ELEMENT>
+UInt heapList<ELEMENT>::findMax()
+{
+    // the maximum is one of the leaves
+    UInt first = heap.size()>1 ? (heap.size()-2)/arity+1 : 0;
+    UInt pos   = first;
+    for(UInt i=first+1; i<heap.size(); ++i)
+	if(less(pos, i))	pos = i;
+
+    return(heap[pos]);
+}
+
+template<class ELEMENT>
+inline bool heapList<ELEMENT>::isIn(UInt elemId)
+{
+    return((elemId<position.size()) && (position[elemId]!=npos));
+}
+
+template<class ELEMENT>
+inline bool heapList<ELEMENT>::isEmpty()
+{
+    return(heap.size()==0);
+}
+
+template<class ELEMENT>
+inline UInt heapList<ELEMENT>::size()
+{
+    return(heap.size());
+}
+
+template<class ELEMENT>
+inline Real heapList<ELEMENT>::getGeoSize(UInt elemId)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento non è presente" << endl;
+	return(-1.0);
+    }
+
+    return(elements[elemId].getGeoSize());
+}
+
+template<class ELEMENT>
+inline ELEMENT heapList<ELEMENT>::getElement(UInt elemId)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento non è presente" << endl;
+	return(elements[heap[0]]);
+    }
+
+    return(elements[elemId]);
+}
+
+//
+// Methods to modify the list
+//
+template<class ELEMENT>
+void heapList<ELEMENT>::change(UInt elemId, Real val)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento NON è presente e non può essere cambiato!" << endl;
+	return;
+    }
+
+    // change the value and restore the heap in the right direction
+    Real old = elements[elemId].getGeoSize();
+    elements[elemId].setGeoSize(val);
+
+    if(val<old)		siftUp(position[elemId]);
+    else		siftDown(position[elemId]);
+}
+
+template<class ELEMENT>
+inline void heapList<ELEMENT>::add(ELEMENT * toAdd)
+{
+    UInt id = toAdd->getId();
+
+    // check that the element is not present
+    if(isIn(id))
+    {
+	cout << "L'Elemento è già presente" << endl;
+	return;
+    }
+
+    // store it and put it at the bottom of the heap
+    reserve(id);
+    elements[id] = *toAdd;
+    position[id] = heap.size();
+    heap.push_back(id);
+
+    siftUp(heap.size()-1);
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::remove(UInt elemId)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento NON è presente e non può essere rimosso!" << endl;
+	return;
+    }
+
+    // put the last one in its place
+    UInt pos  = position[elemId];
+    UInt last = heap.size()-1;
+
+    if(pos!=last)	swapPositions(pos, last);
+
+    heap.pop_back();
+    position[elemId] = npos;
+
+    // the moved element can go in both directions
+    if(pos<heap.size())
+    {
+	siftUp(pos);
+	siftDown(pos);
+    }
+}
+
+//
+// Internal methods of the heap
+//
+template<class ELEMENT>
+inline bool heapList<ELEMENT>::less(UInt i, UInt j)
+{
+    // equivalent elements are taken in order of id, so the minimum does not depend on the history of the heap
+    if(elements[heap[i]]<elements[heap[j]])	return(true);
+    if(elements[heap[j]]<elements[heap[i]])	return(false);
+    return(heap[i]<heap[j]);
+}
+
+template<class ELEMENT>
+inline void heapList<ELEMENT>::swapPositions(UInt i, UInt j)
+{
+    std::swap(heap[i], heap[j]);
+    position[heap[i]] = i;
+    position[heap[j]] = j;
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::siftUp(UInt i)
+{
+    while(i>0)
+    {
+	UInt parent = (i-1)/arity;
+
+	if(!less(i, parent))	break;
+
+	swapPositions(i, parent);
+	i = parent;
+    }
+}
+
+template<class ELEMENT>
+void heapList<ELEMENT>::siftDown(UInt i)
+{
+    while(true)
+    {
+	// look for the smallest child
+	UInt first = i*arity+1;
+	if(first>=heap.size())	break;
+
+	UInt best = first;
+	UInt end  = min(first+arity, static_cast<UInt>(heap.size()));
+	for(UInt c=first+1; c<end; ++c)
+	    if(less(c, best))	best = c;
+
+	if(!less(best, i))	break;
+
+	swapPositions(i, best);
+	i = best;
+    }
+}
+
+//
+// Print
+//
+template<class ELEMENT>
+void heapList<ELEMENT>::print()
+{
+    // sort a copy of the elements
+    vector<ELEMENT> tmp(heap.size());
+    for(UInt i=0; i<heap.size(); ++i)	tmp[i] = elements[heap[i]];
+    sort(tmp.begin(), tmp.end());
+
+    // print the content
+    cout << "CONTENUTO" << endl;
+    for(UInt i=0; i<tmp.size(); ++i)
+    {
+	cout << "Posizione: "      << i << "         ";
+	cout << "Identificatore: " << tmp[i].getId() << "         ";
+	cout << "Valore: "         << tmp[i].getGeoSize() << endl;
+    }
+}
+
+}
+
+#endif
@@ -21,6 +21,23 @@ inSegment::inSegment()
       C = new REAL[2];
 }
 
+inSegment::inSegment(const inSegment & E)
+{
+      // setto la tolleranza  
+      toll = E.toll;
+      
+      // ogni oggetto ha le sue variabili 
+      A = new REAL[2];
+      B = new REAL[2];
+      C = new REAL[2];
+}
+
+inSegment & inSegment::operator=(const inSegment & E)
+{
+      toll = E.toll;
+      return(*this);
+}
+
 //
 // Metodi per trovare la posizione del punto
 //
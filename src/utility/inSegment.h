@@ -42,6 +42,14 @@ class inSegment
 	   //
 	   public:
 		  inSegment();
+		  
+		  /*! Costruttore di copia, i vettori per i predicati sono di lavoro e non vengono condivisi 
+		      \param E oggetto da copiare */
+		  inSegment(const inSegment & E);
+		  
+		  /*! Operatore di assegnazione, copia solamente la tolleranza 
+		      \param E oggetto da copiare */
+		  inSegment & operator=(const inSegment & E);
 	   
            //
 	   // Metodi per trovare la posizione del punto
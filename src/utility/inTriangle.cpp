@@ -28,6 +28,23 @@ inTriangle::inTriangle()
       bar.setToll(toll);
 }
 
+inTriangle::inTriangle(const inTriangle & E) : toll(E.toll), inSeg(E.inSeg), bar(E.bar)
+{
+      // ogni oggetto ha le sue variabili 
+      A = new REAL[3];
+      B = new REAL[3];
+      C = new REAL[3];
+      D = new REAL[3];
+}
+
+inTriangle & inTriangle::operator=(const inTriangle & E)
+{
+      toll  = E.toll;
+      inSeg = E.inSeg;
+      bar   = E.bar;
+      return(*this);
+}
+
 //
 // Metodi per trovare la posizione del punto
 //
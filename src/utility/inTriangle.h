@@ -48,6 +48,14 @@ class inTriangle
 	   //
 	   public:
 		  inTriangle();
+		  
+		  /*! Costruttore di copia, i vettori per i predicati sono di lavoro e non vengono condivisi 
+		      \param E oggetto da copiare */
+		  inTriangle(const inTriangle & E);
+		  
+		  /*! Operatore di assegnazione, copia solamente la tolleranza 
+		      \param E oggetto da copiare */
+		  inTriangle & operator=(const inTriangle & E);
 	   
 	   
 	   //
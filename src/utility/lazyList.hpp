@@ -0,0 +1,503 @@
+#ifndef lazyList_HPP_
+#define lazyList_HPP_
+
+#include "../core/shapes.hpp"
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+namespace geometry
+{
+
+using namespace std;
+
+/*! This class implements a priority list with lazy invalidation. It has the same interface of the classes sortList
+    and heapList but the elements are never moved or erased inside the heap: every id carries a version stamp, add and
+    change simply push a new entry with the current version and remove only increases the version. The stale entries
+    are discarded when they reach the top of the heap.
+
+    The heap is a flat vector of small entries (cost, id, version and the sorted ids of the connected nodes), so the
+    ordering is the same of the operator "<" of geoElementSize: first the size and then the connected ids. The id
+    breaks the remaining ties as in heapList.
+
+    When the stale entries become more than the live ones the heap is rebuilt, so the memory stays proportional to
+    the number of elements in the list.
+
+    The class is templated on ELEMENT which must contain
+    <ol>
+    <li> the method "getId()" which gives the identifier of the element;
+    <li> the methods "getGeoSize()", "setGeoSize()" and "getConnectedId()";
+    <li> the static variable "numVertex" with the number of connected ids.
+    </ol>
+*/
+
+template<class ELEMENT> class lazyList
+{
+      //
+      // Entry of the heap
+      //
+      public:
+		/*! Entry stored in the heap */
+		struct entry
+		{
+		    /*! Cost of the element when it was pushed */
+		    Real size;
+
+		    /*! Identifier of the element */
+		    UInt id;
+
+		    /*! Version of the element when it was pushed */
+		    UInt version;
+
+		    /*! Sorted connected ids used to break the ties */
+		    UInt key[ELEMENT::numVertex];
+		};
+
+		/*! Comparison used by the heap algorithms (the top is the minimum) */
+		struct greater
+		{
+		    bool operator()(const entry & a, const entry & b) const
+		    {
+			if(a.size!=b.size)	return(a.size>b.size);
+			for(UInt i=0; i<ELEMENT::numVertex; ++i)
+			    if(a.key[i]!=b.key[i])	return(a.key[i]>b.key[i]);
+			return(a.id>b.id);
+		    }
+		};
+      //
+      // Class variables
+      //
+      public:
+		/*! Flat heap with the entries, it also contains the stale ones */
+		vector<entry>			heap;
+
+		/*! Actual version of each id */
+		vector<UInt>		     version;
+
+		/*! Flag that says if an id is in the list */
+		vector<bool>		     present;
+
+		/*! Last element stored for each id */
+		vector<ELEMENT>		    elements;
+
+		/*! Number of ids in the list */
+		UInt			     numLive;
+      //
+      // Constructor and setting
+      //
+      public:
+		/*! Empty constructor */
+		lazyList();
+
+		/*! Method that cleans the lists */
+		void clear();
+
+		/*! Method that reserves the memory for the ids up to maxId
+		    \param maxId maximum id that will be stored */
+		void reserve(UInt maxId);
+
+		/*! Method that sets the class variables starting from a list
+		    \param lista pointer to the list */
+		void setElementVector(vector<ELEMENT> * _lista);
+		void setElementVector(set<ELEMENT>    * _lista);
+      //
+      // Methods to get the minimum and the other elements
+      //
+      public:
+		/*! Method that gives the first */
+		inline UInt findMin();
+
+		/*! Method that gives the k-th median
+		    \param k position */
+		UInt findKMedian(UInt k);
+
+		/*! Method that gives the median */
+		inline UInt findMedian();
+
+		/*! Method that gives the last */
+		UInt findMax();
+
+		/*! Method to check if an element is in the list
+		    \param elemId identifier of the element */
+		inline bool isIn(UInt elemId);
+
+		/*! Method that checks if the list is empty */
+		inline bool isEmpty();
+
+		/*! Number of elements in the list */
+		inline UInt size();
+
+		/*! Method to get an element
+		    \param elemId identifier of the element */
+		inline ELEMENT getElement(UInt elemId);
+
+		/*! Method that gives the geoSize of an element
+		    \param elemId identifier of the element */
+		inline Real getGeoSize(UInt elemId);
+      //
+      // Methods to modify the list
+      //
+      public:
+		/*! Method that changes the geoSize of the element, the old entry becomes stale
+		    \param elemId identifier of the element
+		    \param val new value */
+		void change(UInt elemId, Real val);
+
+		/*! Method that adds an element
+		    \param toAdd pointer to an element */
+		inline void add(ELEMENT * toAdd);
+
+		/*! Method that removes an element, its entries become stale
+		    \param elemId identifier of the element */
+		void remove(UInt elemId);
+      //
+      // Internal methods
+      //
+      protected:
+		/*! Method that pushes the actual version of an element */
+		void push(UInt elemId);
+
+		/*! Method that checks if an entry is the actual version of its element */
+		inline bool isValid(const entry & e);
+
+		/*! Method that discards the stale entries on the top of the heap */
+		void purgeTop();
+
+		/*! Method that rebuilds the heap with only the valid entries */
+		void compact();
+
+		/*! Method that fills a vector with the elements in the list sorted */
+		void getSortedElements(vector<ELEMENT> * tmp);
+      //
+      // Print
+      //
+      public:
+		/*! Method that prints the content of the list in order */
+		void print();
+};
+
+//-------------------------------------------------------------------------------------------------------
+// IMPLEMENTATION
+//-------------------------------------------------------------------------------------------------------
+
+//
+// Constructor and setting
+//
+template<class ELEMENT>
+lazyList<ELEMENT>::lazyList()
+{
+    numLive = 0;
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::clear()
+{
+    // clean the vectors
+    heap.clear();
+    version.clear();
+    present.clear();
+    elements.clear();
+    numLive = 0;
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::reserve(UInt maxId)
+{
+    // the ids are used as indexes
+    if(version.size()<=maxId)
+    {
+	version.resize(maxId+1, 0);
+	present.resize(maxId+1, false);
+	elements.resize(maxId+1);
+    }
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::setElementVector(vector<ELEMENT> * _lista)
+{
+    // clean
+    clear();
+
+    // if it is empty print an error
+    if(_lista->size()==0)
+    {
+	cout << "Il vettore che hai passato a lazyList è vuoto" << endl;
+	return;
+    }
+
+    // find the maximum id to size the vectors once
+    UInt maxId = 0;
+    for(UInt i=0; i<_lista->size(); ++i)	maxId = max(maxId, _lista->at(i).getId());
+    reserve(maxId);
+
+    // store the elements
+    heap.reserve(2*_lista->size());
+    for(UInt i=0; i<_lista->size(); ++i)
+    {
+	UInt id = _lista->at(i).getId();
+
+	// same policy of sortList: an id is stored only once
+	if(present[id])		continue;
+
+	elements[id] = _lista->at(i);
+	present[id]  = true;
+	++numLive;
+
+	push(id);
+    }
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::setElementVector(set<ELEMENT> * _lista)
+{
+    // if it is empty print an error
+    if(_lista->size()==0)
+    {
+	cout << "Il set che hai passato a lazyList è vuoto" << endl;
+	return;
+    }
+
+    // create a vector
+    vector<ELEMENT>	 tmp(_lista->begin(), _lista->end());
+
+    // call the other method
+    setElementVector(&tmp);
+}
+
+//
+// Methods to get the minimum and the other elements
+//
+template<class ELEMENT>
+inline UInt lazyList<ELEMENT>::findMin()
+{
+    purgeTop();
+    return(heap[0].id);
+}
+
+template<class ELEMENT>
+UInt lazyList<ELEMENT>::findKMedian(UInt k)
+{
+    // if k is too high print an error
+    if(k>=numLive)
+    {
+	cout << "Mi hai dato un k troppo alto" << endl;
+	return(-1);
+    }
+
+    // this is not a frequent operation
+    vector<ELEMENT> tmp;
+    getSortedElements(&tmp);
+
+    return(tmp[k].getId());
+}
+
+template<class ELEMENT>
+inline UInt lazyList<ELEMENT>::findMedian()
+{
+    return(findKMedian(static_cast<UInt>(numLive*0.5)));
+}
+
+template<class ELEMENT>
+UInt lazyList<ELEMENT>::findMax()
+{
+    // look for the maximum among the valid entries
+    typename lazyList<ELEMENT>::greater comp;
+    UInt pos = heap.size();
+    for(UInt i=0; i<heap.size(); ++i)
+	if(isValid(heap[i]) && ((pos==heap.size()) || comp(heap[i], heap[pos])))	pos = i;
+
+    return(heap[pos].id);
+}
+
+template<class ELEMENT>
+inline bool lazyList<ELEMENT>::isIn(UInt elemId)
+{
+    return((elemId<present.size()) && present[elemId]);
+}
+
+template<class ELEMENT>
+inline bool lazyList<ELEMENT>::isEmpty()
+{
+    return(numLive==0);
+}
+
+template<class ELEMENT>
+inline UInt lazyList<ELEMENT>::size()
+{
+    return(numLive);
+}
+
+template<class ELEMENT>
+inline Real lazyList<ELEMENT>::getGeoSize(UInt elemId)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento non è presente" << endl;
+	return(-1.0);
+    }
+
+    return(elements[elemId].getGeoSize());
+}
+
+template<class ELEMENT>
+inline ELEMENT lazyList<ELEMENT>::getElement(UInt elemId)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento non è presente" << endl;
+	return(elements[findMin()]);
+    }
+
+    return(elements[elemId]);
+}
+
+//
+// Methods to modify the list
+//
+template<class ELEMENT>
+void lazyList<ELEMENT>::change(UInt elemId, Real val)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento NON è presente e non può essere cambiato!" << endl;
+	return;
+    }
+
+    // the old entry becomes stale
+    elements[elemId].setGeoSize(val);
+    ++version[elemId];
+    push(elemId);
+}
+
+template<class ELEMENT>
+inline void lazyList<ELEMENT>::add(ELEMENT * toAdd)
+{
+    UInt id = toAdd->getId();
+
+    // check that the element is not present
+    if(isIn(id))
+    {
+	cout << "L'Elemento è già presente" << endl;
+	return;
+    }
+
+    // store it with a new version
+    reserve(id);
+    elements[id] = *toAdd;
+    present[id]  = true;
+    ++version[id];
+    ++numLive;
+
+    push(id);
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::remove(UInt elemId)
+{
+    // check that the element is present
+    if(!isIn(elemId))
+    {
+	cout << "L'Elemento NON è presente e non può essere rimosso!" << endl;
+	return;
+    }
+
+    // all its entries become stale
+    present[elemId] = false;
+    ++version[elemId];
+    --numLive;
+
+    // if the heap is mostly made of stale entries it is rebuilt
+    if(heap.size()>2*numLive+64)	compact();
+}
+
+//
+// Internal methods
+//
+template<class ELEMENT>
+void lazyList<ELEMENT>::push(UInt elemId)
+{
+    // variables
+    entry e;
+
+    // fill the entry
+    e.size    = elements[elemId].getGeoSize();
+    e.id      = elemId;
+    e.version = version[elemId];
+    for(UInt i=0; i<ELEMENT::numVertex; ++i)	e.key[i] = elements[elemId].getConnectedId(i);
+    sort(e.key, e.key+ELEMENT::numVertex);
+
+    // put it in the heap
+    heap.push_back(e);
+    push_heap(heap.begin(), heap.end(), greater());
+
+    // the changes leave stale entries too
+    if(heap.size()>2*numLive+64)	compact();
+}
+
+template<class ELEMENT>
+inline bool lazyList<ELEMENT>::isValid(const entry & e)
+{
+    return(present[e.id] && (version[e.id]==e.version));
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::purgeTop()
+{
+    while(!heap.empty() && !isValid(heap.front()))
+    {
+	pop_heap(heap.begin(), heap.end(), greater());
+	heap.pop_back();
+    }
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::compact()
+{
+    // keep only the valid entries
+    UInt cont = 0;
+    for(UInt i=0; i<heap.size(); ++i)
+	if(isValid(heap[i]))	heap[cont++] = heap[i];
+    heap.resize(cont);
+
+    // rebuild the heap
+    make_heap(heap.begin(), heap.end(), greater());
+}
+
+template<class ELEMENT>
+void lazyList<ELEMENT>::getSortedElements(vector<ELEMENT> * tmp)
+{
+    tmp->clear();
+    tmp->reserve(numLive);
+    for(UInt i=0; i<present.size(); ++i)
+	if(present[i])	tmp->push_back(elements[i]);
+    sort(tmp->begin(), tmp->end());
+}
+
+//
+// Print
+//
+template<class ELEMENT>
+void lazyList<ELEMENT>::print()
+{
+    // sort the elements
+    vector<ELEMENT> tmp;
+    getSortedElements(&tmp);
+
+    // print the content
+    cout << "CONTENUTO" << endl;
+    for(UInt i=0; i<tmp.size(); ++i)
+    {
+	cout << "Posizione: "      << i << "         ";
+	cout << "Identificatore: " << tmp[i].getId() << "         ";
+	cout << "Valore: "         << tmp[i].getGeoSize() << endl;
+    }
+}
+
+}
+
+#endif
@@ -60,6 +60,11 @@ template<class ELEMENT> class sortList
 		/*! Trovo il primo */
 		inline UInt findMin();
 		
+		/*! Metodo che ritorna i primi k elementi in ordine 
+		    \param k numero di elementi 
+		    \param ids vettore con gli identificatori */
+		void findKMin(UInt k, vector<UInt> * ids);
+		
 		/*! Metodo che ritorna la mediana k-esima
 		    \param k posizione */
 		UInt findKMedian(UInt k);
@@ -178,6 +183,17 @@ inline UInt sortList<ELEMENT>::findMin()
     return(lista.begin()->getId());
 }
 
+template<class ELEMENT>
+void sortList<ELEMENT>::findKMin(UInt k, vector<UInt> * ids)
+{
+    // variabili 
+    typename set<ELEMENT>::iterator it=lista.begin();
+    
+    // prendo i primi k 
+    ids->clear();
+    for(; (it!=lista.end()) && (ids->size()<k); ++it)	ids->push_back(it->getId());
+}
+
 template<class ELEMENT>
 UInt sortList<ELEMENT>::findKMedian(UInt k)
 {
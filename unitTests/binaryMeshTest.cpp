@@ -0,0 +1,232 @@
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+using namespace std::chrono;
+
+// controlla che due mesh abbiano gli stessi bit
+template<typename MESH> bool same(MESH & a, MESH & b)
+{
+    if(a.getNumNodes()!=b.getNumNodes() || a.getNumElements()!=b.getNumElements())
+    {
+        cout << "Different sizes" << endl;
+        return(false);
+    }
+
+    for(UInt i=0; i<a.getNumNodes(); ++i)
+        for(UInt j=0; j<3; ++j)
+            if(a.getNode(i).getI(j)!=b.getNode(i).getI(j) || b.getNode(i).getId()!=i)
+            {
+                cout << "The node " << i << " is different" << endl;
+                return(false);
+            }
+
+    for(UInt i=0; i<a.getNumElements(); ++i)
+    {
+        if(a.getElement(i).getGeoId()!=b.getElement(i).getGeoId() || b.getElement(i).getId()!=i)
+        {
+            cout << "The element " << i << " is different" << endl;
+            return(false);
+        }
+        for(UInt j=0; j<a.getElement(i).getNumConnected(); ++j)
+            if(a.getElement(i).getConnectedId(j)!=b.getElement(i).getConnectedId(j))
+            {
+                cout << "The element " << i << " is different" << endl;
+                return(false);
+            }
+    }
+
+    return(true);
+}
+
+// scrive un file fatto da un'intestazione e da n byte a zero, se n non è dato la dimensione è quella calcolata da
+// layout come se l'intestazione fosse valida
+void header(string nome, binaryMeshHeader h, size_t n=numeric_limits<size_t>::max())
+{
+    size_t pos[5];
+
+    binaryMesh::layout(h, pos);
+    if(n==numeric_limits<size_t>::max())	n = pos[4]-sizeof(h);
+
+    ofstream out(nome.c_str(), ios::binary);
+    out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+    out << string(n, '\0');
+}
+
+// scrive e legge i file binari dei tre tipi di mesh, controlla i blocchi dati da binaryMesh e che i file sbagliati
+// lascino la mesh vuota
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf,back;
+    mesh1d<Line>		lines,linesBack;
+    mesh3d<Tetra>		vol,volBack;
+    downloadMesh		down;
+    createFile			file;
+    vector<vector<Real> >	prop(2),propBack;
+    binaryMesh			bin;
+
+    if(!loadMesh("../mesh/brain.inp", &surf))	return(1);
+    for(UInt i=0; i<surf.getNumNodes(); ++i)
+    {
+        prop[0].push_back(surf.getNode(i).getX()/3.0);
+        prop[1].push_back(i);
+    }
+
+    // triangoli con le proprietà, i tempi sono presi leggendo in una mesh che ha già i vettori
+    back = surf;
+    high_resolution_clock::time_point t0 = high_resolution_clock::now();
+    file.fileForBinary("binaryMeshTest.msh", &surf, &prop);
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    down.fileFromBinary("binaryMeshTest.msh", &back, &propBack);
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+    file.fileForParaview("binaryMeshTest.inp", &surf);
+    high_resolution_clock::time_point t3 = high_resolution_clock::now();
+    down.fileFromParaview("binaryMeshTest.inp", &back);
+    high_resolution_clock::time_point t4 = high_resolution_clock::now();
+    down.fileFromBinary("binaryMeshTest.msh", &back, &propBack);
+
+    cout << "Binary: write " << duration_cast<milliseconds>(t1-t0).count() << " ms, read ";
+    cout << duration_cast<milliseconds>(t2-t1).count() << " ms" << endl;
+    cout << "Paraview: write " << duration_cast<milliseconds>(t3-t2).count() << " ms, read ";
+    cout << duration_cast<milliseconds>(t4-t3).count() << " ms" << endl;
+
+    if(!same(surf, back))	return(1);
+    if(propBack!=prop)
+    {
+        cout << "Different properties" << endl;
+        return(1);
+    }
+
+    // i blocchi del file senza copie
+    if(!bin.open("binaryMeshTest.msh"))	return(1);
+    if(bin.getNumNodes()!=surf.getNumNodes() || bin.getNumElements()!=surf.getNumElements() ||
+       bin.getNumVertices()!=3 || bin.getNumProperties()!=2)
+    {
+        cout << "Wrong header" << endl;
+        return(1);
+    }
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+        for(UInt j=0; j<3; ++j)
+            if(bin.getConnectivity()[3*i+j]!=surf.getElement(i).getConnectedId(j))
+            {
+                cout << "Wrong connectivity block" << endl;
+                return(1);
+            }
+    if(bin.getNodes()[3*7+2]!=surf.getNode(7).getZ() || bin.getProperty(1)[11]!=11.0)
+    {
+        cout << "Wrong node blocks" << endl;
+        return(1);
+    }
+    bin.close();
+
+    // linee e tetraedri
+    geoElement<Line>	lin;
+    geoElement<Tetra>	tet;
+    for(UInt i=0; i<5; ++i)
+    {
+        lines.insertNode(point(i, 0.1*i, -1.0/(i+1)));
+        vol.insertNode(point(i%2, i/2, 1.0/3.0*i));
+    }
+    for(UInt i=0; i<4; ++i)
+    {
+        lin.setConnectedId(0, i);	lin.setConnectedId(1, i+1);	lin.setGeoId(i);
+        lines.insertElement(lin);
+    }
+    for(UInt i=0; i<2; ++i)
+    {
+        for(UInt j=0; j<4; ++j)	tet.setConnectedId(j, i+j);
+        tet.setGeoId(10+i);
+        vol.insertElement(tet);
+    }
+    lines.setUpIds();
+    vol.setUpIds();
+
+    file.fileForBinary("binaryMeshLines.msh", &lines);
+    file.fileForBinary("binaryMeshVolume.msh", &vol);
+    down.fileFromBinary("binaryMeshLines.msh", &linesBack);
+    down.fileFromBinary("binaryMeshVolume.msh", &volBack);
+    if(!same(lines, linesBack) || !same(vol, volBack))	return(1);
+
+    // un file di tetraedri non si legge come triangoli e un file troncato non è valido
+    down.fileFromBinary("binaryMeshVolume.msh", &back);
+    if(back.getNumNodes()!=0)
+    {
+        cout << "Tetrahedra read as triangles" << endl;
+        return(1);
+    }
+
+    ifstream in("binaryMeshLines.msh", ios::binary);
+    string content((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    ofstream out("binaryMeshShort.msh", ios::binary);
+    out.write(content.c_str(), content.size()-4);
+    out.close();
+
+    down.fileFromBinary("binaryMeshShort.msh", &linesBack);
+    if(linesBack.getNumNodes()!=0)
+    {
+        cout << "A truncated file is read" << endl;
+        return(1);
+    }
+
+    // una linea che punta a un nodo che non esiste
+    mesh1d<Line> badLines = lines;
+    badLines.getElementPointer(3)->setConnectedId(1, 99);
+    file.fileForBinary("binaryMeshBad.msh", &badLines);
+
+    down.fileFromBinary("binaryMeshBad.msh", &linesBack);
+    if(linesBack.getNumNodes()!=0 || linesBack.getNumElements()!=0)
+    {
+        cout << "A file with a node id out of range is read" << endl;
+        return(1);
+    }
+
+    // intestazioni con numeri fuori dai limiti: con 2^61 nodi 3*8*numNode va in overflow a 0 e un file fatto dalla
+    // sola intestazione avrebbe la dimensione giusta
+    binaryMeshHeader h = binaryMesh::createHeader(3, 0, 0, 0);
+    h.numNode = static_cast<uint64_t>(1) << 61;
+    header("binaryMeshWrap.msh", h);
+
+    // più di 4 nodi per elemento, con la dimensione che corrisponde all'intestazione
+    binaryMeshHeader vertici = binaryMesh::createHeader(5, 0, 1, 1);
+    header("binaryMeshVertex.msh", vertici);
+
+    // nessun nodo per elemento
+    binaryMeshHeader zero = binaryMesh::createHeader(0, 0, 1, 1);
+    header("binaryMeshZero.msh", zero);
+
+    // quattro miliardi di proprietà senza nodi, prima si allocavano i vettori delle proprietà
+    binaryMeshHeader proprieta = binaryMesh::createHeader(3, 4000000000u, 0, 0);
+    header("binaryMeshProp.msh", proprieta);
+
+    // più di numeric_limits<UInt>::max() elementi, il file sarebbe di 32 GB e si scrive solo l'intestazione
+    binaryMeshHeader elementi = binaryMesh::createHeader(1, 0, 0, 0);
+    elementi.numElem = static_cast<uint64_t>(numeric_limits<UInt>::max())+1;
+    header("binaryMeshElem.msh", elementi, 0);
+
+    const char * sbagliati[] = {"binaryMeshWrap.msh", "binaryMeshVertex.msh", "binaryMeshZero.msh",
+                                "binaryMeshProp.msh", "binaryMeshElem.msh"};
+    for(UInt k=0; k<5; ++k)
+    {
+        if(bin.open(sbagliati[k]))
+        {
+            cout << "The header of " << sbagliati[k] << " is accepted" << endl;
+            return(1);
+        }
+
+        back = surf;
+        down.fileFromBinary(sbagliati[k], &back, &propBack);
+        if(back.getNumNodes()!=0 || back.getNumElements()!=0)
+        {
+            cout << "The mesh of " << sbagliati[k] << " is not empty" << endl;
+            return(1);
+        }
+    }
+
+    cout << "binary mesh test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,103 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+using namespace std::chrono;
+
+// legge tutto il file
+string content(string s)
+{
+    ifstream in(s.c_str(), ios::binary);
+    return(string((istreambuf_iterator<char>(in)), istreambuf_iterator<char>()));
+}
+
+// controlla la scrittura dei reali, i file scritti con più thread e che i file siano riletti esattamente
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf,back;
+    downloadMesh		down;
+    createFile			file;
+    vector<Real>		prop,propBack,values;
+    mt19937_64			gen(7);
+
+    // i reali sono riletti esattamente e non hanno più cifre del necessario
+    values.push_back(0.1);
+    values.push_back(1.0/3.0);
+    values.push_back(-0.0);
+    values.push_back(1e300);
+    values.push_back(5e-324);
+    values.push_back(-123456.0);
+    values.push_back(1099511627776.0);
+    values.push_back(numeric_limits<Real>::max());
+    for(UInt i=0; i<100000; ++i)
+    {
+        uint64_t bits = gen();
+        Real v;
+        memcpy(&v, &bits, sizeof(v));
+        if(v==v && fabs(v)<=numeric_limits<Real>::max())	values.push_back(v);
+        values.push_back(static_cast<Real>(gen()%1000000)/1000.0);
+    }
+
+    for(UInt i=0; i<values.size(); ++i)
+    {
+        string buf;
+        char tmp[32];
+        bufferedWriter::appendReal(buf, values[i]);
+
+        if(strtod(buf.c_str(), NULL)!=values[i] || signbit(strtod(buf.c_str(), NULL))!=signbit(values[i]))
+        {
+            cout << "The real " << buf << " is not read back exactly" << endl;
+            return(1);
+        }
+        snprintf(tmp, sizeof(tmp), "%.15g", values[i]);
+        if(strtod(tmp, NULL)==values[i] && buf!=tmp)
+        {
+            cout << "The real " << buf << " has more digits than " << tmp << endl;
+            return(1);
+        }
+    }
+
+    // gli stessi file con uno e quattro thread
+    if(!loadMesh("../mesh/brain.inp", &surf))
+        return(1);
+    for(UInt i=0; i<surf.getNumNodes(); ++i)	prop.push_back(surf.getNode(i).norm2()/7.0);
+
+    high_resolution_clock::time_point start = high_resolution_clock::now();
+    file.setNumThreads(1);
+    file.fileForParaview("bufferedWriterOne.inp", &surf);
+    high_resolution_clock::time_point stop = high_resolution_clock::now();
+    file.setNumThreads(4);
+    file.fileForParaview("bufferedWriterMany.inp", &surf);
+    cout << "Paraview file written in " << duration_cast<milliseconds>(stop-start).count() << " ms" << endl;
+
+    if(content("bufferedWriterOne.inp")!=content("bufferedWriterMany.inp"))
+    {
+        cout << "Different files with 1 and 4 threads" << endl;
+        return(1);
+    }
+
+    // la mesh e la proprietà sono rilette esattamente
+    file.fileForParaviewNodePropriety("bufferedWriterProp.inp", &surf, &prop);
+    if(!loadMesh("bufferedWriterOne.inp", &back) || !sameMesh(surf, back, "bufferedWriter"))
+        return(1);
+
+    down.fileFromParaviewNodePropriety("bufferedWriterProp.inp", &back, &propBack);
+    if(propBack!=prop)
+    {
+        cout << "The property is not read back exactly" << endl;
+        return(1);
+    }
+
+    cout << "buffered writer test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,205 @@
+#include <iostream>
+#include <set>
+#include <map>
+#include <algorithm>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// associazioni di un elemento come coppie id del punto tracciato e proiezione
+vector<pair<UInt, point> > associazioni(mementoElement<Triangle> & elem)
+{
+    vector<pair<UInt, point> > ass;
+
+    for(UInt k=0; k<elem.ptAssSize(); ++k)
+        ass.push_back(make_pair(elem.getPtAssId(k), elem.getPtAss(k)));
+
+    return(ass);
+}
+
+// controlla che due liste di associazioni abbiano gli stessi id e le stesse coordinate
+bool sameAss(vector<pair<UInt, point> > & a, vector<pair<UInt, point> > & b)
+{
+    if(a.size()!=b.size())	return(false);
+
+    for(UInt k=0; k<a.size(); ++k)
+    {
+        if(a[k].first!=b[k].first)	return(false);
+        for(UInt c=0; c<3; ++c)
+            if(a[k].second.getI(c)!=b[k].second.getI(c))	return(false);
+    }
+
+    return(true);
+}
+
+// controlla se l'elemento ha il punto tracciato tra i suoi associati
+bool hasAss(mementoElement<Triangle> & elem, UInt id)
+{
+    for(UInt k=0; k<elem.ptAssSize(); ++k)
+        if(elem.getPtAssId(k)==id)	return(true);
+
+    return(false);
+}
+
+// controlla se l'elemento ha entrambi gli estremi dell'edge
+bool isOnEdge(vector<UInt> conn, vector<UInt> & edge)
+{
+    return(find(conn.begin(), conn.end(), edge[0])!=conn.end() && find(conn.begin(), conn.end(), edge[1])!=conn.end());
+}
+
+// segue i collassi di meshDataSimplification e controlla le associazioni dei mementoElement prima e dopo changeMemento,
+// anche contro la ricerca esaustiva dell'elemento più vicino
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>				surf;
+    vector<UInt>				edge,toAdd,elem,ass;
+    vector<mementoElement<Triangle> >		newMem;
+    vector<vector<pair<UInt, point> > >		prima;
+    set<UInt>					idPrima,idDopo;
+    map<UInt, point>				vecchi;
+    point					p;
+    UInt					numColl=0;
+
+    if(!loadMesh("../mesh/cow_580.inp", &surf))
+        return(1);
+
+    meshDataSimplification<Triangle> simp;
+    simp.setDynamicFinder(true);
+    simp.setMeshPointer(&surf);
+    simp.setPointToTrack(surf.getNodePointer());
+    simp.upDateMeanAssValue();
+    simp.createElementList();
+
+    // all'inizio ogni elemento ha associati i suoi vertici
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+        if(simp.mem[i].ptAssSize()!=3)
+        {
+            cout << "The element " << i << " has not its three vertices" << endl;
+            return(1);
+        }
+
+    // collassi uno alla volta come in simplificate con un candidato
+    while(numColl<200)
+    {
+        if(simp.sortedList.isEmpty())	break;
+        p = simp.getEdgeToSimplificate(&edge);
+
+        // punti tracciati dagli elementi attorno all'edge prima del collasso
+        elem.clear();
+        for(UInt s=0; s<2; ++s)
+            for(UInt j=0; j<simp.conn.getNodeToElementPointer(edge[s])->getNumConnected(); ++j)
+                elem.push_back(simp.conn.getNodeToElementPointer(edge[s])->getConnectedId(j));
+        sort(elem.begin(), elem.end());
+        elem.erase(unique(elem.begin(), elem.end()), elem.end());
+
+        idPrima.clear();
+        for(UInt i=0; i<elem.size(); ++i)
+            for(UInt k=0; k<simp.mem[elem[i]].ptAssSize(); ++k)
+                idPrima.insert(simp.mem[elem[i]].getPtAssId(k));
+
+        // proiezioni da associare prese nello stesso ordine di changeMemento: prima gli elementi che restano e poi
+        // i due sull'edge, di ogni punto si tiene la prima
+        vecchi.clear();
+        for(UInt giro=0; giro<2; ++giro)
+            for(UInt i=0; i<elem.size(); ++i)
+            {
+                if(isOnEdge(surf.getElement(elem[i]).getConnectedIds(), edge)!=(giro==1))	continue;
+
+                for(UInt k=0; k<simp.mem[elem[i]].ptAssSize(); ++k)
+                    vecchi.insert(make_pair(simp.mem[elem[i]].getPtAssId(k), simp.mem[elem[i]].getPtAss(k)));
+            }
+
+        simp.Q.push_back(simp.createQ(&edge));
+        simp.changeMemento(&edge, p, &newMem);
+        if(newMem.empty())
+        {
+            cout << "changeMemento does not associate the points of the collapse " << numColl << endl;
+            return(1);
+        }
+
+        // gli stessi punti tracciati, nessuno perso e nessuno aggiunto
+        idDopo.clear();
+        prima.clear();
+        for(UInt i=0; i<newMem.size(); ++i)
+        {
+            prima.push_back(associazioni(newMem[i]));
+            for(UInt k=0; k<newMem[i].ptAssSize(); ++k)
+                idDopo.insert(newMem[i].getPtAssId(k));
+        }
+        if(idPrima!=idDopo)
+        {
+            cout << "changeMemento changes the tracked points of the collapse " << numColl << endl;
+            return(1);
+        }
+
+        // riferimento senza la potatura con i box: ogni punto è provato su tutti gli elementi e va al più vicino,
+        // a parità di distanza al primo, l'elemento scelto deve averlo tra i suoi associati
+        for(map<UInt, point>::iterator it=vecchi.begin(); it!=vecchi.end(); ++it)
+        {
+            UInt migliore = newMem.size();
+            Real dist     = 9e99;
+            for(UInt j=0; j<newMem.size(); ++j)
+            {
+                pair<int, Real> result = newMem[j].controlPoint(it->second, simp.toTrack[it->first], &ass);
+                if((result.first!=NULLGEO) && (result.second<dist))
+                {
+                    migliore = j;
+                    dist     = result.second;
+                }
+            }
+
+            if(migliore==newMem.size() || !hasAss(newMem[migliore], it->first))
+            {
+                cout << "The point " << it->first << " is not associated to the nearest element in the collapse ";
+                cout << numColl << endl;
+                return(1);
+            }
+        }
+
+        simp.deleteElementList(&edge, &toAdd);
+        simp.upDateMemento(&newMem);
+        simp.upDateFinder(&edge, p);
+        surf.insertNode(p);
+        simp.collEdge(&edge);
+        simp.upDate(&toAdd);
+
+        // dopo upDateMemento gli elementi hanno le associazioni calcolate da changeMemento
+        for(UInt i=0; i<newMem.size(); ++i)
+        {
+            vector<pair<UInt, point> > dopo = associazioni(simp.mem[newMem[i].getId()]);
+            if(!sameAss(prima[i], dopo))
+            {
+                cout << "upDateMemento changes the associations of the collapse " << numColl << endl;
+                return(1);
+            }
+        }
+
+        ++numColl;
+    }
+
+    // la ricompattazione del contenitore non cambia le associazioni
+    prima.clear();
+    for(UInt i=0; i<simp.mem.size(); ++i)	prima.push_back(associazioni(simp.mem[i]));
+    simp.compactAss();
+    for(UInt i=0; i<simp.mem.size(); ++i)
+    {
+        vector<pair<UInt, point> > dopo = associazioni(simp.mem[i]);
+        if(!sameAss(prima[i], dopo))
+        {
+            cout << "compactAss changes the associations of the element " << i << endl;
+            return(1);
+        }
+    }
+
+    if(numColl<200)
+    {
+        cout << "Only " << numColl << " collapses" << endl;
+        return(1);
+    }
+
+    cout << "changeMemento test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <set>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// svuota due liste togliendo il minimo e controlla che diano gli stessi elementi con gli stessi costi
+template<typename ELEMENT>
+bool sameOrder(heapList<ELEMENT> & lista, heapList<ELEMENT> & riferimento, string s)
+{
+    while(!lista.isEmpty() && !riferimento.isEmpty())
+    {
+        if(lista.findMin()!=riferimento.findMin() ||
+           lista.getGeoSize(lista.findMin())!=riferimento.getGeoSize(riferimento.findMin()))
+        {
+            cout << s << ": different element or cost at the top of the list" << endl;
+            return(false);
+        }
+        lista.remove(lista.findMin());
+        riferimento.remove(riferimento.findMin());
+    }
+
+    if(!lista.isEmpty() || !riferimento.isEmpty())
+    {
+        cout << s << ": the lists have a different size" << endl;
+        return(false);
+    }
+
+    return(true);
+}
+
+// confronta le liste costruite in parallelo con quelle costruite in serie con un set come prima, e con un thread
+// solo contro tutti i thread
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>				surf;
+    vector<UInt>				edge;
+    geoElementSize<Triangle>			elem;
+    set<geoElementSize<Triangle> >		insieme;
+    set<geoElementSize<simplePoint> >		insiemePunti;
+    heapList<geoElementSize<Triangle> >		lista,listaUno,riferimento,copia;
+    heapList<geoElementSize<simplePoint> >	listaPunti,listaPuntiUno,riferimentoPunti,copiaPunti;
+    garlandCostFunction				garland;
+
+    if(!loadMesh("../mesh/cow_580.inp", &surf))
+        return(1);
+
+    // -----------------------------------------------
+    //	   semplificazione basata sulle quadriche
+    // -----------------------------------------------
+    simplification2d<Triangle> simp(&surf);
+    simp.createElementList(&lista);
+
+    // riferimento in serie con il set
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+    {
+        for(UInt j=0; j<3; ++j)  elem.setConnectedId(j, surf.getElement(i).getConnectedId(j));
+        elem.setId(surf.getElement(i).getId());
+
+        pair<point, quadric> result = simp.getMinEdgeCost(i, &edge);
+        if((result.first-simp.pNull).norm2()>1e-10)
+        {
+            elem.setGeoSize(simp.getEdgeCost(&result.second, result.first));
+            insieme.insert(elem);
+        }
+    }
+    riferimento.setElementVector(&insieme);
+
+#ifdef _OPENMP
+    int numTh = omp_get_max_threads();
+    omp_set_num_threads(1);
+    simp.createElementList(&listaUno);
+    omp_set_num_threads(numTh);
+#else
+    simp.createElementList(&listaUno);
+#endif
+
+    // sameOrder svuota le liste, la seconda volta si confronta con una copia
+    copia = lista;
+    if(!sameOrder(lista, riferimento, "simplification2d") || !sameOrder(listaUno, copia, "simplification2d"))
+        return(1);
+
+    // -----------------------------------------------
+    //	   semplificazione basata sulla funzione costo
+    // -----------------------------------------------
+    vector<UInt> materiali(surf.getNumNodes(), 0);
+    simplification2dCostFunctionBased simpCosto(&garland, &surf, materiali);
+    simpCosto.createElementList(listaPunti);
+
+    // riferimento in serie con il set
+    for(UInt i=0; i<surf.getNumNodes(); ++i)
+    {
+        geoElementSize<simplePoint> punto;
+        simpCosto.computeCostOfAPoint(i, punto);
+        insiemePunti.insert(punto);
+    }
+    riferimentoPunti.setElementVector(&insiemePunti);
+
+#ifdef _OPENMP
+    omp_set_num_threads(1);
+    simpCosto.createElementList(listaPuntiUno);
+    omp_set_num_threads(numTh);
+#else
+    simpCosto.createElementList(listaPuntiUno);
+#endif
+
+    copiaPunti = listaPunti;
+    if(!sameOrder(listaPunti, riferimentoPunti, "cost function") ||
+       !sameOrder(listaPuntiUno, copiaPunti, "cost function"))
+        return(1);
+
+    cout << "createElementList test passed" << endl;
+    return(0);
+}
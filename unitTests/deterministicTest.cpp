@@ -0,0 +1,74 @@
+#include <iostream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// setta il numero di thread usato dai cicli paralleli, gli oggetti della semplificazione dimensionano i dati di ogni
+// thread all'inizio di ogni ciclo
+void setThreads(int numThreads)
+{
+#ifdef _OPENMP
+    omp_set_num_threads(numThreads);
+#else
+    (void)numThreads;
+#endif
+}
+
+// decimazione QEM a turni di collassi indipendenti
+bool runParallel(mesh2d<Triangle> & surf, int numThreads)
+{
+    setThreads(numThreads);
+    if(!loadMesh("../mesh/bunny.inp", &surf))	return(false);
+
+    simplification2d<Triangle> simp;
+    simp.setMeshPointer(&surf);
+    simp.simplificateParallel(34000, numThreads);
+    return(true);
+}
+
+// decimazione con la funzione costo, i costi iniziali sono calcolati in parallelo
+bool runCostFunction(mesh2d<Triangle> & surf, int numThreads)
+{
+    setThreads(numThreads);
+    if(!loadMesh("../mesh/bunny.inp", &surf))	return(false);
+
+    garlandCostFunction cost;
+    vector<UInt> materialId(surf.getNumNodes(), 10);
+    simplification2dCostFunctionBased simp(&cost, &surf, materialId);
+    simp.simplificateGreedy(30000);
+    return(true);
+}
+
+// decimazione con i dati, i costi dei gruppi dei migliori K candidati sono ricalcolati in parallelo
+bool runData(mesh2d<Triangle> & surf, int numThreads)
+{
+    setThreads(numThreads);
+    if(!loadMesh("../mesh/cow_580.inp", &surf))	return(false);
+
+    meshDataSimplification<Triangle> simp;
+    simp.setDynamicFinder(true);
+    simp.setNumCandidates(8);
+    simp.setMeshPointer(&surf);
+    simp.simplificationProcess(450, 0);
+    return(true);
+}
+
+// controlla che le decimazioni parallele diano mesh identiche bit a bit con 1 e 4 thread
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>	one,many;
+
+    if(!runParallel(one, 1) || !runParallel(many, 4))	return(1);
+    if(!sameMesh(one, many, "simplificateParallel"))	return(1);
+
+    if(!runCostFunction(one, 1) || !runCostFunction(many, 4))	return(1);
+    if(!sameMesh(one, many, "simplification2dCostFunctionBased"))	return(1);
+
+    if(!runData(one, 1) || !runData(many, 4))	return(1);
+    if(!sameMesh(one, many, "meshDataSimplification"))	return(1);
+
+    return(0);
+}
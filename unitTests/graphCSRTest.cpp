@@ -0,0 +1,98 @@
+#include <iostream>
+#include <cstdlib>
+#include "meshSimplification.h"
+
+using namespace geometry;
+using namespace std;
+
+// controlla che le righe di graphCSR si comportino come i graphItem di un vector<graphItem> dopo una sequenza
+// casuale di operazioni
+int main()
+{
+    // variabili in uso
+    vector<graphItem>	lista(500);
+    graphCSR		graph;
+    vector<UInt>	comList,comGraph,tmp;
+
+    // riempio le righe
+    srand(1);
+    for(UInt i=0; i<lista.size(); ++i)
+        for(UInt j=0; j<static_cast<UInt>(rand()%8); ++j)
+            lista[i].connectedPushBack(rand()%1000);
+
+    graph.assign(lista);
+
+    // operazioni casuali, le righe crescono e vengono spostate così viene usato anche compact
+    for(UInt step=0; step<200000; ++step)
+    {
+        UInt i = rand()%lista.size();
+        UInt k = rand()%lista.size();
+        UInt v = rand()%1000;
+
+        switch(rand()%8)
+        {
+            case(0):
+                lista[i].add(v);
+                graph[i].add(v);
+                break;
+            case(1):
+                if(lista[i].getNumConnected()>0)	v = lista[i].getConnectedId(rand()%lista[i].getNumConnected());
+                lista[i].remove(v);
+                graph[i].remove(v);
+                break;
+            case(2):
+                lista[i].connectedPushBack(v);
+                graph[i].connectedPushBack(v);
+                break;
+            case(3):
+                lista[i] = lista[k];
+                graph[i] = graph[k];
+                break;
+            case(4):
+                tmp.assign(rand()%20, v);
+                lista[i].add(tmp);
+                graph[i].add(tmp);
+                break;
+            case(5):
+                lista[i].common(lista[k], &comList);
+                graph[i].common(graph[k], &comGraph);
+                if(comList!=comGraph)
+                {
+                    cout << "graphCSR and graphItem give different common ids at step " << step << endl;
+                    return(1);
+                }
+                break;
+            case(6):
+                if(rand()%50==0)
+                {
+                    lista[i].clear();
+                    graph[i].clear();
+                }
+                break;
+            default:
+                lista.push_back(lista[i]);
+                graph.push_back(lista[i]);
+        }
+
+        if(graph.size()!=lista.size())
+        {
+            cout << "graphCSR and vector<graphItem> have a different size at step " << step << endl;
+            return(1);
+        }
+    }
+
+    // tutte le righe devono essere uguali
+    for(UInt i=0; i<lista.size(); ++i)
+    {
+        graphItem row = graph[i];
+
+        if(row.connected!=lista[i].connected)
+        {
+            cout << "The row " << i << " of graphCSR is different" << endl;
+            return(1);
+        }
+    }
+
+    cout << "graphCSR test passed, memory " << graph.getMemory() << " bytes" << endl;
+    return(0);
+}
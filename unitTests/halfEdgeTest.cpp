@@ -0,0 +1,100 @@
+#include <iostream>
+#include <set>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// confronta le richieste a halfEdge2d con tricky2d e il collasso incrementale con una struttura costruita da capo
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf;
+    tricky2d<Triangle>		tricky;
+    halfEdge2d<Triangle>	he,fresh;
+    vector<UInt>		heIds,trIds,edge(2);
+    UInt			numColl=0;
+
+    if(!loadMesh("../mesh/cow.inp", &surf))
+        return(1);
+
+    tricky.setMeshPointer(&surf);
+    if(!he.setMeshPointer(&surf))
+    {
+        cout << "halfEdge2d cannot be built on the cow" << endl;
+        return(1);
+    }
+
+    // stesse stellate e stessi triangoli sui lati, i nodi singolari vedono un solo ventaglio
+    for(UInt i=0; i<surf.getNumNodes(); ++i)
+    {
+        if(he.isSingularNode(i))	continue;
+
+        he.createStellata(i, &heIds);
+        tricky.createStellata(i, &trIds);
+        if(heIds!=trIds)
+        {
+            cout << "Different star around the node " << i << endl;
+            return(1);
+        }
+
+        for(UInt j=0; j<heIds.size(); ++j)
+        {
+            edge[0] = i;
+            edge[1] = heIds[j];
+            he.elementOnEdge(edge[0], edge[1], &heIds);
+            tricky.elementOnEdge(edge[0], edge[1], &trIds);
+            if(set<UInt>(heIds.begin(), heIds.end())!=set<UInt>(trIds.begin(), trIds.end()))
+            {
+                cout << "Different triangles on the edge " << edge[0] << " " << edge[1] << endl;
+                return(1);
+            }
+            he.createStellata(i, &heIds);
+        }
+    }
+
+    // una serie di collassi
+    for(UInt i=0; (i<surf.getNumNodes()) && (numColl<1000); ++i)
+    {
+        if(he.isNodeRemoved(i))	continue;
+
+        he.createStellata(i, &heIds);
+        for(UInt j=0; j<heIds.size(); ++j)
+            if(he.isCollapsable(i, heIds[j]))
+            {
+                he.collapse(i, heIds[j]);
+                ++numColl;
+                break;
+            }
+    }
+
+    // la struttura incrementale deve essere uguale a una nuova
+    fresh.setMeshPointer(&surf);
+    if(he.twin!=fresh.twin)
+    {
+        cout << "The twins after " << numColl << " collapses are different from a new build" << endl;
+        return(1);
+    }
+
+    for(UInt i=0; i<surf.getNumNodes(); ++i)
+    {
+        if(he.isNodeRemoved(i)!=fresh.isNodeRemoved(i) || he.isSingularNode(i)!=fresh.isSingularNode(i))
+        {
+            cout << "Different state of the node " << i << " after the collapses" << endl;
+            return(1);
+        }
+        if(he.isNodeRemoved(i) || he.isSingularNode(i))	continue;
+
+        he.createStellata(i, &heIds);
+        fresh.createStellata(i, &trIds);
+        if((heIds!=trIds) || (he.isBoundaryNode(i)!=fresh.isBoundaryNode(i)))
+        {
+            cout << "Different star around the node " << i << " after the collapses" << endl;
+            return(1);
+        }
+    }
+
+    cout << "halfEdge2d test passed, " << numColl << " collapses" << endl;
+    return(0);
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <cstdlib>
+#include "meshSimplification.h"
+
+using namespace geometry;
+using namespace std;
+
+// controlla che heapList dia lo stesso minimo di sortList dopo una sequenza casuale di operazioni
+int main()
+{
+    // variabili in uso
+    sortList<geoElementSize<simplePoint> > lista;
+    heapList<geoElementSize<simplePoint> > heap;
+    vector<geoElementSize<simplePoint> >   elements(2000);
+
+    // riempio gli elementi con alcuni costi uguali
+    srand(1);
+    for(UInt i=0; i<elements.size(); ++i)
+    {
+        elements[i].setId(i);
+        elements[i].setConnectedId(0, i);
+        elements[i].setGeoSize(static_cast<Real>(rand()%500));
+    }
+
+    lista.setElementVector(&elements);
+    heap.setElementVector(&elements);
+
+    // add/change/remove casuali
+    for(UInt step=0; step<20000; ++step)
+    {
+        UInt id = rand()%(elements.size()+200);
+
+        if(lista.isIn(id)!=heap.isIn(id))
+        {
+            cout << "heapList and sortList disagree on the element " << id << endl;
+            return(1);
+        }
+
+        switch(rand()%3)
+        {
+            case(0):
+                if(lista.isIn(id))
+                {
+                    Real val = static_cast<Real>(rand()%500);
+                    lista.change(id, val);
+                    heap.change(id, val);
+                }
+                break;
+            case(1):
+                if(lista.isIn(id))
+                {
+                    lista.remove(id);
+                    heap.remove(id);
+                }
+                break;
+            default:
+                if(!lista.isIn(id))
+                {
+                    geoElementSize<simplePoint> tmp;
+                    tmp.setId(id);
+                    tmp.setConnectedId(0, id);
+                    tmp.setGeoSize(static_cast<Real>(rand()%500));
+                    lista.add(&tmp);
+                    heap.add(&tmp);
+                }
+        }
+
+        if(lista.isEmpty()!=heap.isEmpty())
+        {
+            cout << "heapList and sortList have a different size" << endl;
+            return(1);
+        }
+
+        if(!lista.isEmpty() && (lista.findMin()!=heap.findMin() || lista.findMax()!=heap.findMax()))
+        {
+            cout << "heapList and sortList have a different order at step " << step << endl;
+            return(1);
+        }
+    }
+
+    // i k elementi più piccoli devono essere i primi k di sortList
+    vector<UInt> kLista,kHeap;
+    lista.findKMin(50, &kLista);
+    heap.findKMin(50, &kHeap);
+    if(kLista!=kHeap)
+    {
+        cout << "heapList and sortList give different k smallest elements" << endl;
+        return(1);
+    }
+
+    // le funzioni costo accettano ancora una sortList
+    garlandCostFunction garland;
+    if(garland.getPointToRemove(lista)!=garland.getPointToRemove(heap))
+    {
+        cout << "getPointToRemove gives different elements on sortList and heapList" << endl;
+        return(1);
+    }
+
+    // svuoto le due liste togliendo il minimo
+    while(!lista.isEmpty())
+    {
+        if(lista.findMin()!=heap.findMin())
+        {
+            cout << "heapList and sortList have a different order" << endl;
+            return(1);
+        }
+        heap.remove(lista.findMin());
+        lista.remove(lista.findMin());
+    }
+
+    cout << "heapList test passed" << endl;
+    return(heap.isEmpty() ? 0 : 1);
+}
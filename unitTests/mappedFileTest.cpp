@@ -0,0 +1,158 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// legge il file con ifstream >> come il vecchio lettore e controlla che il lettore mappato dia gli stessi bit
+bool same(string s, UInt numThreads)
+{
+    mesh2d<Triangle>	surf,riferimento;
+    downloadMesh	down;
+    ifstream		file(s.c_str());
+    UInt		numNode,numElem,tmp,geo,id[3];
+    Real		x[3];
+    string		str;
+
+    // la mesh è caricata due volte per controllare anche il riuso dei vettori
+    if(!file.is_open() || !down.fileFromParaviewMapped(s, &surf, numThreads) ||
+       !down.fileFromParaviewMapped(s, &surf, numThreads))
+    {
+        cout << "The mapped reader does not load " << s << endl;
+        return(false);
+    }
+
+    // fileFromParaview deve usare il lettore mappato e dare la stessa mesh
+    if(!loadMesh(s, &riferimento) || !sameMesh(surf, riferimento, s))
+        return(false);
+
+    file >> numNode >> numElem >> tmp >> tmp >> tmp;
+    if(!file || numNode==0 || surf.getNumNodes()!=numNode || surf.getNumElements()!=numElem)
+    {
+        cout << "Wrong sizes reading " << s << endl;
+        return(false);
+    }
+
+    for(UInt i=0; i<numNode; ++i)
+    {
+        file >> tmp >> x[0] >> x[1] >> x[2];
+        for(UInt j=0; j<3; ++j)
+            if(surf.getNode(i).getI(j)!=x[j] || surf.getNode(i).getId()!=i)
+            {
+                cout << "The node " << i << " of " << s << " is different" << endl;
+                return(false);
+            }
+    }
+
+    for(UInt i=0; i<numElem; ++i)
+    {
+        file >> tmp >> geo >> str >> id[0] >> id[1] >> id[2];
+        for(UInt j=0; j<3; ++j)
+            if(surf.getElement(i).getConnectedId(j)!=id[j]-1 || surf.getElement(i).getGeoId()!=geo)
+            {
+                cout << "The element " << i << " of " << s << " is different" << endl;
+                return(false);
+            }
+    }
+
+    return(true);
+}
+
+// riscrive una mesh con i record spezzati su più righe o più record su una riga
+void spezza(string s, string nome)
+{
+    ifstream	file(s.c_str());
+    ofstream	out(nome.c_str());
+    string	riga;
+    UInt	k=0;
+
+    getline(file, riga);
+    out << riga << "\n";
+    while(getline(file, riga))
+    {
+        istringstream parole(riga);
+        string parola;
+        while(parole >> parola)
+        {
+            // un a capo ogni tanto dentro i record e talvolta nessun a capo tra due record
+            out << parola << ((k%5==2) ? "\n" : " ");
+            ++k;
+        }
+        if(k%3!=0)	out << "\n";
+    }
+}
+
+// controlla il lettore mappato dei file .inp su delle mesh e su un file con numeri fuori dal percorso veloce
+int main()
+{
+    // un file piccolo con esponenti, mantisse lunghe, segni, righe vuote, CRLF e senza a capo alla fine
+    ofstream file("mappedFileTest.inp");
+    file << "4 2 0 0 0\r\n";
+    file << "1 0.1 -2.5e-3 1E+10\r\n";
+    file << "\n";
+    file << "2 3.141592653589793238462643 -0 7e-30\n";
+    file << "3 +12345678901234567890 0.000000000000000000000000123 -1.7976931348623157e308\n";
+    file << "4   1.  .5   2.2250738585072014e-308\n";
+    file << "1 3 tri 1 2 3\n";
+    file << "2 7 tri 1 3 4";
+    file.close();
+
+    if(!same("mappedFileTest.inp", 1))	return(1);
+    if(!same("mappedFileTest.inp", 3))	return(1);
+    if(!same("../mesh/cow.inp", 1))		return(1);
+    if(!same("../mesh/brain.inp", 4))		return(1);
+
+    // un file con meno record di quelli dichiarati lascia la mesh vuota
+    mesh2d<Triangle>	surf,riferimento;
+    downloadMesh	down;
+    ofstream corto("mappedFileShort.inp");
+    corto << "3 1 0 0 0\n1 0 0 0\n2 1 0 0\n";
+    corto.close();
+
+    down.fileFromParaviewMapped("../mesh/cow.inp", &surf);
+    if(down.fileFromParaviewMapped("mappedFileShort.inp", &surf) || surf.getNumNodes()!=0 || surf.getNumElements()!=0)
+    {
+        cout << "The mesh of a truncated file is not empty" << endl;
+        return(1);
+    }
+
+    // anche a flusso il file troncato lascia la mesh vuota
+    down.fileFromParaview("../mesh/cow.inp", &surf);
+    down.fileFromParaview("mappedFileShort.inp", &surf);
+    if(surf.getNumNodes()!=0 || surf.getNumElements()!=0)
+    {
+        cout << "The mesh of a truncated file read as a stream is not empty" << endl;
+        return(1);
+    }
+
+    // un id di un nodo che non sta in 32 bit non deve diventare un nodo valido
+    ofstream grande("mappedFileOverflow.inp");
+    grande << "3 1 0 0 0\n1 0 0 0\n2 1 0 0\n3 0 1 0\n1 0 tri 1 2 4294967297\n";
+    grande.close();
+
+    down.fileFromParaviewMapped("../mesh/cow.inp", &surf);
+    if(down.fileFromParaviewMapped("mappedFileOverflow.inp", &surf) || surf.getNumNodes()!=0 ||
+       surf.getNumElements()!=0)
+    {
+        cout << "The mesh of a file with an overflowing id is not empty" << endl;
+        return(1);
+    }
+
+    // con i record non uno per riga il lettore mappato rinuncia e fileFromParaview legge il file a flusso
+    spezza("../mesh/cow_580.inp", "mappedFileSplit.inp");
+    if(down.fileFromParaviewMapped("mappedFileSplit.inp", &surf))
+    {
+        cout << "The mapped reader accepts records that are not one per line" << endl;
+        return(1);
+    }
+    if(!loadMesh("../mesh/cow_580.inp", &riferimento) || !loadMesh("mappedFileSplit.inp", &surf))
+        return(1);
+    if(!sameMesh(surf, riferimento, "records split over lines"))
+        return(1);
+
+    cout << "mapped file test passed" << endl;
+    return(0);
+}
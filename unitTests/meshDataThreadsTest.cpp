@@ -0,0 +1,45 @@
+#include <iostream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// semplificazione con i dati, il numero di thread viene cambiato dopo aver costruito l'oggetto
+bool runData(mesh2d<Triangle> & surf, int numThreads)
+{
+    if(!loadMesh("../mesh/cow_580.inp", &surf))	return(false);
+
+    meshDataSimplification<Triangle> simp;
+    simp.setDynamicFinder(true);
+    simp.setNumCandidates(8);
+    simp.setMeshPointer(&surf);
+
+#ifdef _OPENMP
+    omp_set_num_threads(numThreads);
+#else
+    (void)numThreads;
+#endif
+
+    simp.simplificationProcess(450, 0);
+    return(true);
+}
+
+// controlla che meshDataSimplification abbia gli oggetti di ogni thread anche se i thread aumentano dopo la sua
+// costruzione e che il risultato sia lo stesso con un thread
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>	one,many;
+    int			numTh = 4;
+
+#ifdef _OPENMP
+    numTh = max(omp_get_max_threads(), omp_get_num_procs())+3;
+#endif
+
+    if(!runData(one, 1) || !runData(many, numTh))	return(1);
+    if(!sameMesh(one, many, "meshDataSimplification"))	return(1);
+
+    cout << "meshDataSimplification threads test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// forza bruta: tutti gli elementi dell'albero il cui box tocca il box della ricerca
+void bruteForce(mesh2d<Triangle> & surf, vector<bool> & inTree, point pMax, point pMin, vector<UInt> * ids)
+{
+    point	bMax,bMin;
+    bool	overlap;
+
+    ids->clear();
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+    {
+        if(!inTree[i])	continue;
+
+        surf.createBBox(i, bMax, bMin);
+        overlap = true;
+        for(UInt j=0; j<3; ++j)
+            overlap = overlap && (bMin.getI(j)<=pMax.getI(j)) && (bMax.getI(j)>=pMin.getI(j));
+
+        if(overlap)	ids->push_back(i);
+    }
+}
+
+// controlla che i box allargati dell'albero non perdano mai un elemento: la risposta deve contenere quella della forza
+// bruta e solamente elementi che sono nell'albero
+bool check(mesh2d<Triangle> & surf, meshSearchDynamic<mesh2d<Triangle>,3> & tree, vector<bool> & inTree, UInt step)
+{
+    point		pMax,pMin,c;
+    vector<UInt>	exact,found;
+
+    for(UInt q=0; q<50; ++q)
+    {
+        // box attorno a un nodo a caso con una dimensione a caso
+        c = surf.getNode(rand()%surf.getNumNodes());
+        Real h = 0.05*static_cast<Real>(rand()%100)/100.0;
+        for(UInt j=0; j<3; ++j)
+        {
+            pMax.setI(j, c.getI(j)+h);
+            pMin.setI(j, c.getI(j)-h);
+        }
+
+        bruteForce(surf, inTree, pMax, pMin, &exact);
+        found = tree.findIntersection(pMax, pMin).second;
+        sort(found.begin(), found.end());
+
+        if(adjacent_find(found.begin(), found.end())!=found.end())
+        {
+            cout << "The tree gives the same element twice at step " << step << endl;
+            return(false);
+        }
+
+        for(UInt i=0; i<found.size(); ++i)
+            if(!inTree[found[i]])
+            {
+                cout << "The tree gives the erased element " << found[i] << " at step " << step << endl;
+                return(false);
+            }
+
+        if(!includes(found.begin(), found.end(), exact.begin(), exact.end()))
+        {
+            cout << "The tree misses some elements at step " << step << endl;
+            return(false);
+        }
+    }
+
+    return(true);
+}
+
+// confronta le ricerche di meshSearchDynamic con la forza bruta mentre i nodi della mucca vengono spostati e gli
+// elementi vengono tolti e rimessi
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>				surf;
+    meshSearchDynamic<mesh2d<Triangle>,3>	tree;
+    vector<bool>				inTree;
+    vector<UInt>				conn;
+    point					p;
+
+    if(!loadMesh("../mesh/cow.inp", &surf))
+        return(1);
+    tree.setMeshPointer(&surf);
+    inTree.assign(surf.getNumElements(), true);
+
+    srand(1);
+    if(!check(surf, tree, inTree, 0))	return(1);
+
+    // l'albero deve restare bilanciato
+    if(tree.getHeight()>4*static_cast<UInt>(log2(static_cast<Real>(surf.getNumElements()))))
+    {
+        cout << "The tree is too high: " << tree.getHeight() << endl;
+        return(1);
+    }
+
+    for(UInt step=1; step<=2000; ++step)
+    {
+        UInt elem = rand()%surf.getNumElements();
+
+        switch(rand()%3)
+        {
+            // sposto un nodo dell'elemento e aggiorno gli elementi attorno
+            case(0):
+            {
+                UInt id = surf.getElement(elem).getConnectedId(rand()%3);
+                p = surf.getNode(id);
+                for(UInt j=0; j<3; ++j)
+                    p.setI(j, p.getI(j) + 0.02*(static_cast<Real>(rand()%200)/100.0-1.0));
+                for(UInt j=0; j<3; ++j)	surf.getNodePointer(id)->setI(j, p.getI(j));
+
+                for(UInt i=0; i<surf.getNumElements(); ++i)
+                {
+                    conn = surf.getElement(i).getConnectedIds();
+                    if(find(conn.begin(), conn.end(), id)!=conn.end() && inTree[i])	tree.moveElement(i);
+                }
+                break;
+            }
+            case(1):
+                tree.eraseElement(elem);
+                inTree[elem] = false;
+                break;
+            case(2):
+                tree.insertElement(elem);
+                inTree[elem] = true;
+                break;
+        }
+
+        if((step%100==0) && !check(surf, tree, inTree, step))	return(1);
+    }
+
+    if(tree.getNumElements()!=static_cast<UInt>(count(inTree.begin(), inTree.end(), true)))
+    {
+        cout << "Wrong number of elements in the tree" << endl;
+        return(1);
+    }
+
+    cout << "meshSearchDynamic test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,67 @@
+#include <iostream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// controlla che la visita dell'anello con i buffer di lavoro dia gli stessi nodi di getNodeAround con i set e che la
+// funzione costo abbia un buffer per ogni thread anche se i thread aumentano dopo la sua costruzione
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf;
+    tricky2d<Triangle>		trick;
+    ringScratch			scratch;
+    vector<UInt>		ids;
+
+    if(!loadMesh("../mesh/cow.inp", &surf))
+        return(1);
+    trick.setMeshPointer(&surf);
+
+    for(UInt deph=1; deph<4; ++deph)
+    {
+        for(UInt i=0; i<surf.getNumNodes(); ++i)
+        {
+            // senza limite, il risultato è scritto nel buffer di lavoro
+            trick.getNodeAround(i, deph, &ids);
+            trick.getNodeAround(i, deph, &scratch.ids, &scratch);
+            if(ids!=scratch.ids)
+            {
+                cout << "Different nodes around " << i << " with depth " << deph << endl;
+                return(1);
+            }
+
+            // con il limite
+            trick.getNodeAround(i, deph, &ids, 10);
+            trick.getNodeAround(i, deph, &scratch.ids, &scratch, 10);
+            if(ids!=scratch.ids)
+            {
+                cout << "Different nodes around " << i << " with depth " << deph << " and limit" << endl;
+                return(1);
+            }
+        }
+    }
+
+    // la funzione costo è costruita prima di aumentare i thread, createElementList deve darle un buffer per ognuno
+    garlandCostFunction	garland;
+    vector<UInt>	materiali(surf.getNumNodes(), 0);
+    heapList<geoElementSize<simplePoint> > lista;
+    simplification2dCostFunctionBased simp(&garland, &surf, materiali);
+#ifdef _OPENMP
+    int numTh = omp_get_max_threads();
+    omp_set_num_threads(max(omp_get_max_threads(), omp_get_num_procs())+3);
+#endif
+    simp.createElementList(lista);
+#ifdef _OPENMP
+    omp_set_num_threads(numTh);
+#endif
+    if(lista.isEmpty())
+    {
+        cout << "The list of the cost function is empty" << endl;
+        return(1);
+    }
+
+    cout << "getNodeAround test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,229 @@
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+using namespace std::chrono;
+
+// controlla che due mesh abbiano gli stessi bit
+bool same(mesh2d<Triangle> & a, mesh2d<Triangle> & b)
+{
+    if(a.getNumNodes()!=b.getNumNodes() || a.getNumElements()!=b.getNumElements())
+    {
+        cout << "Different sizes" << endl;
+        return(false);
+    }
+
+    for(UInt i=0; i<a.getNumNodes(); ++i)
+        for(UInt j=0; j<3; ++j)
+            if(a.getNode(i).getI(j)!=b.getNode(i).getI(j) || b.getNode(i).getId()!=i)
+            {
+                cout << "The node " << i << " is different" << endl;
+                return(false);
+            }
+
+    for(UInt i=0; i<a.getNumElements(); ++i)
+    {
+        if(a.getElement(i).getGeoId()!=b.getElement(i).getGeoId() || b.getElement(i).getId()!=i)
+        {
+            cout << "The element " << i << " is different" << endl;
+            return(false);
+        }
+        for(UInt j=0; j<3; ++j)
+            if(a.getElement(i).getConnectedId(j)!=b.getElement(i).getConnectedId(j))
+            {
+                cout << "The element " << i << " is different" << endl;
+                return(false);
+            }
+    }
+
+    return(true);
+}
+
+// scrive un elemento face binario con una lista di indici seguita da una lista di coordinate della texture
+void binaryTexcoord(string name, uint32_t numero)
+{
+    ofstream	out(name.c_str(), ios::binary);
+    float	xyz[4][3] = {{0,0,0}, {1,0,0}, {0,1,0}, {0,0,1}};
+    int32_t	ids[2][3] = {{0,1,2}, {0,1,3}};
+    float	tex[6] = {0, 0, 1, 0, 0.5, 1};
+    uint8_t	sei = 6;
+
+    out << "ply\nformat binary_little_endian 1.0\nelement vertex 4\n";
+    out << "property float x\nproperty float y\nproperty float z\n";
+    out << "element face 2\nproperty list uint int vertex_indices\nproperty list uchar float texcoord\nend_header\n";
+    out.write(reinterpret_cast<char*>(xyz), sizeof(xyz));
+    for(UInt i=0; i<2; ++i)
+    {
+        out.write(reinterpret_cast<char*>(&numero), sizeof(numero));
+        out.write(reinterpret_cast<char*>(ids[i]), sizeof(ids[i]));
+        out.write(reinterpret_cast<char*>(&sei), sizeof(sei));
+        out.write(reinterpret_cast<char*>(tex), sizeof(tex));
+    }
+}
+
+// scrive un file con quattro vertici e una faccia con i numeri di record dati, l'intestazione può dichiarare più
+// record di quelli scritti
+void counts(string name, bool binario, string vertici, string facce)
+{
+    ofstream	out(name.c_str(), ios::binary);
+    float	xyz[4][3] = {{0,0,0}, {1,0,0}, {0,1,0}, {0,0,1}};
+    int32_t	ids[3] = {0, 1, 2};
+    uint8_t	tre = 3;
+
+    out << "ply\nformat " << (binario ? "binary_little_endian" : "ascii") << " 1.0\nelement vertex " << vertici << "\n";
+    out << "property float x\nproperty float y\nproperty float z\n";
+    out << "element face " << facce << "\nproperty list uchar int vertex_indices\nend_header\n";
+    if(binario)
+    {
+        out.write(reinterpret_cast<char*>(xyz), sizeof(xyz));
+        out.write(reinterpret_cast<char*>(&tre), sizeof(tre));
+        out.write(reinterpret_cast<char*>(ids), sizeof(ids));
+    }
+    else
+    {
+        out << "0 0 0\n1 0 0\n0 1 0\n0 0 1\n3 0 1 2\n";
+    }
+}
+
+// scrive e legge file PLY binari e ascii, legge file scritti a mano con poligoni, altri tipi e liste dopo gli indici e
+// controlla che un file troncato, una lista più lunga del file o troppi record lascino la mesh vuota
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf,back;
+    downloadMesh		down;
+    createFile			file;
+    vector<vector<Real> >	prop(1),propBack;
+    vector<string>		nomi(1,"quality"),nomiBack;
+
+    if(!loadMesh("../mesh/brain.inp", &surf))	return(1);
+    for(UInt i=0; i<surf.getNumNodes(); ++i)	prop[0].push_back(surf.getNode(i).getY()/7.0);
+    for(UInt i=0; i<surf.getNumElements(); ++i)	surf.getElementPointer(i)->setGeoId(i%5);
+
+    // andata e ritorno in binario e in ascii
+    for(UInt k=0; k<2; ++k)
+    {
+        high_resolution_clock::time_point t0 = high_resolution_clock::now();
+        file.fileForPly("plyTest.ply", &surf, k==0, &prop, &nomi);
+        high_resolution_clock::time_point t1 = high_resolution_clock::now();
+        down.fileFromPly("plyTest.ply", &back, &propBack, &nomiBack);
+        high_resolution_clock::time_point t2 = high_resolution_clock::now();
+
+        cout << ((k==0) ? "Binary" : "Ascii") << ": write " << duration_cast<milliseconds>(t1-t0).count();
+        cout << " ms, read " << duration_cast<milliseconds>(t2-t1).count() << " ms" << endl;
+
+        if(!same(surf, back))	return(1);
+        if(propBack!=prop || nomiBack!=nomi)
+        {
+            cout << "Different properties" << endl;
+            return(1);
+        }
+    }
+
+    // un quadrilatero è diviso in due triangoli, le proprietà float e uchar sono lette, il commento è saltato
+    ofstream out("plyQuad.ply");
+    out << "ply\nformat ascii 1.0\ncomment written by hand\nelement vertex 5\n";
+    out << "property float x\nproperty float y\nproperty float z\nproperty uchar red\n";
+    out << "element face 2\nproperty list uchar int vertex_indices\nelement edge 1\nproperty int a\nend_header\n";
+    out << "0 0 0 10\n1 0 0 20\n1 1 0 30\n0 1 0 40\n0.5 0.5 1.5 50\n";
+    out << "4 0 1 2 3\n3 0 1 4\n";
+    out << "0\n";
+    out.close();
+
+    down.fileFromPly("plyQuad.ply", &back, &propBack, &nomiBack);
+    if(back.getNumNodes()!=5 || back.getNumElements()!=3 || back.getNode(4).getZ()!=1.5 ||
+       back.getElement(1).getConnectedId(1)!=2 || back.getElement(1).getConnectedId(2)!=3 ||
+       back.getElement(2).getConnectedId(2)!=4)
+    {
+        cout << "Wrong polygon file" << endl;
+        return(1);
+    }
+    if(nomiBack.size()!=1 || nomiBack[0]!="red" || propBack[0][3]!=40.0)
+    {
+        cout << "Wrong polygon properties" << endl;
+        return(1);
+    }
+
+    // le liste della texture dopo gli indici sono saltate, in ascii e in binario
+    out.open("plyTexcoord.ply");
+    out << "ply\nformat ascii 1.0\nelement vertex 4\nproperty float x\nproperty float y\nproperty float z\n";
+    out << "element face 2\nproperty list uchar int vertex_indices\nproperty list uchar float texcoord\nend_header\n";
+    out << "0 0 0\n1 0 0\n0 1 0\n0 0 1\n";
+    out << "3 0 1 2 6 0 0 1 0 0.5 1\n3 0 1 3 6 0 0 1 0 0.5 1\n";
+    out.close();
+    binaryTexcoord("plyTexcoordBinary.ply", 3);
+
+    for(UInt k=0; k<2; ++k)
+    {
+        down.fileFromPly((k==0) ? "plyTexcoord.ply" : "plyTexcoordBinary.ply", &back);
+        if(back.getNumNodes()!=4 || back.getNumElements()!=2 || back.getElement(1).getConnectedId(2)!=3)
+        {
+            cout << "Wrong texture list file" << endl;
+            return(1);
+        }
+    }
+
+    // un conteggio molto più grande del file è rifiutato prima di allocare la lista
+    binaryTexcoord("plyHugeList.ply", 4000000000u);
+    down.fileFromPly("plyHugeList.ply", &back);
+    if(back.getNumNodes()!=0 || back.getNumElements()!=0)
+    {
+        cout << "A list longer than the file is read" << endl;
+        return(1);
+    }
+
+    // un file binario troncato
+    file.fileForPly("plyTest.ply", &surf, true);
+    ifstream in("plyTest.ply", ios::binary);
+    string content((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    ofstream outShort("plyShort.ply", ios::binary);
+    outShort.write(content.c_str(), content.size()-3);
+    outShort.close();
+
+    down.fileFromPly("plyShort.ply", &back);
+    if(back.getNumNodes()!=0 || back.getNumElements()!=0)
+    {
+        cout << "A truncated file is read" << endl;
+        return(1);
+    }
+
+    // il numero di vertici o di facce dell'intestazione è controllato con la dimensione del file prima di allocare
+    // i vettori, prima con quattro miliardi di vertici si aveva bad_alloc
+    for(UInt k=0; k<4; ++k)
+    {
+        counts("plyHugeCount.ply", k%2==0, (k<2) ? "4000000000" : "4", (k<2) ? "1" : "4000000000");
+        try
+        {
+            down.fileFromPly("plyHugeCount.ply", &back, &propBack, &nomiBack);
+        }
+        catch(bad_alloc &)
+        {
+            cout << "The count of the header is allocated before checking the file" << endl;
+            return(1);
+        }
+        if(back.getNumNodes()!=0 || back.getNumElements()!=0)
+        {
+            cout << "A file with more records than its size is read" << endl;
+            return(1);
+        }
+    }
+
+    // gli stessi file con i numeri giusti si leggono
+    for(UInt k=0; k<2; ++k)
+    {
+        counts("plyCount.ply", k==0, "4", "1");
+        down.fileFromPly("plyCount.ply", &back);
+        if(back.getNumNodes()!=4 || back.getNumElements()!=1)
+        {
+            cout << "Wrong file with four vertices" << endl;
+            return(1);
+        }
+    }
+
+    cout << "ply test passed" << endl;
+    return(0);
+}
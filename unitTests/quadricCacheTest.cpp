@@ -0,0 +1,98 @@
+#include <iostream>
+#include <cmath>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// funzione costo di Garland senza la cache, ricalcola le quadriche ad ogni chiamata come prima della cache
+class garlandNoCache : public garlandCostFunction
+{
+    public:
+
+    bool usesQuadricCache() const
+    {
+        return(false);
+    }
+};
+
+// confronta la funzione costo di Garland con e senza la cache delle quadriche sulla stessa mesh
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>                        surf1,surf2;
+    garlandCostFunction                     conCache;
+    garlandNoCache                          senzaCache;
+    heapList<geoElementSize<simplePoint> >  lista1,lista2;
+    geoElementSize<simplePoint>             p1,p2;
+
+    if(!loadMesh("../mesh/cow_580.inp", &surf1) || !loadMesh("../mesh/cow_580.inp", &surf2))
+        return(1);
+
+    vector<UInt> materiali1(surf1.getNumNodes(), 0), materiali2(surf2.getNumNodes(), 0);
+    simplification2dCostFunctionBased simp1(&conCache, &surf1, materiali1);
+    simplification2dCostFunctionBased simp2(&senzaCache, &surf2, materiali2);
+
+    // i costi di ogni punto devono essere gli stessi
+    for(UInt i=0; i<surf1.getNumNodes(); ++i)
+    {
+        simp1.computeCostOfAPoint(i, p1);
+        simp2.computeCostOfAPoint(i, p2);
+
+        if(fabs(p1.getGeoSize()-p2.getGeoSize())>1e-9*max(1.0, fabs(p2.getGeoSize())))
+        {
+            cout << "Different cost of the point " << i << " with and without the cache" << endl;
+            return(1);
+        }
+    }
+
+    // la seconda volta i costi vengono dalla cache e devono essere ancora gli stessi
+    for(UInt i=0; i<surf1.getNumNodes(); ++i)
+    {
+        simp1.computeCostOfAPoint(i, p1);
+        simp2.computeCostOfAPoint(i, p2);
+
+        if(fabs(p1.getGeoSize()-p2.getGeoSize())>1e-9*max(1.0, fabs(p2.getGeoSize())))
+        {
+            cout << "Different cost of the point " << i << " read from the cache" << endl;
+            return(1);
+        }
+    }
+
+    // le due liste devono dare i punti nello stesso ordine
+    simp1.createElementList(lista1);
+    simp2.createElementList(lista2);
+    while(!lista1.isEmpty() && !lista2.isEmpty())
+    {
+        if(lista1.findMin()!=lista2.findMin())
+        {
+            cout << "The lists with and without the cache have a different order" << endl;
+            return(1);
+        }
+        lista1.remove(lista1.findMin());
+        lista2.remove(lista2.findMin());
+    }
+    if(!lista1.isEmpty() || !lista2.isEmpty())
+    {
+        cout << "The lists with and without the cache have a different size" << endl;
+        return(1);
+    }
+
+    // dopo le contrazioni le quadriche della cache sono le somme di Garland e non quelle ricalcolate, i due
+    // risultati possono essere diversi ma devono avere lo stesso numero di nodi ed essere chiusi
+    simp1.simplificateGreedy(300);
+    simp2.simplificateGreedy(300);
+
+    if(surf1.getNumNodes()!=surf2.getNumNodes())
+    {
+        cout << "Different number of nodes with and without the cache" << endl;
+        return(1);
+    }
+
+    if(!closed(surf1) || !closed(surf2))
+        return(1);
+
+    cout << "quadric cache test passed" << endl;
+    return(0);
+}
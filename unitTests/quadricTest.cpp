@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cmath>
+#include <numeric>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// confronta la quadrica compatta con la vecchia matrice 4x4 di 16 elementi costruita e valutata come prima
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf;
+    vector<vector<UInt> >	attorno;
+    vector<Real>		K(16),vTmp(4),v(4);
+    point			normal,p;
+    quadric			Q;
+    Real			d,valore,vecchio,scala;
+
+    if(!loadMesh("../mesh/cow_580.inp", &surf))
+        return(1);
+
+    simplification2d<Triangle> simp(&surf);
+
+    // elementi attorno ad ogni nodo
+    attorno.resize(surf.getNumNodes());
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+        for(UInt j=0; j<3; ++j)
+            attorno[surf.getElement(i).getConnectedId(j)].push_back(i);
+
+    for(UInt i=0; i<surf.getNumNodes(); ++i)
+    {
+        // vecchia matrice: somma delle K_p[4r+c] = n_r*n_c con n = (normale, -nodo*normale)
+        fill(K.begin(), K.end(), 0.0);
+        for(UInt e=0; e<attorno[i].size(); ++e)
+        {
+            normal = simp.getTriangleNormal(attorno[i][e]);
+            d      = (-1.0)*(surf.getNode(i)*normal);
+            v[0] = normal.getI(0);	v[1] = normal.getI(1);	v[2] = normal.getI(2);	v[3] = d;
+            for(UInt r=0; r<4; ++r)
+                for(UInt c=0; c<4; ++c)
+                    K[4*r+c] += v[r]*v[c];
+        }
+
+        // la nuova quadrica deve avere gli stessi elementi
+        Q = simp.createQ(i);
+        scala = 1.0;
+        for(UInt k=0; k<16; ++k)	scala = max(scala, fabs(K[k]));
+        for(UInt r=0; r<4; ++r)
+            for(UInt c=0; c<4; ++c)
+                if(fabs(Q.getI(r,c)-K[4*r+c])>1e-12*scala)
+                {
+                    cout << "Different entry " << r << " " << c << " of the quadric of the node " << i << endl;
+                    return(1);
+                }
+
+        // valuto nel nodo e in un punto spostato come faceva il vecchio getEdgeCost
+        for(UInt s=0; s<2; ++s)
+        {
+            p = surf.getNode(i) + point(0.01*s, -0.02*s, 0.03*s);
+            v[0] = p.getI(0);	v[1] = p.getI(1);	v[2] = p.getI(2);	v[3] = 1.0;
+            for(UInt k=0; k<4; ++k)
+                vTmp[k] = K[k]*v[0] + K[4+k]*v[1] + K[8+k]*v[2] + K[12+k]*v[3];
+            vecchio = inner_product(v.begin(), v.end(), vTmp.begin(), 0.0);
+
+            valore = simp.getEdgeCost(&Q, p);
+            if(fabs(valore-vecchio)>1e-9*max(scala, fabs(vecchio)))
+            {
+                cout << "Different cost of the node " << i << ": " << valore << " " << vecchio << endl;
+                return(1);
+            }
+        }
+    }
+
+    cout << "quadric test passed" << endl;
+    return(0);
+}
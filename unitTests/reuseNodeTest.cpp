@@ -0,0 +1,77 @@
+#include <iostream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// controlla che la connettività usi solo nodi esistenti, cioè che la compattazione non lasci id appesi
+bool noDangling(mesh2d<Triangle> & surf, string s)
+{
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+        for(UInt j=0; j<3; ++j)
+            if(surf.getElement(i).getConnectedId(j)>=surf.getNumNodes())
+            {
+                cout << s << ": the element " << i << " uses the node " << surf.getElement(i).getConnectedId(j);
+                cout << " but there are " << surf.getNumNodes() << " nodes" << endl;
+                return(false);
+            }
+
+    return(true);
+}
+
+// confronta i due modi di gestire la memoria semplificando la stessa mesh, con 150 nodi su 580 simplification2d
+// in modalità REUSENODE passa almeno una volta per la compattazione periodica
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>	append,reuse,appendCosto,reuseCosto;
+    garlandCostFunction	garland1,garland2;
+
+    if(!loadMesh("../mesh/cow_580.inp", &append) || !loadMesh("../mesh/cow_580.inp", &reuse))
+        return(1);
+    if(!loadMesh("../mesh/cow_580.inp", &appendCosto) || !loadMesh("../mesh/cow_580.inp", &reuseCosto))
+        return(1);
+
+    // semplificazione basata sulle quadriche
+    simplification2d<Triangle> simp1(&append);
+    simplification2d<Triangle> simp2(&reuse);
+    simp1.setMemoryMode(APPENDNODE);
+    simp2.setMemoryMode(REUSENODE);
+    simp1.simplificateGreedy(150);
+    simp2.simplificateGreedy(150);
+
+    if(append.getNumNodes()!=reuse.getNumNodes())
+    {
+        cout << "APPENDNODE and REUSENODE give " << append.getNumNodes() << " and " << reuse.getNumNodes();
+        cout << " nodes" << endl;
+        return(1);
+    }
+
+    if(!noDangling(append, "APPENDNODE") || !noDangling(reuse, "REUSENODE") || !closed(append) || !closed(reuse))
+        return(1);
+
+    // semplificazione basata sulla funzione costo
+    vector<UInt> materiali1(appendCosto.getNumNodes(), 0), materiali2(reuseCosto.getNumNodes(), 0);
+    simplification2dCostFunctionBased simp3(&garland1, &appendCosto, materiali1);
+    simplification2dCostFunctionBased simp4(&garland2, &reuseCosto, materiali2);
+    simp3.setMemoryMode(APPENDNODE);
+    simp4.setMemoryMode(REUSENODE);
+    simp3.simplificateGreedy(150);
+    simp4.simplificateGreedy(150);
+
+    if(appendCosto.getNumNodes()!=reuseCosto.getNumNodes())
+    {
+        cout << "APPENDNODE and REUSENODE give " << appendCosto.getNumNodes() << " and ";
+        cout << reuseCosto.getNumNodes() << " nodes with the cost function" << endl;
+        return(1);
+    }
+
+    if(!noDangling(appendCosto, "APPENDNODE") || !noDangling(reuseCosto, "REUSENODE"))
+        return(1);
+    if(!closed(appendCosto) || !closed(reuseCosto))
+        return(1);
+
+    cout << "reuse node test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,43 @@
+#include <iostream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// semplifica la mucca in quattro patch e controlla la mesh ricucita e che il numero di thread non conti
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		one,many;
+
+    if(!loadMesh("../mesh/cow.inp", &one) || !loadMesh("../mesh/cow.inp", &many))	return(1);
+
+    simplification2dPatch simpOne(&one);
+    simpOne.setNumThreads(1);
+    simpOne.simplificate(1500, 4);
+
+    simplification2dPatch simpMany(&many);
+    simpMany.setNumThreads(4);
+    simpMany.simplificate(1500, 4);
+
+    if(one.getNumNodes()>1500)
+    {
+        cout << "The simplification stops at " << one.getNumNodes() << " nodes" << endl;
+        return(1);
+    }
+
+    if(!closed(one))	return(1);
+
+    // i nodi bloccati nell'ultimo passo devono riavere il loro flag di bordo, la mucca non ha bordo
+    for(UInt i=0; i<one.getNumNodes(); ++i)
+        if(one.getNode(i).getBoundary()!=0)
+        {
+            cout << "The node " << i << " keeps the boundary flag " << one.getNode(i).getBoundary() << endl;
+            return(1);
+        }
+
+    if(!sameMesh(one, many, "1 and 4 threads"))	return(1);
+
+    return(0);
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+using namespace std::chrono;
+
+// media sui nodi della mesh di partenza del quadrato della distanza dai piani degli elementi semplificati attorno al
+// nodo semplificato più vicino, è l'errore delle quadriche di Garland misurato sui nodi di partenza
+Real error(mesh2d<Triangle> & orig, mesh2d<Triangle> & surf)
+{
+    Real			somma=0.0;
+    vector<vector<UInt> >	around(surf.getNumNodes());
+    vector<UInt>		conn;
+
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+    {
+        conn = surf.getElement(i).getConnectedIds();
+        for(UInt j=0; j<3; ++j)	around[conn[j]].push_back(i);
+    }
+
+    for(UInt i=0; i<orig.getNumNodes(); ++i)
+    {
+        UInt vicino = 0;
+        for(UInt j=1; j<surf.getNumNodes(); ++j)
+            if((surf.getNode(j)-orig.getNode(i)).norm2()<(surf.getNode(vicino)-orig.getNode(i)).norm2())	vicino = j;
+
+        Real minimo = 9.9e99;
+        for(UInt j=0; j<around[vicino].size(); ++j)
+        {
+            conn = surf.getElement(around[vicino][j]).getConnectedIds();
+            point n = (surf.getNode(conn[1])-surf.getNode(conn[0]))^(surf.getNode(conn[2])-surf.getNode(conn[0]));
+            if(n.norm2()==0.0)	continue;
+            n = n/n.norm2();
+            Real d = (orig.getNode(i)-surf.getNode(conn[0]))*n;
+            minimo = min(minimo, d*d);
+        }
+        somma += minimo;
+    }
+
+    return(somma/orig.getNumNodes());
+}
+
+// semplifica una mucca rada con la lista ordinata e con le scelte multiple casuali, controlla la mesh casuale e che il
+// numero di thread non conti, poi confronta la qualità delle due. La semplificazione greedy è solo un riferimento,
+// quindi la mesh è piccola per farla durare poco
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		orig,greedy,one,many;
+    string			name = "../mesh/cow_580.inp";
+    UInt			target = 300;
+
+    if(!loadMesh(name, &orig) || !loadMesh(name, &greedy) || !loadMesh(name, &one) || !loadMesh(name, &many))
+        return(1);
+
+    high_resolution_clock::time_point start = high_resolution_clock::now();
+    simplification2d<Triangle> simpGreedy(&greedy);
+    simpGreedy.simplificateGreedy(target);
+    high_resolution_clock::time_point middle = high_resolution_clock::now();
+    simplification2d<Triangle> simpOne(&one);
+    simpOne.simplificateRandom(target, 8, 1);
+    high_resolution_clock::time_point stop = high_resolution_clock::now();
+
+    simplification2d<Triangle> simpMany(&many);
+    simpMany.simplificateRandom(target, 8, 4);
+
+    if(one.getNumNodes()>target)
+    {
+        cout << "The simplification stops at " << one.getNumNodes() << " nodes" << endl;
+        return(1);
+    }
+
+    if(!closed(one))	return(1);
+
+    if(!sameMesh(one, many, "1 and 4 threads"))	return(1);
+
+    Real errGreedy = error(orig, greedy);
+    Real errRandom = error(orig, one);
+    cout << "Greedy: " << duration_cast<milliseconds>(middle-start).count() << " ms, error " << errGreedy << endl;
+    cout << "Random: " << duration_cast<milliseconds>(stop-middle).count() << " ms, error " << errRandom << endl;
+
+    if(errRandom>2.0*errGreedy)
+    {
+        cout << "The random simplification is too far from the greedy one" << endl;
+        return(1);
+    }
+
+    return(0);
+}
@@ -0,0 +1,199 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+using namespace std::chrono;
+
+// scrive i triangoli di una mesh come un file STL binario
+void writeBinary(string s, mesh2d<Triangle> & surf)
+{
+    char	header[80];
+    uint32_t	num = surf.getNumElements();
+    float	record[12];
+    uint16_t	attr = 0;
+
+    memset(header, 0, sizeof(header));
+    ofstream out(s.c_str(), ios::binary);
+    out.write(header, sizeof(header));
+    out.write(reinterpret_cast<const char *>(&num), sizeof(num));
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+    {
+        for(UInt j=0; j<3; ++j)	record[j] = 0.0;
+        for(UInt k=0; k<3; ++k)
+            for(UInt j=0; j<3; ++j)	record[3+3*k+j] = surf.getNode(surf.getElement(i).getConnectedId(k)).getI(j);
+        out.write(reinterpret_cast<const char *>(record), sizeof(record));
+        out.write(reinterpret_cast<const char *>(&attr), sizeof(attr));
+    }
+}
+
+// scrive i triangoli di una mesh come un file STL ascii, ogni vertice è spostato di un multiplo di eps
+void writeAscii(string s, mesh2d<Triangle> & surf, Real eps)
+{
+    char	num[32];
+
+    ofstream out(s.c_str());
+    out << "solid test\n";
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+    {
+        out << "  facet normal 0 0 1\n    outer loop\n";
+        for(UInt k=0; k<3; ++k)
+        {
+            out << "      vertex";
+            for(UInt j=0; j<3; ++j)
+            {
+                snprintf(num, sizeof(num), " %.17g", surf.getNode(surf.getElement(i).getConnectedId(k)).getI(j) + eps*((i+k)%3));
+                out << num;
+            }
+            out << "\n";
+        }
+        out << "    endloop\n  endfacet\n";
+    }
+    out << "endsolid test\n";
+}
+
+// controlla che la mesh fusa abbia gli stessi nodi e triangoli di quella di partenza, i nodi sono confrontati con la
+// tolleranza toll
+bool same(mesh2d<Triangle> & a, mesh2d<Triangle> & b, Real toll)
+{
+    if(a.getNumNodes()!=b.getNumNodes() || a.getNumElements()!=b.getNumElements())
+    {
+        cout << "Different sizes " << b.getNumNodes() << " " << b.getNumElements() << endl;
+        return(false);
+    }
+
+    for(UInt i=0; i<a.getNumElements(); ++i)
+        for(UInt k=0; k<3; ++k)
+        {
+            point pa = a.getNode(a.getElement(i).getConnectedId(k));
+            point pb = b.getNode(b.getElement(i).getConnectedId(k));
+            if((pa-pb).norm2()>toll)
+            {
+                cout << "The element " << i << " is different" << endl;
+                return(false);
+            }
+        }
+
+    return(true);
+}
+
+// scrive un file STL ascii con un triangolo per ogni punto dato, gli altri due vertici di ogni triangolo sono lontani
+// da tutti gli altri
+void writePoints(string s, vector<point> & punti)
+{
+    ofstream out(s.c_str());
+    out << "solid punti\n";
+    for(UInt i=0; i<punti.size(); ++i)
+    {
+        out << "  facet normal 0 0 1\n    outer loop\n";
+        out << "      vertex " << punti[i].getX() << " " << punti[i].getY() << " " << punti[i].getZ() << "\n";
+        out << "      vertex " << 10.0*(i+1) << " 0 0\n";
+        out << "      vertex 0 " << 10.0*(i+1) << " 0\n";
+        out << "    endloop\n  endfacet\n";
+    }
+    out << "endsolid punti\n";
+}
+
+// legge i file STL binari e ascii di una mesh e controlla che i vertici siano fusi negli stessi nodi, con e senza
+// tolleranza e con numeri di thread diversi, e che la tolleranza segua la distanza fra i vertici e non le celle
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf,back,other;
+    downloadMesh		down;
+    vector<point>		punti;
+
+    if(!loadMesh("../mesh/brain.inp", &surf))
+        return(1);
+
+    // file binario, fusione esatta delle coordinate float
+    writeBinary("stlTest.stl", surf);
+    high_resolution_clock::time_point t0 = high_resolution_clock::now();
+    down.fileFromStl("stlTest.stl", &back);
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    cout << "Binary STL with " << surf.getNumElements() << " triangles: ";
+    cout << duration_cast<milliseconds>(t1-t0).count() << " ms" << endl;
+
+    if(!same(surf, back, 1e-5))	return(1);
+
+    // il risultato non dipende dai thread
+    down.fileFromStl("stlTest.stl", &other, 0.0, 1);
+    for(UInt i=0; i<back.getNumElements(); ++i)
+        for(UInt k=0; k<3; ++k)
+            if(back.getElement(i).getConnectedId(k)!=other.getElement(i).getConnectedId(k))
+            {
+                cout << "The threads change the mesh" << endl;
+                return(1);
+            }
+
+    // file ascii con le coordinate esatte
+    writeAscii("stlTest.txt", surf, 0.0);
+    down.fileFromStl("stlTest.txt", &back);
+    if(!same(surf, back, 0.0))	return(1);
+
+    // i vertici spostati restano divisi senza tolleranza e sono fusi con la tolleranza
+    writeAscii("stlTest.txt", surf, 1e-9);
+    down.fileFromStl("stlTest.txt", &back);
+    if(back.getNumNodes()<=surf.getNumNodes())
+    {
+        cout << "Moved vertices welded without tolerance" << endl;
+        return(1);
+    }
+
+    down.fileFromStl("stlTest.txt", &back, 1e-6, 3);
+    if(!same(surf, back, 1e-8))	return(1);
+
+    // due vertici lontani più di toll non sono fusi anche se prima erano nella stessa cella di lato toll
+    punti.push_back(point(0.05, 0.05, 0.05));
+    punti.push_back(point(0.95, 0.95, 0.95));
+    writePoints("stlFar.txt", punti);
+    down.fileFromStl("stlFar.txt", &back, 1.0);
+    if(back.getNumNodes()!=6 || back.getNumElements()!=2)
+    {
+        cout << "Vertices farther than the tolerance are welded" << endl;
+        return(1);
+    }
+
+    // una catena di vertici a distanza minore di toll diventa un solo nodo, anche se i primi vertici delle loro celle
+    // sono lontani più di toll, e il nodo ha le coordinate del primo vertice del file
+    punti.clear();
+    punti.push_back(point(0.1, 0.5, 0.5));
+    punti.push_back(point(1.9, 0.5, 0.5));
+    punti.push_back(point(0.95, 0.5, 0.5));
+    punti.push_back(point(1.05, 0.5, 0.5));
+    writePoints("stlChain.txt", punti);
+    for(UInt th=1; th<=3; th+=2)
+    {
+        down.fileFromStl("stlChain.txt", &back, 1.0, th);
+        if(back.getNumNodes()!=9 || back.getNumElements()!=4 || back.getNode(0).getX()!=0.1)
+        {
+            cout << "The vertices nearer than the tolerance are not welded with " << th << " threads" << endl;
+            return(1);
+        }
+        for(UInt i=0; i<4; ++i)
+            if(back.getElement(i).getConnectedId(0)!=0)
+            {
+                cout << "The element " << i << " does not use the welded node" << endl;
+                return(1);
+            }
+    }
+
+    // un file sbagliato lascia la mesh vuota
+    ofstream out("stlWrong.stl");
+    out << "solid wrong\n facet normal 0 0 1\n outer loop\n vertex 0 0 x\n";
+    out.close();
+    down.fileFromStl("stlWrong.stl", &back);
+    if(back.getNumNodes()!=0 || back.getNumElements()!=0)
+    {
+        cout << "A wrong file is read" << endl;
+        return(1);
+    }
+
+    cout << "stl test passed" << endl;
+    return(0);
+}
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// legge un file intero in una stringa
+string content(string name)
+{
+    ifstream		file(name.c_str());
+    ostringstream	str;
+
+    str << file.rdbuf();
+    return(str.str());
+}
+
+// aggiunge una sfera con nLat anelli e nLon spicchi, i nodi partono da primo
+void sfera(vector<point> * nodi, vector<vector<UInt> > * tria, point centro, Real raggio, UInt nLat, UInt nLon)
+{
+    UInt primo = nodi->size();
+    Real pi    = 4.0*atan(1.0);
+
+    // poli e anelli
+    nodi->push_back(centro + point(0.0, 0.0, raggio));
+    nodi->push_back(centro + point(0.0, 0.0, -raggio));
+    for(UInt i=1; i<=nLat; ++i)
+        for(UInt j=0; j<nLon; ++j)
+        {
+            Real t = pi*i/(nLat+1), f = 2.0*pi*j/nLon;
+            nodi->push_back(centro + point(raggio*sin(t)*cos(f), raggio*sin(t)*sin(f), raggio*cos(t)));
+        }
+
+    // calotte e fasce tra gli anelli
+    for(UInt j=0; j<nLon; ++j)
+    {
+        UInt a = primo+2+j, b = primo+2+(j+1)%nLon;
+        tria->push_back({primo, a, b});
+        tria->push_back({primo+1, b+(nLat-1)*nLon, a+(nLat-1)*nLon});
+        for(UInt i=0; i+1<nLat; ++i)
+        {
+            tria->push_back({a+i*nLon, a+(i+1)*nLon, b+(i+1)*nLon});
+            tria->push_back({a+i*nLon, b+(i+1)*nLon, b+i*nLon});
+        }
+    }
+}
+
+// semplifica la mucca da file a file con una memoria che la divide in più blocchi, poi controlla che con un file dei
+// blocchi aperto alla volta il risultato sia lo stesso, che una mesh molto disuniforme rispetti la memoria e che i
+// file sbagliati vengano rifiutati
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf;
+    streamSimplification	stream;
+    UInt			numNode;
+
+    stream.setMemoryBudget(1000*1024);
+    stream.setTmpPrefix("streamTest");
+    numNode = stream.simplificate("../mesh/cow.inp", "streamCow.inp", 1500);
+
+    if(numNode==0)
+    {
+        cout << "The simplification of ../mesh/cow.inp fails" << endl;
+        return(1);
+    }
+
+    if(!loadMesh("streamCow.inp", &surf))
+        return(1);
+
+    if(surf.getNumNodes()!=numNode)
+    {
+        cout << "The file has " << surf.getNumNodes() << " nodes instead of " << numNode << endl;
+        return(1);
+    }
+
+    if(numNode>1600)
+    {
+        cout << "The simplification stops at " << numNode << " nodes" << endl;
+        return(1);
+    }
+
+    if(!closed(surf))	return(1);
+
+    // i file dei blocchi scritti in più passate
+    stream.setMaxOpenFiles(1);
+    if(stream.simplificate("../mesh/cow.inp", "streamCowPasses.inp", 1500)!=numNode ||
+       content("streamCow.inp")!=content("streamCowPasses.inp"))
+    {
+        cout << "Different results with one open block file" << endl;
+        return(1);
+    }
+
+    // una sfera fitta e una rada: la griglia è fatta sul numero totale di triangoli e il blocco della sfera fitta
+    // deve essere diviso
+    vector<point>		nodi;
+    vector<vector<UInt> >	tria;
+    sfera(&nodi, &tria, point(0.0, 0.0, 0.0), 0.1, 40, 50);
+    sfera(&nodi, &tria, point(3.0, 0.0, 0.0), 1.0, 6, 8);
+
+    ofstream uneven("streamUneven.inp");
+    uneven.precision(16);
+    uneven << nodi.size() << " " << tria.size() << " 0 0 0" << endl;
+    for(UInt i=0; i<nodi.size(); ++i)
+        uneven << i+1 << " " << nodi[i].getX() << " " << nodi[i].getY() << " " << nodi[i].getZ() << endl;
+    for(UInt i=0; i<tria.size(); ++i)
+        uneven << i+1 << " 0 tri " << tria[i][0]+1 << " " << tria[i][1]+1 << " " << tria[i][2]+1 << endl;
+    uneven.close();
+
+    stream.setMaxOpenFiles(64);
+    numNode = stream.simplificate("streamUneven.inp", "streamUnevenOut.inp", 1000);
+    if(numNode==0 || !loadMesh("streamUnevenOut.inp", &surf) || !closed(surf))
+        return(1);
+
+    if(stream.getMaxBlockSize()*streamSimplification::bytePerElement>stream.getMemoryBudget())
+    {
+        cout << "A block of the uneven mesh has " << stream.getMaxBlockSize() << " elements" << endl;
+        return(1);
+    }
+
+    // un file mancante e un triangolo con un nodo fuori dai nodi
+    if(stream.simplificate("../mesh/missing.inp", "streamMissing.inp", 1500)!=0)
+    {
+        cout << "A missing file is simplified" << endl;
+        return(1);
+    }
+
+    ofstream bad("streamBad.inp");
+    bad << "3 1 0 0 0" << endl;
+    bad << "1 0 0 0" << endl << "2 1 0 0" << endl << "3 0 1 0" << endl;
+    bad << "1 0 tri 1 2 4" << endl;
+    bad.close();
+
+    if(stream.simplificate("streamBad.inp", "streamBadOut.inp", 1)!=0)
+    {
+        cout << "A triangle with a node out of range is accepted" << endl;
+        return(1);
+    }
+
+    cout << "streamSimplification test passed" << endl;
+    return(0);
+}
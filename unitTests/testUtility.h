@@ -0,0 +1,97 @@
+#ifndef TESTUTILITY_H_
+#define TESTUTILITY_H_
+
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include <string>
+#include "meshSimplification.h"
+
+// funzioni comuni ai test, i test partono dalla cartella di build e restituiscono 1 se falliscono
+
+// carica una mesh paraview e controlla che abbia dei nodi
+inline bool loadMesh(std::string name, geometry::mesh2d<geometry::Triangle> * surf)
+{
+    geometry::downloadMesh	down;
+
+    down.fileFromParaview(name, surf);
+    if(surf->getNumNodes()==0)
+    {
+        std::cout << "The mesh " << name << " is not loaded" << std::endl;
+        return(false);
+    }
+
+    return(true);
+}
+
+// controlla che la mesh sia chiusa: ogni edge ha esattamente due elementi e non ci sono elementi degeneri o nodi non
+// usati
+inline bool closed(geometry::mesh2d<geometry::Triangle> & surf)
+{
+    std::vector<bool>					used(surf.getNumNodes(), false);
+    std::map<std::pair<geometry::UInt,geometry::UInt>, geometry::UInt>	edges;
+    std::vector<geometry::UInt>				conn;
+
+    for(geometry::UInt i=0; i<surf.getNumElements(); ++i)
+    {
+        conn = surf.getElement(i).getConnectedIds();
+        if(conn[0]==conn[1] || conn[1]==conn[2] || conn[0]==conn[2])
+        {
+            std::cout << "The element " << i << " is degenerate" << std::endl;
+            return(false);
+        }
+
+        for(geometry::UInt j=0; j<3; ++j)
+        {
+            used[conn[j]] = true;
+            ++edges[std::make_pair(std::min(conn[j], conn[(j+1)%3]), std::max(conn[j], conn[(j+1)%3]))];
+        }
+    }
+
+    for(auto it=edges.begin(); it!=edges.end(); ++it)
+        if(it->second!=2)
+        {
+            std::cout << "The edge " << it->first.first << " " << it->first.second << " has " << it->second;
+            std::cout << " elements" << std::endl;
+            return(false);
+        }
+
+    if(std::find(used.begin(), used.end(), false)!=used.end())
+    {
+        std::cout << "There are unused nodes" << std::endl;
+        return(false);
+    }
+
+    return(true);
+}
+
+// controlla che due mesh abbiano gli stessi nodi e la stessa connettività, serve a confrontare 1 e N thread
+inline bool sameMesh(geometry::mesh2d<geometry::Triangle> & a, geometry::mesh2d<geometry::Triangle> & b,
+                     std::string s)
+{
+    if(a.getNumNodes()!=b.getNumNodes() || a.getNumElements()!=b.getNumElements())
+    {
+        std::cout << s << ": different number of nodes or elements" << std::endl;
+        return(false);
+    }
+
+    for(geometry::UInt i=0; i<a.getNumNodes(); ++i)
+        for(geometry::UInt j=0; j<3; ++j)
+            if(a.getNode(i).getI(j)!=b.getNode(i).getI(j))
+            {
+                std::cout << s << ": different coordinates of the node " << i << std::endl;
+                return(false);
+            }
+
+    for(geometry::UInt i=0; i<a.getNumElements(); ++i)
+        for(geometry::UInt j=0; j<3; ++j)
+            if(a.getElement(i).getConnectedId(j)!=b.getElement(i).getConnectedId(j))
+            {
+                std::cout << s << ": different connectivity of the element " << i << std::endl;
+                return(false);
+            }
+
+    return(true);
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <algorithm>
+#include <map>
+#include "meshSimplification.h"
+#include "testUtility.h"
+
+using namespace geometry;
+using namespace std;
+
+// controlla che la mesh del clustering vada bene per il collasso degli edge: niente triangoli degeneri o ripetuti,
+// niente nodi non usati e nessun edge con più di due triangoli
+bool valid(mesh2d<Triangle> & surf)
+{
+    vector<bool>			used(surf.getNumNodes(), false);
+    vector<vector<UInt> >		tria;
+    map<pair<UInt,UInt>, UInt>		edges;
+    vector<UInt>			conn;
+
+    for(UInt i=0; i<surf.getNumElements(); ++i)
+    {
+        conn = surf.getElement(i).getConnectedIds();
+        if(conn[0]==conn[1] || conn[1]==conn[2] || conn[0]==conn[2])
+        {
+            cout << "The element " << i << " is degenerate" << endl;
+            return(false);
+        }
+
+        for(UInt j=0; j<3; ++j)
+        {
+            used[conn[j]] = true;
+            if(++edges[make_pair(min(conn[j], conn[(j+1)%3]), max(conn[j], conn[(j+1)%3]))]>2)
+            {
+                cout << "An edge of the element " << i << " is shared by more than two elements" << endl;
+                return(false);
+            }
+        }
+
+        sort(conn.begin(), conn.end());
+        tria.push_back(conn);
+    }
+
+    sort(tria.begin(), tria.end());
+    if(adjacent_find(tria.begin(), tria.end())!=tria.end())
+    {
+        cout << "There are duplicated elements" << endl;
+        return(false);
+    }
+
+    if(find(used.begin(), used.end(), false)!=used.end())
+    {
+        cout << "There are unused nodes" << endl;
+        return(false);
+    }
+
+    return(true);
+}
+
+// fa il clustering del coniglio a un quinto dei nodi e poi prosegue con il collasso degli edge
+int main()
+{
+    // variabili in uso
+    mesh2d<Triangle>		surf;
+    UInt			start,target;
+
+    if(!loadMesh("../mesh/bunny.inp", &surf))	return(1);
+    start  = surf.getNumNodes();
+    target = start/5;
+
+    vertexClustering clus(&surf);
+    clus.simplificate(target);
+
+    if(surf.getNumNodes()>target || surf.getNumNodes()<target/2)
+    {
+        cout << "The clustering gives " << surf.getNumNodes() << " nodes instead of " << target << endl;
+        return(1);
+    }
+
+    if(!valid(surf))	return(1);
+
+    // seconda fase, basta un breve collasso per vedere che la mesh del clustering va bene
+    simplification2d<Triangle> simp;
+    simp.setMeshPointer(&surf);
+    simp.simplificateGreedy(target-1000);
+
+    if(surf.getNumNodes()>target-1000 || !valid(surf))	return(1);
+
+    // un lato troppo piccolo per numerare le celle: la griglia lo allarga e i rappresentanti usano lo stesso lato
+    if(!loadMesh("../mesh/cow.inp", &surf))	return(1);
+    vertexClustering tiny(&surf);
+    tiny.simplificateCellSize(1e-12);
+    if(surf.getNumNodes()==0 || !valid(surf))	return(1);
+
+    // con zero nodi la mesh non viene toccata
+    UInt numNodi = surf.getNumNodes();
+    vertexClustering zero(&surf);
+    zero.simplificate(0);
+    if(surf.getNumNodes()!=numNodi)
+    {
+        cout << "The clustering to zero nodes changes the mesh" << endl;
+        return(1);
+    }
+
+    cout << "vertexClustering test passed" << endl;
+    return(0);
+}